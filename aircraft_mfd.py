@@ -31,6 +31,7 @@ Keyboard Shortcuts (fallback when USB device not connected):
     7 - Show TURN PERF panel only (full screen)
     8 - Show VNAV panel only (full screen)
     9 - Show DENSITY ALT panel only (full screen)
+    T - Toggle the frame timing panel (per-stage latency histograms)
 """
 
 import tkinter as tk
@@ -44,6 +45,22 @@ from pathlib import Path
 import subprocess
 import ctypes
 import ctypes.util
+import platform
+import fcntl
+import select
+import socket
+import struct
+import mmap
+import re
+import tempfile
+import base64
+import hashlib
+import threading
+import urllib.parse
+from collections import deque
+from contextlib import contextmanager
+from dataclasses import dataclass, field
+from concurrent.futures import ThreadPoolExecutor, wait
 
 try:
     import pygame.joystick
@@ -53,12 +70,441 @@ except ImportError:
     print("Warning: pygame not available. Install with: pip install pygame")
 
 
+class StageHistogram:
+    """Latency histogram with fixed millisecond buckets (no per-sample storage)"""
+
+    BOUNDS_MS = (0.05, 0.1, 0.2, 0.5, 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000)
+
+    def __init__(self):
+        self.reset()
+
+    def reset(self):
+        self.counts = [0] * (len(self.BOUNDS_MS) + 1)
+        self.count = 0
+        self.total_ms = 0.0
+        self.max_ms = 0.0
+
+    def record(self, ms: float):
+        bucket = 0
+        while bucket < len(self.BOUNDS_MS) and ms > self.BOUNDS_MS[bucket]:
+            bucket += 1
+        self.counts[bucket] += 1
+        self.count += 1
+        self.total_ms += ms
+        self.max_ms = max(self.max_ms, ms)
+
+    def percentile(self, fraction: float) -> float:
+        """Upper bound of the bucket holding the given fraction of samples"""
+        if self.count == 0:
+            return 0.0
+        target = fraction * self.count
+        seen = 0
+        for bucket, bucket_count in enumerate(self.counts):
+            seen += bucket_count
+            if seen >= target:
+                if bucket < len(self.BOUNDS_MS):
+                    return min(self.BOUNDS_MS[bucket], self.max_ms)
+                break
+        return self.max_ms
+
+
+class FrameTimings:
+    """Per-stage timing of the MFD update loop
+
+    Time spent in a stage is added up over one frame (a tick can make many
+    dataref fetches) and each frame's total goes into that stage's
+    histogram. Stages:
+        fetch    X-Plane Web API requests
+        calc     calculator round trips, decoding excluded
+        compute  time the calculators report for their own maths (compute_us)
+        ipc      calc minus compute: pipe/socket and scheduling cost
+        decode   JSON / wire format decoding of calculator replies
+        widgets  display variable updates and the Tk redraw
+        frame    the Tk thread's work showing one frame
+        latency  acquisition start to the frame being shown
+    The histograms cover the current log interval and are reset after each
+    periodic log line.
+    """
+
+    STAGES = ("frame", "latency", "fetch", "calc", "compute", "ipc", "decode", "widgets")
+
+    def __init__(self, log_interval_s: float = 10.0):
+        self.log_interval_s = log_interval_s
+        self.histograms = {stage: StageHistogram() for stage in self.STAGES}
+        self.frame_totals: Dict[str, float] = {}
+        self.window_start = time.monotonic()
+
+    def add(self, stage: str, seconds: float):
+        self.frame_totals[stage] = self.frame_totals.get(stage, 0.0) + seconds
+
+    def frame_seconds(self, stage: str) -> float:
+        return self.frame_totals.get(stage, 0.0)
+
+    def take_frame_totals(self) -> Dict[str, float]:
+        """Hand this frame's stage totals over (pipeline threads) and start afresh"""
+        totals, self.frame_totals = self.frame_totals, {}
+        return totals
+
+    def merge(self, totals: Dict[str, float]):
+        for stage, seconds in totals.items():
+            self.add(stage, seconds)
+
+    @contextmanager
+    def measure(self, stage: str):
+        start = time.perf_counter()
+        try:
+            yield
+        finally:
+            self.add(stage, time.perf_counter() - start)
+
+    def end_frame(self):
+        """Record this frame's stage totals and start the next frame"""
+        if "calc" in self.frame_totals and "compute" in self.frame_totals:
+            self.frame_totals["ipc"] = max(0.0, self.frame_totals["calc"] - self.frame_totals["compute"])
+        for stage, seconds in self.frame_totals.items():
+            if stage in self.histograms:
+                self.histograms[stage].record(seconds * 1000.0)
+        self.frame_totals = {}
+
+    def summary_lines(self):
+        """One 'stage count p50 p95 p99 max' line per stage (milliseconds)"""
+        lines = [f"{'STAGE':<8} {'N':>5} {'P50':>7} {'P95':>7} {'P99':>7} {'MAX':>7}"]
+        for stage in self.STAGES:
+            h = self.histograms[stage]
+            lines.append(f"{stage.upper():<8} {h.count:>5} {h.percentile(0.5):>7.2f} "
+                         f"{h.percentile(0.95):>7.2f} {h.percentile(0.99):>7.2f} {h.max_ms:>7.2f}")
+        return lines
+
+    def log_line(self) -> str:
+        parts = []
+        for stage in self.STAGES:
+            h = self.histograms[stage]
+            if h.count:
+                parts.append(f"{stage} p50={h.percentile(0.5):g} p99={h.percentile(0.99):g} "
+                             f"max={h.max_ms:.1f}")
+        return "timing (ms): " + " | ".join(parts)
+
+    def maybe_log(self):
+        """Print the log line and start a new window every log_interval_s"""
+        now = time.monotonic()
+        if now - self.window_start >= self.log_interval_s:
+            if self.histograms["frame"].count:
+                print(self.log_line())
+            for histogram in self.histograms.values():
+                histogram.reset()
+            self.window_start = now
+
+
+class LatestSlot:
+    """Single-item handoff between pipeline threads that keeps the newest item
+
+    put replaces an item the consumer hasn't taken yet (a stale frame is
+    dropped, never queued). The slot is a deque(maxlen=1), whose append and
+    popleft are atomic, so neither side takes a lock; the Event only wakes a
+    waiting consumer.
+    """
+
+    def __init__(self):
+        self.items = deque(maxlen=1)
+        self.ready = threading.Event()
+        self.dropped = 0
+
+    def put(self, item):
+        if self.items:
+            self.dropped += 1
+        self.items.append(item)
+        self.ready.set()
+
+    def take(self, timeout: Optional[float] = None):
+        """Newest item, or None if there is none (after waiting up to timeout)"""
+        if timeout is not None and not self.ready.wait(timeout):
+            return None
+        self.ready.clear()
+        try:
+            return self.items.popleft()
+        except IndexError:
+            return None
+
+
+class PanelScheduler:
+    """Which datarefs and calculator sections an acquisition tick reads
+
+    Each panel lists the datarefs and calculator sections it shows, each
+    with a rate class: RATE_FAST items are read every tick, RATE_SLOW ones
+    at most every RATE_INTERVALS_S[RATE_SLOW]. An item several visible
+    panels show takes the fastest of their rates; an item no visible panel
+    shows is paused. A section's input datarefs are read at the section's
+    rate, except those with a rate limit (aircraft constants, weight, OAT),
+    which are never read more often than their limit; the section then uses
+    the last value read.
+
+    set_visible (Tk thread) replaces the plan with one assignment and
+    take_due (acquisition thread) reads it once per tick, so neither takes
+    a lock. A panel shown again is due at once, since its items haven't
+    been read while it was hidden.
+    """
+
+    RATE_FAST = "fast"
+    RATE_SLOW = "slow"
+    RATE_INTERVALS_S = {RATE_FAST: 0.0, RATE_SLOW: 1.0}
+
+    def __init__(self, panel_items: Dict[int, Dict[Any, str]], section_datarefs: Dict[str, tuple],
+                 rate_limits: Dict[tuple, str]):
+        self.panel_items = panel_items
+        self.section_datarefs = section_datarefs
+        self.rate_limits = rate_limits
+        self.intervals: Dict[Any, float] = {}
+        self.last_read: Dict[Any, float] = {}
+        # Items issued so far, for the timing panel
+        self.dataref_reads = 0
+        self.section_runs = 0
+
+    def set_visible(self, panels):
+        """Plan the reads for the panels now on screen"""
+        intervals = {}
+        for panel in panels:
+            for item, rate in self.panel_items.get(panel, {}).items():
+                intervals[item] = min(intervals.get(item, float("inf")), self.RATE_INTERVALS_S[rate])
+        for section, keys in self.section_datarefs.items():
+            if section in intervals:
+                for key in keys:
+                    intervals[key] = min(intervals.get(key, float("inf")), intervals[section])
+        for key, rate in self.rate_limits.items():
+            if key in intervals:
+                intervals[key] = max(intervals[key], self.RATE_INTERVALS_S[rate])
+        self.intervals = intervals
+
+    def take_due(self, now: float):
+        """(dataref keys, section names) due at now (time.monotonic), marked read"""
+        datarefs = []
+        sections = set()
+        for item, interval in self.intervals.items():
+            last = self.last_read.get(item)
+            if last is None or now - last >= interval:
+                self.last_read[item] = now
+                if item in self.section_datarefs:
+                    sections.add(item)
+                else:
+                    datarefs.append(item)
+        self.dataref_reads += len(datarefs)
+        self.section_runs += len(sections)
+        return datarefs, sections
+
+
+@dataclass
+class FrameSnapshot:
+    """One frame on its way through the display pipeline
+
+    The acquisition thread fills in the connection state, dataref values and
+    calculator inputs; the compute thread adds the results and formats the
+    display text; the Tk thread applies it. timings holds each stage thread's FrameTimings totals.
+    """
+    status: str                                   # "connected", "lost" or "disconnected"
+    error: str = ""
+    values: Dict[tuple, Any] = field(default_factory=dict)
+    sections: Dict[str, list] = field(default_factory=dict)
+    results: Dict[str, dict] = field(default_factory=dict)
+    fields: Dict[str, str] = field(default_factory=dict)   # display text by variable name
+    timings: Dict[str, float] = field(default_factory=dict)
+    acquired: float = 0.0                         # perf_counter at acquisition start
+
+
+class WebSocketConnection:
+    """Minimal RFC 6455 client (text messages, ping/pong, close) on the stdlib
+
+    Incoming bytes are buffered and frames parsed from the buffer, so a
+    receive timeout never leaves a half-read frame behind.
+    """
+
+    GUID = b"258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+    OP_CONTINUATION, OP_TEXT, OP_CLOSE, OP_PING, OP_PONG = 0x0, 0x1, 0x8, 0x9, 0xA
+
+    def __init__(self, url: str, timeout: float = 2.0):
+        parts = urllib.parse.urlsplit(url)
+        self.sock = socket.create_connection((parts.hostname, parts.port or 80), timeout=timeout)
+        self.buffer = b""
+        self.fragments = []
+        try:
+            self.handshake(parts, timeout)
+        except Exception:
+            self.sock.close()
+            raise
+
+    def handshake(self, parts, timeout: float):
+        key = base64.b64encode(os.urandom(16))
+        request = (f"GET {parts.path or '/'} HTTP/1.1\r\n"
+                   f"Host: {parts.hostname}:{parts.port or 80}\r\n"
+                   "Upgrade: websocket\r\nConnection: Upgrade\r\n"
+                   f"Sec-WebSocket-Key: {key.decode()}\r\nSec-WebSocket-Version: 13\r\n\r\n")
+        self.sock.sendall(request.encode())
+        deadline = time.monotonic() + timeout
+        while b"\r\n\r\n" not in self.buffer:
+            if time.monotonic() > deadline:
+                raise ConnectionError("websocket handshake timed out")
+            chunk = self.sock.recv(4096)
+            if not chunk:
+                raise ConnectionError("websocket handshake closed")
+            self.buffer += chunk
+        head, self.buffer = self.buffer.split(b"\r\n\r\n", 1)
+        lines = head.decode("latin-1").split("\r\n")
+        if len(lines[0].split()) < 2 or lines[0].split()[1] != "101":
+            raise ConnectionError(f"websocket upgrade refused: {lines[0]}")
+        accept = base64.b64encode(hashlib.sha1(key + self.GUID).digest()).decode()
+        headers = {k.strip().lower(): v.strip() for k, _, v in (line.partition(":") for line in lines[1:])}
+        if headers.get("sec-websocket-accept") != accept:
+            raise ConnectionError("bad Sec-WebSocket-Accept")
+
+    def send_frame(self, opcode: int, payload: bytes):
+        # Client frames are always masked
+        header = bytes([0x80 | opcode])
+        length = len(payload)
+        if length < 126:
+            header += bytes([0x80 | length])
+        elif length < 65536:
+            header += bytes([0x80 | 126]) + struct.pack(">H", length)
+        else:
+            header += bytes([0x80 | 127]) + struct.pack(">Q", length)
+        mask = os.urandom(4)
+        masked = bytes(b ^ mask[i % 4] for i, b in enumerate(payload))
+        self.sock.sendall(header + mask + masked)
+
+    def send_text(self, text: str):
+        self.send_frame(self.OP_TEXT, text.encode())
+
+    def parse_frame(self):
+        """Take one whole frame off the buffer: (fin, opcode, payload) or None"""
+        if len(self.buffer) < 2:
+            return None
+        fin = bool(self.buffer[0] & 0x80)
+        opcode = self.buffer[0] & 0x0F
+        masked = bool(self.buffer[1] & 0x80)
+        length = self.buffer[1] & 0x7F
+        offset = 2
+        if length == 126:
+            if len(self.buffer) < 4:
+                return None
+            length = struct.unpack_from(">H", self.buffer, 2)[0]
+            offset = 4
+        elif length == 127:
+            if len(self.buffer) < 10:
+                return None
+            length = struct.unpack_from(">Q", self.buffer, 2)[0]
+            offset = 10
+        mask = b""
+        if masked:
+            mask = self.buffer[offset:offset + 4]
+            offset += 4
+        if len(self.buffer) < offset + length:
+            return None
+        payload = self.buffer[offset:offset + length]
+        self.buffer = self.buffer[offset + length:]
+        if masked:
+            payload = bytes(b ^ mask[i % 4] for i, b in enumerate(payload))
+        return fin, opcode, payload
+
+    def recv_text(self, timeout: float) -> Optional[str]:
+        """Next text message, or None if none completes within timeout
+
+        Raises ConnectionError when the server closes the connection.
+        """
+        deadline = time.monotonic() + timeout
+        while True:
+            frame = self.parse_frame()
+            if frame is None:
+                remaining = deadline - time.monotonic()
+                if remaining <= 0:
+                    return None
+                self.sock.settimeout(remaining)
+                try:
+                    chunk = self.sock.recv(65536)
+                except socket.timeout:
+                    return None
+                if not chunk:
+                    raise ConnectionError("websocket closed")
+                self.buffer += chunk
+                continue
+            fin, opcode, payload = frame
+            if opcode == self.OP_PING:
+                self.send_frame(self.OP_PONG, payload)
+            elif opcode == self.OP_CLOSE:
+                raise ConnectionError("websocket closed by server")
+            elif opcode in (self.OP_TEXT, self.OP_CONTINUATION):
+                self.fragments.append(payload)
+                if fin:
+                    message = b"".join(self.fragments).decode()
+                    self.fragments = []
+                    return message
+
+    def close(self):
+        try:
+            self.send_frame(self.OP_CLOSE, b"")
+        except OSError:
+            pass
+        self.sock.close()
+
+
 class XPlaneAPI:
-    """Interface to X-Plane Web API"""
+    """Interface to X-Plane Web API
+
+    update_data reads about 25 datarefs per frame. Names registered with
+    register_datarefs are resolved to IDs with one request, and
+    fetch_frame_values then reads all of them concurrently over pooled
+    keep-alive connections, so a frame costs about one round trip instead
+    of 25 in a row. get_dataref_value serves registered datarefs from the
+    frame snapshot; other names are still fetched one request at a time.
+    
+    With start_subscription, a background thread instead subscribes to the
+    registered datarefs over X-Plane's WebSocket API and keeps the pushed
+    values in a local cache. fetch_frame_values then only copies that cache,
+    so the Tk thread does no network I/O. If the WebSocket drops, frames go
+    back to REST polling until the thread reconnects.
+    """
+    
+    # Concurrent value requests per frame, and how long a frame waits for
+    # them; a value that misses the deadline reads as None for that frame
+    FETCH_WORKERS = 8
+    FRAME_FETCH_DEADLINE_S = 0.25
+    
+    # Names X-Plane didn't know (aircraft-specific) are retried this often
+    UNRESOLVED_RETRY_S = 5.0
     
-    def __init__(self, base_url: str = "http://localhost:8086/api/v2"):
+    # Delay before the subscription thread reconnects a dropped WebSocket
+    SUBSCRIPTION_RECONNECT_S = 2.0
+    
+    def __init__(self, base_url: str = "http://localhost:8086/api/v2",
+                 timings: Optional[FrameTimings] = None):
         self.base_url = base_url
         self.dataref_cache: Dict[str, int] = {}
+        self.timings = timings if timings is not None else FrameTimings()
+        
+        # Registered (name, index) keys, names still awaiting an ID, and the
+        # values of the last fetch_frame_values call
+        self.frame_datarefs = []
+        self.unresolved_names = set()
+        self.unresolved_checked = 0.0
+        self.frame_values: Dict[tuple, Any] = {}
+        
+        # Value requests still queued or running past their frame's
+        # deadline, by key. A key is not requested again until its last
+        # request finishes, so a stalled X-Plane holds at most one request
+        # per dataref in the fetch pool.
+        self.in_flight: Dict[tuple, Any] = {}
+        self.missed_deadline = 0    # requests that missed FRAME_FETCH_DEADLINE_S
+        self.skipped_pending = 0    # frame reads skipped while the last request ran
+        
+        self.session = requests.Session()
+        adapter = requests.adapters.HTTPAdapter(pool_connections=1, pool_maxsize=self.FETCH_WORKERS)
+        self.session.mount("http://", adapter)
+        self.executor = ThreadPoolExecutor(max_workers=self.FETCH_WORKERS,
+                                           thread_name_prefix="dataref-fetch")
+        
+        # WebSocket push subscription: values by (name, index), written by
+        # the subscription thread under subscription_lock
+        self.subscription_thread: Optional[threading.Thread] = None
+        self.subscription_stop = threading.Event()
+        self.subscription_lock = threading.Lock()
+        self.subscription_connected = False
+        self.pushed_values: Dict[tuple, Any] = {}
         
     def get_dataref_id_by_name(self, name: str) -> Optional[int]:
         """Get dataref ID by name, with caching"""
@@ -66,12 +512,13 @@ class XPlaneAPI:
             return self.dataref_cache[name]
         
         try:
-            response = requests.get(
-                f"{self.base_url}/datarefs",
-                headers={"Accept": "application/json"},
-                params={"filter[name]": name},
-                timeout=1
-            )
+            with self.timings.measure("fetch"):
+                response = self.session.get(
+                    f"{self.base_url}/datarefs",
+                    headers={"Accept": "application/json"},
+                    params={"filter[name]": name},
+                    timeout=1
+                )
             if response.status_code == 200:
                 data = response.json()
                 if data.get("data") and len(data["data"]) > 0:
@@ -82,34 +529,778 @@ class XPlaneAPI:
             print(f"Error getting dataref {name}: {e}")
         return None
     
+    def resolve_dataref_ids(self, names):
+        """Look up the IDs of several dataref names with one request
+        
+        filter[name] may be repeated; the reply lists every dataref that
+        matched. Names X-Plane doesn't report stay unresolved.
+        """
+        names = [name for name in names if name not in self.dataref_cache]
+        if not names:
+            return
+        try:
+            response = self.session.get(
+                f"{self.base_url}/datarefs",
+                headers={"Accept": "application/json"},
+                params={"filter[name]": names, "fields": "id,name"},
+                timeout=1
+            )
+            if response.status_code == 200:
+                for entry in response.json().get("data") or []:
+                    self.dataref_cache[entry["name"]] = entry["id"]
+        except Exception as e:
+            print(f"Error resolving {len(names)} datarefs: {e}")
+    
+    def register_datarefs(self, keys):
+        """Set the datarefs fetch_frame_values reads: (name, index or None) pairs"""
+        self.frame_datarefs = list(keys)
+        self.unresolved_names = {name for name, _ in self.frame_datarefs}
+        self.unresolved_checked = 0.0
+    
+    def fetch_value_by_id(self, dataref_id: int, index: Optional[int] = None) -> Optional[Any]:
+        """One value request (safe to call from the fetch pool)"""
+        params = {"index": index} if index is not None else {}
+        response = self.session.get(
+            f"{self.base_url}/datarefs/{dataref_id}/value",
+            headers={"Accept": "application/json"},
+            params=params,
+            timeout=1
+        )
+        if response.status_code != 200:
+            return None
+        value = response.json().get("data")
+        
+        # If requesting array element, X-Plane returns [value], extract it
+        if index is not None and isinstance(value, list) and len(value) > 0:
+            return value[0]
+        
+        return value
+    
+    def start_subscription(self):
+        """Start the WebSocket subscription thread for the registered datarefs"""
+        if self.subscription_thread is None:
+            self.subscription_stop.clear()
+            self.subscription_thread = threading.Thread(target=self.run_subscription,
+                                                        name="dataref-subscription", daemon=True)
+            self.subscription_thread.start()
+    
+    def stop_subscription(self):
+        self.subscription_stop.set()
+        if self.subscription_thread is not None:
+            self.subscription_thread.join(timeout=2.0)
+            self.subscription_thread = None
+    
+    def is_subscribed(self) -> bool:
+        with self.subscription_lock:
+            return self.subscription_connected
+    
+    def websocket_url(self) -> str:
+        parts = urllib.parse.urlsplit(self.base_url)
+        scheme = "wss" if parts.scheme == "https" else "ws"
+        return urllib.parse.urlunsplit((scheme, parts.netloc, parts.path, "", ""))
+    
+    def run_subscription(self):
+        """Subscription thread: connect, subscribe, apply updates, reconnect"""
+        while not self.subscription_stop.is_set():
+            connection = None
+            try:
+                connection = WebSocketConnection(self.websocket_url())
+                self.subscribe_updates(connection)
+            except (OSError, ConnectionError, ValueError) as e:
+                print(f"Dataref subscription: {e}")
+            finally:
+                with self.subscription_lock:
+                    self.subscription_connected = False
+                if connection is not None:
+                    connection.close()
+            self.subscription_stop.wait(self.SUBSCRIPTION_RECONNECT_S)
+    
+    def subscribe_updates(self, connection: WebSocketConnection):
+        """Subscribe the registered datarefs and apply pushed values until closed
+        
+        X-Plane sends dataref_update_values messages holding only the values
+        that changed, keyed by dataref ID; names it didn't know when the
+        connection opened are retried every UNRESOLVED_RETRY_S. The cache
+        starts empty on each connection: a value the previous one pushed may
+        be long out of date, and reads None until X-Plane sends it again.
+        """
+        with self.subscription_lock:
+            self.pushed_values.clear()
+        subscribed = set()
+        keys_by_id: Dict[int, list] = {}
+        next_req_id = 1
+        resolve_checked = None
+        while not self.subscription_stop.is_set():
+            now = time.monotonic()
+            pending = [key for key in self.frame_datarefs if key not in subscribed]
+            if pending and (resolve_checked is None or now - resolve_checked >= self.UNRESOLVED_RETRY_S):
+                resolve_checked = now
+                self.resolve_dataref_ids(sorted({name for name, _ in pending}))
+                request = []
+                for name, index in pending:
+                    dataref_id = self.dataref_cache.get(name)
+                    if dataref_id is not None:
+                        request.append({"id": dataref_id} if index is None else {"id": dataref_id, "index": index})
+                        keys_by_id.setdefault(dataref_id, []).append((name, index))
+                        subscribed.add((name, index))
+                if request:
+                    connection.send_text(json.dumps({"req_id": next_req_id, "type": "dataref_subscribe_values",
+                                                     "params": {"datarefs": request}}))
+                    next_req_id += 1
+            
+            message = connection.recv_text(timeout=0.5)
+            if message is None:
+                continue
+            data = json.loads(message)
+            if data.get("type") == "result" and not data.get("success", True):
+                print(f"Dataref subscription refused: {data.get('error_message', data)}")
+            elif data.get("type") == "dataref_update_values":
+                updates = {}
+                for id_text, value in (data.get("data") or {}).items():
+                    for name, index in keys_by_id.get(int(id_text), []):
+                        # An indexed subscription arrives as [value], like the REST reply
+                        if index is not None and isinstance(value, list):
+                            updates[(name, index)] = value[0] if value else None
+                        else:
+                            updates[(name, index)] = value
+                with self.subscription_lock:
+                    self.pushed_values.update(updates)
+                    self.subscription_connected = True
+    
+    def fetch_frame_values(self, keys=None):
+        """Read this frame's datarefs: keys, or every registered dataref
+        
+        keys must be registered. While the WebSocket subscription is up this
+        copies them from the pushed cache.
+        Otherwise unresolved names are looked up first (one request, at most
+        every UNRESOLVED_RETRY_S), then all values are requested at once.
+        Values that fail or miss FRAME_FETCH_DEADLINE_S are None in the
+        snapshot. A request that missed the deadline is counted and kept in
+        in_flight: its key reads None until it finishes, and its value is
+        then the next frame's instead of a new request.
+        """
+        keys = self.frame_datarefs if keys is None else keys
+        with self.subscription_lock:
+            if self.subscription_connected:
+                self.frame_values = {key: self.pushed_values.get(key) for key in keys}
+                return self.frame_values
+        
+        with self.timings.measure("fetch"):
+            now = time.monotonic()
+            if self.unresolved_names and now - self.unresolved_checked >= self.UNRESOLVED_RETRY_S:
+                self.unresolved_checked = now
+                self.resolve_dataref_ids(sorted(self.unresolved_names))
+                self.unresolved_names = {name for name in self.unresolved_names
+                                         if name not in self.dataref_cache}
+            
+            futures = {}
+            for key in keys:
+                dataref_id = self.dataref_cache.get(key[0])
+                pending = self.in_flight.pop(key, None)
+                if pending is not None:
+                    if pending.done():
+                        futures[key] = pending
+                    else:
+                        self.in_flight[key] = pending
+                        self.skipped_pending += 1
+                elif dataref_id is not None:
+                    futures[key] = self.executor.submit(self.fetch_value_by_id, dataref_id, key[1])
+            wait(futures.values(), timeout=self.FRAME_FETCH_DEADLINE_S)
+            
+            for key, future in futures.items():
+                if not future.done():
+                    self.missed_deadline += 1
+                    self.in_flight[key] = future
+            
+            values = {}
+            for key in keys:
+                future = futures.get(key)
+                values[key] = None
+                if future is not None and future.done():
+                    try:
+                        values[key] = future.result()
+                    except Exception as e:
+                        print(f"Error getting value for {key[0]}: {e}")
+            self.frame_values = values
+        return values
+    
     def get_dataref_value(self, name: str, index: Optional[int] = None) -> Optional[Any]:
         """Get current value of a dataref by name"""
+        if (name, index) in self.frame_values:
+            return self.frame_values[(name, index)]
+        
         dataref_id = self.get_dataref_id_by_name(name)
         if dataref_id is None:
             return None
         
         try:
-            params = {"index": index} if index is not None else {}
-            response = requests.get(
-                f"{self.base_url}/datarefs/{dataref_id}/value",
-                headers={"Accept": "application/json"},
-                params=params,
-                timeout=1
-            )
-            if response.status_code == 200:
-                data = response.json()
-                value = data.get("data")
-                
-                # If requesting array element, X-Plane returns [value], extract it
-                if index is not None and isinstance(value, list) and len(value) > 0:
-                    return value[0]
-                
-                return value
+            with self.timings.measure("fetch"):
+                return self.fetch_value_by_id(dataref_id, index)
         except Exception as e:
             print(f"Error getting value for {name}: {e}")
         return None
 
 
+# Binary wire format (calculators/wire_format.h): 8-byte header, then a
+# fixed-layout little-endian payload per record type
+WIRE_MAGIC = 0x44464D58
+WIRE_VERSION = 1
+WIRE_HEADER = struct.Struct("<IBBH")
+WIRE_RECORD_ERROR = 9
+WIRE_RECORD_REPLY = 10
+WIRE_RECORD_TIMING = 11
+WIRE_REPLY = struct.Struct("<qii")
+WIRE_TIMING = struct.Struct("<d")
+
+# record type -> (section, key within the section or None, payload layout, field names)
+WIRE_RECORDS = {
+    1: ("flight", "wind", struct.Struct("<5d"),
+        ("speed_kts", "direction_from", "headwind", "crosswind", "gust_factor")),
+    2: ("flight", "envelope", struct.Struct("<6d"),
+        ("stall_margin_pct", "vmo_margin_pct", "mmo_margin_pct", "min_margin_pct",
+         "load_factor", "corner_speed_kts")),
+    3: ("flight", "energy", struct.Struct("<2di"),
+        ("specific_energy_ft", "energy_rate_kts", "trend")),
+    4: ("flight", "glide", struct.Struct("<4d"),
+        ("still_air_range_nm", "wind_adjusted_range_nm", "glide_ratio", "best_glide_speed_kts")),
+    5: ("turn", None, struct.Struct("<8d"),
+        ("radius_nm", "radius_ft", "turn_rate_dps", "lead_distance_nm", "lead_distance_ft",
+         "time_to_turn_sec", "load_factor", "standard_rate_bank")),
+    6: ("vnav", None, struct.Struct("<7d?"),
+        ("altitude_to_lose_ft", "flight_path_angle_deg", "required_vs_fpm", "tod_distance_nm",
+         "time_to_constraint_min", "distance_per_1000ft", "vs_for_3deg", "is_descent")),
+    7: ("density", None, struct.Struct("<8d"),
+        ("density_altitude_ft", "pressure_altitude_ft", "air_density_ratio",
+         "temperature_deviation_c", "performance_loss_pct", "eas_kts", "tas_to_ias_ratio",
+         "pressure_ratio")),
+}
+
+# Records that finish a section (flight spans wind..glide)
+WIRE_SECTION_LAST = {4, 5, 6, 7, WIRE_RECORD_ERROR}
+
+
+def split_wire_reply(buffer: bytes):
+    """Split one complete daemon binary reply off the front of buffer
+
+    Returns (records, reply_record, rest) where records is a list of
+    (type, payload) and reply_record is (id, status, count), or None if the
+    buffer doesn't hold a whole reply yet. Raises ValueError on a bad header.
+    """
+    records = []
+    offset = 0
+    while len(buffer) - offset >= WIRE_HEADER.size:
+        magic, version, record_type, size = WIRE_HEADER.unpack_from(buffer, offset)
+        if magic != WIRE_MAGIC or version != WIRE_VERSION:
+            raise ValueError("bad wire record header")
+        end = offset + WIRE_HEADER.size + size
+        if end > len(buffer):
+            return None
+        payload = buffer[offset + WIRE_HEADER.size:end]
+        offset = end
+        if record_type == WIRE_RECORD_REPLY:
+            return records, WIRE_REPLY.unpack(payload), buffer[offset:]
+        records.append((record_type, payload))
+    return None
+
+
+def decode_wire_sections(records, section_names) -> dict:
+    """Turn section records into the same dicts the JSON reply would hold
+
+    A timing record becomes results["compute_us"]; unknown record types are
+    skipped.
+    """
+    results = {}
+    position = 0
+    for record_type, payload in records:
+        if record_type == WIRE_RECORD_TIMING:
+            results["compute_us"] = WIRE_TIMING.unpack(payload)[0]
+        elif record_type == WIRE_RECORD_ERROR:
+            if position < len(section_names):
+                results[section_names[position]] = {"error": struct.unpack("<i", payload)[0]}
+        elif record_type in WIRE_RECORDS:
+            section, key, layout, names = WIRE_RECORDS[record_type]
+            data = dict(zip(names, layout.unpack(payload)))
+            if key is None:
+                results[section] = data
+            else:
+                results.setdefault(section, {})[key] = data
+        if record_type in WIRE_SECTION_LAST:
+            position += 1
+    return results
+
+
+class ResidentCalculator:
+    """Long-running C++ calculator in --serve mode (one request per line)
+
+    Avoids a fork/exec per frame: the process is started once and reused.
+    If it dies or misses the deadline it is killed and restarted lazily on
+    the next request.
+    """
+
+    def __init__(self, calculator_path: Path, timeout: float = 0.1,
+                 timings: Optional[FrameTimings] = None):
+        self.calculator_path = calculator_path
+        self.timeout = timeout
+        self.timings = timings if timings is not None else FrameTimings()
+        self.process: Optional[subprocess.Popen] = None
+
+    def start(self) -> bool:
+        """Start the calculator process if it isn't already running"""
+        if self.process is not None and self.process.poll() is None:
+            return True
+        if not self.calculator_path.exists():
+            return False
+        try:
+            self.process = subprocess.Popen(
+                [str(self.calculator_path), "--serve"],
+                stdin=subprocess.PIPE,
+                stdout=subprocess.PIPE,
+                stderr=subprocess.DEVNULL,
+                text=True,
+                bufsize=1
+            )
+            return True
+        except OSError:
+            self.process = None
+            return False
+
+    def query(self, *values) -> Optional[dict]:
+        """Send one request line and return the decoded JSON reply"""
+        if not self.start():
+            return None
+        try:
+            self.process.stdin.write(" ".join(str(v) for v in values) + "\n")
+            self.process.stdin.flush()
+
+            ready, _, _ = select.select([self.process.stdout], [], [], self.timeout)
+            if not ready:
+                # Missed the frame deadline: the reply can't be matched to
+                # this request any more, so restart with a clean pipe
+                self.stop()
+                return None
+
+            line = self.process.stdout.readline()
+            if not line:
+                self.stop()
+                return None
+
+            with self.timings.measure("decode"):
+                reply = json.loads(line)
+            if "error" in reply:
+                return None
+            # Time the calculator spent on the request itself
+            compute_us = reply.pop("compute_us", None)
+            if compute_us is not None:
+                self.timings.add("compute", compute_us / 1e6)
+            return reply
+        except (OSError, ValueError):
+            self.stop()
+            return None
+
+    def stop(self):
+        """Terminate the calculator process"""
+        if self.process is not None:
+            try:
+                self.process.kill()
+                self.process.wait(timeout=1)
+            except Exception:
+                pass
+            self.process = None
+
+
+# Shared-memory channel (calculators/shm_channel.h): header, then an input
+# and a result frame at fixed offsets, each guarded by a seqlock. The frames
+# are written with plain stores and no fences, which publish in program
+# order only on x86-64, so the channel is used there alone.
+SHM_MAGIC = 0x53464D58
+SHM_VERSION = 2
+SHM_HEADER = struct.Struct("<IIIII")
+SHM_DOORBELL_OFFSET = 12
+SHM_ORDERED_STORES = platform.machine().lower() in ("x86_64", "amd64")
+SYS_FUTEX_X86_64 = 202
+FUTEX_WAKE = 1
+SHM_INPUT_OFFSET = 64
+SHM_INPUT = struct.Struct("<QQII14d3d5d5d")
+SHM_RESULT_OFFSET = 320
+SHM_RESULT = struct.Struct("<QQII")
+SHM_RESULT_BYTES = 512
+# Result polls: spin this many times, then sleep, doubling from the first
+# sleep up to the longest
+SHM_SPIN_POLLS = 200
+SHM_FIRST_SLEEP_S = 0.0002
+SHM_LONGEST_SLEEP_S = 0.002
+SHM_SECTIONS = ("flight", "turn", "vnav", "density")
+SHM_SECTION_FIELDS = {"flight": 14, "turn": 3, "vnav": 5, "density": 5}
+DEFAULT_SHM_PATH = os.path.join("/dev/shm" if os.path.isdir("/dev/shm") else tempfile.gettempdir(),
+                                "mfd_calcd.shm")
+
+
+class SharedMemoryChannel:
+    """Client side of mfd_calcd's shared-memory channel (--shm)
+
+    The input frame is written with the seqlock protocol (sequence odd while
+    writing), the doorbell is rung, and the result frame is polled until it
+    carries the same frame_id. A spinning daemon (--spin) sees the frame with
+    no system call on either side; one sleeping on the doorbell is woken
+    with one futex call. The writes rely on the CPU keeping stores in
+    program order, as the daemon's C++ side does with release fences, so
+    the channel refuses (ValueError) any machine but x86-64.
+
+    The channel has one writer (shm_channel.h), so the client holds an
+    exclusive flock on the file while it is attached; a second client finds
+    it locked (OSError) and stays on the socket.
+    """
+
+    def __init__(self, path: str):
+        if not SHM_ORDERED_STORES:
+            raise ValueError(f"the shared-memory channel needs x86-64 store order, not {platform.machine()}")
+        self.file = open(path, "r+b")
+        try:
+            fcntl.flock(self.file.fileno(), fcntl.LOCK_EX | fcntl.LOCK_NB)
+            self.map = mmap.mmap(self.file.fileno(), 0)
+        except OSError:
+            self.file.close()
+            raise
+        magic, version, size, _, doorbell_wait = SHM_HEADER.unpack_from(self.map, 0)
+        if magic != SHM_MAGIC or version != SHM_VERSION or size > len(self.map):
+            self.map.close()
+            self.file.close()
+            raise ValueError(f"{path} is not a version {SHM_VERSION} mfd_calcd channel")
+        self.doorbell = ctypes.c_uint32.from_buffer(self.map, SHM_DOORBELL_OFFSET)
+        self.doorbell_address = ctypes.c_void_p(ctypes.addressof(self.doorbell))
+        self.futex = ctypes.CDLL(None, use_errno=True).syscall if doorbell_wait else None
+        # Carry on from the daemon's last answer so a new client's first
+        # frame_id is never mistaken for one already served
+        self.frame_id = SHM_RESULT.unpack_from(self.map, SHM_RESULT_OFFSET)[1]
+
+    def query(self, sections: Dict[str, list], timeout: float):
+        """Publish one input frame and wait for its records
+
+        Returns (records, reply_record) as split_wire_reply does, or None on
+        timeout.
+        """
+        self.frame_id += 1
+        mask = 0
+        values = []
+        for bit, name in enumerate(SHM_SECTIONS):
+            fields = sections.get(name)
+            if fields is not None:
+                mask |= 1 << bit
+                values.extend(float(v) for v in fields)
+            else:
+                values.extend([0.0] * SHM_SECTION_FIELDS[name])
+
+        sequence = struct.unpack_from("<Q", self.map, SHM_INPUT_OFFSET)[0]
+        struct.pack_into("<Q", self.map, SHM_INPUT_OFFSET, sequence + 1)
+        SHM_INPUT.pack_into(self.map, SHM_INPUT_OFFSET, sequence + 1, self.frame_id, mask, 0, *values)
+        struct.pack_into("<Q", self.map, SHM_INPUT_OFFSET, sequence + 2)
+        self.doorbell.value += 1
+        if self.futex is not None:
+            self.futex(SYS_FUTEX_X86_64, self.doorbell_address, FUTEX_WAKE, 1, None, None, 0)
+
+        # A warm daemon answers within microseconds, sooner than a sleep
+        # returns, so the first polls spin; past those the daemon is busy or
+        # asleep and the client backs off rather than hold a core
+        deadline = time.monotonic() + timeout
+        polls = 0
+        pause = SHM_FIRST_SLEEP_S
+        while time.monotonic() < deadline:
+            before, frame_id, length, _ = SHM_RESULT.unpack_from(self.map, SHM_RESULT_OFFSET)
+            if frame_id == self.frame_id and before % 2 == 0 and length <= SHM_RESULT_BYTES:
+                start = SHM_RESULT_OFFSET + SHM_RESULT.size
+                payload = bytes(self.map[start:start + length])
+                if struct.unpack_from("<Q", self.map, SHM_RESULT_OFFSET)[0] == before:
+                    reply = split_wire_reply(payload)
+                    if reply is not None:
+                        return reply[0], reply[1]
+            polls += 1
+            if polls > SHM_SPIN_POLLS:
+                time.sleep(pause)
+                pause = min(pause * 2, SHM_LONGEST_SLEEP_S)
+        return None
+
+    def close(self):
+        """Unmap the channel and release its lock"""
+        # The doorbell view must go before the map can close
+        del self.doorbell
+        self.map.close()
+        self.file.close()
+
+
+class CalculatorDaemonClient:
+    """Client for mfd_calcd: every panel's calculations in one round trip
+
+    Requests carry an id that the daemon echoes back, so a late reply from a
+    previous frame is recognised and skipped instead of being shown as the
+    current one. The daemon is started on first use if it isn't running.
+    Replies use the binary wire format, so decoding is a few struct.unpack
+    calls rather than json.loads. A daemon this client starts also opens the
+    shared-memory channel (x86-64 only), which is then used in place of the
+    socket. A client of a daemon someone else started (another display)
+    always uses the socket, since the channel serves a single client.
+    """
+
+    def __init__(self, daemon_path: Path, socket_path: str = "/tmp/mfd_calcd.sock",
+                 timeout: float = 0.1, timings: Optional[FrameTimings] = None,
+                 shm_path: Optional[str] = DEFAULT_SHM_PATH):
+        self.daemon_path = daemon_path
+        self.socket_path = socket_path
+        self.shm_path = shm_path
+        self.shm: Optional[SharedMemoryChannel] = None
+        self.timeout = timeout
+        self.timings = timings if timings is not None else FrameTimings()
+        self.sock: Optional[socket.socket] = None
+        self.daemon: Optional[subprocess.Popen] = None
+        self.next_id = 0
+        self.rx_buffer = b""
+
+    def connect(self) -> bool:
+        """Connect to the daemon, starting it if needed"""
+        if self.sock is not None:
+            return True
+        sock = None
+        try:
+            sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+            sock.connect(self.socket_path)
+            self.sock = sock
+            self.rx_buffer = b""
+            self.attach_shm()
+            return True
+        except OSError:
+            if sock is not None:
+                sock.close()
+            if (self.daemon is None or self.daemon.poll() is not None) and self.daemon_path.exists():
+                # Spawn it now; it will be accepting connections by a later frame
+                try:
+                    command = [str(self.daemon_path), "--socket", self.socket_path]
+                    if self.shm_path is not None and SHM_ORDERED_STORES:
+                        command += ["--shm", self.shm_path]
+                    self.daemon = subprocess.Popen(command, stderr=subprocess.DEVNULL)
+                except OSError:
+                    self.daemon = None
+            return False
+
+    def attach_shm(self):
+        """Map the shared-memory channel of the daemon this client started"""
+        owns_daemon = self.daemon is not None and self.daemon.poll() is None
+        if self.shm is None and owns_daemon and self.shm_path is not None and os.path.exists(self.shm_path):
+            try:
+                self.shm = SharedMemoryChannel(self.shm_path)
+            except (OSError, ValueError):
+                self.shm = None
+
+    def query(self, sections: Dict[str, list]) -> Optional[dict]:
+        """Send one multiplexed request {section: [fields]} and return the reply"""
+        if not sections or not self.connect():
+            return None
+
+        if self.shm is not None:
+            reply = self.shm.query(sections, self.timeout)
+            if reply is None:
+                # Daemon gone or not serving the channel: back to the socket
+                self.shm.close()
+                self.shm = None
+            else:
+                records, (reply_id, status, _) = reply
+                return self.decode_reply(records, reply_id, status, sections)
+
+        self.next_id += 1
+        request_id = self.next_id
+        fields = [str(request_id), "binary"]
+        for name, values in sections.items():
+            fields.append(name)
+            fields.extend(str(v) for v in values)
+
+        try:
+            self.sock.sendall((" ".join(fields) + "\n").encode())
+            deadline = time.monotonic() + self.timeout
+            while True:
+                reply = split_wire_reply(self.rx_buffer)
+                while reply is None:
+                    remaining = deadline - time.monotonic()
+                    if remaining <= 0:
+                        return None
+                    ready, _, _ = select.select([self.sock], [], [], remaining)
+                    if not ready:
+                        return None
+                    chunk = self.sock.recv(65536)
+                    if not chunk:
+                        self.close()
+                        return None
+                    self.rx_buffer += chunk
+                    reply = split_wire_reply(self.rx_buffer)
+
+                records, (reply_id, status, _), self.rx_buffer = reply
+                if reply_id == request_id:
+                    return self.decode_reply(records, reply_id, status, sections)
+                # Otherwise a stale reply to an earlier frame: keep reading
+        except (OSError, ValueError):
+            self.close()
+            return None
+
+    def decode_reply(self, records, reply_id: int, status: int, sections: Dict[str, list]) -> dict:
+        if status != 0:
+            return {"id": reply_id, "error": status}
+        # The shared-memory channel answers in fixed section order
+        names = [name for name in SHM_SECTIONS if name in sections] if self.shm is not None else list(sections)
+        with self.timings.measure("decode"):
+            results = decode_wire_sections(records, names)
+        compute_us = results.pop("compute_us", None)
+        if compute_us is not None:
+            self.timings.add("compute", compute_us / 1e6)
+        results["id"] = reply_id
+        return results
+
+    def close(self):
+        """Drop the connection (the daemon keeps running until stop())"""
+        if self.shm is not None:
+            self.shm.close()
+            self.shm = None
+        if self.sock is not None:
+            try:
+                self.sock.close()
+            except OSError:
+                pass
+            self.sock = None
+
+    def stop(self):
+        """Close the connection and stop a daemon this client started"""
+        self.close()
+        if self.daemon is not None:
+            try:
+                self.daemon.terminate()
+                self.daemon.wait(timeout=1)
+            except Exception:
+                pass
+            self.daemon = None
+
+
+# C API of libxpmfd_calc (calculators/xpmfd_calc.h). Its structs have the
+# fields of the wire records, in the same order and types.
+XPMFD_CALC_API_VERSION = 1
+XPMFD_ERROR_INVALID_VALUE = 3
+CTYPES_BY_WIRE_FORMAT = {"d": ctypes.c_double, "i": ctypes.c_int32, "?": ctypes.c_bool}
+FLIGHT_INPUT_FIELDS = ("tas_kts", "gs_kts", "heading", "track", "ias_kts", "mach", "altitude_ft",
+                       "agl_ft", "vs_fpm", "weight_kg", "bank_deg", "vso_kts", "vne_kts", "mmo")
+
+
+def wire_record_struct(record_type: int):
+    """ctypes Structure laid out like one wire record's payload"""
+    _, _, layout, names = WIRE_RECORDS[record_type]
+    codes = []
+    for count, code in re.findall(r"(\d*)([di?])", layout.format):
+        codes.extend([code] * int(count or 1))
+    fields = [(name, CTYPES_BY_WIRE_FORMAT[code]) for name, code in zip(names, codes)]
+    return type(f"XpmfdRecord{record_type}", (ctypes.Structure,), {"_fields_": fields})
+
+
+class XpmfdFlightInputs(ctypes.Structure):
+    _fields_ = [(name, ctypes.c_double) for name in FLIGHT_INPUT_FIELDS]
+
+
+class XpmfdFlightResults(ctypes.Structure):
+    _fields_ = [(WIRE_RECORDS[t][1], wire_record_struct(t)) for t in (1, 2, 3, 4)]
+
+
+XpmfdTurnData = wire_record_struct(5)
+XpmfdVnavData = wire_record_struct(6)
+XpmfdDensityAltitudeData = wire_record_struct(7)
+
+
+def struct_to_dict(data: ctypes.Structure) -> dict:
+    return {name: getattr(data, name) for name, _ in data._fields_}
+
+
+class CalculatorLibrary:
+    """The calculator kernels called in-process through libxpmfd_calc
+
+    Each section is one ctypes call (the GIL is released while it runs), so
+    a frame costs no process, pipe or socket round trip. Results are the
+    same dicts a daemon binary reply decodes to, and rejected sections come
+    back as {"error": code}. The library keeps the flight state (IAS history,
+    result cache) for as long as this object. If the library is missing or
+    has a different API version, query() returns None and the MFD uses the
+    daemon instead.
+    """
+
+    def __init__(self, library_path: Path, timings: Optional[FrameTimings] = None):
+        self.library_path = library_path
+        self.timings = timings if timings is not None else FrameTimings()
+        self.lib = None
+        self.flight_state = None
+        self.load_failed = False
+
+    def load(self) -> bool:
+        """Load the library once; a failed load is not retried"""
+        if self.lib is not None:
+            return True
+        if self.load_failed or not self.library_path.exists():
+            return False
+        try:
+            lib = ctypes.CDLL(str(self.library_path))
+            lib.xpmfd_calc_version.restype = ctypes.c_int32
+            # Newer libraries only add functions
+            if lib.xpmfd_calc_version() < XPMFD_CALC_API_VERSION:
+                raise OSError("libxpmfd_calc API version mismatch")
+            lib.xpmfd_flight_state_create.restype = ctypes.c_void_p
+            lib.xpmfd_flight_state_destroy.argtypes = [ctypes.c_void_p]
+            lib.xpmfd_calculate_flight.argtypes = [ctypes.c_void_p, ctypes.POINTER(XpmfdFlightInputs),
+                                                   ctypes.POINTER(XpmfdFlightResults)]
+            lib.xpmfd_calculate_turn.argtypes = [ctypes.c_double] * 3 + [ctypes.POINTER(XpmfdTurnData)]
+            lib.xpmfd_calculate_vnav.argtypes = [ctypes.c_double] * 5 + [ctypes.POINTER(XpmfdVnavData)]
+            lib.xpmfd_calculate_density_altitude.argtypes = (
+                [ctypes.c_double] * 4 + [ctypes.POINTER(XpmfdDensityAltitudeData)])
+            for function in (lib.xpmfd_calculate_flight, lib.xpmfd_calculate_turn,
+                             lib.xpmfd_calculate_vnav, lib.xpmfd_calculate_density_altitude):
+                function.restype = ctypes.c_int32
+            state = lib.xpmfd_flight_state_create()
+            if not state:
+                raise OSError("libxpmfd_calc: no flight state")
+        except (OSError, AttributeError):
+            self.load_failed = True
+            return False
+        self.lib = lib
+        self.flight_state = state
+        return True
+
+    def query(self, sections: Dict[str, list]) -> Optional[dict]:
+        """Calculate {section: [fields]} and return {section: result}"""
+        if not sections or not self.load():
+            return None
+        start = time.perf_counter()
+        results = {name: self.calculate(name, values) for name, values in sections.items()}
+        self.timings.add("compute", time.perf_counter() - start)
+        return results
+
+    def calculate(self, name: str, values: list) -> dict:
+        """One section, with the fields of the daemon protocol"""
+        if name == "flight":
+            out = XpmfdFlightResults()
+            status = self.lib.xpmfd_calculate_flight(self.flight_state, XpmfdFlightInputs(*values),
+                                                     out)
+            result = {key: struct_to_dict(getattr(out, key)) for key, _ in out._fields_}
+        elif name == "density" and values[4]:
+            # The MFD's simulated error, as mfd_calcd reports it
+            status = XPMFD_ERROR_INVALID_VALUE
+        else:
+            function, out = {
+                "turn": (self.lib.xpmfd_calculate_turn, XpmfdTurnData()),
+                "vnav": (self.lib.xpmfd_calculate_vnav, XpmfdVnavData()),
+                "density": (self.lib.xpmfd_calculate_density_altitude, XpmfdDensityAltitudeData()),
+            }[name]
+            arguments = values[:4] if name == "density" else values
+            status = function(*arguments, out)
+            result = struct_to_dict(out)
+        return result if status == 0 else {"error": status}
+
+    def close(self):
+        """Release the library's flight state"""
+        if self.flight_state is not None:
+            self.lib.xpmfd_flight_state_destroy(self.flight_state)
+            self.flight_state = None
+            self.lib = None
+
+
 class USBDeviceManager:
     """Manager for F16 MFD 2 USB device input using SDL2 joystick API"""
     
@@ -246,6 +1437,48 @@ class USBDeviceManager:
             pass
 
 
+class FieldRenderer:
+    """Sets display variables to a frame's text, changed fields only
+
+    StringVar.set fires the variable's traces and has Tk lay the label out
+    again even when the text is the same, so apply compares each field with
+    the text it last set and sets only those that differ, all in one pass on
+    the Tk thread. Fields a frame leaves out keep their text.
+    """
+
+    def __init__(self, variables: Dict[str, tk.StringVar]):
+        self.variables = variables
+        self.shown = {name: variable.get() for name, variable in variables.items()}
+        # Fields set and fields left unchanged so far, for the timing panel
+        self.set_count = 0
+        self.unchanged_count = 0
+
+    def apply(self, fields: Dict[str, str]) -> int:
+        """Set the fields whose text changed; returns how many"""
+        changed = [(name, text) for name, text in fields.items() if self.shown.get(name) != text]
+        for name, text in changed:
+            self.variables[name].set(text)
+            self.shown[name] = text
+        self.set_count += len(changed)
+        self.unchanged_count += len(fields) - len(changed)
+        return len(changed)
+
+
+class FontCache:
+    """One tkfont.Font per (size, weight) of a family, created on first use"""
+
+    def __init__(self, family: str):
+        self.family = family
+        self.fonts: Dict[tuple, tkfont.Font] = {}
+
+    def get(self, size: int, weight: str = "normal") -> tkfont.Font:
+        font = self.fonts.get((size, weight))
+        if font is None:
+            font = tkfont.Font(family=self.family, size=size, weight=weight)
+            self.fonts[(size, weight)] = font
+        return font
+
+
 class AircraftMFD:
     """Multi-Function Display for X-Plane aircraft data"""
     
@@ -257,6 +1490,124 @@ class AircraftMFD:
     ALERT_COLOR = "#FFAA00"
     WARNING_COLOR = "#FF0000"
     
+    # VNAV reference constraint: descent to 10000 ft at 100 NM
+    VNAV_TARGET_ALT_FT = 10000.0
+    VNAV_REFERENCE_DISTANCE_NM = 100.0
+    
+    # Acquisition interval: 30 Hz from the WebSocket cache, 10 Hz when
+    # polling. The Tk side checks for a finished frame at the faster rate.
+    SUBSCRIBED_INTERVAL_MS = 33
+    POLLING_INTERVAL_MS = 100
+    
+    # Polling interval with one panel on screen: it reads a small part of
+    # the datarefs, so it can poll twice as often for fewer requests
+    SINGLE_PANEL_POLLING_INTERVAL_MS = 50
+    
+    # Datarefs update_data reads, fetched together once per frame
+    FRAME_DATAREFS = (
+        ("sim/flightmodel/position/latitude", None),
+        ("sim/flightmodel/position/longitude", None),
+        ("sim/flightmodel/position/elevation", None),
+        ("sim/flightmodel/position/y_agl", None),
+        ("sim/flightmodel/position/psi", None),
+        ("sim/flightmodel/position/theta", None),
+        ("sim/flightmodel/position/phi", None),
+        ("sim/flightmodel/position/hpath", None),
+        ("sim/cockpit2/gauges/indicators/airspeed_kts_pilot", None),
+        ("sim/flightmodel/position/indicated_airspeed", None),
+        ("sim/flightmodel/position/groundspeed", None),
+        ("sim/cockpit2/gauges/indicators/vvi_fpm_pilot", None),
+        ("sim/flightmodel/misc/machno", None),
+        ("sim/cockpit2/engine/indicators/N1_percent", 0),
+        ("sim/cockpit2/engine/indicators/N2_percent", 0),
+        ("sim/cockpit2/engine/indicators/engine_speed_rpm", 0),
+        ("sim/cockpit2/engine/indicators/prop_speed_rpm", 0),
+        ("sim/cockpit2/engine/actuators/throttle_ratio", 0),
+        ("sim/flightmodel/weight/m_fuel_total", None),
+        ("sim/flightmodel/position/true_airspeed", None),
+        ("sim/flightmodel/weight/m_total", None),
+        ("sim/aircraft/view/acf_Vso", None),
+        ("sim/aircraft/view/acf_Vne", None),
+        ("sim/aircraft/view/acf_Mmo", None),
+        ("sim/cockpit2/temperature/outside_air_temp_degc", None),
+    )
+    
+    # Calculator sections and the datarefs build_sections reads for them
+    SECTION_DATAREFS = {
+        "flight": (
+            ("sim/flightmodel/position/true_airspeed", None),
+            ("sim/flightmodel/position/groundspeed", None),
+            ("sim/flightmodel/position/psi", None),
+            ("sim/flightmodel/position/hpath", None),
+            ("sim/cockpit2/gauges/indicators/airspeed_kts_pilot", None),
+            ("sim/flightmodel/position/indicated_airspeed", None),
+            ("sim/flightmodel/misc/machno", None),
+            ("sim/flightmodel/position/elevation", None),
+            ("sim/flightmodel/position/y_agl", None),
+            ("sim/cockpit2/gauges/indicators/vvi_fpm_pilot", None),
+            ("sim/flightmodel/weight/m_total", None),
+            ("sim/flightmodel/position/phi", None),
+            ("sim/aircraft/view/acf_Vso", None),
+            ("sim/aircraft/view/acf_Vne", None),
+            ("sim/aircraft/view/acf_Mmo", None),
+        ),
+        "turn": (
+            ("sim/flightmodel/position/true_airspeed", None),
+            ("sim/flightmodel/position/phi", None),
+        ),
+        "vnav": (
+            ("sim/flightmodel/position/elevation", None),
+            ("sim/flightmodel/position/groundspeed", None),
+            ("sim/cockpit2/gauges/indicators/vvi_fpm_pilot", None),
+        ),
+        "density": (
+            ("sim/flightmodel/position/elevation", None),
+            ("sim/cockpit2/temperature/outside_air_temp_degc", None),
+            ("sim/cockpit2/gauges/indicators/airspeed_kts_pilot", None),
+            ("sim/flightmodel/position/indicated_airspeed", None),
+            ("sim/flightmodel/position/true_airspeed", None),
+        ),
+    }
+    
+    # What each panel shows (apply_frame), with its rate class:
+    # position and attitude fast, density altitude and fuel slow
+    PANEL_ITEMS = {
+        1: {("sim/flightmodel/position/latitude", None): PanelScheduler.RATE_FAST,
+            ("sim/flightmodel/position/longitude", None): PanelScheduler.RATE_FAST,
+            ("sim/flightmodel/position/elevation", None): PanelScheduler.RATE_FAST,
+            ("sim/flightmodel/position/y_agl", None): PanelScheduler.RATE_FAST},
+        2: {"flight": PanelScheduler.RATE_FAST},
+        3: {"flight": PanelScheduler.RATE_FAST},
+        4: {("sim/flightmodel/position/psi", None): PanelScheduler.RATE_FAST,
+            ("sim/flightmodel/position/hpath", None): PanelScheduler.RATE_FAST,
+            ("sim/flightmodel/position/theta", None): PanelScheduler.RATE_FAST,
+            ("sim/flightmodel/position/phi", None): PanelScheduler.RATE_FAST},
+        5: {("sim/cockpit2/gauges/indicators/airspeed_kts_pilot", None): PanelScheduler.RATE_FAST,
+            ("sim/flightmodel/position/indicated_airspeed", None): PanelScheduler.RATE_FAST,
+            ("sim/flightmodel/position/groundspeed", None): PanelScheduler.RATE_FAST,
+            ("sim/cockpit2/gauges/indicators/vvi_fpm_pilot", None): PanelScheduler.RATE_FAST,
+            "flight": PanelScheduler.RATE_FAST},
+        6: {("sim/cockpit2/engine/indicators/N1_percent", 0): PanelScheduler.RATE_FAST,
+            ("sim/cockpit2/engine/indicators/N2_percent", 0): PanelScheduler.RATE_FAST,
+            ("sim/cockpit2/engine/indicators/engine_speed_rpm", 0): PanelScheduler.RATE_FAST,
+            ("sim/cockpit2/engine/indicators/prop_speed_rpm", 0): PanelScheduler.RATE_FAST,
+            ("sim/cockpit2/engine/actuators/throttle_ratio", 0): PanelScheduler.RATE_FAST,
+            ("sim/flightmodel/weight/m_fuel_total", None): PanelScheduler.RATE_SLOW},
+        7: {"turn": PanelScheduler.RATE_FAST},
+        8: {"vnav": PanelScheduler.RATE_FAST},
+        9: {"density": PanelScheduler.RATE_SLOW},
+    }
+    
+    # Section inputs that change slowly, read no faster than this however
+    # fast their section runs
+    DATAREF_RATE_LIMITS = {
+        ("sim/flightmodel/weight/m_total", None): PanelScheduler.RATE_SLOW,
+        ("sim/aircraft/view/acf_Vso", None): PanelScheduler.RATE_SLOW,
+        ("sim/aircraft/view/acf_Vne", None): PanelScheduler.RATE_SLOW,
+        ("sim/aircraft/view/acf_Mmo", None): PanelScheduler.RATE_SLOW,
+        ("sim/cockpit2/temperature/outside_air_temp_degc", None): PanelScheduler.RATE_SLOW,
+    }
+    
     def __init__(self, root):
         self.root = root
         self.root.title("X-PLANE MFD")
@@ -264,8 +1615,28 @@ class AircraftMFD:
         self.root.configure(bg=self.BG_COLOR)
         self.root.resizable(False, False)
         
-        self.api = XPlaneAPI()
+        # Per-stage frame timing: debug panel ([T]) and a periodic log line.
+        # Each pipeline thread times its own stages; the totals travel with
+        # the frame and are merged into self.timings on the Tk thread.
+        self.timings = FrameTimings()
+        self.acquire_timings = FrameTimings()
+        self.compute_timings = FrameTimings()
+        self.timing_panel_visible = False
+        self.timing_panel_refreshed = 0.0
+        
+        self.api = XPlaneAPI(timings=self.acquire_timings)
+        self.api.register_datarefs(self.FRAME_DATAREFS)
+        self.api.start_subscription()
         self.is_connected = False
+        
+        # Calculator library in this process; without it the calculator
+        # daemon (all panels in one round trip), with the resident flight
+        # calculator and one-shot calculators as the last fallback
+        script_dir = Path(__file__).resolve().parent
+        self.calc_library = CalculatorLibrary(script_dir / "libxpmfd_calc.so", timings=self.compute_timings)
+        self.calc_daemon = CalculatorDaemonClient(script_dir / "mfd_calcd", timings=self.compute_timings)
+        self.flight_calculator = ResidentCalculator(script_dir / "flight_calculator",
+                                                    timings=self.compute_timings)
         self.fields_created = False  # Track if data fields have been created
         
         # Display mode: 0 = all panels, 1-9 = individual panel full screen
@@ -282,6 +1653,14 @@ class AircraftMFD:
             9: "DENSITY ALT"
         }
         
+        # Reads only what the visible panels show, at each item's rate.
+        # latest_values (acquisition thread) keeps the last value read of
+        # every dataref, so a frame shows the items not due unchanged.
+        self.scheduler = PanelScheduler(self.PANEL_ITEMS, self.SECTION_DATAREFS, self.DATAREF_RATE_LIMITS)
+        self.scheduler.set_visible(self.panel_map)
+        self.latest_values: Dict[tuple, Any] = {}
+        self.reads_counted = (0, 0)
+        
         # Error handling
         self.has_cpp_error = False
         self.cpp_error_message = ""
@@ -293,24 +1672,30 @@ class AircraftMFD:
         self.load_custom_fonts()
         
         # Setup fonts - regular size for all-panels view
-        self.title_font = tkfont.Font(family=self.font_family, size=14, weight="bold")
-        self.data_font = tkfont.Font(family=self.font_family, size=12, weight="bold")
-        self.label_font = tkfont.Font(family=self.font_family, size=10)
-        self.small_font = tkfont.Font(family=self.font_family, size=8)
+        self.fonts = FontCache(self.font_family)
+        self.title_font = self.fonts.get(14, "bold")
+        self.data_font = self.fonts.get(12, "bold")
+        self.label_font = self.fonts.get(10)
+        self.small_font = self.fonts.get(8)
         
         # Large fonts for single-panel view
-        self.title_font_large = tkfont.Font(family=self.font_family, size=32, weight="bold")
-        self.data_font_large = tkfont.Font(family=self.font_family, size=28, weight="bold")
-        self.label_font_large = tkfont.Font(family=self.font_family, size=22)
-        self.small_font_large = tkfont.Font(family=self.font_family, size=16)
+        self.title_font_large = self.fonts.get(32, "bold")
+        self.data_font_large = self.fonts.get(28, "bold")
+        self.label_font_large = self.fonts.get(22)
+        self.small_font_large = self.fonts.get(16)
         
-        # Track all labels for font updates
+        # Track all labels for font updates, and which fonts they have
         self.header_labels = []
         self.data_value_labels = []
         self.data_label_labels = []
+        self.large_fonts_shown = False
         
-        # Initialize data variables
+        # Initialize data variables; the renderer sets them from each frame
         self.init_data_variables()
+        self.renderer = FieldRenderer({name: variable for name, variable in vars(self).items()
+                                       if isinstance(variable, tk.StringVar)})
+        self.clock_text = ""
+        self.fields_counted = (0, 0)
         
         self.setup_ui()
         self.setup_keyboard_bindings()
@@ -318,7 +1703,9 @@ class AircraftMFD:
         # Bind cleanup on window close
         self.root.protocol("WM_DELETE_WINDOW", self.on_closing)
         
-        # Start main update loop (includes USB polling)
+        # Start the acquisition and compute threads, then the Tk side of the
+        # pipeline (includes USB polling)
+        self.start_pipeline()
         self.update_display()
     
     def load_custom_fonts(self):
@@ -473,6 +1860,9 @@ class AircraftMFD:
         # Error overlay (hidden by default)
         self.create_error_overlay()
         
+        # Frame timing debug panel (hidden by default)
+        self.create_timing_panel()
+        
         # Bottom status bar
         self.status_bar = tk.Frame(self.root, bg=self.DIM_COLOR, height=30)
         self.status_bar.pack(fill=tk.X, padx=2, pady=2, side=tk.BOTTOM)
@@ -537,7 +1927,7 @@ class AircraftMFD:
         self.error_text = tk.Label(
             self.error_overlay,
             text="",
-            font=tkfont.Font(family=self.font_family, size=14, weight="bold"),
+            font=self.fonts.get(14, "bold"),
             bg="#000000",
             fg=self.WARNING_COLOR,
             wraplength=550,
@@ -574,6 +1964,56 @@ class AircraftMFD:
         self.cpp_error_message = ""
         self.error_overlay.place_forget()
     
+    def create_timing_panel(self):
+        """Create the frame timing debug panel (hidden by default)"""
+        self.timing_panel = tk.Label(
+            self.root,
+            text="",
+            font=self.small_font,
+            bg=self.BG_COLOR,
+            fg=self.PRIMARY_COLOR,
+            justify=tk.LEFT,
+            anchor="nw",
+            bd=1,
+            relief=tk.SOLID,
+            padx=8,
+            pady=6
+        )
+    
+    def toggle_timing_panel(self):
+        """Show or hide the frame timing panel"""
+        self.timing_panel_visible = not self.timing_panel_visible
+        if self.timing_panel_visible:
+            self.timing_panel_refreshed = 0.0
+            self.refresh_timing_panel()
+            self.timing_panel.place(relx=1.0, rely=1.0, x=-8, y=-40, anchor="se")
+            self.timing_panel.lift()
+        else:
+            self.timing_panel.place_forget()
+    
+    def refresh_timing_panel(self):
+        """Redraw the timing panel text (at most once per second)"""
+        now = time.monotonic()
+        if not self.timing_panel_visible or now - self.timing_panel_refreshed < 1.0:
+            return
+        elapsed = now - self.timing_panel_refreshed
+        self.timing_panel_refreshed = now
+        lines = ["FRAME TIMING (MS, THIS LOG WINDOW)"] + self.timings.summary_lines()
+        reads = (self.scheduler.dataref_reads, self.scheduler.section_runs)
+        if elapsed < 10.0:
+            lines.append(f"READS/S  {(reads[0] - self.reads_counted[0]) / elapsed:.0f} DATAREFS, "
+                         f"{(reads[1] - self.reads_counted[1]) / elapsed:.1f} SECTIONS")
+        fields = (self.renderer.set_count, self.renderer.unchanged_count)
+        if elapsed < 10.0:
+            lines.append(f"FIELDS/S {(fields[0] - self.fields_counted[0]) / elapsed:.0f} SET, "
+                         f"{(fields[1] - self.fields_counted[1]) / elapsed:.0f} UNCHANGED")
+        if self.api.missed_deadline:
+            lines.append(f"FETCH    {self.api.missed_deadline} MISSED DEADLINE, "
+                         f"{self.api.skipped_pending} SKIPPED PENDING")
+        self.reads_counted = reads
+        self.fields_counted = fields
+        self.timing_panel.config(text="\n".join(lines))
+    
     def create_section(self, parent, title: str) -> tuple:
         """Create a labeled section frame - returns (section_frame, content_frame)"""
         section = tk.Frame(parent, bg=self.BG_COLOR, relief=tk.RIDGE, bd=2, highlightbackground=self.DIM_COLOR)
@@ -633,6 +2073,10 @@ class AircraftMFD:
         # Bind number keys 0-9
         for i in range(10):
             self.root.bind(str(i), lambda event, num=i: self.switch_display_mode(num))
+        
+        # Frame timing debug panel
+        self.root.bind("t", lambda event: self.toggle_timing_panel())
+        self.root.bind("T", lambda event: self.toggle_timing_panel())
     
     def on_usb_button_press(self, button_number: int):
         """Callback for USB device button presses
@@ -652,10 +2096,22 @@ class AircraftMFD:
         print("Shutting down...")
         if hasattr(self, 'usb_device'):
             self.usb_device.cleanup()
+        self.stop_pipeline()
+        self.api.stop_subscription()
+        self.calc_library.close()
+        self.calc_daemon.stop()
+        self.flight_calculator.stop()
         self.root.destroy()
     
     def update_font_sizes(self, use_large_fonts: bool):
-        """Update all label fonts based on display mode"""
+        """Update all label fonts based on display mode
+        
+        Switching between single panels keeps the large fonts, so the
+        labels are only walked when the size actually changes.
+        """
+        if use_large_fonts == self.large_fonts_shown:
+            return
+        self.large_fonts_shown = use_large_fonts
         if use_large_fonts:
             # Use large fonts for single-panel view
             label_font = self.label_font_large
@@ -687,6 +2143,7 @@ class AircraftMFD:
             self.hide_error_overlay()
         
         self.display_mode = mode
+        self.scheduler.set_visible(self.panel_map if mode == 0 else [mode])
         
         if mode == 0:
             # Show all panels in 3-column layout
@@ -781,33 +2238,11 @@ class AircraftMFD:
     
     def calculate_flight_data(self, tas, gs, heading, track, ias, mach, altitude, agl, vs, 
                               weight, bank, vso, vne, mmo) -> Optional[dict]:
-        """Call C++ flight calculator for comprehensive calculations"""
-        try:
-            script_dir = Path(__file__).parent
-            calculator_path = script_dir / "flight_calculator"
-            
-            if not calculator_path.exists():
-                return None
-            
-            # Call the C++ program with all parameters
-            result = subprocess.run(
-                [str(calculator_path),
-                 str(tas), str(gs), str(heading), str(track),
-                 str(ias), str(mach), str(altitude), str(agl), str(vs),
-                 str(weight), str(bank), str(vso), str(vne), str(mmo)],
-                capture_output=True,
-                text=True,
-                timeout=0.1  # 100ms timeout
-            )
-            
-            if result.returncode == 0:
-                return json.loads(result.stdout)
-            else:
-                return None
-                
-        except Exception as e:
-            # Silently fail - don't spam console
-            return None
+        """Call the resident C++ flight calculator for comprehensive calculations"""
+        return self.flight_calculator.query(
+            tas, gs, heading, track, ias, mach, altitude, agl, vs,
+            weight, bank, vso, vne, mmo
+        )
     
     def calculate_turn_performance(self, tas_kts, bank_deg) -> Optional[dict]:
         """Call C++ turn calculator"""
@@ -827,7 +2262,8 @@ class AircraftMFD:
             )
             
             if result.returncode == 0:
-                return json.loads(result.stdout)
+                with self.compute_timings.measure("decode"):
+                    return json.loads(result.stdout)
             return None
         except:
             return None
@@ -842,8 +2278,8 @@ class AircraftMFD:
                 return None
             
             # Simplified: show TOD for descent to 10000 ft
-            target_alt = 10000.0
-            distance_nm = 100.0  # Reference distance
+            target_alt = self.VNAV_TARGET_ALT_FT
+            distance_nm = self.VNAV_REFERENCE_DISTANCE_NM  # Reference distance
             
             result = subprocess.run(
                 [str(calculator_path), 
@@ -855,7 +2291,8 @@ class AircraftMFD:
             )
             
             if result.returncode == 0:
-                return json.loads(result.stdout)
+                with self.compute_timings.measure("decode"):
+                    return json.loads(result.stdout)
             return None
         except:
             return None
@@ -888,68 +2325,222 @@ class AircraftMFD:
             )
             
             if result.returncode == 0:
-                return json.loads(result.stdout)
-            else:
-                # Check if this is an actual exception (return code 1) vs graceful error handling (return code 3)
-                # Return code 1 = uncaught exception (non-compliant version)
-                # Return code 3 = gracefully handled error (compliant version)
-                if self.display_mode == 9 and result.returncode == 1 and not self.has_cpp_error:
-                    # Extract error message from stderr
-                    error_lines = result.stderr.strip().split('\n')
-                    error_msg = "Unknown C++ error"
-                    for line in error_lines:
-                        if line.startswith("Error:"):
-                            error_msg = line.replace("Error:", "").strip()
-                            break
-
-                    # Show error overlay with shutdown notice
-                    self.show_error_overlay(f"{error_msg}\n\nSYSTEM SHUTTING DOWN...")
-
-                    # Quit application after 5 seconds (non-blocking so UI can render)
-                    self.root.after(5000, self.root.quit)
-                    
-                elif self.display_mode == 9 and result.returncode == 3 and not self.has_cpp_error:
-                    error_msg = "Error: Handled error occurred in CDA calculator. Program will no longer crash"
-                    self.show_error_overlay(error_msg)
-                
-                return None
+                with self.compute_timings.measure("decode"):
+                    return json.loads(result.stdout)
+            return {"error": result.returncode, "stderr": result.stderr}
         except Exception as e:
+            return {"error": None, "stderr": f"Failed to execute calculator: {str(e)}"}
+    
+    def run_calculators(self, sections: Dict[str, list]) -> Dict[str, dict]:
+        """Run this frame's calculations and return {section: result}
+        
+        Time spent here goes into the "calc" stage, less the decoding the
+        clients record under "decode".
+        """
+        decode_before = self.compute_timings.frame_seconds("decode")
+        start = time.perf_counter()
+        results = self.query_calculators(sections)
+        decode_seconds = self.compute_timings.frame_seconds("decode") - decode_before
+        self.compute_timings.add("calc", time.perf_counter() - start - decode_seconds)
+        return results
+    
+    def query_calculators(self, sections: Dict[str, list]) -> Dict[str, dict]:
+        """Calls libxpmfd_calc in-process when it loads, else uses one round
+        trip to mfd_calcd, otherwise falls back to the individual calculator
+        programs.
+        
+        Runs on the compute thread, so it never touches Tk: a failed section
+        comes back as {"error": code, ...} for apply_frame to report.
+        """
+        reply = self.calc_library.query(sections)
+        if reply is None:
+            reply = self.calc_daemon.query(sections)
+        if reply is not None and "error" not in reply:
+            results = {}
+            for name in sections:
+                data = reply.get(name)
+                if not isinstance(data, dict):
+                    continue
+                results[name] = data
+            return results
+        
+        results = {}
+        if "flight" in sections:
+            results["flight"] = self.calculate_flight_data(*sections["flight"])
+        if "turn" in sections:
+            tas_kts, bank_deg, _ = sections["turn"]
+            results["turn"] = self.calculate_turn_performance(tas_kts, bank_deg)
+        if "vnav" in sections:
+            current_alt_ft, _, _, gs_kts, vs_fpm = sections["vnav"]
+            results["vnav"] = self.calculate_vnav_data(current_alt_ft, gs_kts, vs_fpm)
+        if "density" in sections:
+            results["density"] = self.calculate_density_altitude(*sections["density"][:4])
+        return {name: data for name, data in results.items() if data}
+    
+    def handle_density_error(self, return_code: Optional[int], stderr: str = ""):
+        """Show the error overlay for a failed density altitude calculation
+        
+        return_code None means the calculator couldn't be run at all.
+        """
+        if return_code is None:
             if self.display_mode == 9 and not self.has_cpp_error:
-                self.show_error_overlay(f"Failed to execute calculator: {str(e)}")
-            return None
+                self.show_error_overlay(stderr)
+            return
+        # Check if this is an actual exception (return code 1) vs graceful error handling (return code 3)
+        # Return code 1 = uncaught exception (non-compliant version)
+        # Return code 3 = gracefully handled error (compliant version)
+        if self.display_mode == 9 and return_code == 1 and not self.has_cpp_error:
+            # Extract error message from stderr
+            error_lines = stderr.strip().split('\n')
+            error_msg = "Unknown C++ error"
+            for line in error_lines:
+                if line.startswith("Error:"):
+                    error_msg = line.replace("Error:", "").strip()
+                    break
+
+            # Show error overlay with shutdown notice
+            self.show_error_overlay(f"{error_msg}\n\nSYSTEM SHUTTING DOWN...")
+
+            # Quit application after 5 seconds (non-blocking so UI can render)
+            self.root.after(5000, self.root.quit)
+            
+        elif self.display_mode == 9 and return_code == 3 and not self.has_cpp_error:
+            error_msg = "Error: Handled error occurred in CDA calculator. Program will no longer crash"
+            self.show_error_overlay(error_msg)
+    
+    def start_pipeline(self):
+        """Start the acquisition and compute threads
+        
+        acquisition: X-Plane fetch -> acquired_slot -> compute: calculators ->
+        display_slot -> Tk thread (update_display). Each slot holds only the
+        newest frame, so a slow stage drops stale frames instead of queueing.
+        """
+        self.pipeline_stop = threading.Event()
+        self.acquired_slot = LatestSlot()
+        self.display_slot = LatestSlot()
+        self.pipeline_threads = [
+            threading.Thread(target=self.acquisition_loop, name="mfd-acquisition", daemon=True),
+            threading.Thread(target=self.compute_loop, name="mfd-compute", daemon=True),
+        ]
+        for thread in self.pipeline_threads:
+            thread.start()
+    
+    def stop_pipeline(self):
+        self.pipeline_stop.set()
+        for thread in self.pipeline_threads:
+            thread.join(timeout=2.0)
+    
+    def acquisition_loop(self):
+        """Acquisition thread: one FrameSnapshot per interval"""
+        while not self.pipeline_stop.is_set():
+            start = time.perf_counter()
+            frame = self.acquire_frame()
+            frame.acquired = start
+            frame.timings = self.acquire_timings.take_frame_totals()
+            self.acquired_slot.put(frame)
+            
+            if self.api.is_subscribed():
+                interval_ms = self.SUBSCRIBED_INTERVAL_MS
+            elif self.display_mode != 0:
+                interval_ms = self.SINGLE_PANEL_POLLING_INTERVAL_MS
+            else:
+                interval_ms = self.POLLING_INTERVAL_MS
+            self.pipeline_stop.wait(max(0.0, interval_ms / 1000.0 - (time.perf_counter() - start)))
+    
+    def acquire_frame(self) -> FrameSnapshot:
+        """Check the connection and read the datarefs and sections due
+        
+        The frame carries the last value of every dataref, and inputs only
+        for the calculator sections due this tick.
+        """
+        try:
+            # Test connection (a live subscription already proves it)
+            if not self.api.is_subscribed():
+                with self.acquire_timings.measure("fetch"):
+                    status_code = self.api.session.get(f"{self.api.base_url}/datarefs/count",
+                                                       timeout=1).status_code
+                if status_code != 200:
+                    return FrameSnapshot(status="lost")
+            datarefs, due_sections = self.scheduler.take_due(time.monotonic())
+            self.latest_values.update(self.api.fetch_frame_values(datarefs))
+            values = dict(self.latest_values)
+            sections = {name: inputs for name, inputs in self.build_sections(values).items()
+                        if name in due_sections}
+            return FrameSnapshot(status="connected", values=values, sections=sections)
+        except Exception as e:
+            return FrameSnapshot(status="disconnected", error=str(e))
+    
+    def compute_loop(self):
+        """Compute thread: run the calculators on the newest acquired frame"""
+        while not self.pipeline_stop.is_set():
+            frame = self.acquired_slot.take(timeout=0.5)
+            if frame is None:
+                continue
+            try:
+                if frame.sections:
+                    frame.results = self.run_calculators(frame.sections)
+                if frame.status == "connected":
+                    frame.fields = self.format_fields(frame)
+            except Exception as e:
+                print(f"Error running calculators: {e}")
+            for stage, seconds in self.compute_timings.take_frame_totals().items():
+                frame.timings[stage] = frame.timings.get(stage, 0.0) + seconds
+            self.display_slot.put(frame)
     
     def update_display(self):
-        """Main update loop for the MFD"""
+        """Tk side of the pipeline: apply the newest finished frame"""
         # Poll USB device buttons (if connected) - MUST be on main thread for macOS
         if self.usb_device.is_connected():
             self.usb_device.poll_buttons_once()
         
-        try:
-            # Test connection
-            response = requests.get(f"{self.api.base_url}/datarefs/count", timeout=1)
-            if response.status_code == 200:
-                if not self.is_connected:
-                    self.is_connected = True
-                    self.status_label.config(text="● CONNECTED", fg=self.PRIMARY_COLOR)
-                
-                self.update_data()
-            else:
-                if self.is_connected:
-                    self.is_connected = False
-                    self.status_label.config(text="● CONNECTION LOST", fg=self.WARNING_COLOR)
-        except Exception as e:
+        frame = self.display_slot.take()
+        if frame is not None:
+            frame_start = time.perf_counter()
+            self.timings.merge(frame.timings)
+            self.apply_connection_status(frame)
+            if frame.status == "connected":
+                try:
+                    with self.timings.measure("widgets"):
+                        self.apply_frame(frame)
+                except Exception as e:
+                    print(f"Error updating data: {e}")
+        
+        # Update time display (its text changes once a second)
+        clock_text = time.strftime("%H:%M:%S UTC", time.gmtime())
+        if clock_text != self.clock_text:
+            self.clock_text = clock_text
+            self.time_label.config(text=clock_text)
+        
+        if frame is not None:
+            # Redraw now so the widget stage includes Tk's layout and paint work
+            with self.timings.measure("widgets"):
+                self.root.update_idletasks()
+            now = time.perf_counter()
+            self.timings.add("frame", now - frame_start)
+            self.timings.add("latency", now - frame.acquired)
+            self.timings.end_frame()
+        self.refresh_timing_panel()
+        self.timings.maybe_log()
+        
+        self.root.after(self.SUBSCRIBED_INTERVAL_MS, self.update_display)
+    
+    def apply_connection_status(self, frame: FrameSnapshot):
+        """Update the status line from the frame's connection check"""
+        if frame.status == "connected":
+            if not self.is_connected:
+                self.is_connected = True
+                self.status_label.config(text="● CONNECTED", fg=self.PRIMARY_COLOR)
+        elif frame.status == "lost":
+            if self.is_connected:
+                self.is_connected = False
+                self.status_label.config(text="● CONNECTION LOST", fg=self.WARNING_COLOR)
+        else:
             if self.is_connected or not hasattr(self, '_first_error_shown'):
-                print(f"Connection error: {e}")
+                print(f"Connection error: {frame.error}")
                 self._first_error_shown = True
             if self.is_connected:
                 self.is_connected = False
             self.status_label.config(text="● DISCONNECTED", fg=self.WARNING_COLOR)
-        
-        # Update time display
-        self.time_label.config(text=time.strftime("%H:%M:%S UTC", time.gmtime()))
-        
-        # Schedule next update (10 Hz)
-        self.root.after(100, self.update_display)
     
     def create_data_fields(self):
         """Create all data field labels (called only once during UI setup)"""
@@ -1007,219 +2598,265 @@ class AircraftMFD:
         self.add_data_row(self.density_frame, "ISA DEV:", self.isa_dev_var)
         self.add_data_row(self.density_frame, "EAS:", self.eas_var)
     
-    def update_data(self):
-        """Update all data fields from X-Plane"""
-        try:
-            # Position
-            lat = self.api.get_dataref_value("sim/flightmodel/position/latitude")
-            lon = self.api.get_dataref_value("sim/flightmodel/position/longitude")
-            alt = self.api.get_dataref_value("sim/flightmodel/position/elevation")
-            agl = self.api.get_dataref_value("sim/flightmodel/position/y_agl")
-            
-            if lat is not None:
-                self.lat_var.set(self.format_lat_lon(lat, True))
-            if lon is not None:
-                self.lon_var.set(self.format_lat_lon(lon, False))
-            if alt is not None:
-                self.alt_var.set(f"{alt * 3.28084:.0f} FT")
-            if agl is not None:
-                self.agl_var.set(f"{agl * 3.28084:.0f} FT")
-            
-            # Navigation
-            heading = self.api.get_dataref_value("sim/flightmodel/position/psi")
-            pitch = self.api.get_dataref_value("sim/flightmodel/position/theta")
-            roll = self.api.get_dataref_value("sim/flightmodel/position/phi")
-            track = self.api.get_dataref_value("sim/flightmodel/position/hpath")
+    def build_sections(self, values: Dict[tuple, Any]) -> Dict[str, list]:
+        """Calculator inputs for one frame, keyed by daemon section name
+        
+        Runs on the acquisition thread; reads the same datarefs apply_frame
+        shows.
+        """
+        def value(name: str, index: Optional[int] = None):
+            return values.get((name, index))
+        
+        alt = value("sim/flightmodel/position/elevation")
+        agl = value("sim/flightmodel/position/y_agl")
+        heading = value("sim/flightmodel/position/psi")
+        roll = value("sim/flightmodel/position/phi")
+        track = value("sim/flightmodel/position/hpath")
+        # Cockpit gauge IAS (what the pilot sees), raw indicated_airspeed as fallback
+        ias = value("sim/cockpit2/gauges/indicators/airspeed_kts_pilot")
+        if ias is None:
+            ias = value("sim/flightmodel/position/indicated_airspeed")
+        gs = value("sim/flightmodel/position/groundspeed")
+        vs = value("sim/cockpit2/gauges/indicators/vvi_fpm_pilot")
+        mach = value("sim/flightmodel/misc/machno")
+        tas = value("sim/flightmodel/position/true_airspeed")
+        weight = value("sim/flightmodel/weight/m_total")
+        vso = value("sim/aircraft/view/acf_Vso")
+        vne = value("sim/aircraft/view/acf_Vne")
+        mmo_val = value("sim/aircraft/view/acf_Mmo")
+        
+        # Convert units for calculator
+        gs_kts = gs * 1.94384 if gs is not None else 0
+        alt_ft = alt * 3.28084 if alt is not None else 0
+        agl_ft = agl * 3.28084 if agl is not None else 0
+        
+        # Get OAT (outside air temperature) for density altitude
+        oat = value("sim/cockpit2/temperature/outside_air_temp_degc")
+        
+        sections = {}
+        if all(v is not None for v in [tas, gs, heading, track, ias, mach, alt, agl, vs, weight, roll, vso, vne, mmo_val]):
+            sections["flight"] = [tas, gs_kts, heading, track, ias, mach, alt_ft, agl_ft, vs,
+                                  weight, roll, vso, vne, mmo_val]
+        if tas is not None and roll is not None:
+            # Calculate for a 90-degree turn (common reference)
+            sections["turn"] = [tas, abs(roll), 90]
+        if alt_ft is not None and gs_kts is not None and vs is not None:
+            sections["vnav"] = [alt_ft, self.VNAV_TARGET_ALT_FT, self.VNAV_REFERENCE_DISTANCE_NM,
+                                gs_kts, vs]
+        if oat is not None and alt_ft is not None and ias is not None and tas is not None:
+            # Force an error when viewing density alt panel in full screen (mode 9)
+            force_error = 1 if self.display_mode == 9 else 0
+            sections["density"] = [alt_ft, oat, ias, tas, force_error]
+        return sections
+    
+    def format_fields(self, frame: FrameSnapshot) -> Dict[str, str]:
+        """Display text of one frame, {variable name: text} (compute thread)
+        
+        A field whose data is missing this frame is left out and keeps the
+        text it shows.
+        """
+        fields = {}
+        
+        def value(name: str, index: Optional[int] = None):
+            return frame.values.get((name, index))
+        
+        # Position
+        lat = value("sim/flightmodel/position/latitude")
+        lon = value("sim/flightmodel/position/longitude")
+        alt = value("sim/flightmodel/position/elevation")
+        agl = value("sim/flightmodel/position/y_agl")
+        
+        if lat is not None:
+            fields["lat_var"] = self.format_lat_lon(lat, True)
+        if lon is not None:
+            fields["lon_var"] = self.format_lat_lon(lon, False)
+        if alt is not None:
+            fields["alt_var"] = f"{alt * 3.28084:.0f} FT"
+        if agl is not None:
+            fields["agl_var"] = f"{agl * 3.28084:.0f} FT"
+        
+        # Navigation
+        heading = value("sim/flightmodel/position/psi")
+        pitch = value("sim/flightmodel/position/theta")
+        roll = value("sim/flightmodel/position/phi")
+        track = value("sim/flightmodel/position/hpath")
+        
+        if heading is not None:
+            fields["heading_var"] = f"{heading:06.2f}°"
+        if pitch is not None:
+            fields["pitch_var"] = f"{pitch:+06.2f}°"
+        if roll is not None:
+            fields["roll_var"] = f"{roll:+06.2f}°"
+        if track is not None:
+            fields["track_var"] = f"{track:06.2f}°"
+        
+        # Flight data
+        # Use cockpit gauge IAS (what pilot sees) instead of raw indicated_airspeed
+        # The raw dataref can be miscalibrated or in wrong units for some aircraft
+        ias = value("sim/cockpit2/gauges/indicators/airspeed_kts_pilot")
+        if ias is None:  # Fallback to raw if cockpit gauge not available
+            ias = value("sim/flightmodel/position/indicated_airspeed")
+        gs = value("sim/flightmodel/position/groundspeed")
+        vs = value("sim/cockpit2/gauges/indicators/vvi_fpm_pilot")
+        mach = value("sim/flightmodel/misc/machno")
+        
+        if ias is not None:
+            fields["ias_var"] = f"{ias:.1f} KTS"
+        if gs is not None:
+            # Convert m/s to knots
+            fields["gs_var"] = f"{gs * 1.94384:.1f} KTS"
+        if vs is not None:
+            fields["vs_var"] = f"{vs:+.0f} FPM"
+        if mach is not None:
+            fields["mach_var"] = f"M {mach:.3f}"
+        
+        # Engine data - try multiple sources for compatibility
+        # Try N1/N2 first (jets)
+        n1 = value("sim/cockpit2/engine/indicators/N1_percent", 0)
+        n2 = value("sim/cockpit2/engine/indicators/N2_percent", 0)
+        
+        # If N1/N2 not available, try RPM (props)
+        if n1 is None or n1 == 0:
+            rpm = value("sim/cockpit2/engine/indicators/engine_speed_rpm", 0)
+            if rpm is not None and rpm > 0:
+                fields["n1_var"] = f"{rpm:.0f} RPM"
+            else:
+                fields["n1_var"] = "---"
+        else:
+            fields["n1_var"] = f"{n1:.1f}%"
+        
+        if n2 is not None and n2 > 0:
+            fields["n2_var"] = f"{n2:.1f}%"
+        else:
+            # Try prop RPM as alternative
+            prop_rpm = value("sim/cockpit2/engine/indicators/prop_speed_rpm", 0)
+            if prop_rpm is not None and prop_rpm > 0:
+                fields["n2_var"] = f"{prop_rpm:.0f} RPM"
+            else:
+                fields["n2_var"] = "---"
+        
+        throttle = value("sim/cockpit2/engine/actuators/throttle_ratio", 0)
+        if throttle is not None:
+            fields["throttle_var"] = f"{throttle * 100:.1f}%"
+        
+        fuel_total = value("sim/flightmodel/weight/m_fuel_total")
+        if fuel_total is not None:
+            # Convert kg to lbs
+            fields["fuel_var"] = f"{fuel_total * 2.20462:.0f} LBS"
+        
+        # Show the rest of the calculations; apply_frame reports the failed ones
+        results = {name: data for name, data in frame.results.items() if "error" not in data}
+        
+        flight_data = results.get("flight")
+        if flight_data:
+            # Extract and display wind data
+            wind = flight_data.get('wind', {})
+            hw = wind.get('headwind', 0)
+            cw = wind.get('crosswind', 0)
+            wind_spd = wind.get('speed_kts', 0)
+            wind_dir = wind.get('direction_from', 0)
             
-            if heading is not None:
-                self.heading_var.set(f"{heading:06.2f}°")
-            if pitch is not None:
-                self.pitch_var.set(f"{pitch:+06.2f}°")
-            if roll is not None:
-                self.roll_var.set(f"{roll:+06.2f}°")
-            if track is not None:
-                self.track_var.set(f"{track:06.2f}°")
+            if hw >= 0:
+                fields["headwind_var"] = f"{hw:.1f} KT"
+            else:
+                fields["headwind_var"] = f"{abs(hw):.1f} TAIL"
             
-            # Flight data
-            # Use cockpit gauge IAS (what pilot sees) instead of raw indicated_airspeed
-            # The raw dataref can be miscalibrated or in wrong units for some aircraft
-            ias = self.api.get_dataref_value("sim/cockpit2/gauges/indicators/airspeed_kts_pilot")
-            if ias is None:  # Fallback to raw if cockpit gauge not available
-                ias = self.api.get_dataref_value("sim/flightmodel/position/indicated_airspeed")
-            gs = self.api.get_dataref_value("sim/flightmodel/position/groundspeed")
-            vs = self.api.get_dataref_value("sim/cockpit2/gauges/indicators/vvi_fpm_pilot")
-            mach = self.api.get_dataref_value("sim/flightmodel/misc/machno")
+            if abs(cw) < 0.5:
+                fields["crosswind_var"] = "CALM"
+            elif cw > 0:
+                fields["crosswind_var"] = f"{cw:.1f} R"
+            else:
+                fields["crosswind_var"] = f"{abs(cw):.1f} L"
             
-            if ias is not None:
-                self.ias_var.set(f"{ias:.1f} KTS")
-            if gs is not None:
-                # Convert m/s to knots
-                self.gs_var.set(f"{gs * 1.94384:.1f} KTS")
-            if vs is not None:
-                self.vs_var.set(f"{vs:+.0f} FPM")
-            if mach is not None:
-                self.mach_var.set(f"M {mach:.3f}")
+            fields["wind_spd_var"] = f"{wind_spd:.1f} KT"
+            fields["wind_dir_var"] = f"{wind_dir:03.0f}°"
             
-            # Engine data - try multiple sources for compatibility
-            # Try N1/N2 first (jets)
-            n1 = self.api.get_dataref_value("sim/cockpit2/engine/indicators/N1_percent", 0)
-            n2 = self.api.get_dataref_value("sim/cockpit2/engine/indicators/N2_percent", 0)
+            # Extract and display envelope margins
+            envelope = flight_data.get('envelope', {})
+            stall_mrg = envelope.get('stall_margin_pct', 0)
+            speed_mrg = envelope.get('min_margin_pct', 0)
+            load_g = envelope.get('load_factor', 1.0)
+            corner = envelope.get('corner_speed_kts', 0)
             
-            # If N1/N2 not available, try RPM (props)
-            if n1 is None or n1 == 0:
-                rpm = self.api.get_dataref_value("sim/cockpit2/engine/indicators/engine_speed_rpm", 0)
-                if rpm is not None and rpm > 0:
-                    self.n1_var.set(f"{rpm:.0f} RPM")
-                else:
-                    self.n1_var.set("---")
+            # Color code stall margin
+            if stall_mrg < 10:
+                stall_color = "CRIT"
+            elif stall_mrg < 20:
+                stall_color = "WARN"
             else:
-                self.n1_var.set(f"{n1:.1f}%")
+                stall_color = ""
             
-            if n2 is not None and n2 > 0:
-                self.n2_var.set(f"{n2:.1f}%")
-            else:
-                # Try prop RPM as alternative
-                prop_rpm = self.api.get_dataref_value("sim/cockpit2/engine/indicators/prop_speed_rpm", 0)
-                if prop_rpm is not None and prop_rpm > 0:
-                    self.n2_var.set(f"{prop_rpm:.0f} RPM")
-                else:
-                    self.n2_var.set("---")
+            fields["stall_margin_var"] = f"{stall_mrg:.0f}% {stall_color}".strip()
+            fields["speed_margin_var"] = f"{speed_mrg:.0f}%"
+            fields["load_factor_var"] = f"{load_g:.2f} G"
+            fields["corner_spd_var"] = f"{corner:.0f} KT"
             
-            throttle = self.api.get_dataref_value("sim/cockpit2/engine/actuators/throttle_ratio", 0)
-            if throttle is not None:
-                self.throttle_var.set(f"{throttle * 100:.1f}%")
+            # Extract and display energy data
+            energy = flight_data.get('energy', {})
+            spec_energy = energy.get('specific_energy_ft', 0)
+            trend = energy.get('trend', 0)
             
-            fuel_total = self.api.get_dataref_value("sim/flightmodel/weight/m_fuel_total")
-            if fuel_total is not None:
-                # Convert kg to lbs
-                self.fuel_var.set(f"{fuel_total * 2.20462:.0f} LBS")
+            trend_arrow = "↑" if trend > 0 else "↓" if trend < 0 else "→"
+            fields["spec_energy_var"] = f"{spec_energy:.0f} {trend_arrow}"
+        
+        turn_data = results.get("turn")
+        if turn_data:
+            radius_nm = turn_data.get('radius_nm', 0)
+            turn_rate = turn_data.get('turn_rate_dps', 0)
+            turn_time = turn_data.get('time_to_turn_sec', 0)
+            std_bank = turn_data.get('standard_rate_bank', 0)
             
-            # Get additional data for comprehensive calculations
-            tas = self.api.get_dataref_value("sim/flightmodel/position/true_airspeed")
-            weight = self.api.get_dataref_value("sim/flightmodel/weight/m_total")
-            vso = self.api.get_dataref_value("sim/aircraft/view/acf_Vso")
-            vne = self.api.get_dataref_value("sim/aircraft/view/acf_Vne")
-            mmo_val = self.api.get_dataref_value("sim/aircraft/view/acf_Mmo")
+            if radius_nm < 10:
+                fields["turn_radius_var"] = f"{radius_nm:.2f} NM"
+            else:
+                fields["turn_radius_var"] = f"{radius_nm:.1f} NM"
             
-            # Convert units for calculator
-            gs_kts = gs * 1.94384 if gs is not None else 0
-            alt_ft = alt * 3.28084 if alt is not None else 0
-            agl_ft = agl * 3.28084 if agl is not None else 0
+            fields["turn_rate_var"] = f"{turn_rate:.1f} °/s"
+            fields["turn_time_var"] = f"{turn_time:.0f} SEC"
+            fields["std_rate_bank_var"] = f"{std_bank:.1f}°"
+        
+        vnav_data = results.get("vnav")
+        if vnav_data:
+            tod_dist = vnav_data.get('tod_distance_nm', 0)
+            req_vs = vnav_data.get('required_vs_fpm', 0)
+            fpa = vnav_data.get('flight_path_angle_deg', 0)
+            vs_3deg = vnav_data.get('vs_for_3deg', 0)
             
-            # Call comprehensive C++ flight calculator
-            if all(v is not None for v in [tas, gs, heading, track, ias, mach, alt, agl, vs, weight, roll, vso, vne, mmo_val]):
-                flight_data = self.calculate_flight_data(
-                    tas, gs_kts, heading, track, ias, mach, alt_ft, agl_ft, vs,
-                    weight, roll, vso, vne, mmo_val
-                )
-                
-                if flight_data:
-                    # Extract and display wind data
-                    wind = flight_data.get('wind', {})
-                    hw = wind.get('headwind', 0)
-                    cw = wind.get('crosswind', 0)
-                    wind_spd = wind.get('speed_kts', 0)
-                    wind_dir = wind.get('direction_from', 0)
-                    
-                    if hw >= 0:
-                        self.headwind_var.set(f"{hw:.1f} KT")
-                    else:
-                        self.headwind_var.set(f"{abs(hw):.1f} TAIL")
-                    
-                    if abs(cw) < 0.5:
-                        self.crosswind_var.set("CALM")
-                    elif cw > 0:
-                        self.crosswind_var.set(f"{cw:.1f} R")
-                    else:
-                        self.crosswind_var.set(f"{abs(cw):.1f} L")
-                    
-                    self.wind_spd_var.set(f"{wind_spd:.1f} KT")
-                    self.wind_dir_var.set(f"{wind_dir:03.0f}°")
-                    
-                    # Extract and display envelope margins
-                    envelope = flight_data.get('envelope', {})
-                    stall_mrg = envelope.get('stall_margin_pct', 0)
-                    speed_mrg = envelope.get('min_margin_pct', 0)
-                    load_g = envelope.get('load_factor', 1.0)
-                    corner = envelope.get('corner_speed_kts', 0)
-                    
-                    # Color code stall margin
-                    if stall_mrg < 10:
-                        stall_color = "CRIT"
-                    elif stall_mrg < 20:
-                        stall_color = "WARN"
-                    else:
-                        stall_color = ""
-                    
-                    self.stall_margin_var.set(f"{stall_mrg:.0f}% {stall_color}".strip())
-                    self.speed_margin_var.set(f"{speed_mrg:.0f}%")
-                    self.load_factor_var.set(f"{load_g:.2f} G")
-                    self.corner_spd_var.set(f"{corner:.0f} KT")
-                    
-                    # Extract and display energy data
-                    energy = flight_data.get('energy', {})
-                    spec_energy = energy.get('specific_energy_ft', 0)
-                    trend = energy.get('trend', 0)
-                    
-                    trend_arrow = "↑" if trend > 0 else "↓" if trend < 0 else "→"
-                    self.spec_energy_var.set(f"{spec_energy:.0f} {trend_arrow}")
+            fields["tod_dist_var"] = f"{tod_dist:.1f} NM"
+            fields["req_vs_var"] = f"{req_vs:+.0f} FPM"
+            fields["fpa_var"] = f"{fpa:+.1f}°"
+            fields["vs_3deg_var"] = f"{vs_3deg:.0f} FPM"
+        
+        da_data = results.get("density")
+        if da_data:
+            dens_alt = da_data.get('density_altitude_ft', 0)
+            perf_loss = da_data.get('performance_loss_pct', 0)
+            isa_dev = da_data.get('temperature_deviation_c', 0)
+            eas = da_data.get('eas_kts', 0)
             
-            # Call turn performance calculator
-            if tas is not None and roll is not None:
-                turn_data = self.calculate_turn_performance(tas, abs(roll))
-                if turn_data:
-                    radius_nm = turn_data.get('radius_nm', 0)
-                    turn_rate = turn_data.get('turn_rate_dps', 0)
-                    turn_time = turn_data.get('time_to_turn_sec', 0)
-                    std_bank = turn_data.get('standard_rate_bank', 0)
-                    
-                    if radius_nm < 10:
-                        self.turn_radius_var.set(f"{radius_nm:.2f} NM")
-                    else:
-                        self.turn_radius_var.set(f"{radius_nm:.1f} NM")
-                    
-                    self.turn_rate_var.set(f"{turn_rate:.1f} °/s")
-                    self.turn_time_var.set(f"{turn_time:.0f} SEC")
-                    self.std_rate_bank_var.set(f"{std_bank:.1f}°")
+            fields["density_alt_var"] = f"{dens_alt:.0f} FT"
+            fields["perf_loss_var"] = f"{perf_loss:.0f}%"
             
-            # Call VNAV calculator
-            if alt_ft is not None and gs_kts is not None and vs is not None:
-                vnav_data = self.calculate_vnav_data(alt_ft, gs_kts, vs)
-                if vnav_data:
-                    tod_dist = vnav_data.get('tod_distance_nm', 0)
-                    req_vs = vnav_data.get('required_vs_fpm', 0)
-                    fpa = vnav_data.get('flight_path_angle_deg', 0)
-                    vs_3deg = vnav_data.get('vs_for_3deg', 0)
-                    
-                    self.tod_dist_var.set(f"{tod_dist:.1f} NM")
-                    self.req_vs_var.set(f"{req_vs:+.0f} FPM")
-                    self.fpa_var.set(f"{fpa:+.1f}°")
-                    self.vs_3deg_var.set(f"{vs_3deg:.0f} FPM")
+            # Color code ISA deviation
+            if abs(isa_dev) < 5:
+                fields["isa_dev_var"] = f"{isa_dev:+.0f}°C"
+            else:
+                fields["isa_dev_var"] = f"{isa_dev:+.0f}°C !"
             
-            # Call density altitude calculator
-            # Get OAT (outside air temperature)
-            oat = self.api.get_dataref_value("sim/cockpit2/temperature/outside_air_temp_degc")
-            if oat is not None and alt_ft is not None and ias is not None and tas is not None:
-                da_data = self.calculate_density_altitude(alt_ft, oat, ias, tas)
-                if da_data:
-                    dens_alt = da_data.get('density_altitude_ft', 0)
-                    perf_loss = da_data.get('performance_loss_pct', 0)
-                    isa_dev = da_data.get('temperature_deviation_c', 0)
-                    eas = da_data.get('eas_kts', 0)
-                    
-                    self.density_alt_var.set(f"{dens_alt:.0f} FT")
-                    self.perf_loss_var.set(f"{perf_loss:.0f}%")
-                    
-                    # Color code ISA deviation
-                    if abs(isa_dev) < 5:
-                        self.isa_dev_var.set(f"{isa_dev:+.0f}°C")
-                    else:
-                        self.isa_dev_var.set(f"{isa_dev:+.0f}°C !")
-                    
-                    self.eas_var.set(f"{eas:.0f} KT")
+            fields["eas_var"] = f"{eas:.0f} KT"
         
-        except Exception as e:
-            print(f"Error updating data: {e}")
+        return fields
+    
+    def apply_frame(self, frame: FrameSnapshot):
+        """Show one finished frame (Tk thread)
+        
+        Reports failed calculations, then sets only the fields whose text
+        changed.
+        """
+        for name, data in frame.results.items():
+            if "error" in data and name == "density":
+                self.handle_density_error(data["error"], data.get("stderr", ""))
+        self.renderer.apply(frame.fields)
 
 
 def main():
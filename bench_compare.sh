@@ -0,0 +1,127 @@
+#!/bin/bash
+# Compare a release build's performance with the default build's (make release)
+#
+# Runs calc_bench and in-process calc_loadgen replays (the synthetic flight,
+# and <release dir>/train.log when a training run left it) with the
+# programs of both directories, and prints each benchmark's ns/op and each
+# replay's throughput and p99 latency side by side with the release
+# build's speedup.
+#
+# Each program runs BENCH_RUNS times (default 5), the two builds taking
+# turns, and the best run of each counts: the fastest ns/op, the highest
+# throughput. A benchmark or replay whose speedup is below REGRESSION_LIMIT
+# (default 0.90; 0 turns the check off) is marked and makes the script
+# exit with 3 after the whole table is printed. A benchmark below the limit
+# is first run BENCH_RECHECKS more times (default 5) on its own, in rounds a
+# second apart: on a shared machine a slow spell can cover every run of a
+# short benchmark. The limit leaves room for code alignment, which alone
+# moves a benchmark of a few tens of ns by up to 5%.
+#
+# Usage: ./bench_compare.sh <default dir> <release dir>
+
+set -e
+
+baseline=$1
+release=$2
+runs=${BENCH_RUNS:-5}
+rechecks=${BENCH_RECHECKS:-5}
+limit=${REGRESSION_LIMIT:-0.90}
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+for run in $(seq "$runs"); do
+    "$baseline/calc_bench" > "$work/default.$run"
+    "$release/calc_bench" > "$work/release.$run"
+done
+
+# name and fastest ns/op of every benchmark, in calc_bench's order
+best_bench() {
+    awk 'FNR > 1 { if (!($1 in best)) { order[++count] = $1; best[$1] = $2 } else if ($2 < best[$1]) best[$1] = $2 }
+         END { for (i = 1; i <= count; ++i) print order[i], best[order[i]] }' "$@"
+}
+best_bench "$work"/default.* > "$work/default.txt"
+best_bench "$work"/release.* > "$work/release.txt"
+
+# Names of the benchmarks below the limit so far
+slow_benches() {
+    awk -v limit="$limit" 'NR == FNR { base[$1] = $2; next } ($1 in base) && $2 > 0 && base[$1] / $2 < limit { print $1 }' \
+        "$work/default.txt" "$work/release.txt"
+}
+slow=$(slow_benches)
+recheck=0
+for run in $(seq "$rechecks"); do
+    [ -n "$slow" ] || break
+    sleep 1
+    for name in $slow; do
+        recheck=$((recheck + 1))
+        # The filter matches by substring; best_bench keeps each name's best
+        "$baseline/calc_bench" "$name" > "$work/default.recheck$recheck"
+        "$release/calc_bench" "$name" > "$work/release.recheck$recheck"
+    done
+done
+if [ "$recheck" -gt 0 ]; then
+    best_bench "$work"/default.* > "$work/default.txt"
+    best_bench "$work"/release.* > "$work/release.txt"
+fi
+
+echo "Benchmarks ($(uname -m), $(date -u +%Y-%m-%d), best of $runs): default build vs release build"
+regressions=$(awk -v limit="$limit" -v table="$work/table.txt" \
+    'NR == FNR { base[$1] = $2; next }
+     FNR == 1 { printf "%-34s %12s %12s %8s\n", "Benchmark", "default ns", "release ns", "speedup" > table }
+     ($1 in base) && $2 > 0 {
+         speedup = base[$1] / $2
+         log_sum += log(speedup)
+         ++count
+         mark = ""
+         if (speedup < limit) { mark = "  REGRESSION"; ++regressions }
+         printf "%-34s %12.1f %12.1f %7.2fx%s\n", $1, base[$1], $2, speedup, mark > table
+     }
+     END {
+         if (count > 0) printf "%-34s %33.2fx\n", "geometric mean", exp(log_sum / count) > table
+         print regressions + 0
+     }' "$work/default.txt" "$work/release.txt")
+cat "$work/table.txt"
+
+# throughput_fps and latency_us p99 of a calc_loadgen --json line
+loadgen_figures() {
+    sed -E 's/.*"throughput_fps": ([0-9.]+).*"p99": ([0-9.]+).*/\1 \2/'
+}
+
+# Highest throughput and lowest p99 over the runs of one build
+best_replay() {
+    awk '{ if (NR == 1 || $1 > fps) fps = $1; if (NR == 1 || $2 < p99) p99 = $2 } END { print fps, p99 }' "$1"
+}
+
+echo ""
+printf "%-34s %12s %12s %8s %10s %10s\n" "Replay (in process)" "default fps" "release fps" "speedup" \
+    "default p99" "release p99"
+for source in synthetic log; do
+    args=(--in-process --frames 200000 --json)
+    if [ "$source" = log ]; then
+        [ -f "$release/train.log" ] || continue
+        args+=(--log "$release/train.log")
+    fi
+    : > "$work/default.replay"
+    : > "$work/release.replay"
+    for run in $(seq "$runs"); do
+        "$baseline/calc_loadgen" "${args[@]}" | loadgen_figures >> "$work/default.replay"
+        "$release/calc_loadgen" "${args[@]}" | loadgen_figures >> "$work/release.replay"
+    done
+    read -r base_fps base_p99 <<< "$(best_replay "$work/default.replay")"
+    read -r release_fps release_p99 <<< "$(best_replay "$work/release.replay")"
+    regressed=$(awk -v bf="$base_fps" -v rf="$release_fps" -v limit="$limit" 'BEGIN { print (rf / bf < limit) }')
+    mark=""
+    if [ "$regressed" = 1 ]; then
+        mark="  REGRESSION"
+        regressions=$((regressions + 1))
+    fi
+    awk -v name="$source" -v bf="$base_fps" -v rf="$release_fps" -v bp="$base_p99" -v rp="$release_p99" \
+        -v mark="$mark" 'BEGIN { printf "%-34s %12.0f %12.0f %7.2fx %8.2fus %8.2fus%s\n", name, bf, rf, rf / bf,
+                                 bp, rp, mark }'
+done
+
+if [ "$regressions" -gt 0 ]; then
+    echo ""
+    echo "✗ $regressions regression(s): release build below ${limit}x of the default build"
+    exit 3
+fi
@@ -0,0 +1,119 @@
+// Aircraft Performance Profile for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Implementation of the profile declared in aircraft_profile.h.
+//
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses return codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (the file is mapped once)
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#include <cmath>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "aircraft_profile.h"
+
+namespace xplane_mfd::calc {
+
+namespace {
+
+const Int64 image_alignment = 8;
+
+bool positive_finite(Float64 value) {
+    return std::isfinite(value) && value > 0.0;
+}
+
+// Every check of attach, before anything is kept
+bool image_valid(const void* image, Int64 size) {
+    bool valid = image != nullptr && size >= static_cast<Int64>(sizeof(AircraftProfileHeader)) &&
+                 reinterpret_cast<std::uintptr_t>(image) % image_alignment == 0;
+    const AircraftProfileHeader* header = static_cast<const AircraftProfileHeader*>(image);
+    if (valid) {
+        valid = header->magic == aircraft_profile_magic && header->version == aircraft_profile_version &&
+                header->point_count >= min_profile_points && header->point_count <= max_profile_points &&
+                size == static_cast<Int64>(sizeof(AircraftProfileHeader)) +
+                        header->point_count * static_cast<Int64>(sizeof(AircraftProfilePoint)) &&
+                positive_finite(header->vso_kts) && positive_finite(header->vne_kts) &&
+                positive_finite(header->mmo) && header->vne_kts > header->vso_kts;
+    }
+    if (valid) {
+        const AircraftProfilePoint* points = reinterpret_cast<const AircraftProfilePoint*>(header + 1);
+        for (Int32 i = 0; i < header->point_count && valid; ++i) {
+            valid = positive_finite(points[i].ias_kts) && positive_finite(points[i].lift_to_drag) &&
+                    (i == 0 || points[i].ias_kts > points[i - 1].ias_kts);
+        }
+    }
+    return valid;
+}
+
+} // namespace
+
+AircraftProfile::AircraftProfile()
+    : header_(nullptr), points_(nullptr), mapping_(nullptr), mapping_size_(0),
+      best_lift_to_drag_(0.0), best_glide_ias_kts_(0.0), lift_to_drag_per_knot_{} {
+}
+
+AircraftProfile::~AircraftProfile() {
+    unmap();
+}
+
+void AircraftProfile::unmap() {
+    if (mapping_ != nullptr) {
+        munmap(mapping_, static_cast<size_t>(mapping_size_));
+    }
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+}
+
+bool AircraftProfile::load(const char* path) {
+    bool ok = false;
+    Int32 fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+            Int64 size = static_cast<Int64>(file_stat.st_size);
+            void* mapping = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                if (image_valid(mapping, size)) {
+                    unmap();
+                    ok = attach(mapping, size);
+                    mapping_ = mapping;
+                    mapping_size_ = size;
+                } else {
+                    munmap(mapping, static_cast<size_t>(size));
+                }
+            }
+        }
+        close(fd);
+    }
+    return ok;
+}
+
+bool AircraftProfile::attach(const void* image, Int64 size) {
+    bool ok = image_valid(image, size);
+    if (ok) {
+        if (image != mapping_) {
+            unmap();
+        }
+        header_ = static_cast<const AircraftProfileHeader*>(image);
+        points_ = reinterpret_cast<const AircraftProfilePoint*>(header_ + 1);
+        best_lift_to_drag_ = points_[0].lift_to_drag;
+        best_glide_ias_kts_ = points_[0].ias_kts;
+        for (Int32 i = 0; i < header_->point_count; ++i) {
+            lift_to_drag_per_knot_[i] = points_[i].lift_to_drag / points_[i].ias_kts;
+            if (points_[i].lift_to_drag > best_lift_to_drag_) {
+                best_lift_to_drag_ = points_[i].lift_to_drag;
+                best_glide_ias_kts_ = points_[i].ias_kts;
+            }
+        }
+    }
+    return ok;
+}
+
+} // namespace xplane_mfd::calc
@@ -0,0 +1,110 @@
+// Aircraft Performance Profile for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// An aircraft's fixed performance data: its speed limits and its lift to
+// drag ratio against indicated airspeed. Resident processes load one
+// profile at startup (mfd_calcd --profile <path>) instead of receiving the
+// limits with every flight request, and the glide kernel reads its L/D
+// curve in place of a fixed ratio.
+//
+// The file is a compact little-endian image that is memory mapped read
+// only and used where it lies; nothing is copied or parsed per request:
+//
+//   offset  size  field                Python struct "<IIii3d" + n * "2d"
+//   0       4     magic "XPAP"
+//   4       4     aircraft_profile_version
+//   8       4     point count n (2..max_profile_points)
+//   12      4     reserved (0)
+//   16      24    vso_kts, vne_kts, mmo
+//   40      16n   n points of (ias_kts, lift_to_drag), ias_kts increasing
+//
+// The file size must be exactly 40 + 16n. The best L/D and its speed are
+// found once when the profile is loaded, along with each point's L/D per
+// knot of IAS, so a glide lookup is a multiply and subtract per point. A change to this layout must bump
+// aircraft_profile_version.
+//
+// A loaded profile is never written, so any number of threads and aircraft
+// may read it at once.
+//
+// AV Rule 126: C++ style comments only (//)
+
+#ifndef AIRCRAFT_PROFILE_H
+#define AIRCRAFT_PROFILE_H
+
+#include <array>
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+// File identification and limits (AV Rule 52: lowercase)
+const Uint32 aircraft_profile_magic = 0x50415058u;  // bytes 'X' 'P' 'A' 'P' little-endian
+const Uint32 aircraft_profile_version = 1;
+const Int32 min_profile_points = 2;
+const Int32 max_profile_points = 32;
+
+struct AircraftProfileHeader {
+    Uint32 magic;
+    Uint32 version;
+    Int32 point_count;
+    Int32 reserved;
+    Float64 vso_kts;
+    Float64 vne_kts;
+    Float64 mmo;
+};
+
+struct AircraftProfilePoint {
+    Float64 ias_kts;
+    Float64 lift_to_drag;
+};
+
+static_assert(sizeof(AircraftProfileHeader) == 40, "profile header layout");
+static_assert(sizeof(AircraftProfilePoint) == 16, "profile point layout");
+
+class AircraftProfile {
+public:
+    AircraftProfile();
+    ~AircraftProfile();
+
+    AircraftProfile(const AircraftProfile&) = delete;
+    AircraftProfile& operator=(const AircraftProfile&) = delete;
+
+    // Map a profile file. False (keeping any profile already loaded) if it
+    // cannot be read or fails the checks of attach.
+    bool load(const char* path);
+
+    // Use an image already in memory (8-byte aligned, kept alive by the
+    // caller). False if the header, size or points are invalid: limits and
+    // ratios must be positive and finite, vne above vso, speeds increasing.
+    bool attach(const void* image, Int64 size);
+
+    bool loaded() const { return header_ != nullptr; }
+
+    Float64 vso_kts() const { return header_->vso_kts; }
+    Float64 vne_kts() const { return header_->vne_kts; }
+    Float64 mmo() const { return header_->mmo; }
+
+    Int32 point_count() const { return header_->point_count; }
+    const AircraftProfilePoint& point(Int32 index) const { return points_[index]; }
+
+    // Highest L/D of the table and the IAS it is reached at
+    Float64 best_lift_to_drag() const { return best_lift_to_drag_; }
+    Float64 best_glide_ias_kts() const { return best_glide_ias_kts_; }
+
+    // lift_to_drag / ias_kts of each point
+    const Float64* lift_to_drag_per_knot() const { return lift_to_drag_per_knot_.data(); }
+
+private:
+    void unmap();
+
+    const AircraftProfileHeader* header_;
+    const AircraftProfilePoint* points_;
+    void* mapping_;
+    Int64 mapping_size_;
+    Float64 best_lift_to_drag_;
+    Float64 best_glide_ias_kts_;
+    std::array<Float64, max_profile_points> lift_to_drag_per_knot_;
+};
+
+} // namespace xplane_mfd::calc
+
+#endif // AIRCRAFT_PROFILE_H
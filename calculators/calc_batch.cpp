@@ -0,0 +1,650 @@
+// Batch Calculator for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Replays recorded flight data through the calculator kernels in bulk:
+// one process evaluates every row of a CSV or column file, instead of one
+// process launch per sample.
+//
+// Kernels and their columns (input order = CSV field order):
+//   envelope  bank_deg ias_kts mach vso_kts vne_kts mmo
+//   energy    tas_kts altitude_ft vs_fpm
+//   glide     agl_ft tas_kts headwind_kts
+//   turn      tas_kts bank_deg course_change_deg
+//   vnav      current_alt_ft target_alt_ft distance_nm groundspeed_kts current_vs_fpm
+//   wind      track heading wind_dir wind_speed
+//
+// Output columns are the fields of the kernel's result struct. CSV output
+// starts with a header line; a non-numeric first input line is taken as a
+// header and skipped. Turn and wind rows that turn_calculator /
+// wind_calculator would reject come out as nan.
+//
+// Rows are processed in blocks of wire_column_block_rows through the
+// structure-of-arrays batch kernels. turn, vnav and wind use the SIMD
+// kernels (simd_math.h) unless --scalar asks for the scalar reference.
+//
+// With --log <path> the rows come from a mfd_calcd flight-data log
+// (flight_recorder.h), mapped read only, instead of stdin: one row per
+// recorded section the kernel can take, in log order, written as CSV or
+// (--columns) a column file.
+//   envelope  flight sections
+//   energy    flight and dynamic sections
+//   glide     flight sections: agl_ft, tas_kts and the recorded headwind
+//   turn      turn sections
+//   vnav      vnav sections
+//   wind      flight and dynamic sections: track, heading and the recorded
+//             wind vector (the wind components of the frame)
+//
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (fixed block buffers)
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+//
+// Compile: g++ -std=c++20 -O3 -o calc_batch calc_batch.cpp flight_kernels.cpp calc_io.cpp
+//          turn_kernels.cpp vnav_kernels.cpp wind_kernels.cpp aircraft_profile.cpp wind_estimator.cpp
+//          flight_recorder.cpp
+//
+// Usage: ./calc_batch [--columns] [--scalar] [--log <path>] <kernel> < input > output
+
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include "jsf_types.h"
+#include "flight_kernels.h"
+#include "turn_kernels.h"
+#include "vnav_kernels.h"
+#include "wind_kernels.h"
+#include "flight_recorder.h"
+#include "wire_format.h"
+#include "simd_math.h"
+
+namespace xplane_mfd::calc {
+
+// Error codes (AV Rule 52: lowercase)
+const Int32 error_success = 0;
+const Int32 error_invalid_args = 1;
+const Int32 error_parse_failed = 2;
+const Int32 error_bad_format = 3;
+const Int32 error_io_failed = 4;
+
+// Fixed limits (AV Rule 206: no dynamic allocation)
+const Int32 max_batch_columns = 8;
+const Int32 batch_line_max = 1024;
+const Int32 batch_number_max = 32;  // longest to_chars output for a Float64
+const Int32 max_kernels = 6;
+
+using BatchRunner = void (*)(const Float64* const* in, Float64* const* out, Int32 rows);
+
+// A flight log record's input row for the kernel; false if the record's
+// section does not feed it
+using LogRowReader = bool (*)(const FlightLogRecord& record, Float64* row);
+
+struct BatchKernelSpec {
+    const char* name;
+    Int32 input_count;
+    Int32 output_count;
+    const char* output_names[max_batch_columns];
+    BatchRunner run;
+    BatchRunner run_simd;  // nullptr if the kernel has no SIMD version
+    LogRowReader log_row;
+};
+
+// Adapters from column arrays to each kernel's batch structs
+
+void run_envelope(const Float64* const* in, Float64* const* out, Int32 rows) {
+    EnvelopeBatchInputs inputs = {in[0], in[1], in[2], in[3], in[4], in[5]};
+    EnvelopeBatchOutputs outputs = {out[0], out[1], out[2], out[3], out[4], out[5]};
+    calculate_envelope_batch(inputs, outputs, rows);
+}
+
+void run_energy(const Float64* const* in, Float64* const* out, Int32 rows) {
+    EnergyBatchInputs inputs = {in[0], in[1], in[2]};
+    EnergyBatchOutputs outputs = {out[0], out[1], out[2]};
+    calculate_energy_batch(inputs, outputs, rows);
+}
+
+void run_glide(const Float64* const* in, Float64* const* out, Int32 rows) {
+    GlideBatchInputs inputs = {in[0], in[1], in[2]};
+    GlideBatchOutputs outputs = {out[0], out[1], out[2], out[3]};
+    calculate_glide_reach_batch(inputs, outputs, rows);
+}
+
+// Rows the standalone calculator would reject have no meaningful result
+void mark_invalid_row(Float64* const* out, Int32 output_count, Int32 row) {
+    const Float64 not_a_number = std::numeric_limits<Float64>::quiet_NaN();
+    for (Int32 c = 0; c < output_count; ++c) {
+        out[c][row] = not_a_number;
+    }
+}
+
+void mark_invalid_turn_rows(const Float64* const* in, Float64* const* out, Int32 rows) {
+    for (Int32 i = 0; i < rows; ++i) {
+        if (!turn_inputs_valid(in[0][i], in[1][i])) {
+            mark_invalid_row(out, 8, i);
+        }
+    }
+}
+
+void run_turn(const Float64* const* in, Float64* const* out, Int32 rows) {
+    TurnBatchInputs inputs = {in[0], in[1], in[2]};
+    TurnBatchOutputs outputs = {out[0], out[1], out[2], out[3], out[4], out[5], out[6], out[7]};
+    calculate_turn_performance_batch(inputs, outputs, rows);
+    mark_invalid_turn_rows(in, out, rows);
+}
+
+void run_turn_simd(const Float64* const* in, Float64* const* out, Int32 rows) {
+    TurnBatchInputs inputs = {in[0], in[1], in[2]};
+    TurnBatchOutputs outputs = {out[0], out[1], out[2], out[3], out[4], out[5], out[6], out[7]};
+    calculate_turn_performance_simd(inputs, outputs, rows);
+    mark_invalid_turn_rows(in, out, rows);
+}
+
+void run_vnav(const Float64* const* in, Float64* const* out, Int32 rows) {
+    VNAVBatchInputs inputs = {in[0], in[1], in[2], in[3], in[4]};
+    VNAVBatchOutputs outputs = {out[0], out[1], out[2], out[3], out[4], out[5], out[6], out[7]};
+    calculate_vnav_batch(inputs, outputs, rows);
+}
+
+void run_vnav_simd(const Float64* const* in, Float64* const* out, Int32 rows) {
+    VNAVBatchInputs inputs = {in[0], in[1], in[2], in[3], in[4]};
+    VNAVBatchOutputs outputs = {out[0], out[1], out[2], out[3], out[4], out[5], out[6], out[7]};
+    calculate_vnav_simd(inputs, outputs, rows);
+}
+
+// wind_calculator rejects negative wind speeds
+void mark_invalid_wind_rows(const Float64* const* in, Float64* const* out, Int32 rows) {
+    for (Int32 i = 0; i < rows; ++i) {
+        if (in[3][i] < 0.0) {
+            mark_invalid_row(out, 5, i);
+        }
+    }
+}
+
+void run_wind(const Float64* const* in, Float64* const* out, Int32 rows) {
+    WindBatchInputs inputs = {in[0], in[1], in[2], in[3]};
+    WindBatchOutputs outputs = {out[0], out[1], out[2], out[3], out[4]};
+    calculate_wind_batch(inputs, outputs, rows);
+    mark_invalid_wind_rows(in, out, rows);
+}
+
+void run_wind_simd(const Float64* const* in, Float64* const* out, Int32 rows) {
+    WindBatchInputs inputs = {in[0], in[1], in[2], in[3]};
+    WindBatchOutputs outputs = {out[0], out[1], out[2], out[3], out[4]};
+    calculate_wind_simd(inputs, outputs, rows);
+    mark_invalid_wind_rows(in, out, rows);
+}
+
+// Flight log rows: the recorded inputs of the sections each kernel is
+// part of, in the kernel's column order (flight field indices as
+// flight_inputs_from_values)
+
+bool is_flight_record(const FlightLogRecord& record, bool dynamic_too) {
+    return record.section == flight_log_section_flight ||
+           (dynamic_too && record.section == flight_log_section_dynamic);
+}
+
+// The recorded flight result; only for records with status 0
+FlightResults recorded_flight(const FlightLogRecord& record) {
+    FlightResults results;
+    std::memcpy(&results, record.result, sizeof(results));
+    return results;
+}
+
+bool log_envelope_row(const FlightLogRecord& record, Float64* row) {
+    // Dynamic sections took their limits from the daemon's profile
+    bool used = is_flight_record(record, false);
+    if (used) {
+        const Float64 fields[6] = {record.values[10], record.values[4], record.values[5],
+                                   record.values[11], record.values[12], record.values[13]};
+        std::memcpy(row, fields, sizeof(fields));
+    }
+    return used;
+}
+
+bool log_energy_row(const FlightLogRecord& record, Float64* row) {
+    bool used = is_flight_record(record, true);
+    if (used) {
+        const Float64 fields[3] = {record.values[0], record.values[6], record.values[8]};
+        std::memcpy(row, fields, sizeof(fields));
+    }
+    return used;
+}
+
+bool log_glide_row(const FlightLogRecord& record, Float64* row) {
+    // Dynamic sections glide on the profile's L/D, not the fixed ratio
+    bool used = is_flight_record(record, false) && record.status == error_success;
+    if (used) {
+        const Float64 fields[3] = {record.values[7], record.values[0], recorded_flight(record).wind.headwind};
+        std::memcpy(row, fields, sizeof(fields));
+    }
+    return used;
+}
+
+bool log_turn_row(const FlightLogRecord& record, Float64* row) {
+    bool used = record.section == flight_log_section_turn;
+    if (used) {
+        std::memcpy(row, record.values, 3 * sizeof(Float64));
+    }
+    return used;
+}
+
+bool log_vnav_row(const FlightLogRecord& record, Float64* row) {
+    bool used = record.section == flight_log_section_vnav;
+    if (used) {
+        std::memcpy(row, record.values, 5 * sizeof(Float64));
+    }
+    return used;
+}
+
+bool log_wind_row(const FlightLogRecord& record, Float64* row) {
+    bool used = is_flight_record(record, true) && record.status == error_success;
+    if (used) {
+        WindData wind = recorded_flight(record).wind;
+        const Float64 fields[4] = {record.values[3], record.values[2], wind.direction_from, wind.speed_kts};
+        std::memcpy(row, fields, sizeof(fields));
+    }
+    return used;
+}
+
+const BatchKernelSpec kernel_specs[max_kernels] = {
+    {"envelope", 6, 6, {"stall_margin_pct", "vmo_margin_pct", "mmo_margin_pct",
+                        "min_margin_pct", "load_factor", "corner_speed_kts"}, run_envelope, nullptr,
+     log_envelope_row},
+    {"energy", 3, 3, {"specific_energy_ft", "energy_rate_kts", "trend"}, run_energy, nullptr, log_energy_row},
+    {"glide", 3, 4, {"still_air_range_nm", "wind_adjusted_range_nm", "glide_ratio",
+                     "best_glide_speed_kts"}, run_glide, nullptr, log_glide_row},
+    {"turn", 3, 8, {"radius_nm", "radius_ft", "turn_rate_dps", "lead_distance_nm",
+                    "lead_distance_ft", "time_to_turn_sec", "load_factor",
+                    "standard_rate_bank"}, run_turn, run_turn_simd, log_turn_row},
+    {"vnav", 5, 8, {"altitude_to_lose_ft", "flight_path_angle_deg", "required_vs_fpm",
+                    "tod_distance_nm", "time_to_constraint_min", "distance_per_1000ft",
+                    "vs_for_3deg", "is_descent"}, run_vnav, run_vnav_simd, log_vnav_row},
+    {"wind", 4, 5, {"headwind", "crosswind", "total_wind", "wca", "drift"}, run_wind, run_wind_simd,
+     log_wind_row}
+};
+
+// Block buffers, one row-block per column (AV Rule 206: fixed storage)
+struct BatchBuffers {
+    std::array<std::array<Float64, wire_column_block_rows>, max_batch_columns> inputs;
+    std::array<std::array<Float64, wire_column_block_rows>, max_batch_columns> outputs;
+    const Float64* input_ptrs[max_batch_columns];
+    Float64* output_ptrs[max_batch_columns];
+
+    BatchBuffers() {
+        for (Int32 c = 0; c < max_batch_columns; ++c) {
+            input_ptrs[c] = inputs[c].data();
+            output_ptrs[c] = outputs[c].data();
+        }
+    }
+};
+
+const BatchKernelSpec* find_kernel(const char* name) {
+    const BatchKernelSpec* spec = nullptr;
+    for (Int32 i = 0; i < max_kernels && spec == nullptr; ++i) {
+        if (std::strcmp(name, kernel_specs[i].name) == 0) {
+            spec = &kernel_specs[i];
+        }
+    }
+    return spec;
+}
+
+// ---------------------------------------------------------------------------
+// CSV
+// ---------------------------------------------------------------------------
+
+// Parse one comma-separated row into column row `row`; false unless the
+// line holds exactly count numbers
+bool parse_csv_row(const char* line, BatchBuffers& buffers, Int32 count, Int32 row) {
+    bool ok = true;
+    const char* cursor = line;
+    const char* end = line + std::strlen(line);
+    while (end > cursor && (end[-1] == '\n' || end[-1] == '\r')) {
+        --end;
+    }
+
+    for (Int32 c = 0; c < count && ok; ++c) {
+        while (cursor < end && (*cursor == ' ' || *cursor == '\t')) {
+            ++cursor;
+        }
+        std::from_chars_result parsed = std::from_chars(cursor, end, buffers.inputs[c][row]);
+        ok = (parsed.ec == std::errc());
+        cursor = parsed.ptr;
+        while (ok && cursor < end && (*cursor == ' ' || *cursor == '\t')) {
+            ++cursor;
+        }
+        if (ok && c + 1 < count) {
+            ok = (cursor < end && *cursor == ',');
+            ++cursor;
+        }
+    }
+    return ok && cursor == end;
+}
+
+// A header line starts with something other than a number
+bool is_header_line(const char* line) {
+    Float64 value = 0.0;
+    const char* end = line + std::strlen(line);
+    while (line < end && (*line == ' ' || *line == '\t')) {
+        ++line;
+    }
+    return std::from_chars(line, end, value).ec != std::errc();
+}
+
+void write_csv_header(const BatchKernelSpec& spec) {
+    for (Int32 c = 0; c < spec.output_count; ++c) {
+        std::fputs(spec.output_names[c], stdout);
+        std::fputc(c + 1 < spec.output_count ? ',' : '\n', stdout);
+    }
+}
+
+// Shortest round-trip text for every value, one line per row
+void write_csv_rows(const BatchKernelSpec& spec, const BatchBuffers& buffers, Int32 rows) {
+    char line[max_batch_columns * (batch_number_max + 1)];
+    for (Int32 i = 0; i < rows; ++i) {
+        char* cursor = line;
+        for (Int32 c = 0; c < spec.output_count; ++c) {
+            std::to_chars_result written =
+                std::to_chars(cursor, cursor + batch_number_max, buffers.outputs[c][i]);
+            cursor = written.ptr;
+            *cursor = (c + 1 < spec.output_count) ? ',' : '\n';
+            ++cursor;
+        }
+        std::fwrite(line, 1, static_cast<size_t>(cursor - line), stdout);
+    }
+}
+
+Int32 run_csv(const BatchKernelSpec& spec, BatchBuffers& buffers) {
+    Int32 return_code = error_success;
+    char line[batch_line_max];
+    Int32 rows = 0;
+    Int64 line_number = 0;
+
+    write_csv_header(spec);
+
+    while (return_code == error_success && std::fgets(line, batch_line_max, stdin) != nullptr) {
+        ++line_number;
+        bool blank = (line[0] == '\n' || (line[0] == '\r' && line[1] == '\n'));
+
+        if (std::strchr(line, '\n') == nullptr && !std::feof(stdin)) {
+            std::cerr << "Error: Line " << line_number << " is too long\n";
+            return_code = error_parse_failed;
+        } else if (blank) {
+            // skip empty lines
+        } else if (!parse_csv_row(line, buffers, spec.input_count, rows)) {
+            // Only the first line may be a header
+            if (line_number != 1 || !is_header_line(line)) {
+                std::cerr << "Error: Line " << line_number << ": expected "
+                          << spec.input_count << " numbers\n";
+                return_code = error_parse_failed;
+            }
+        } else {
+            ++rows;
+            if (rows == wire_column_block_rows) {
+                spec.run(buffers.input_ptrs, buffers.output_ptrs, rows);
+                write_csv_rows(spec, buffers, rows);
+                rows = 0;
+            }
+        }
+    }
+
+    if (return_code == error_success && rows > 0) {
+        spec.run(buffers.input_ptrs, buffers.output_ptrs, rows);
+        write_csv_rows(spec, buffers, rows);
+    }
+    return return_code;
+}
+
+// ---------------------------------------------------------------------------
+// Column files (layout in wire_format.h)
+// ---------------------------------------------------------------------------
+
+bool read_exact(void* data, size_t size) {
+    return std::fread(data, 1, size, stdin) == size;
+}
+
+Uint32 load_le(const Uint8* bytes, Int32 byte_count) {
+    Uint32 value = 0;
+    for (Int32 i = 0; i < byte_count; ++i) {
+        value |= static_cast<Uint32>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+void store_le(Uint8* bytes, Uint32 value, Int32 byte_count) {
+    for (Int32 i = 0; i < byte_count; ++i) {
+        bytes[i] = static_cast<Uint8>(value >> (8 * i));
+    }
+}
+
+// Column data is Float64 little-endian; on big-endian hosts swap in place
+void swap_column_if_needed(Float64* values, Int32 rows) {
+    if constexpr (std::endian::native == std::endian::big) {
+        for (Int32 i = 0; i < rows; ++i) {
+            Uint64 bits = 0;
+            std::memcpy(&bits, &values[i], sizeof(bits));
+            bits = __builtin_bswap64(bits);
+            std::memcpy(&values[i], &bits, sizeof(bits));
+        }
+    } else {
+        (void)values;
+        (void)rows;
+    }
+}
+
+void write_column_header(Int32 column_count) {
+    Uint8 header[wire_header_size];
+    store_le(header, wire_column_magic, 4);
+    header[4] = wire_version;
+    header[5] = 0;
+    store_le(header + 6, static_cast<Uint32>(column_count), 2);
+    std::fwrite(header, 1, sizeof(header), stdout);
+}
+
+void write_column_block(const BatchKernelSpec& spec, BatchBuffers& buffers, Int32 rows) {
+    Uint8 row_count[4];
+    store_le(row_count, static_cast<Uint32>(rows), 4);
+    std::fwrite(row_count, 1, sizeof(row_count), stdout);
+    for (Int32 c = 0; c < spec.output_count; ++c) {
+        swap_column_if_needed(buffers.outputs[c].data(), rows);
+        std::fwrite(buffers.outputs[c].data(), sizeof(Float64), static_cast<size_t>(rows), stdout);
+    }
+}
+
+Int32 run_columns(const BatchKernelSpec& spec, BatchBuffers& buffers) {
+    Int32 return_code = error_success;
+    Uint8 header[wire_header_size];
+
+    if (!read_exact(header, sizeof(header)) ||
+        load_le(header, 4) != wire_column_magic || header[4] != wire_version) {
+        std::cerr << "Error: Input is not a version " << static_cast<Int32>(wire_version)
+                  << " column file\n";
+        return_code = error_bad_format;
+    } else if (static_cast<Int32>(load_le(header + 6, 2)) != spec.input_count) {
+        std::cerr << "Error: " << spec.name << " needs " << spec.input_count
+                  << " input columns, file has " << load_le(header + 6, 2) << "\n";
+        return_code = error_bad_format;
+    } else {
+        write_column_header(spec.output_count);
+
+        bool done = false;
+        while (!done && return_code == error_success) {
+            Uint8 row_count[4];
+            Uint32 rows = 0;
+            if (!read_exact(row_count, sizeof(row_count))) {
+                std::cerr << "Error: Column file ends without an end block\n";
+                return_code = error_bad_format;
+            } else {
+                rows = load_le(row_count, 4);
+                if (rows == 0) {
+                    done = true;
+                } else if (rows > static_cast<Uint32>(wire_column_block_rows)) {
+                    std::cerr << "Error: Block of " << rows << " rows exceeds "
+                              << wire_column_block_rows << "\n";
+                    return_code = error_bad_format;
+                }
+            }
+
+            for (Int32 c = 0; c < spec.input_count && !done && return_code == error_success; ++c) {
+                if (!read_exact(buffers.inputs[c].data(), rows * sizeof(Float64))) {
+                    std::cerr << "Error: Truncated column block\n";
+                    return_code = error_bad_format;
+                } else {
+                    swap_column_if_needed(buffers.inputs[c].data(), static_cast<Int32>(rows));
+                }
+            }
+
+            if (!done && return_code == error_success) {
+                spec.run(buffers.input_ptrs, buffers.output_ptrs, static_cast<Int32>(rows));
+                write_column_block(spec, buffers, static_cast<Int32>(rows));
+            }
+        }
+
+        if (return_code == error_success) {
+            Uint8 end_block[4] = {0, 0, 0, 0};
+            std::fwrite(end_block, 1, sizeof(end_block), stdout);
+        }
+    }
+    return return_code;
+}
+
+// ---------------------------------------------------------------------------
+// Flight logs (layout in flight_recorder.h)
+// ---------------------------------------------------------------------------
+
+void write_rows(const BatchKernelSpec& spec, BatchBuffers& buffers, Int32 rows, bool column_output) {
+    spec.run(buffers.input_ptrs, buffers.output_ptrs, rows);
+    if (column_output) {
+        write_column_block(spec, buffers, rows);
+    } else {
+        write_csv_rows(spec, buffers, rows);
+    }
+}
+
+Int32 run_log(const BatchKernelSpec& spec, BatchBuffers& buffers, const char* log_path, bool column_output) {
+    Int32 return_code = error_success;
+    FlightLogReader log;
+
+    if (!log.load(log_path)) {
+        std::cerr << "Error: " << log_path << " is not a version " << flight_log_version
+                  << " flight log (flight_recorder.h)\n";
+        return_code = error_bad_format;
+    } else {
+        if (column_output) {
+            write_column_header(spec.output_count);
+        } else {
+            write_csv_header(spec);
+        }
+
+        Float64 row_values[max_batch_columns];
+        Int32 rows = 0;
+        for (Int64 r = 0; r < log.record_count(); ++r) {
+            if (spec.log_row(log.record(r), row_values)) {
+                for (Int32 c = 0; c < spec.input_count; ++c) {
+                    buffers.inputs[c][rows] = row_values[c];
+                }
+                ++rows;
+                if (rows == wire_column_block_rows) {
+                    write_rows(spec, buffers, rows, column_output);
+                    rows = 0;
+                }
+            }
+        }
+        if (rows > 0) {
+            write_rows(spec, buffers, rows, column_output);
+        }
+
+        if (column_output) {
+            Uint8 end_block[4] = {0, 0, 0, 0};
+            std::fwrite(end_block, 1, sizeof(end_block), stdout);
+        }
+        if (log.dropped_count() > 0) {
+            std::cerr << "Warning: " << log_path << " lost " << log.dropped_count()
+                      << " records while recording\n";
+        }
+    }
+    return return_code;
+}
+
+} // namespace xplane_mfd::calc
+
+void print_usage(const char* program_name) {
+    using namespace xplane_mfd::calc;
+    std::cerr << "Usage: " << program_name << " [--columns] [--scalar] [--log <path>] <kernel> < input > output\n\n";
+    std::cerr << "Evaluates one output row per input row. Input is CSV (one row per line,\n";
+    std::cerr << "comma separated) or, with --columns, a column file (wire_format.h);\n";
+    std::cerr << "output uses the same format.\n";
+    std::cerr << "--log replays the kernel's sections of a mfd_calcd --record flight log\n";
+    std::cerr << "(flight_recorder.h) instead of reading stdin.\n\n";
+    std::cerr << "turn, vnav and wind run SIMD kernels (" << simd_isa_name() << " on this CPU);\n";
+    std::cerr << "--scalar uses the scalar reference kernels instead.\n\n";
+    std::cerr << "Kernels and input columns:\n";
+    std::cerr << "  envelope  bank_deg ias_kts mach vso_kts vne_kts mmo\n";
+    std::cerr << "  energy    tas_kts altitude_ft vs_fpm\n";
+    std::cerr << "  glide     agl_ft tas_kts headwind_kts\n";
+    std::cerr << "  turn      tas_kts bank_deg course_change_deg\n";
+    std::cerr << "  vnav      current_alt_ft target_alt_ft distance_nm groundspeed_kts current_vs_fpm\n";
+    std::cerr << "  wind      track heading wind_dir wind_speed\n\n";
+    std::cerr << "Example:\n";
+    std::cerr << "  printf '250,25,90\\n180,30,45\\n' | " << program_name << " turn\n";
+}
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+
+    Int32 return_code = error_success;  // Single exit point variable
+
+    bool column_mode = false;
+    bool scalar_mode = false;
+    const char* log_path = nullptr;
+    bool flags_valid = true;
+    for (Int32 i = 1; i < argc - 1; ++i) {
+        if (std::strcmp(argv[i], "--columns") == 0) {
+            column_mode = true;
+        } else if (std::strcmp(argv[i], "--scalar") == 0) {
+            scalar_mode = true;
+        } else if (std::strcmp(argv[i], "--log") == 0 && i + 2 < argc) {
+            log_path = argv[i + 1];
+            ++i;
+        } else {
+            flags_valid = false;
+        }
+    }
+
+    const BatchKernelSpec* spec = nullptr;
+    if (argc >= 2 && flags_valid) {
+        spec = find_kernel(argv[argc - 1]);
+    }
+
+    if (spec == nullptr) {
+        print_usage(argv[0]);
+        return_code = error_invalid_args;
+    } else {
+        BatchKernelSpec selected = *spec;
+        if (!scalar_mode && selected.run_simd != nullptr) {
+            selected.run = selected.run_simd;
+        }
+
+        // Block buffers are large: static storage rather than the stack
+        static BatchBuffers buffers;
+        if (log_path != nullptr) {
+            return_code = run_log(selected, buffers, log_path, column_mode);
+        } else {
+            return_code = column_mode ? run_columns(selected, buffers) : run_csv(selected, buffers);
+        }
+
+        if (std::fflush(stdout) != 0 || std::ferror(stdout) != 0) {
+            std::cerr << "Error: Failed to write output\n";
+            return_code = error_io_failed;
+        }
+    }
+
+    return return_code;  // Single exit point
+}
@@ -0,0 +1,705 @@
+// Kernel Micro-Benchmarks for X-Plane MFD Calculators
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Times every calculate_* kernel, the JSON serializers and the request
+// parsing path, and reports for each:
+//
+//   ns/op      mean time per call over all samples
+//   p99 ns     99th percentile of the per-sample mean (a sample is a short
+//              run of calls sized to take about sample_target_ns, so clock
+//              overhead stays small even for the cheapest kernels)
+//   allocs/op  calls to operator new per call (kernels must stay at 0)
+//
+// --check-allocs makes that a gate (make release runs it on the optimized
+// build): the exit code is 2 if any benchmark run made a single
+// allocation, by its raw count rather than the rounded allocs/op, or if
+// a probe allocation is not counted (a build whose calls bypass the
+// replaced operator new would otherwise report 0 everywhere).
+//
+// Inputs cycle through bench_input_count precomputed rows so the compiler
+// cannot fold the calls; results go through keep() so they are not dropped.
+// Serializers write to a stream that discards its output, which measures
+// the formatting without buffer growth.
+//
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (fixed sample storage); the
+//   replaced operator new only counts the allocations of the code under test
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+//
+// Compile: g++ -std=c++20 -O3 -o calc_bench calc_bench.cpp flight_kernels.cpp calc_io.cpp
+//          turn_kernels.cpp vnav_kernels.cpp vnav_predictor.cpp wind_kernels.cpp
+//          density_altitude_kernels.cpp aircraft_profile.cpp terrain_tiles.cpp glide_footprint.cpp
+//          wind_estimator.cpp flight_recorder.cpp
+//
+// Usage: ./calc_bench [--check-allocs] [<name filter>]
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <streambuf>
+#include "jsf_types.h"
+#include "calc_io.h"
+#include "flight_kernels.h"
+#include "aircraft_profile.h"
+#include "terrain_tiles.h"
+#include "glide_footprint.h"
+#include "turn_kernels.h"
+#include "vnav_kernels.h"
+#include "vnav_predictor.h"
+#include "wind_kernels.h"
+#include "wind_estimator.h"
+#include "flight_recorder.h"
+#include "calc_metrics.h"
+#include "density_altitude_kernels.h"
+#include "isa_table.h"
+
+// Allocation counter behind the replaced global operator new
+namespace {
+Int64 allocation_count = 0;
+}
+
+void* operator new(std::size_t size) {
+    ++allocation_count;
+    void* block = std::malloc(size == 0 ? 1 : size);
+    if (block == nullptr) {
+        std::abort();  // AV Rule 208: no std::bad_alloc
+    }
+    return block;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* block) noexcept {
+    std::free(block);
+}
+
+void operator delete[](void* block) noexcept {
+    std::free(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept {
+    std::free(block);
+}
+
+void operator delete[](void* block, std::size_t) noexcept {
+    std::free(block);
+}
+
+namespace xplane_mfd::calc {
+
+// Error codes (AV Rule 52: lowercase constants)
+const Int32 error_success = 0;
+const Int32 error_invalid_args = 1;
+const Int32 error_allocations = 2;
+
+// Sampling parameters (AV Rule 151: no magic numbers)
+const Int32 bench_samples = 2000;
+const Float64 sample_target_ns = 5000.0;
+const Int64 max_iterations_per_sample = 1 << 20;
+const Int64 warmup_iterations = 256;
+const Float64 p99_fraction = 0.99;
+const Int32 bench_input_count = 64;  // power of two (index mask below)
+const Int32 bench_input_mask = bench_input_count - 1;
+
+// Keep a result alive without letting the compiler see how it is used
+template <typename T>
+inline void keep(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+// Stream buffer that drops everything written to it
+class NullBuffer : public std::streambuf {
+protected:
+    int_type overflow(int_type c) override {
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char*, std::streamsize count) override {
+        return count;
+    }
+};
+
+NullBuffer null_buffer;
+std::ostream null_stream(&null_buffer);
+
+// ---------------------------------------------------------------------------
+// Input rows (filled once by make_inputs)
+// ---------------------------------------------------------------------------
+
+std::array<FlightInputs, bench_input_count> flight_inputs;
+std::array<WindComponents, bench_input_count> wind_results;
+std::array<TurnData, bench_input_count> turn_results;
+std::array<VNAVData, bench_input_count> vnav_results;
+std::array<DensityAltitudeData, bench_input_count> density_results;
+std::array<FlightResults, bench_input_count> flight_results;
+IasHistoryBuffer ias_history;
+ResidentFlightState resident_state;
+
+// A descent from FL350 over three constraints and four wind layers
+VnavPredictor vnav_predictor;
+VnavDescentSettings vnav_settings = {35000.0, 500.0, 0.78, 280.0, 250.0, 10000.0, 2200.0, 3.0, 6.0, 0.0};
+const VnavConstraint vnav_constraints[] = {
+    {12.0, 4000.0, 3000.0}, {30.0, 11000.0, 9000.0}, {60.0, 24000.0, 0.0}
+};
+VnavWindLayer vnav_winds[] = {
+    {0.0, 5.0}, {10000.0, 20.0}, {20000.0, 40.0}, {35000.0, 60.0}
+};
+const Int32 vnav_constraint_count = 3;
+const Int32 vnav_wind_count = 4;
+Int64 vnav_changes = 0;  // alternates the changed input across samples
+
+// A 16-point L/D table, attached in place as a mapped file would be
+const Int32 bench_profile_points = 16;
+struct BenchProfileImage {
+    AircraftProfileHeader header;
+    std::array<AircraftProfilePoint, bench_profile_points> points;
+};
+BenchProfileImage bench_profile_image;
+AircraftProfile bench_profile;
+ResidentFlightState profiled_state;
+
+// A 64 x 64 tile of rolling terrain under the footprint, attached in place
+const Int32 bench_terrain_samples = 64;
+struct BenchTerrainImage {
+    TerrainTileHeader header;
+    std::array<Int16, bench_terrain_samples * bench_terrain_samples> elevation_ft;
+};
+BenchTerrainImage bench_terrain_image;
+TerrainTileCache bench_terrain;
+GlideFootprint bench_footprint;
+const FootprintInputs footprint_inputs = {47.0, 11.0, 12000.0, 200.0, 240.0, 270.0, 30.0};
+Int64 footprint_changes = 0;  // alternates the sweep altitude across samples
+
+// A filter fed 10 Hz samples through a climb, and the profile it fills
+WindEstimator bench_wind_estimator;
+WindProfileStore bench_wind_profile;
+Float64 wind_sample_time_s = 0.0;
+
+// The flight recorder's queue, filled as mfd_calcd fills it per section and
+// emptied as its flusher takes records for the file
+FlightLogRing bench_log_ring;
+FlightLogRecord bench_log_record;
+
+// One flight request as argv strings and as a --serve line
+const char* const flight_argv[flight_input_count] = {
+    "250", "245", "90", "95", "220", "0.65", "35000",
+    "35000", "-500", "75000", "5", "120", "250", "0.82"
+};
+const char flight_line[] = "250 245 90 95 220 0.65 35000 35000 -500 75000 5 120 250 0.82";
+
+void make_inputs() {
+    for (Int32 i = 0; i < bench_input_count; ++i) {
+        Float64 step = static_cast<Float64>(i);
+        FlightInputs& in = flight_inputs[i];
+        in.tas_kts = 180.0 + 4.0 * step;
+        in.gs_kts = 170.0 + 5.0 * step;
+        in.heading = 5.5 * step;
+        in.track = 5.5 * step + 3.0;
+        in.ias_kts = 150.0 + 2.0 * step;
+        in.mach = 0.3 + 0.008 * step;
+        in.altitude_ft = 2000.0 + 500.0 * step;
+        in.agl_ft = 1500.0 + 400.0 * step;
+        in.vs_fpm = -1500.0 + 50.0 * step;
+        in.weight_kg = 60000.0;
+        in.bank_deg = -30.0 + step;
+        in.vso_kts = 110.0;
+        in.vne_kts = 340.0;
+        in.mmo = 0.82;
+    }
+    seed_ias_history(ias_history);
+
+    for (Int32 i = 0; i < bench_input_count; ++i) {
+        const FlightInputs& in = flight_inputs[i];
+        wind_results[i] = calculate_wind(in.track, in.heading, in.heading + 40.0, 25.0);
+        turn_results[i] = calculate_turn_performance(in.tas_kts, 25.0, in.heading);
+        vnav_results[i] = calculate_vnav(in.altitude_ft + 10000.0, in.altitude_ft, 100.0,
+                                         in.gs_kts, in.vs_fpm);
+        density_results[i] = calculate_density_altitude_data(in.altitude_ft / 4.0, 15.0,
+                                                              in.ias_kts, in.tas_kts);
+        flight_results[i] = calculate_flight(in, ias_history);
+    }
+
+    bench_profile_image.header = {aircraft_profile_magic, aircraft_profile_version, bench_profile_points, 0,
+                                  110.0, 340.0, 0.82};
+    for (Int32 i = 0; i < bench_profile_points; ++i) {
+        Float64 offset = static_cast<Float64>(i - 6);
+        bench_profile_image.points[i] = {120.0 + 10.0 * i, 17.0 - 0.04 * offset * offset};
+    }
+    bench_profile.attach(&bench_profile_image, static_cast<Int64>(sizeof(bench_profile_image)));
+
+    bench_terrain_image.header = {terrain_tile_magic, terrain_tile_version, bench_terrain_samples,
+                                  bench_terrain_samples, 46.0, 10.0, 2.0 / bench_terrain_samples};
+    for (Int32 r = 0; r < bench_terrain_samples; ++r) {
+        for (Int32 c = 0; c < bench_terrain_samples; ++c) {
+            bench_terrain_image.elevation_ft[r * bench_terrain_samples + c] =
+                static_cast<Int16>(2000 + 1500 * ((r * 7 + c * 3) % 5));
+        }
+    }
+    bench_terrain.attach(&bench_terrain_image, static_cast<Int64>(sizeof(bench_terrain_image)));
+    bench_footprint.update(footprint_inputs, &bench_terrain, &bench_profile);
+
+    for (Int32 i = 0; i < bench_input_count; ++i) {
+        const FlightInputs& in = flight_inputs[i];
+        wind_sample_time_s += 0.1;
+        bench_wind_estimator.update({wind_sample_time_s, in.altitude_ft, in.tas_kts, in.gs_kts, in.heading, in.track});
+        bench_wind_profile.record(in.altitude_ft, bench_wind_estimator);
+    }
+
+    vnav_predictor.set_settings(vnav_settings);
+    vnav_predictor.set_constraints(vnav_constraints, vnav_constraint_count);
+    vnav_predictor.set_wind_layers(vnav_winds, vnav_wind_count);
+    vnav_predictor.advance(vnav_max_steps);
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark bodies: each runs its operation iterations times
+// ---------------------------------------------------------------------------
+
+void bench_calculate_wind(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        const FlightInputs& in = flight_inputs[n & bench_input_mask];
+        keep(calculate_wind(in.track, in.heading, in.heading + 40.0, 25.0));
+    }
+}
+
+void bench_calculate_wind_vector(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        const FlightInputs& in = flight_inputs[n & bench_input_mask];
+        keep(calculate_wind_vector(in.tas_kts, in.gs_kts, in.heading, in.track, ias_history));
+    }
+}
+
+void bench_calculate_envelope(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        const FlightInputs& in = flight_inputs[n & bench_input_mask];
+        keep(calculate_envelope(in.bank_deg, in.ias_kts, in.mach, in.vso_kts, in.vne_kts, in.mmo));
+    }
+}
+
+void bench_calculate_energy(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        const FlightInputs& in = flight_inputs[n & bench_input_mask];
+        keep(calculate_energy(in.tas_kts, in.altitude_ft, in.vs_fpm));
+    }
+}
+
+void bench_calculate_glide_reach(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        const FlightInputs& in = flight_inputs[n & bench_input_mask];
+        keep(calculate_glide_reach(in.agl_ft, in.tas_kts, in.vs_fpm / 100.0));
+    }
+}
+
+void bench_calculate_glide_reach_profile(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        const FlightInputs& in = flight_inputs[n & bench_input_mask];
+        keep(calculate_glide_reach(bench_profile, in.agl_ft, in.ias_kts, in.tas_kts, in.vs_fpm / 100.0));
+    }
+}
+
+// Every radial again: each sample climbs past the altitude threshold
+void bench_glide_footprint_sweep(Int64 iterations) {
+    FootprintInputs in = footprint_inputs;
+    for (Int64 n = 0; n < iterations; ++n) {
+        in.altitude_ft = footprint_inputs.altitude_ft + ((++footprint_changes & 1) == 0 ? 200.0 : 0.0);
+        keep(bench_footprint.update(in, &bench_terrain, &bench_profile));
+    }
+}
+
+// A frame that stays within the thresholds and keeps the last sweep
+void bench_glide_footprint_hold(Int64 iterations) {
+    FootprintInputs in = footprint_inputs;
+    bench_footprint.update(in, &bench_terrain, &bench_profile);
+    for (Int64 n = 0; n < iterations; ++n) {
+        in.altitude_ft = footprint_inputs.altitude_ft + static_cast<Float64>(n & 7);
+        keep(bench_footprint.update(in, &bench_terrain, &bench_profile));
+    }
+}
+
+void bench_wind_estimator_update(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        const FlightInputs& in = flight_inputs[n & bench_input_mask];
+        wind_sample_time_s += 0.1;
+        keep(bench_wind_estimator.update({wind_sample_time_s, in.altitude_ft, in.tas_kts, in.gs_kts,
+                                          in.heading, in.track}));
+        bench_wind_profile.record(in.altitude_ft, bench_wind_estimator);
+        keep(bench_wind_estimator.estimate());
+    }
+}
+
+void bench_wind_profile_vnav_layers(Int64 iterations) {
+    std::array<VnavWindLayer, vnav_max_wind_layers> layers;
+    for (Int64 n = 0; n < iterations; ++n) {
+        keep(bench_wind_profile.vnav_layers(flight_inputs[n & bench_input_mask].track, layers.data(),
+                                            vnav_max_wind_layers));
+        keep(layers);
+    }
+}
+
+// One flight section queued and taken off again: the compute path's record
+// cost plus the flusher's copy, without the file write
+void bench_flight_log_ring_push_pop(Int64 iterations) {
+    FlightLogRecord record = {};
+    for (Int64 n = 0; n < iterations; ++n) {
+        const FlightInputs& in = flight_inputs[n & bench_input_mask];
+        record.section = flight_log_section_flight;
+        record.value_count = static_cast<Uint32>(flight_input_count);
+        std::memcpy(record.values, &in, sizeof(in));
+        std::memcpy(record.result, &flight_results[n & bench_input_mask], sizeof(FlightResults));
+        keep(bench_log_ring.push(record, n));
+        keep(bench_log_ring.pop(bench_log_record));
+    }
+}
+
+// What a timed section costs the daemon on top of its kernel: two clock
+// reads, the call count and histogram bucket, and an input branch check
+void bench_metrics_kernel_call(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        const FlightInputs& in = flight_inputs[n & bench_input_mask];
+        Int64 start_ns = metrics_now_ns();
+        metrics_count_turn_inputs(in.bank_deg);
+        metrics_kernel_call(metric_kernel_turn, metrics_now_ns() - start_ns);
+    }
+}
+
+void bench_calculate_turn_performance(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        const FlightInputs& in = flight_inputs[n & bench_input_mask];
+        keep(calculate_turn_performance(in.tas_kts, 25.0, in.heading));
+    }
+}
+
+void bench_calculate_vnav(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        const FlightInputs& in = flight_inputs[n & bench_input_mask];
+        keep(calculate_vnav(in.altitude_ft + 10000.0, in.altitude_ft, 100.0, in.gs_kts, in.vs_fpm));
+    }
+}
+
+// Whole profile: an ISA deviation change invalidates every step
+void bench_vnav_predictor_full_profile(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        vnav_settings.isa_deviation_c = (++vnav_changes & 1) == 0 ? 0.5 : 0.0;
+        vnav_predictor.set_settings(vnav_settings);
+        keep(vnav_predictor.advance(vnav_max_steps));
+    }
+}
+
+// One display frame after the top wind layer changes: only the steps
+// above the layer below it are integrated again
+void bench_vnav_predictor_upper_wind_frame(Int64 iterations) {
+    VnavPrediction prediction;
+    for (Int64 n = 0; n < iterations; ++n) {
+        vnav_winds[vnav_wind_count - 1].headwind_kts = (++vnav_changes & 1) == 0 ? 61.0 : 60.0;
+        vnav_predictor.set_wind_layers(vnav_winds, vnav_wind_count);
+        keep(vnav_predictor.advance(vnav_max_steps));
+        keep(vnav_predictor.predict(80.0 + static_cast<Float64>(n & bench_input_mask), 30000.0, prediction));
+        keep(prediction);
+    }
+}
+
+void bench_vnav_predictor_predict(Int64 iterations) {
+    VnavPrediction prediction;
+    for (Int64 n = 0; n < iterations; ++n) {
+        const FlightInputs& in = flight_inputs[n & bench_input_mask];
+        keep(vnav_predictor.predict(in.agl_ft / 200.0, in.altitude_ft, prediction));
+        keep(prediction);
+    }
+}
+
+void bench_calculate_density_altitude_data(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        const FlightInputs& in = flight_inputs[n & bench_input_mask];
+        keep(calculate_density_altitude_data(in.altitude_ft / 4.0, 15.0, in.ias_kts, in.tas_kts));
+    }
+}
+
+// Table lookups over the altitudes the density kernel sees
+void bench_isa_pressure_ratio(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        keep(isa_pressure_ratio(flight_inputs[n & bench_input_mask].altitude_ft / 4.0));
+    }
+}
+
+void bench_isa_density_ratio(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        keep(isa_density_ratio(flight_inputs[n & bench_input_mask].altitude_ft / 4.0));
+    }
+}
+
+void bench_calculate_flight(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        keep(calculate_flight(flight_inputs[n & bench_input_mask], ias_history));
+    }
+}
+
+// Resident path on a steady input (cruise): wind recomputed, the other
+// three results served from the cache
+void bench_calculate_flight_sample_steady(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        keep(calculate_flight_sample(flight_inputs[0], resident_state));
+    }
+}
+
+// Profiled resident path (mfd_calcd dynamic section) on changing inputs:
+// every cached result misses
+void bench_calculate_flight_sample_profile(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        keep(calculate_flight_sample(flight_inputs[n & bench_input_mask], profiled_state, bench_profile));
+    }
+}
+
+void bench_print_json_wind(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        print_json(null_stream, wind_results[n & bench_input_mask], true);
+    }
+}
+
+void bench_print_json_turn(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        print_json(null_stream, turn_results[n & bench_input_mask], true);
+    }
+}
+
+void bench_print_json_vnav(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        print_json(null_stream, vnav_results[n & bench_input_mask], true);
+    }
+}
+
+void bench_print_json_density(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        print_json(null_stream, density_results[n & bench_input_mask], true);
+    }
+}
+
+void bench_print_json_results(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        print_json_results(null_stream, flight_results[n & bench_input_mask], true);
+    }
+}
+
+void bench_print_binary_results(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        print_binary_results(null_stream, flight_results[n & bench_input_mask]);
+    }
+}
+
+void bench_parse_float64(Int64 iterations) {
+    for (Int64 n = 0; n < iterations; ++n) {
+        Float64 value = 0.0;
+        keep(parse_float64(flight_argv[n % flight_input_count], value));
+        keep(value);
+    }
+}
+
+// One-shot path: argv strings to FlightInputs
+void bench_parse_flight_inputs(Int64 iterations) {
+    FlightInputs inputs;
+    for (Int64 n = 0; n < iterations; ++n) {
+        keep(parse_flight_inputs(flight_argv, inputs));
+        keep(inputs);
+    }
+}
+
+// --serve path: split a request line in place, then parse its fields
+void bench_split_and_parse_line(Int64 iterations) {
+    char line[sizeof(flight_line)];
+    const char* fields[flight_input_count];
+    FlightInputs inputs;
+    for (Int64 n = 0; n < iterations; ++n) {
+        std::memcpy(line, flight_line, sizeof(flight_line));
+        keep(split_fields(line, fields, flight_input_count));
+        keep(parse_flight_inputs(fields, inputs));
+        keep(inputs);
+    }
+}
+
+typedef void (*BenchBody)(Int64 iterations);
+
+struct BenchCase {
+    const char* name;
+    BenchBody body;
+};
+
+const Int32 bench_case_count = 32;
+
+const BenchCase bench_cases[bench_case_count] = {
+    {"calculate_wind", bench_calculate_wind},
+    {"calculate_wind_vector", bench_calculate_wind_vector},
+    {"wind_estimator/update", bench_wind_estimator_update},
+    {"wind_profile/vnav_layers", bench_wind_profile_vnav_layers},
+    {"calculate_envelope", bench_calculate_envelope},
+    {"calculate_energy", bench_calculate_energy},
+    {"calculate_glide_reach", bench_calculate_glide_reach},
+    {"calculate_glide_reach/profile", bench_calculate_glide_reach_profile},
+    {"glide_footprint/sweep", bench_glide_footprint_sweep},
+    {"glide_footprint/hold", bench_glide_footprint_hold},
+    {"calculate_turn_performance", bench_calculate_turn_performance},
+    {"calculate_vnav", bench_calculate_vnav},
+    {"vnav_predictor/full_profile", bench_vnav_predictor_full_profile},
+    {"vnav_predictor/upper_wind_frame", bench_vnav_predictor_upper_wind_frame},
+    {"vnav_predictor/predict", bench_vnav_predictor_predict},
+    {"calculate_density_altitude_data", bench_calculate_density_altitude_data},
+    {"isa_pressure_ratio", bench_isa_pressure_ratio},
+    {"isa_density_ratio", bench_isa_density_ratio},
+    {"calculate_flight", bench_calculate_flight},
+    {"calculate_flight_sample/steady", bench_calculate_flight_sample_steady},
+    {"calculate_flight_sample/profile", bench_calculate_flight_sample_profile},
+    {"print_json/wind", bench_print_json_wind},
+    {"print_json/turn", bench_print_json_turn},
+    {"print_json/vnav", bench_print_json_vnav},
+    {"print_json/density", bench_print_json_density},
+    {"print_json_results", bench_print_json_results},
+    {"print_binary_results", bench_print_binary_results},
+    {"flight_log_ring/push+pop", bench_flight_log_ring_push_pop},
+    {"metrics/kernel_call", bench_metrics_kernel_call},
+    {"parse_float64", bench_parse_float64},
+    {"parse_flight_inputs", bench_parse_flight_inputs},
+    {"split_fields+parse_flight_inputs", bench_split_and_parse_line}
+};
+
+// ---------------------------------------------------------------------------
+// Harness
+// ---------------------------------------------------------------------------
+
+struct BenchResult {
+    Float64 ns_per_op;
+    Float64 p99_ns;
+    Float64 allocs_per_op;
+    Int64 allocations;
+    Int64 iterations;
+};
+
+Float64 time_sample_ns(BenchBody body, Int64 iterations) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    body(iterations);
+    std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+    return static_cast<Float64>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+}
+
+// Warm caches and branch predictors, then double the sample size until one
+// sample takes sample_target_ns
+Int64 calibrate_iterations(BenchBody body) {
+    body(warmup_iterations);
+
+    Int64 iterations = 1;
+    while (iterations < max_iterations_per_sample &&
+           time_sample_ns(body, iterations) < sample_target_ns) {
+        iterations *= 2;
+    }
+    return iterations;
+}
+
+BenchResult run_bench(BenchBody body) {
+    // AV Rule 206: sample storage is fixed
+    static std::array<Float64, bench_samples> sample_ns_per_op;
+
+    BenchResult result;
+    Int64 iterations = calibrate_iterations(body);
+    Float64 total_ns = 0.0;
+
+    Int64 allocations_before = allocation_count;
+    for (Int32 s = 0; s < bench_samples; ++s) {
+        Float64 sample_ns = time_sample_ns(body, iterations);
+        total_ns += sample_ns;
+        sample_ns_per_op[s] = sample_ns / static_cast<Float64>(iterations);
+    }
+    Int64 allocations = allocation_count - allocations_before;
+
+    result.iterations = iterations * bench_samples;
+    result.ns_per_op = total_ns / static_cast<Float64>(result.iterations);
+    result.allocations = allocations;
+    result.allocs_per_op = static_cast<Float64>(allocations) / static_cast<Float64>(result.iterations);
+
+    Int32 p99_index = static_cast<Int32>(p99_fraction * (bench_samples - 1));
+    std::nth_element(sample_ns_per_op.begin(), sample_ns_per_op.begin() + p99_index,
+                     sample_ns_per_op.end());
+    result.p99_ns = sample_ns_per_op[p99_index];
+    return result;
+}
+
+void print_result_line(const char* name, const BenchResult& result) {
+    std::printf("%-34s %10.1f %10.1f %10.2f %12lld\n", name, result.ns_per_op, result.p99_ns,
+                result.allocs_per_op, static_cast<long long>(result.iterations));
+}
+
+// One allocation through the replaced operator new must be counted, or a
+// count of 0 proves nothing. The volatile pointer keeps the pair from being
+// elided.
+bool allocation_counter_live() {
+    Int64 before = allocation_count;
+    Float64* volatile probe = new Float64(1.0);
+    delete probe;
+    return allocation_count == before + 1;
+}
+
+} // namespace xplane_mfd::calc
+
+void print_usage(const char* program_name) {
+    std::cerr << "Usage: " << program_name << " [--check-allocs] [<name filter>]\n\n";
+    std::cerr << "Runs every benchmark whose name contains the filter (all by default)\n";
+    std::cerr << "and prints ns/op, p99 ns and allocs/op for each.\n";
+    std::cerr << "--check-allocs exits with 2 if any of them allocated at all.\n\n";
+    std::cerr << "Example:\n";
+    std::cerr << "  " << program_name << " calculate_\n";
+}
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+
+    Int32 return_code = error_success;  // Single exit point variable
+    bool check_allocs = argc >= 2 && std::strcmp(argv[1], "--check-allocs") == 0;
+    Int32 first_arg = check_allocs ? 2 : 1;
+    const char* filter = (argc == first_arg + 1) ? argv[first_arg] : "";
+
+    if (argc > first_arg + 1 || (argc == first_arg + 1 && argv[first_arg][0] == '-')) {
+        print_usage(argv[0]);
+        return_code = error_invalid_args;
+    } else if (check_allocs && !allocation_counter_live()) {
+        std::cerr << "Error: The allocation counter does not see operator new in this build\n";
+        return_code = error_allocations;
+    } else {
+        make_inputs();
+        std::printf("%-34s %10s %10s %10s %12s\n", "Benchmark", "ns/op", "p99 ns", "allocs/op",
+                    "iterations");
+
+        Int32 matched = 0;
+        Int32 allocating = 0;
+        for (Int32 i = 0; i < bench_case_count; ++i) {
+            if (std::strstr(bench_cases[i].name, filter) != nullptr) {
+                BenchResult result = run_bench(bench_cases[i].body);
+                print_result_line(bench_cases[i].name, result);
+                std::fflush(stdout);
+                ++matched;
+                if (check_allocs && result.allocations != 0) {
+                    std::cerr << "Error: " << bench_cases[i].name << " made " << result.allocations
+                              << " allocations\n";
+                    ++allocating;
+                }
+            }
+        }
+
+        if (matched == 0) {
+            std::cerr << "Error: No benchmark matches '" << filter << "'\n";
+            return_code = error_invalid_args;
+        } else if (allocating > 0) {
+            return_code = error_allocations;
+        }
+    }
+
+    return return_code;  // Single exit point
+}
@@ -0,0 +1,164 @@
+// Request I/O Helpers for X-Plane MFD Calculators
+// JSF AV C++ Coding Standard Compliant Version
+//
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try)
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 126: C++ style comments only (//)
+
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <system_error>
+#include "calc_io.h"
+
+namespace xplane_mfd::calc {
+
+namespace {
+
+bool is_separator(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// from_chars takes no leading '+', which strtod did; skip one unless a
+// sign follows it
+const char* skip_plus_sign(const char* str) {
+    const char* start = str;
+    if (start[0] == '+' && start[1] != '-' && start[1] != '+') {
+        ++start;
+    }
+    return start;
+}
+
+// from_chars over a NUL-terminated field: true if it consumed all of it
+template <typename Number>
+bool parse_whole_field(const char* str, Number& result) {
+    const char* start = skip_plus_sign(str);
+    const char* end = start + std::strlen(start);
+    std::from_chars_result parsed = std::from_chars(start, end, result);
+    return parsed.ec == std::errc() && parsed.ptr == end && end != start;
+}
+
+} // namespace
+
+bool parse_float64(const char* str, Float64& result) {
+    return parse_whole_field(str, result);
+}
+
+bool parse_int64(const char* str, Int64& result) {
+    return parse_whole_field(str, result);
+}
+
+void TextWriter::put(const char* text) {
+    Int32 remaining = static_cast<Int32>(std::strlen(text));
+    while (remaining > 0) {
+        if (length_ == text_writer_capacity) {
+            flush();
+        }
+        Int32 chunk = text_writer_capacity - length_;
+        if (chunk > remaining) {
+            chunk = remaining;
+        }
+        std::memcpy(buffer_ + length_, text, static_cast<size_t>(chunk));
+        length_ += chunk;
+        text += chunk;
+        remaining -= chunk;
+    }
+}
+
+void TextWriter::put_fixed(Float64 value) {
+    if (text_writer_capacity - length_ < text_number_max) {
+        flush();
+    }
+    std::to_chars_result written = std::to_chars(buffer_ + length_, buffer_ + text_writer_capacity,
+                                                 value, std::chars_format::fixed, 2);
+    length_ = static_cast<Int32>(written.ptr - buffer_);
+}
+
+void TextWriter::put_int(Int64 value) {
+    if (text_writer_capacity - length_ < text_number_max) {
+        flush();
+    }
+    std::to_chars_result written = std::to_chars(buffer_ + length_, buffer_ + text_writer_capacity, value);
+    length_ = static_cast<Int32>(written.ptr - buffer_);
+}
+
+void TextWriter::flush() {
+    if (length_ > 0) {
+        out_.write(buffer_, length_);
+        length_ = 0;
+    }
+}
+
+namespace {
+
+void put_member_name(TextWriter& text, const char* indent, const char* name) {
+    text.put(indent);
+    text.put('"');
+    text.put(name);
+    text.put("\": ");
+}
+
+void put_member_end(TextWriter& text, bool last, const char* nl) {
+    if (!last) {
+        text.put(',');
+    }
+    text.put(nl);
+}
+
+} // namespace
+
+void put_json_member(TextWriter& text, const char* indent, const char* name, Float64 value,
+                     bool last, const char* nl) {
+    put_member_name(text, indent, name);
+    text.put_fixed(value);
+    put_member_end(text, last, nl);
+}
+
+void put_json_integer(TextWriter& text, const char* indent, const char* name, Int64 value,
+                      bool last, const char* nl) {
+    put_member_name(text, indent, name);
+    text.put_int(value);
+    put_member_end(text, last, nl);
+}
+
+void put_json_object_start(TextWriter& text, const char* indent, const char* name, const char* nl) {
+    put_member_name(text, indent, name);
+    text.put('{');
+    text.put(nl);
+}
+
+void put_json_object_end(TextWriter& text, const char* indent, bool last, const char* nl) {
+    text.put(indent);
+    text.put('}');
+    put_member_end(text, last, nl);
+}
+
+Int32 split_fields(char* line, const char** fields, Int32 max_fields) {
+    Int32 count = 0;
+    char* cursor = line;
+    while (*cursor != '\0' && count <= max_fields) {
+        while (is_separator(*cursor)) {
+            *cursor = '\0';
+            ++cursor;
+        }
+        if (*cursor != '\0') {
+            if (count < max_fields) {
+                fields[count] = cursor;
+            }
+            ++count;
+            while (*cursor != '\0' && !is_separator(*cursor)) {
+                ++cursor;
+            }
+        }
+    }
+    return count;
+}
+
+Float64 monotonic_us() {
+    std::chrono::steady_clock::duration since_epoch = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration<Float64, std::micro>(since_epoch).count();
+}
+
+} // namespace xplane_mfd::calc
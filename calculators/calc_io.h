@@ -0,0 +1,92 @@
+// Request I/O Helpers for X-Plane MFD Calculators
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Text helpers shared by every calculator front end: argv and request
+// parsing, and the JSON writers. Numbers go through std::from_chars and
+// std::to_chars, which ignore the locale, and text is built in a fixed
+// buffer, so parsing and formatting never allocate.
+//
+// AV Rule 126: C++ style comments only (//)
+
+#ifndef CALC_IO_H
+#define CALC_IO_H
+
+#include <ostream>
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+// JSF-compliant parse functions: true if all of str is a number. Decimal
+// or exponent notation with an optional sign, plus "inf"/"nan", as strtod
+// reads them in the C locale. Hexadecimal floats and values outside the
+// Float64 range are rejected rather than rounded to inf or zero.
+bool parse_float64(const char* str, Float64& result);
+bool parse_int64(const char* str, Int64& result);
+
+// Size of TextWriter's buffer; one number in fixed notation (up to 309
+// integer digits for a Float64) always fits after a flush
+const Int32 text_writer_capacity = 1024;
+const Int32 text_number_max = 320;
+
+// Builds output text in a fixed buffer and hands it to out in one write
+// when the buffer fills or on flush(). Numbers are formatted with
+// std::to_chars: put_fixed matches iostream std::fixed with
+// setprecision(2), byte for byte. A stream that fails (a full FixedBuffer)
+// stays failed, as with operator<<.
+class TextWriter {
+public:
+    explicit TextWriter(std::ostream& out) : out_(out), length_(0) {}
+    ~TextWriter() { flush(); }
+
+    TextWriter(const TextWriter&) = delete;
+    TextWriter& operator=(const TextWriter&) = delete;
+
+    void put(char c) {
+        if (length_ == text_writer_capacity) {
+            flush();
+        }
+        buffer_[length_] = c;
+        ++length_;
+    }
+
+    void put(const char* text);
+
+    // Fixed notation, two decimals (the JSON outputs' format)
+    void put_fixed(Float64 value);
+
+    void put_int(Int64 value);
+
+    // Write the buffered text to the stream
+    void flush();
+
+private:
+    std::ostream& out_;
+    Int32 length_;
+    char buffer_[text_writer_capacity];
+};
+
+// One JSON member: indent, "name": value, a comma unless it is the last
+// member, then nl (empty for single-line output)
+void put_json_member(TextWriter& text, const char* indent, const char* name, Float64 value,
+                     bool last, const char* nl);
+void put_json_integer(TextWriter& text, const char* indent, const char* name, Int64 value,
+                      bool last, const char* nl);
+
+// A member that holds an object: indent, "name": {, then nl; and the
+// closing brace, with a comma unless it is the last member
+void put_json_object_start(TextWriter& text, const char* indent, const char* name, const char* nl);
+void put_json_object_end(TextWriter& text, const char* indent, bool last, const char* nl);
+
+// Split line in place on spaces/tabs/CR; returns the number of fields found.
+// At most max_fields pointers are stored, but counting continues one past
+// max_fields so callers can detect extra fields.
+// AV Rule 206: no allocation, the fields point into line.
+Int32 split_fields(char* line, const char** fields, Int32 max_fields);
+
+// Steady-clock time in microseconds from an arbitrary fixed point; the
+// difference of two readings is a server's compute_us
+Float64 monotonic_us();
+
+} // namespace xplane_mfd::calc
+
+#endif // CALC_IO_H
@@ -0,0 +1,923 @@
+// Load Generator for the X-Plane MFD Calculator Daemon
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Measures how many frames per second, and how many concurrent displays,
+// one machine can serve. Each client is a thread that sends frames at a
+// fixed rate (or back to back with --rate 0) through one interface:
+//
+//   --socket <path>   mfd_calcd's Unix socket, one connection per client;
+//                     a frame is one request line, answered by one reply line
+//                     (with --binary, by wire_format.h records up to the
+//                     reply record)
+//   --shm <path>      mfd_calcd's shared-memory channel (shm_channel.h);
+//                     one client only, flight/turn/vnav/density sections
+//   --in-process      the calculator library's C API (xpmfd_calc.h) on the
+//                     client's thread, one flight state per client; no
+//                     footprint or dynamic sections. As a display's wind
+//                     and VNAV pages, a flight section also feeds the
+//                     state's wind estimator, and a vnav section advances
+//                     the client's descent predictor on the state's wind
+//                     profile and looks the aircraft up on it.
+//
+// Frames come from one of two deterministic sources, so two runs with the
+// same arguments send the same bytes:
+//
+//   --synthetic       (default) a flight envelope per client, seeded from
+//                     the calculator test fixtures: a 30 minute climb to
+//                     FL350, cruise and descent, weaving +-25 degrees of
+//                     bank, sampled every synthetic_step_s of flight time
+//                     with --seed noise on speeds and heading. A frame is
+//                     the flight, turn, vnav and density sections of the
+//                     client's own aircraft (client n is aircraft n + 1).
+//                     --dynamic sends a dynamic section in place of the
+//                     flight section, for a mfd_calcd --profile daemon.
+//                     --hold <n> sends each sample n times in a row, as a
+//                     display refreshing faster than its data changes.
+//   --log <path>      a mfd_calcd --record flight log (flight_recorder.h),
+//                     each recorded section replayed as a frame of its own
+//                     with its recorded aircraft, from the top again at
+//                     the end
+//
+// Frame k of a client is due at start + k / rate. A client still waiting
+// for a reply when a frame is more than one period overdue drops that frame
+// (as a display missing its refresh) and moves on to the next due one;
+// a frame sent late but within its period counts its latency. The run ends
+// after --frames due frames per client (default 1000) or --duration
+// seconds.
+//
+// The report gives frames sent, answered, dropped, failed (timeouts,
+// request errors, lost connections) and skipped (nothing the interface can
+// compute), throughput in answered frames per second, and the latency of
+// answered frames, send to reply, as mean and percentiles: text, or one
+// JSON line with --json. --dry-run writes the socket request lines of
+// every client instead of sending them.
+//
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (fixed client table, request
+//   and reply buffers; client threads started once)
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+//
+// Compile: g++ -std=c++20 -O3 -pthread -o calc_loadgen calc_loadgen.cpp xpmfd_calc.cpp calc_io.cpp
+//          flight_kernels.cpp turn_kernels.cpp vnav_kernels.cpp vnav_predictor.cpp wind_kernels.cpp
+//          density_altitude_kernels.cpp aircraft_profile.cpp wind_estimator.cpp flight_recorder.cpp
+//
+// Usage: ./calc_loadgen (--socket <path> | --shm <path> | --in-process | --dry-run)
+//                       [--synthetic [--dynamic] [--hold <n>] | --log <path>] [--binary]
+//                       [--clients <n>] [--rate <hz>] [--frames <n>] [--duration <s>]
+//                       [--seed <n>] [--json]
+
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "jsf_types.h"
+#include "calc_io.h"
+#include "flight_recorder.h"
+#include "latency_histogram.h"
+#include "shm_channel.h"
+#include "wire_format.h"
+#include "xpmfd_calc.h"
+
+namespace xplane_mfd::calc {
+
+// Error codes (AV Rule 52: lowercase)
+const Int32 error_success = 0;
+const Int32 error_invalid_args = 1;
+const Int32 error_bad_format = 3;
+const Int32 error_io_failed = 4;
+
+// Interfaces
+const Int32 interface_socket = 0;
+const Int32 interface_shm = 1;
+const Int32 interface_in_process = 2;
+const Int32 interface_dry_run = 3;
+
+// Fixed limits (AV Rule 206: no dynamic allocation)
+const Int32 max_loadgen_clients = 64;
+const Int32 max_frame_sections = 4;
+const Int32 request_line_max = 2048;
+const Int32 reply_line_max = 65536;
+const Int32 reply_timeout_ms = 2000;
+const Int32 number_text_max = 32;      // longest to_chars output for a Float64
+const Int64 default_frames = 1000;
+const Int32 start_delay_ms = 20;       // lets every client connect before the first frame is due
+
+// In-process VNAV page: a descent from the synthetic cruise level, and
+// the predictor steps integrated per frame
+const XpmfdVnavSettings in_process_vnav_settings = {35000.0, 500.0, 0.78, 280.0, 250.0, 10000.0, 2200.0,
+                                                    3.0, 6.0, 0.0};
+const Int32 in_process_vnav_steps = 32;
+
+// Synthetic envelope
+const Float64 synthetic_step_s = 0.1;
+const Float64 synthetic_phase_s = 600.0;     // climb, cruise and descent each
+const Float64 synthetic_client_offset_s = 37.0;
+const Float64 synthetic_weave_period_s = 120.0;
+const Float64 synthetic_low_ft = 2000.0;
+const Float64 synthetic_cruise_ft = 35000.0;
+const Float64 two_pi = 6.283185307179586;
+
+// Section names and field counts, indexed by flight_log_section_*
+struct LoadSectionSpec {
+    const char* name;
+    Int32 field_count;
+};
+
+const Int32 load_section_kinds = 7;
+const LoadSectionSpec load_section_specs[load_section_kinds] = {
+    {"flight", 14}, {"turn", 3}, {"vnav", 5}, {"density", 5}, {"dynamic", 11}, {"footprint", 8},
+    {"wind_estimate", 6}
+};
+
+struct LoadSection {
+    Int32 kind;
+    Float64 values[flight_log_max_values];
+};
+
+struct LoadFrame {
+    bool has_aircraft;
+    Int64 aircraft_id;
+    Int32 section_count;
+    LoadSection sections[max_frame_sections];
+};
+
+struct LoadConfig {
+    Int32 interface;
+    const char* path;
+    const FlightLogReader* log;  // null: synthetic
+    bool dynamic;                // synthetic: dynamic in place of flight sections
+    Int64 hold;                  // synthetic: frames per sample
+    bool binary;                 // socket: binary replies
+    Int32 clients;
+    Float64 rate_hz;             // 0: back to back
+    Int64 frames;
+    Float64 duration_s;          // 0: until frames
+    Uint64 seed;
+};
+
+// One client's counts; written by its thread only, read after it ends
+struct ClientRun {
+    LatencyHistogram latency;
+    Int64 sent = 0;
+    Int64 answered = 0;
+    Int64 dropped = 0;
+    Int64 failed = 0;
+    Int64 skipped = 0;
+    Int64 sections = 0;
+    bool reached = false;  // the interface was set up
+    std::chrono::steady_clock::time_point finish;
+};
+
+// ---------------------------------------------------------------------------
+// Frames
+// ---------------------------------------------------------------------------
+
+// splitmix64: a stateless hash, so frame n's noise does not depend on the
+// frames before it
+Uint64 mix_bits(Uint64 value) {
+    Uint64 z = value + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Uniform in [-1, 1) for (seed, client, frame, channel)
+Float64 frame_noise(Uint64 seed, Int32 client, Int64 frame, Int32 channel) {
+    Uint64 bits = mix_bits(seed ^ mix_bits(static_cast<Uint64>(client) * 4u + static_cast<Uint64>(channel)) ^
+                           mix_bits(static_cast<Uint64>(frame)));
+    return static_cast<Float64>(bits >> 11) * (2.0 / 9007199254740992.0) - 1.0;
+}
+
+void set_section(LoadSection& section, Int32 kind, const Float64* values) {
+    section.kind = kind;
+    for (Int32 i = 0; i < flight_log_max_values; ++i) {
+        section.values[i] = i < load_section_specs[kind].field_count ? values[i] : 0.0;
+    }
+}
+
+// Frame n of a client's synthetic flight: the flight test fixture's
+// aircraft (75000 lb, Vso 120 kt, Mmo 0.82; Vne raised to 340 kt so the
+// cruise stays inside the envelope) flown through climb, cruise and descent
+void synthetic_frame(const LoadConfig& config, Int32 client, Int64 frame_number, LoadFrame& frame) {
+    Int64 n = frame_number / config.hold;
+    Float64 t = static_cast<Float64>(n) * synthetic_step_s;
+    Float64 phase = std::fmod(t + client * synthetic_client_offset_s, 3.0 * synthetic_phase_s);
+    Float64 climb_fpm = (synthetic_cruise_ft - synthetic_low_ft) / (synthetic_phase_s / 60.0);
+    Float64 altitude_ft = synthetic_cruise_ft;
+    Float64 vs_fpm = 0.0;
+    if (phase < synthetic_phase_s) {
+        altitude_ft = synthetic_low_ft + climb_fpm * phase / 60.0;
+        vs_fpm = climb_fpm;
+    } else if (phase >= 2.0 * synthetic_phase_s) {
+        altitude_ft = synthetic_cruise_ft - climb_fpm * (phase - 2.0 * synthetic_phase_s) / 60.0;
+        vs_fpm = -climb_fpm;
+    }
+
+    Float64 height = altitude_ft / synthetic_cruise_ft;
+    Float64 weave = std::sin(two_pi * t / synthetic_weave_period_s);
+    Float64 tas_kts = 250.0 + 200.0 * height + 2.0 * frame_noise(config.seed, client, n, 0);
+    Float64 gs_kts = tas_kts - 5.0 - 20.0 * height + 2.0 * frame_noise(config.seed, client, n, 1);
+    Float64 heading = std::fmod(90.0 + 30.0 * std::sin(two_pi * t / (5.0 * synthetic_weave_period_s)) + 360.0,
+                                360.0);
+    Float64 track = heading + 5.0 + 0.5 * frame_noise(config.seed, client, n, 2);
+    Float64 ias_kts = 220.0 + 30.0 * (1.0 - height);
+    Float64 mach = tas_kts / 580.0;
+    Float64 bank_deg = 25.0 * weave;
+
+    const Float64 flight[14] = {tas_kts, gs_kts, heading, track, ias_kts, mach, altitude_ft,
+                                altitude_ft - 500.0, vs_fpm, 75000.0, bank_deg, 120.0, 340.0, 0.82};
+    const Float64 turn[3] = {tas_kts, 15.0 + 10.0 * std::fabs(weave), 90.0};
+    const Float64 vnav[5] = {altitude_ft, vs_fpm >= 0.0 ? synthetic_cruise_ft : 10000.0,
+                             100.0 - 90.0 * (phase / (3.0 * synthetic_phase_s)), gs_kts, vs_fpm};
+    const Float64 density[5] = {altitude_ft, 25.0 - 1.98 * altitude_ft / 1000.0, ias_kts, tas_kts, 0.0};
+
+    frame.has_aircraft = true;
+    frame.aircraft_id = client + 1;
+    frame.section_count = 4;
+    // A dynamic section is the first 11 flight fields
+    set_section(frame.sections[0], config.dynamic ? flight_log_section_dynamic : flight_log_section_flight,
+                flight);
+    set_section(frame.sections[1], flight_log_section_turn, turn);
+    set_section(frame.sections[2], flight_log_section_vnav, vnav);
+    set_section(frame.sections[3], flight_log_section_density, density);
+}
+
+// Frame n of a log replay: record n, looping
+void log_frame(const FlightLogReader& log, Int64 n, LoadFrame& frame) {
+    const FlightLogRecord& record = log.record(n % log.record_count());
+    frame.has_aircraft = (record.flags & flight_log_flag_aircraft) != 0u;
+    frame.aircraft_id = record.aircraft_id;
+    frame.section_count = 0;
+    if (record.section >= 0 && record.section < load_section_kinds) {
+        set_section(frame.sections[0], record.section, record.values);
+        frame.section_count = 1;
+    }
+}
+
+void build_frame(const LoadConfig& config, Int32 client, Int64 n, LoadFrame& frame) {
+    if (config.log != nullptr) {
+        log_frame(*config.log, n, frame);
+    } else {
+        synthetic_frame(config, client, n, frame);
+    }
+}
+
+// The frame as a socket request line (with its newline); returns its length
+Int32 format_request(const LoadFrame& frame, Int64 request_id, bool binary, char* line) {
+    char* cursor = line;
+    char* end = line + request_line_max - number_text_max - 2;
+    cursor = std::to_chars(cursor, end, request_id).ptr;
+    if (binary) {
+        std::memcpy(cursor, " binary", 7);
+        cursor += 7;
+    }
+    if (frame.has_aircraft) {
+        std::memcpy(cursor, " aircraft ", 10);
+        cursor = std::to_chars(cursor + 10, end, frame.aircraft_id).ptr;
+    }
+    for (Int32 s = 0; s < frame.section_count; ++s) {
+        const LoadSection& section = frame.sections[s];
+        const char* name = load_section_specs[section.kind].name;
+        *cursor = ' ';
+        ++cursor;
+        Int32 name_length = static_cast<Int32>(std::strlen(name));
+        std::memcpy(cursor, name, static_cast<size_t>(name_length));
+        cursor += name_length;
+        for (Int32 i = 0; i < load_section_specs[section.kind].field_count; ++i) {
+            *cursor = ' ';
+            // Shortest round-trip text: the daemon parses the same values
+            cursor = std::to_chars(cursor + 1, cursor + 1 + number_text_max, section.values[i]).ptr;
+        }
+    }
+    *cursor = '\n';
+    ++cursor;
+    return static_cast<Int32>(cursor - line);
+}
+
+// ---------------------------------------------------------------------------
+// Interfaces: each computes one frame and says whether it was answered
+// ---------------------------------------------------------------------------
+
+const Int32 frame_answered = 0;
+const Int32 frame_failed = 1;
+const Int32 frame_skipped = 2;
+const Int32 frame_lost = 3;      // the interface is gone: the client stops
+
+struct SocketClient {
+    Int32 fd = -1;
+    std::array<char, reply_line_max> reply;
+};
+
+bool connect_socket(SocketClient& client, const char* path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    bool ok = std::strlen(path) < sizeof(address.sun_path);
+    if (ok) {
+        std::strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+        client.fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        ok = client.fd >= 0 && connect(client.fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+    }
+    return ok;
+}
+
+bool send_all(Int32 fd, const char* data, Int32 length) {
+    bool ok = true;
+    while (ok && length > 0) {
+        ssize_t n = send(fd, data, static_cast<size_t>(length), MSG_NOSIGNAL);
+        ok = n > 0;
+        if (ok) {
+            data += n;
+            length -= static_cast<Int32>(n);
+        }
+    }
+    return ok;
+}
+
+// Offset just past the reply record of a binary reply (wire_format.h) in
+// the first length bytes of data, or 0 if it has not all arrived; request
+// errors are a reply record with a nonzero status
+Int32 binary_reply_end(const char* data, Int32 length, bool& request_error) {
+    Int32 offset = 0;
+    Int32 end = 0;
+    while (end == 0 && offset + wire_header_size <= length) {
+        Uint8 type = static_cast<Uint8>(data[offset + 5]);
+        Uint16 size = 0;
+        std::memcpy(&size, data + offset + 6, sizeof(size));
+        Int32 next = offset + wire_header_size + size;
+        if (next > length) {
+            offset = length;
+        } else {
+            if (type == wire_record_reply) {
+                Int32 status = 0;
+                std::memcpy(&status, data + offset + wire_header_size + 8, sizeof(status));
+                request_error = status != 0;
+                end = next;
+            }
+            offset = next;
+        }
+    }
+    return end;
+}
+
+// Read one reply line (or binary reply); frame_failed on a timeout or a
+// request error ({"id": n, "error": "<message>"}), frame_lost if the
+// connection ends
+Int32 read_reply(SocketClient& client, bool binary) {
+    Int32 status = frame_answered;
+    Int32 length = 0;
+    bool complete = false;
+    bool binary_error = false;
+    while (!complete && status == frame_answered) {
+        pollfd poll_fd = {client.fd, POLLIN, 0};
+        if (length == reply_line_max) {
+            status = frame_lost;  // a line longer than any reply: out of step with the daemon
+        } else if (poll(&poll_fd, 1, reply_timeout_ms) <= 0) {
+            status = frame_lost;
+        } else {
+            ssize_t n = recv(client.fd, client.reply.data() + length, static_cast<size_t>(reply_line_max - length), 0);
+            if (n <= 0) {
+                status = frame_lost;
+            } else {
+                if (binary) {
+                    length += static_cast<Int32>(n);
+                    complete = binary_reply_end(client.reply.data(), length, binary_error) > 0;
+                } else {
+                    complete = std::memchr(client.reply.data() + length, '\n', static_cast<size_t>(n)) != nullptr;
+                    length += static_cast<Int32>(n);
+                }
+            }
+        }
+    }
+    if (status == frame_answered && binary) {
+        if (binary_error) {
+            status = frame_failed;
+        }
+    } else if (status == frame_answered) {
+        // Section errors are numbers; only a request error is a string
+        static const char request_error[] = "\"error\": \"";
+        for (Int32 i = 0; i + 10 <= length && status == frame_answered; ++i) {
+            if (std::memcmp(client.reply.data() + i, request_error, 10) == 0) {
+                status = frame_failed;
+            }
+        }
+    }
+    return status;
+}
+
+Int32 socket_frame(SocketClient& client, const LoadFrame& frame, Int64 request_id, bool binary) {
+    char line[request_line_max];
+    Int32 length = format_request(frame, request_id, binary, line);
+    Int32 status = frame_lost;
+    if (send_all(client.fd, line, length)) {
+        status = read_reply(client, binary);
+    }
+    return status;
+}
+
+struct ShmClient {
+    ShmChannel* channel = nullptr;
+    Uint64 next_frame_id = 1;
+};
+
+bool map_shm_channel(ShmClient& client, const char* path) {
+    bool ok = false;
+    Int32 fd = open(path, O_RDWR);
+    if (fd >= 0) {
+        void* mapping = mmap(nullptr, static_cast<size_t>(shm_channel_size), PROT_READ | PROT_WRITE, MAP_SHARED,
+                             fd, 0);
+        if (mapping != MAP_FAILED) {
+            ShmChannel* channel = static_cast<ShmChannel*>(mapping);
+            ok = channel->header.magic == shm_magic && channel->header.version == shm_version &&
+                 channel->header.size == static_cast<Uint32>(shm_channel_size);
+            if (ok) {
+                client.channel = channel;
+                // Frame ids continue after the daemon's last answer
+                ShmResultFrame last;
+                while (!seqlock_read(channel->result, last)) {
+                }
+                client.next_frame_id = last.frame_id + 1;
+            } else {
+                munmap(mapping, static_cast<size_t>(shm_channel_size));
+            }
+        }
+        close(fd);
+    }
+    return ok;
+}
+
+Int32 shm_frame(ShmClient& client, const LoadFrame& frame) {
+    ShmInputFrame& input = client.channel->input;
+    Uint32 mask = 0u;
+    for (Int32 s = 0; s < frame.section_count; ++s) {
+        if (frame.sections[s].kind < shm_section_count) {
+            mask |= 1u << frame.sections[s].kind;
+        }
+    }
+
+    Int32 status = frame_skipped;
+    if (mask != 0u) {
+        Uint64 frame_id = client.next_frame_id;
+        ++client.next_frame_id;
+        seqlock_write_begin(input.sequence);
+        input.frame_id = frame_id;
+        input.section_mask = mask;
+        for (Int32 s = 0; s < frame.section_count; ++s) {
+            const LoadSection& section = frame.sections[s];
+            Float64* fields[shm_section_count] = {input.flight, input.turn, input.vnav, input.density};
+            if (section.kind < shm_section_count) {
+                std::memcpy(fields[section.kind], section.values,
+                            static_cast<size_t>(load_section_specs[section.kind].field_count) * sizeof(Float64));
+            }
+        }
+        seqlock_write_end(input.sequence);
+        shm_doorbell_ring(client.channel->header.doorbell, client.channel->header.doorbell_wait != 0u);
+
+        // The daemon answers each new frame id once
+        std::chrono::steady_clock::time_point deadline =
+            std::chrono::steady_clock::now() + std::chrono::milliseconds(reply_timeout_ms);
+        ShmResultFrame result;
+        bool answered = false;
+        status = frame_failed;
+        while (!answered && std::chrono::steady_clock::now() < deadline) {
+            answered = seqlock_read(client.channel->result, result) && result.frame_id == frame_id;
+            if (!answered) {
+                std::this_thread::yield();
+            }
+        }
+        if (answered) {
+            status = frame_answered;
+        }
+    }
+    return status;
+}
+
+struct InProcessClient {
+    XpmfdFlightState* state = nullptr;
+    XpmfdVnavPredictor* predictor = nullptr;
+    Float64 sample_time_s = 0.0;  // wind estimator clock, one synthetic step per flight section
+};
+
+bool create_in_process(InProcessClient& client) {
+    client.state = xpmfd_flight_state_create();
+    client.predictor = xpmfd_vnav_predictor_create();
+    return client.state != nullptr && client.predictor != nullptr &&
+           xpmfd_vnav_set_settings(client.predictor, &in_process_vnav_settings) == xpmfd_ok;
+}
+
+// Sections the C API computes; footprint and dynamic sections need the
+// daemon's terrain and profile
+Int32 in_process_frame(InProcessClient& client, const LoadFrame& frame, Int64& sections) {
+    XpmfdFlightState* state = client.state;
+    Int32 computed = 0;
+    Float64 track_deg = 0.0;
+    for (Int32 s = 0; s < frame.section_count; ++s) {
+        const Float64* v = frame.sections[s].values;
+        Int32 kind = frame.sections[s].kind;
+        if (kind == flight_log_section_flight) {
+            XpmfdFlightInputs inputs = {v[0], v[1], v[2], v[3], v[4], v[5], v[6],
+                                        v[7], v[8], v[9], v[10], v[11], v[12], v[13]};
+            XpmfdFlightResults results;
+            xpmfd_calculate_flight(state, &inputs, &results);
+            XpmfdWindSample sample = {client.sample_time_s, v[6], v[0], v[1], v[2], v[3]};
+            XpmfdWindEstimate estimate;
+            xpmfd_estimate_wind(state, &sample, &estimate);
+            client.sample_time_s += synthetic_step_s;
+            track_deg = v[3];
+            ++computed;
+        } else if (kind == flight_log_section_turn) {
+            XpmfdTurnData turn;
+            xpmfd_calculate_turn(v[0], v[1], v[2], &turn);
+            ++computed;
+        } else if (kind == flight_log_section_vnav) {
+            XpmfdVnavData vnav;
+            xpmfd_calculate_vnav(v[0], v[1], v[2], v[3], v[4], &vnav);
+            // Pending until the steps integrated so far reach the aircraft
+            XpmfdVnavProgress progress;
+            XpmfdVnavPrediction prediction;
+            xpmfd_vnav_set_wind_profile(client.predictor, state, track_deg);
+            xpmfd_vnav_advance(client.predictor, in_process_vnav_steps, &progress);
+            xpmfd_vnav_predict(client.predictor, v[2], v[0], &prediction);
+            ++computed;
+        } else if (kind == flight_log_section_density) {
+            XpmfdDensityAltitudeData density;
+            xpmfd_calculate_density_altitude(v[0], v[1], v[2], v[3], &density);
+            ++computed;
+        } else if (kind == flight_log_section_wind_estimate) {
+            XpmfdWindSample sample = {v[0], v[1], v[2], v[3], v[4], v[5]};
+            XpmfdWindEstimate estimate;
+            xpmfd_estimate_wind(state, &sample, &estimate);
+            ++computed;
+        }
+    }
+    sections += computed;
+    return computed > 0 ? frame_answered : frame_skipped;
+}
+
+// ---------------------------------------------------------------------------
+// Clients
+// ---------------------------------------------------------------------------
+
+struct ClientContext {
+    const LoadConfig* config;
+    Int32 client;
+    std::chrono::steady_clock::time_point start;
+    ClientRun* run;
+};
+
+void run_client(ClientContext context) {
+    const LoadConfig& config = *context.config;
+    ClientRun& run = *context.run;
+    typedef std::chrono::steady_clock Clock;
+
+    // Interface state, set up before the first frame is due
+    SocketClient socket_client;
+    ShmClient shm_client;
+    InProcessClient in_process_client;
+    bool ready = false;
+    if (config.interface == interface_socket) {
+        ready = connect_socket(socket_client, config.path);
+    } else if (config.interface == interface_shm) {
+        ready = map_shm_channel(shm_client, config.path);
+    } else {
+        ready = create_in_process(in_process_client);
+    }
+
+    Clock::duration period = Clock::duration::zero();
+    if (config.rate_hz > 0.0) {
+        period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<Float64>(1.0 / config.rate_hz));
+    }
+    Clock::time_point stop = Clock::time_point::max();
+    if (config.duration_s > 0.0) {
+        stop = context.start + std::chrono::duration_cast<Clock::duration>(
+                                   std::chrono::duration<Float64>(config.duration_s));
+    }
+
+    std::this_thread::sleep_until(context.start);
+    run.reached = ready;
+    bool lost = !ready;
+    LoadFrame frame;
+    for (Int64 n = 0; n < config.frames && !lost && Clock::now() < stop; ++n) {
+        Clock::time_point due = context.start + period * n;
+        Clock::time_point now = Clock::now();
+        if (period != Clock::duration::zero() && now > due + period) {
+            ++run.dropped;
+        } else {
+            std::this_thread::sleep_until(due);
+            build_frame(config, context.client, n, frame);
+            Int64 frame_sections = frame.section_count;
+            Clock::time_point sent = Clock::now();
+            Int32 status = frame_skipped;
+            if (config.interface == interface_socket) {
+                status = socket_frame(socket_client, frame, n + 1, config.binary);
+            } else if (config.interface == interface_shm) {
+                status = shm_frame(shm_client, frame);
+            } else {
+                frame_sections = 0;
+                status = in_process_frame(in_process_client, frame, frame_sections);
+            }
+            Clock::time_point answered = Clock::now();
+
+            if (status == frame_skipped) {
+                ++run.skipped;
+            } else {
+                ++run.sent;
+                if (status == frame_answered) {
+                    ++run.answered;
+                    run.sections += frame_sections;
+                    run.latency.add(std::chrono::duration_cast<std::chrono::nanoseconds>(answered - sent).count());
+                } else {
+                    ++run.failed;
+                    lost = status == frame_lost;
+                }
+            }
+        }
+    }
+    run.finish = Clock::now();
+
+    if (socket_client.fd >= 0) {
+        close(socket_client.fd);
+        socket_client.fd = -1;
+    }
+    if (shm_client.channel != nullptr) {
+        munmap(shm_client.channel, static_cast<size_t>(shm_channel_size));
+    }
+    if (in_process_client.state != nullptr) {
+        xpmfd_flight_state_destroy(in_process_client.state);
+    }
+    if (in_process_client.predictor != nullptr) {
+        xpmfd_vnav_predictor_destroy(in_process_client.predictor);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Report
+// ---------------------------------------------------------------------------
+
+const char* interface_name(Int32 interface) {
+    const char* name = "in-process";
+    if (interface == interface_socket) {
+        name = "socket";
+    } else if (interface == interface_shm) {
+        name = "shm";
+    }
+    return name;
+}
+
+Float64 to_us(Int64 ns) {
+    return static_cast<Float64>(ns) / 1000.0;
+}
+
+void print_report(const LoadConfig& config, const ClientRun& total, Float64 elapsed_s, bool json) {
+    const LatencyHistogram& latency = total.latency;
+    Float64 throughput = elapsed_s > 0.0 ? static_cast<Float64>(total.answered) / elapsed_s : 0.0;
+    const Float64 fractions[4] = {0.5, 0.9, 0.99, 0.999};
+    const char* const names[4] = {"p50", "p90", "p99", "p999"};
+
+    if (json) {
+        TextWriter text(std::cout);
+        text.put("{\"interface\": \"");
+        text.put(interface_name(config.interface));
+        text.put("\", \"source\": \"");
+        text.put(config.log != nullptr ? "log" : "synthetic");
+        text.put("\", \"clients\": ");
+        text.put_int(config.clients);
+        text.put(", \"rate_hz\": ");
+        text.put_fixed(config.rate_hz);
+        text.put(", \"elapsed_s\": ");
+        text.put_fixed(elapsed_s);
+        text.put(", \"sent\": ");
+        text.put_int(total.sent);
+        text.put(", \"answered\": ");
+        text.put_int(total.answered);
+        text.put(", \"dropped\": ");
+        text.put_int(total.dropped);
+        text.put(", \"failed\": ");
+        text.put_int(total.failed);
+        text.put(", \"skipped\": ");
+        text.put_int(total.skipped);
+        text.put(", \"sections\": ");
+        text.put_int(total.sections);
+        text.put(", \"throughput_fps\": ");
+        text.put_fixed(throughput);
+        text.put(", \"latency_us\": {\"mean\": ");
+        text.put_fixed(latency.mean_ns() / 1000.0);
+        for (Int32 i = 0; i < 4; ++i) {
+            text.put(", \"");
+            text.put(names[i]);
+            text.put("\": ");
+            text.put_fixed(to_us(latency.percentile_ns(fractions[i])));
+        }
+        text.put(", \"max\": ");
+        text.put_fixed(to_us(latency.max_ns()));
+        text.put("}}\n");
+        text.flush();
+    } else {
+        std::printf("calc_loadgen: %s, %d client%s at ", interface_name(config.interface), config.clients,
+                    config.clients == 1 ? "" : "s");
+        if (config.rate_hz > 0.0) {
+            std::printf("%.1f Hz", config.rate_hz);
+        } else {
+            std::printf("full speed");
+        }
+        std::printf(", %s, %.2f s\n", config.log != nullptr ? "recorded log" : "synthetic envelope", elapsed_s);
+        std::printf("frames      %lld sent  %lld answered  %lld dropped  %lld failed  %lld skipped\n",
+                    static_cast<long long>(total.sent), static_cast<long long>(total.answered),
+                    static_cast<long long>(total.dropped), static_cast<long long>(total.failed),
+                    static_cast<long long>(total.skipped));
+        std::printf("throughput  %.1f frames/s  %.1f sections/s\n", throughput,
+                    elapsed_s > 0.0 ? static_cast<Float64>(total.sections) / elapsed_s : 0.0);
+        std::printf("latency us  mean %.1f", latency.mean_ns() / 1000.0);
+        for (Int32 i = 0; i < 4; ++i) {
+            std::printf("  %s %.1f", names[i], to_us(latency.percentile_ns(fractions[i])));
+        }
+        std::printf("  max %.1f\n", to_us(latency.max_ns()));
+    }
+}
+
+// Every client's request lines, client by client, without sending them
+void print_requests(const LoadConfig& config) {
+    char line[request_line_max];
+    LoadFrame frame;
+    for (Int32 c = 0; c < config.clients; ++c) {
+        for (Int64 n = 0; n < config.frames; ++n) {
+            build_frame(config, c, n, frame);
+            std::fwrite(line, 1, static_cast<size_t>(format_request(frame, n + 1, config.binary, line)), stdout);
+        }
+    }
+}
+
+Int32 run_load(const LoadConfig& config, bool json) {
+    Int32 return_code = error_success;
+    // AV Rule 206: the client table is fixed
+    static std::array<ClientRun, max_loadgen_clients> runs;
+    std::array<std::thread, max_loadgen_clients> threads;
+
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(start_delay_ms);
+    for (Int32 c = 0; c < config.clients; ++c) {
+        threads[c] = std::thread(run_client, ClientContext{&config, c, start, &runs[c]});
+    }
+
+    ClientRun total;
+    total.reached = true;
+    std::chrono::steady_clock::time_point finish = start;
+    for (Int32 c = 0; c < config.clients; ++c) {
+        threads[c].join();
+        const ClientRun& run = runs[c];
+        total.latency.merge(run.latency);
+        total.sent += run.sent;
+        total.answered += run.answered;
+        total.dropped += run.dropped;
+        total.failed += run.failed;
+        total.skipped += run.skipped;
+        total.sections += run.sections;
+        total.reached = total.reached && run.reached;
+        if (run.finish > finish) {
+            finish = run.finish;
+        }
+    }
+
+    Float64 elapsed_s = std::chrono::duration<Float64>(finish - start).count();
+    print_report(config, total, elapsed_s, json);
+    if (!total.reached) {
+        std::cerr << "Error: Could not " << (config.interface == interface_socket ? "connect to " : "open ")
+                  << (config.path != nullptr ? config.path : "a flight state") << "\n";
+        return_code = error_io_failed;
+    } else if (total.failed > 0) {
+        std::cerr << "Error: " << total.failed << " frames failed\n";
+        return_code = error_io_failed;
+    }
+    return return_code;
+}
+
+} // namespace xplane_mfd::calc
+
+void print_usage(const char* program_name) {
+    std::cerr << "Usage: " << program_name << " (--socket <path> | --shm <path> | --in-process | --dry-run)\n";
+    std::cerr << "       [--synthetic [--dynamic] [--hold <n>] | --log <path>] [--binary]\n";
+    std::cerr << "       [--clients <n>] [--rate <hz>] [--frames <n>] [--duration <s>] [--seed <n>]\n";
+    std::cerr << "       [--json]\n\n";
+    std::cerr << "Sends frames from --clients threads (default 1, at most 64) at --rate frames\n";
+    std::cerr << "per second each (0, the default: back to back) to mfd_calcd's socket or\n";
+    std::cerr << "shared-memory channel (one client), or computes them with the library's\n";
+    std::cerr << "C API, and reports throughput, latency percentiles and dropped frames.\n";
+    std::cerr << "Frames are a synthetic flight envelope per client (--seed picks its noise)\n";
+    std::cerr << "or the sections of a mfd_calcd --record flight log. --dynamic sends the\n";
+    std::cerr << "synthetic flight as dynamic sections (mfd_calcd --profile); --hold sends each\n";
+    std::cerr << "synthetic sample that many times. --binary asks the socket for binary replies.\n";
+    std::cerr << "Each client runs --frames frames (default 1000) or for --duration seconds.\n";
+    std::cerr << "--dry-run prints the request lines instead of sending them.\n\n";
+    std::cerr << "Example:\n";
+    std::cerr << "  " << program_name << " --socket /tmp/mfd_calcd.sock --clients 8 --rate 60 --duration 10\n";
+}
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+
+    Int32 return_code = error_success;  // Single exit point variable
+    LoadConfig config = {-1, nullptr, nullptr, false, 1, false, 1, 0.0, 0, 0.0, 1};
+    const char* log_path = nullptr;
+    bool json = false;
+    Int64 clients = 1;
+    Int64 seed = 1;
+
+    for (Int32 i = 1; i < argc && return_code == error_success; ++i) {
+        bool has_value = i + 1 < argc;
+        if ((std::strcmp(argv[i], "--socket") == 0 || std::strcmp(argv[i], "--shm") == 0) && has_value &&
+            config.interface < 0) {
+            config.interface = argv[i][2] == 's' && argv[i][3] == 'o' ? interface_socket : interface_shm;
+            config.path = argv[i + 1];
+            ++i;
+        } else if (std::strcmp(argv[i], "--in-process") == 0 && config.interface < 0) {
+            config.interface = interface_in_process;
+        } else if (std::strcmp(argv[i], "--dry-run") == 0 && config.interface < 0) {
+            config.interface = interface_dry_run;
+        } else if (std::strcmp(argv[i], "--log") == 0 && has_value) {
+            log_path = argv[i + 1];
+            ++i;
+        } else if (std::strcmp(argv[i], "--synthetic") == 0) {
+            log_path = nullptr;
+        } else if (std::strcmp(argv[i], "--dynamic") == 0) {
+            config.dynamic = true;
+        } else if (std::strcmp(argv[i], "--hold") == 0 && has_value && parse_int64(argv[i + 1], config.hold) &&
+                   config.hold >= 1) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--binary") == 0) {
+            config.binary = true;
+        } else if (std::strcmp(argv[i], "--clients") == 0 && has_value && parse_int64(argv[i + 1], clients) &&
+                   clients >= 1 && clients <= max_loadgen_clients) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--rate") == 0 && has_value &&
+                   parse_float64(argv[i + 1], config.rate_hz) && config.rate_hz >= 0.0) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--frames") == 0 && has_value &&
+                   parse_int64(argv[i + 1], config.frames) && config.frames >= 1) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--duration") == 0 && has_value &&
+                   parse_float64(argv[i + 1], config.duration_s) && config.duration_s > 0.0) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--seed") == 0 && has_value && parse_int64(argv[i + 1], seed)) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else {
+            return_code = error_invalid_args;
+        }
+    }
+    config.clients = static_cast<Int32>(clients);
+    config.seed = static_cast<Uint64>(seed);
+    if (config.frames == 0) {
+        config.frames = config.duration_s > 0.0 ? std::numeric_limits<Int64>::max() : default_frames;
+    }
+    // One writer per shared-memory frame: the channel has one client
+    if (config.interface < 0 || (config.interface == interface_shm && config.clients != 1) ||
+        (config.interface == interface_dry_run && config.frames == std::numeric_limits<Int64>::max())) {
+        return_code = error_invalid_args;
+    }
+    if (return_code != error_success) {
+        print_usage(argv[0]);
+    }
+
+    // Mapped once; every client reads it
+    FlightLogReader log;
+    if (return_code == error_success && log_path != nullptr) {
+        if (!log.load(log_path) || log.record_count() == 0) {
+            std::cerr << "Error: " << log_path << " is not a flight log with records (flight_recorder.h)\n";
+            return_code = error_bad_format;
+        } else {
+            config.log = &log;
+        }
+    }
+
+    if (return_code == error_success) {
+        if (config.interface == interface_dry_run) {
+            print_requests(config);
+        } else {
+            return_code = run_load(config, json);
+        }
+        if (std::fflush(stdout) != 0 || std::ferror(stdout) != 0) {
+            std::cerr << "Error: Failed to write output\n";
+            return_code = error_io_failed;
+        }
+    }
+
+    return return_code;  // Single exit point
+}
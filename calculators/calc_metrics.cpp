@@ -0,0 +1,292 @@
+// Calculator Metrics for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Implementation of the per-thread counters declared in calc_metrics.h.
+//
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try)
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (shards in static storage)
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include "calc_metrics.h"
+#include "calc_io.h"
+#include "flight_kernels.h"
+#include "turn_kernels.h"
+#include "vnav_kernels.h"
+
+namespace xplane_mfd::calc {
+
+const char* const metric_counter_names[metric_counter_count] = {
+    "requests", "request_errors", "parse_failures", "section_errors", "cache_hits", "cache_misses",
+    "turn_wings_level", "vnav_distance_floor", "vnav_groundspeed_floor", "footprint_sweeps"
+};
+
+const char* const metric_kernel_names[metric_kernel_count] = {
+    "flight", "turn", "vnav", "density", "dynamic", "footprint", "wind_estimate"
+};
+
+namespace {
+
+// Prometheus histogram buckets: the le label and its bound
+struct PrometheusBucket {
+    const char* label;
+    Int64 bound_ns;
+};
+
+const Int32 prometheus_bucket_count = 15;
+const PrometheusBucket prometheus_buckets[prometheus_bucket_count] = {
+    {"2.5e-07", 250}, {"5e-07", 500}, {"1e-06", 1000}, {"2.5e-06", 2500}, {"5e-06", 5000},
+    {"1e-05", 10000}, {"2.5e-05", 25000}, {"5e-05", 50000}, {"0.0001", 100000}, {"0.00025", 250000},
+    {"0.0005", 500000}, {"0.001", 1000000}, {"0.0025", 2500000}, {"0.01", 10000000}, {"0.1", 100000000}
+};
+
+const Float64 ns_per_us = 1000.0;
+const Float64 ns_per_s = 1.0e9;
+
+// One thread's counts; its own cache lines, so threads never share one
+struct alignas(64) MetricsShard {
+    std::array<std::atomic<Int64>, metric_counter_count> counters;
+    std::array<std::atomic<Int64>, metric_kernel_count> calls;
+    std::array<std::atomic<Int64>, metric_kernel_count> sum_ns;
+    std::array<std::atomic<Int64>, metric_kernel_count> max_ns;
+    std::array<std::array<std::atomic<Int64>, histogram_bucket_count>, metric_kernel_count> buckets;
+};
+
+// Zero-initialized static storage: nothing to construct at startup
+std::array<MetricsShard, metrics_max_threads> shards;
+std::atomic<Int32> claimed_shards(0);
+
+// The calling thread's shard, and whether other threads write it too
+struct ThreadShard {
+    MetricsShard* shard;
+    bool shared;
+};
+
+thread_local ThreadShard thread_shard = {nullptr, false};
+
+ThreadShard& own_shard() {
+    ThreadShard& own = thread_shard;
+    if (own.shard == nullptr) {
+        Int32 index = claimed_shards.fetch_add(1, std::memory_order_relaxed);
+        own.shared = index >= metrics_max_threads - 1;
+        own.shard = &shards[own.shared ? metrics_max_threads - 1 : index];
+    }
+    return own;
+}
+
+// A shard's only writer adds with a plain load and store (no locked
+// instruction); the shared last shard needs a real atomic add
+void add_to(std::atomic<Int64>& value, Int64 amount, bool shared) {
+    if (shared) {
+        value.fetch_add(amount, std::memory_order_relaxed);
+    } else {
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+}
+
+void put_number(TextWriter& text, Float64 value) {
+    char digits[text_number_max];
+    std::to_chars_result end = std::to_chars(digits, digits + text_number_max - 1, value);
+    *end.ptr = '\0';
+    text.put(digits);
+}
+
+void put_counter_help(TextWriter& text, const char* name, const char* help) {
+    text.put("# HELP xpmfd_");
+    text.put(name);
+    text.put("_total ");
+    text.put(help);
+    text.put("\n# TYPE xpmfd_");
+    text.put(name);
+    text.put("_total counter\n");
+}
+
+const char* const counter_help[metric_counter_count] = {
+    "Request lines and shared-memory frames answered.",
+    "Request lines rejected whole.",
+    "Sections or lines with a field that is not a number.",
+    "Sections whose inputs were rejected.",
+    "Flight envelope, energy and glide results reused from the result cache.",
+    "Flight envelope, energy and glide results computed again.",
+    "Turns computed on the wings-level branch.",
+    "VNAV calculations with the distance raised to its floor.",
+    "VNAV calculations with the groundspeed raised to its floor.",
+    "Glide footprints swept again."
+};
+
+} // namespace
+
+void metrics_count(Int32 counter, Int64 amount) {
+    ThreadShard& own = own_shard();
+    add_to(own.shard->counters[counter], amount, own.shared);
+}
+
+void metrics_kernel_call(Int32 kernel, Int64 duration_ns) {
+    ThreadShard& own = own_shard();
+    MetricsShard& shard = *own.shard;
+    add_to(shard.calls[kernel], 1, own.shared);
+    if (duration_ns >= 0) {
+        add_to(shard.buckets[kernel][LatencyHistogram::bucket_of(static_cast<Uint64>(duration_ns))], 1,
+               own.shared);
+        add_to(shard.sum_ns[kernel], duration_ns, own.shared);
+        // Only the shared shard ever has a competing writer
+        Int64 max_ns = shard.max_ns[kernel].load(std::memory_order_relaxed);
+        while (duration_ns > max_ns &&
+               !shard.max_ns[kernel].compare_exchange_weak(max_ns, duration_ns, std::memory_order_relaxed)) {
+        }
+    }
+}
+
+Int64 metrics_now_ns() {
+    return static_cast<Int64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void metrics_count_turn_inputs(Float64 bank_deg) {
+    if (turn_wings_level(bank_deg)) {
+        metrics_count(metric_turn_wings_level, 1);
+    }
+}
+
+void metrics_count_vnav_inputs(Float64 distance_nm, Float64 groundspeed_kts) {
+    if (vnav_distance_floored(distance_nm)) {
+        metrics_count(metric_vnav_distance_floor, 1);
+    }
+    if (vnav_groundspeed_floored(groundspeed_kts)) {
+        metrics_count(metric_vnav_groundspeed_floor, 1);
+    }
+}
+
+void metrics_count_cache(const CacheCounters& before, const CacheCounters& after) {
+    if (after.hits != before.hits) {
+        metrics_count(metric_cache_hits, after.hits - before.hits);
+    }
+    if (after.misses != before.misses) {
+        metrics_count(metric_cache_misses, after.misses - before.misses);
+    }
+}
+
+void metrics_snapshot(MetricsSnapshot& snapshot) {
+    Int32 claimed = claimed_shards.load(std::memory_order_relaxed);
+    snapshot.thread_count = claimed < metrics_max_threads ? claimed : metrics_max_threads;
+    snapshot.counters.fill(0);
+    snapshot.calls.fill(0);
+    std::array<Int64, histogram_bucket_count> counts;
+    for (Int32 k = 0; k < metric_kernel_count; ++k) {
+        snapshot.compute[k].clear();
+    }
+
+    for (Int32 t = 0; t < snapshot.thread_count; ++t) {
+        const MetricsShard& shard = shards[t];
+        for (Int32 c = 0; c < metric_counter_count; ++c) {
+            snapshot.counters[c] += shard.counters[c].load(std::memory_order_relaxed);
+        }
+        for (Int32 k = 0; k < metric_kernel_count; ++k) {
+            snapshot.calls[k] += shard.calls[k].load(std::memory_order_relaxed);
+            for (Int32 b = 0; b < histogram_bucket_count; ++b) {
+                counts[b] = shard.buckets[k][b].load(std::memory_order_relaxed);
+            }
+            snapshot.compute[k].add_counts(counts, shard.sum_ns[k].load(std::memory_order_relaxed),
+                                           shard.max_ns[k].load(std::memory_order_relaxed));
+        }
+    }
+}
+
+void print_json(std::ostream& out, const MetricsSnapshot& snapshot) {
+    TextWriter text(out);
+    text.put("{\"threads\": ");
+    text.put_int(snapshot.thread_count);
+    text.put(", \"counters\": {");
+    for (Int32 c = 0; c < metric_counter_count; ++c) {
+        text.put(c == 0 ? "\"" : ", \"");
+        text.put(metric_counter_names[c]);
+        text.put("\": ");
+        text.put_int(snapshot.counters[c]);
+    }
+    text.put("}, \"kernels\": {");
+    for (Int32 k = 0; k < metric_kernel_count; ++k) {
+        const LatencyHistogram& compute = snapshot.compute[k];
+        text.put(k == 0 ? "\"" : ", \"");
+        text.put(metric_kernel_names[k]);
+        text.put("\": {\"calls\": ");
+        text.put_int(snapshot.calls[k]);
+        text.put(", \"timed\": ");
+        text.put_int(compute.count());
+        text.put(", \"mean_us\": ");
+        text.put_fixed(compute.mean_ns() / ns_per_us);
+        text.put(", \"p50_us\": ");
+        text.put_fixed(static_cast<Float64>(compute.percentile_ns(0.5)) / ns_per_us);
+        text.put(", \"p90_us\": ");
+        text.put_fixed(static_cast<Float64>(compute.percentile_ns(0.9)) / ns_per_us);
+        text.put(", \"p99_us\": ");
+        text.put_fixed(static_cast<Float64>(compute.percentile_ns(0.99)) / ns_per_us);
+        text.put(", \"max_us\": ");
+        text.put_fixed(static_cast<Float64>(compute.max_ns()) / ns_per_us);
+        text.put('}');
+    }
+    text.put("}}");
+}
+
+void print_prometheus(std::ostream& out, const MetricsSnapshot& snapshot) {
+    TextWriter text(out);
+    for (Int32 c = 0; c < metric_counter_count; ++c) {
+        put_counter_help(text, metric_counter_names[c], counter_help[c]);
+        text.put("xpmfd_");
+        text.put(metric_counter_names[c]);
+        text.put("_total ");
+        text.put_int(snapshot.counters[c]);
+        text.put('\n');
+    }
+
+    put_counter_help(text, "kernel_calls", "Kernel calls, timed or not.");
+    for (Int32 k = 0; k < metric_kernel_count; ++k) {
+        text.put("xpmfd_kernel_calls_total{kernel=\"");
+        text.put(metric_kernel_names[k]);
+        text.put("\"} ");
+        text.put_int(snapshot.calls[k]);
+        text.put('\n');
+    }
+
+    text.put("# HELP xpmfd_kernel_seconds Compute time of the timed kernel calls.\n");
+    text.put("# TYPE xpmfd_kernel_seconds histogram\n");
+    for (Int32 k = 0; k < metric_kernel_count; ++k) {
+        const LatencyHistogram& compute = snapshot.compute[k];
+        Int64 cumulative = 0;
+        Int32 bucket = 0;
+        for (Int32 p = 0; p < prometheus_bucket_count; ++p) {
+            while (bucket < histogram_bucket_count &&
+                   LatencyHistogram::upper_edge(bucket) <= prometheus_buckets[p].bound_ns) {
+                cumulative += compute.bucket_count(bucket);
+                ++bucket;
+            }
+            text.put("xpmfd_kernel_seconds_bucket{kernel=\"");
+            text.put(metric_kernel_names[k]);
+            text.put("\",le=\"");
+            text.put(prometheus_buckets[p].label);
+            text.put("\"} ");
+            text.put_int(cumulative);
+            text.put('\n');
+        }
+        text.put("xpmfd_kernel_seconds_bucket{kernel=\"");
+        text.put(metric_kernel_names[k]);
+        text.put("\",le=\"+Inf\"} ");
+        text.put_int(compute.count());
+        text.put("\nxpmfd_kernel_seconds_sum{kernel=\"");
+        text.put(metric_kernel_names[k]);
+        text.put("\"} ");
+        put_number(text, static_cast<Float64>(compute.sum_ns()) / ns_per_s);
+        text.put("\nxpmfd_kernel_seconds_count{kernel=\"");
+        text.put(metric_kernel_names[k]);
+        text.put("\"} ");
+        text.put_int(compute.count());
+        text.put('\n');
+    }
+}
+
+} // namespace xplane_mfd::calc
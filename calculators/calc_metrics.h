@@ -0,0 +1,114 @@
+// Calculator Metrics for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Always-on counters of the resident calculators (mfd_calcd, flight_calculator
+// --serve, the C API): calls and compute time per kernel, parse failures and
+// rejected inputs, flight result cache hits, and the degenerate-input
+// branches of the kernels (wings-level turns, the VNAV distance and
+// groundspeed floors), so a live rig shows its hot paths and bad inputs.
+//
+// Every thread counts into its own shard, claimed on its first count and
+// cache-line aligned, so counting never contends: the shard's only writer
+// adds with a relaxed atomic load and store, no locked instruction. A
+// compute time is a bucket of a LatencyHistogram layout
+// (latency_histogram.h) added the same way. metrics_snapshot sums the
+// shards when read; a snapshot taken while threads count may be a count or
+// two behind, never torn within a value. The first metrics_max_threads - 1
+// threads get shards of their own; later ones share the last shard and add
+// to it with atomic read-modify-writes, so it stays exact. Counts are kept
+// for the life of the process, so every counter only grows.
+//
+// The kernels themselves are not instrumented (their batch and SIMD loops
+// stay as they are); a front end counts around the calls it makes.
+//
+// Storage is fixed (AV Rule 206): metrics_max_threads shards in static
+// storage, never allocated.
+//
+// AV Rule 126: C++ style comments only (//)
+
+#ifndef CALC_METRICS_H
+#define CALC_METRICS_H
+
+#include <array>
+#include <ostream>
+#include "jsf_types.h"
+#include "latency_histogram.h"
+
+namespace xplane_mfd::calc {
+
+struct CacheCounters;  // flight_kernels.h
+
+// Counters (AV Rule 52: lowercase)
+const Int32 metric_requests = 0;               // request lines (and shared-memory frames) answered
+const Int32 metric_request_errors = 1;         // request lines rejected whole
+const Int32 metric_parse_failures = 2;         // sections or lines with a field that is not a number
+const Int32 metric_section_errors = 3;         // sections whose inputs were rejected
+const Int32 metric_cache_hits = 4;             // flight envelope, energy and glide results reused
+const Int32 metric_cache_misses = 5;
+const Int32 metric_turn_wings_level = 6;       // turns computed on the wings-level branch
+const Int32 metric_vnav_distance_floor = 7;    // VNAV distances raised to their floor
+const Int32 metric_vnav_groundspeed_floor = 8; // VNAV groundspeeds raised to their floor
+const Int32 metric_footprint_sweeps = 9;       // glide footprints swept again
+const Int32 metric_counter_count = 10;
+
+// Kernels, numbered as mfd_calcd's sections
+const Int32 metric_kernel_flight = 0;
+const Int32 metric_kernel_turn = 1;
+const Int32 metric_kernel_vnav = 2;
+const Int32 metric_kernel_density = 3;
+const Int32 metric_kernel_dynamic = 4;
+const Int32 metric_kernel_footprint = 5;
+const Int32 metric_kernel_wind_estimate = 6;
+const Int32 metric_kernel_count = 7;
+
+const Int32 metrics_max_threads = 64;
+
+// Metric names: in JSON as they are, in Prometheus text as
+// xpmfd_<name>_total and the kernel label
+extern const char* const metric_counter_names[metric_counter_count];
+extern const char* const metric_kernel_names[metric_kernel_count];
+
+// The sum of every thread's shard
+struct MetricsSnapshot {
+    std::array<Int64, metric_counter_count> counters;
+    std::array<Int64, metric_kernel_count> calls;
+    std::array<LatencyHistogram, metric_kernel_count> compute;  // of the timed calls
+    Int32 thread_count;                                         // shards in use
+};
+
+// Add to one of the calling thread's counters
+void metrics_count(Int32 counter, Int64 amount);
+
+// One call of a kernel, with its compute time (a negative duration: the
+// call was not timed)
+void metrics_kernel_call(Int32 kernel, Int64 duration_ns);
+
+// Steady-clock nanoseconds, for timing a call
+Int64 metrics_now_ns();
+
+// The inputs' degenerate branches, counted as calculate_turn_performance
+// and calculate_vnav take them
+void metrics_count_turn_inputs(Float64 bank_deg);
+void metrics_count_vnav_inputs(Float64 distance_nm, Float64 groundspeed_kts);
+
+// A result cache's hits and misses between two readings of its counters
+void metrics_count_cache(const CacheCounters& before, const CacheCounters& after);
+
+void metrics_snapshot(MetricsSnapshot& snapshot);
+
+// Write the JSON object (one line, no trailing newline):
+// {"threads": n, "counters": {"requests": n, ...},
+//  "kernels": {"flight": {"calls": n, "timed": n, "mean_us": x, "p50_us": x,
+//  "p90_us": x, "p99_us": x, "max_us": x}, ...}}
+void print_json(std::ostream& out, const MetricsSnapshot& snapshot);
+
+// Write the Prometheus text exposition format: a counter per counter, and
+// per kernel a calls counter and an xpmfd_kernel_seconds histogram. The
+// histogram's le buckets are fixed; each takes the samples of the
+// LatencyHistogram buckets whose upper edge is within it, so a count may
+// land one le bucket high (never low).
+void print_prometheus(std::ostream& out, const MetricsSnapshot& snapshot);
+
+} // namespace xplane_mfd::calc
+
+#endif // CALC_METRICS_H
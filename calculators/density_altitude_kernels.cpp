@@ -0,0 +1,167 @@
+// Density Altitude Kernels for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Implementation of the kernels declared in density_altitude_kernels.h.
+//
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#include <cmath>
+#include "density_altitude_kernels.h"
+#include "isa_table.h"
+#include "wire_format.h"
+#include "calc_io.h"
+
+namespace xplane_mfd::calc {
+
+// Physical constants (AV Rule 52: lowercase); the standard atmosphere
+// constants are in isa_table.h
+const Float64 density_alt_factor = 120.0;
+const Float64 min_ias_for_ratio = 10.0;
+
+// Validation ranges (the ISA table covers the same altitudes)
+const Float64 min_altitude_ft = isa_table_min_ft;
+const Float64 max_altitude_ft = isa_table_max_ft;
+const Float64 min_temperature_c = -60.0;
+const Float64 max_temperature_c = 60.0;
+
+bool density_altitude_inputs_valid(Float64 pressure_altitude_ft, Float64 oat_celsius) {
+    bool altitude_ok = pressure_altitude_ft >= min_altitude_ft && pressure_altitude_ft <= max_altitude_ft;
+    bool temperature_ok = oat_celsius >= min_temperature_c && oat_celsius <= max_temperature_c;
+    return altitude_ok && temperature_ok;
+}
+
+// Calculate ISA temperature at given pressure altitude
+Float64 isa_temperature_c(Float64 pressure_altitude_ft) {
+    return sea_level_temp_c - (temp_lapse_rate * pressure_altitude_ft);
+}
+
+// Calculate density altitude using exact formula
+// DA = PA + [120 * (OAT - ISA)]
+Float64 calculate_density_altitude(Float64 pressure_altitude_ft, Float64 oat_celsius) {
+    // ISA temperature at pressure altitude
+    Float64 isa_temp = isa_temperature_c(pressure_altitude_ft);
+    
+    // Temperature deviation from ISA
+    Float64 temp_deviation = oat_celsius - isa_temp;
+    
+    // Density altitude approximation (good to about 1% accuracy)
+    Float64 density_altitude = pressure_altitude_ft + (density_alt_factor * temp_deviation);
+    
+    return density_altitude;
+}
+
+namespace {
+
+// σ from the pressure ratio and the actual air temperature
+Float64 density_ratio_at(Float64 pressure_ratio, Float64 oat_celsius) {
+    // Convert to absolute temperature
+    Float64 temp_k = convert<Celsius, Kelvin>(oat_celsius);
+    Float64 sea_level_temp_k = convert<Celsius, Kelvin>(sea_level_temp_c);
+    
+    // Temperature ratio
+    Float64 temp_ratio = sea_level_temp_k / temp_k;
+    
+    // Density ratio: σ = (P/P₀) * (T₀/T)
+    Float64 sigma = pressure_ratio * temp_ratio;
+    
+    return sigma;
+}
+
+} // namespace
+
+// Calculate air density ratio (sigma)
+// σ = ρ / ρ₀
+Float64 calculate_density_ratio(Float64 pressure_altitude_ft, Float64 oat_celsius) {
+    // Pressure ratio (standard atmosphere table)
+    return density_ratio_at(isa_pressure_ratio(pressure_altitude_ft), oat_celsius);
+}
+
+// Calculate Equivalent Airspeed (EAS)
+// EAS = TAS * sqrt(σ)
+Float64 calculate_eas(Float64 tas_kts, Float64 sigma) {
+    return tas_kts * sqrt(sigma);
+}
+
+// Calculate True Airspeed from EAS (inverse of calculate_eas)
+// TAS = EAS / sqrt(σ)
+Float64 calculate_tas_from_eas(Float64 eas_kts, Float64 sigma) {
+    return eas_kts / sqrt(sigma);
+}
+
+// Calculate complete density altitude data
+DensityAltitudeData calculate_density_altitude_data(
+    Float64 pressure_altitude_ft,
+    Float64 oat_celsius,
+    Float64 ias_kts,
+    Float64 tas_kts
+) {
+    DensityAltitudeData result;
+    
+    result.pressure_altitude_ft = pressure_altitude_ft;
+    result.density_altitude_ft = calculate_density_altitude(pressure_altitude_ft, oat_celsius);
+    
+    // ISA temperature at this altitude
+    Float64 isa_temp = isa_temperature_c(pressure_altitude_ft);
+    result.temperature_deviation_c = oat_celsius - isa_temp;
+    
+    // Pressure ratio, looked up once for σ and the result
+    result.pressure_ratio = isa_pressure_ratio(pressure_altitude_ft);
+    
+    // Air density ratio
+    result.air_density_ratio = density_ratio_at(result.pressure_ratio, oat_celsius);
+    
+    // Performance loss (inverse of density ratio)
+    result.performance_loss_pct = (1.0 - result.air_density_ratio) * 100.0;
+    
+    // Equivalent airspeed
+    result.eas_kts = calculate_eas(tas_kts, result.air_density_ratio);
+    
+    // TAS/IAS ratio (useful for quick mental calculations)
+    if (ias_kts > min_ias_for_ratio) {
+        result.tas_to_ias_ratio = tas_kts / ias_kts;
+    } else {
+        result.tas_to_ias_ratio = 1.0;
+    }
+    
+    return result;
+}
+
+// Output results as JSON
+void print_json(std::ostream& out, const DensityAltitudeData& da, bool single_line) {
+    const char* nl = single_line ? "" : "\n";
+    const char* in1 = single_line ? "" : "  ";
+    
+    TextWriter text(out);
+    text.put('{');
+    text.put(nl);
+    put_json_member(text, in1, "density_altitude_ft", da.density_altitude_ft, false, nl);
+    put_json_member(text, in1, "pressure_altitude_ft", da.pressure_altitude_ft, false, nl);
+    put_json_member(text, in1, "air_density_ratio", da.air_density_ratio, false, nl);
+    put_json_member(text, in1, "temperature_deviation_c", da.temperature_deviation_c, false, nl);
+    put_json_member(text, in1, "performance_loss_pct", da.performance_loss_pct, false, nl);
+    put_json_member(text, in1, "eas_kts", da.eas_kts, false, nl);
+    put_json_member(text, in1, "tas_to_ias_ratio", da.tas_to_ias_ratio, false, nl);
+    put_json_member(text, in1, "pressure_ratio", da.pressure_ratio, true, nl);
+    text.put('}');
+}
+
+void print_binary(std::ostream& out, const DensityAltitudeData& da) {
+    WireRecord record(wire_record_density_altitude);
+    record.put_float64(da.density_altitude_ft);
+    record.put_float64(da.pressure_altitude_ft);
+    record.put_float64(da.air_density_ratio);
+    record.put_float64(da.temperature_deviation_c);
+    record.put_float64(da.performance_loss_pct);
+    record.put_float64(da.eas_kts);
+    record.put_float64(da.tas_to_ias_ratio);
+    record.put_float64(da.pressure_ratio);
+    record.write_to(out);
+}
+
+} // namespace xplane_mfd::calc
@@ -0,0 +1,62 @@
+// Density Altitude Kernels for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Result type and kernels shared by density_altitude_calculator and mfd_calcd.
+//
+// AV Rule 126: C++ style comments only (//)
+
+#ifndef DENSITY_ALTITUDE_KERNELS_H
+#define DENSITY_ALTITUDE_KERNELS_H
+
+#include <ostream>
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+struct DensityAltitudeData {
+    Float64 density_altitude_ft;      // Density altitude
+    Float64 pressure_altitude_ft;     // Pressure altitude (from setting)
+    Float64 air_density_ratio;        // σ (sigma) - ratio to sea level
+    Float64 temperature_deviation_c;  // Deviation from ISA
+    Float64 performance_loss_pct;     // % performance loss vs sea level
+    Float64 eas_kts;                  // Equivalent airspeed
+    Float64 tas_to_ias_ratio;         // TAS/IAS ratio
+    Float64 pressure_ratio;           // Pressure ratio vs sea level
+};
+
+// True if pressure altitude and OAT are inside the validated range
+bool density_altitude_inputs_valid(Float64 pressure_altitude_ft, Float64 oat_celsius);
+
+// Calculate ISA temperature at given pressure altitude
+Float64 isa_temperature_c(Float64 pressure_altitude_ft);
+
+// Calculate density altitude using exact formula
+Float64 calculate_density_altitude(Float64 pressure_altitude_ft, Float64 oat_celsius);
+
+// Calculate air density ratio (sigma)
+Float64 calculate_density_ratio(Float64 pressure_altitude_ft, Float64 oat_celsius);
+
+// Calculate Equivalent Airspeed (EAS)
+Float64 calculate_eas(Float64 tas_kts, Float64 sigma);
+
+// Calculate True Airspeed from EAS (inverse of calculate_eas)
+Float64 calculate_tas_from_eas(Float64 eas_kts, Float64 sigma);
+
+// Calculate complete density altitude data
+DensityAltitudeData calculate_density_altitude_data(
+    Float64 pressure_altitude_ft,
+    Float64 oat_celsius,
+    Float64 ias_kts,
+    Float64 tas_kts
+);
+
+// Write the JSON object (no trailing newline); single_line drops the
+// newlines and indentation for one-line replies
+void print_json(std::ostream& out, const DensityAltitudeData& da, bool single_line);
+
+// Write a wire_record_density_altitude record (wire_format.h)
+void print_binary(std::ostream& out, const DensityAltitudeData& da);
+
+} // namespace xplane_mfd::calc
+
+#endif // DENSITY_ALTITUDE_KERNELS_H
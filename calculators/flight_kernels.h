@@ -0,0 +1,403 @@
+// Flight Performance Kernels for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Result types and calculation kernels shared by flight_calculator and
+// mfd_calcd:
+// 1. Real-time wind vector with gust/turbulence analysis
+// 2. Envelope margins (stall/overspeed/buffet)
+// 3. Energy management (specific energy & trend)
+// 4. Glide reach estimation
+//
+// AV Rule 126: C++ style comments only (//)
+
+#ifndef FLIGHT_KERNELS_H
+#define FLIGHT_KERNELS_H
+
+#include <array>
+#include <ostream>
+#include "jsf_types.h"
+#include "wind_estimator.h"
+
+namespace xplane_mfd::calc {
+
+class AircraftProfile;  // aircraft_profile.h
+
+// IAS readings in the gust window (AV Rule 206: fixed at compile time).
+// Sets the SensorHistoryBuffer length used by IasHistoryBuffer below.
+const Int32 ias_history_length = 20;
+
+// 1. Wind vector calculation
+struct WindData {
+    Float64 speed_kts;
+    Float64 direction_from;  // deg, where wind comes FROM
+    Float64 headwind;
+    Float64 crosswind;
+    Float64 gust_factor;
+};
+
+// 2. Envelope margins
+struct EnvelopeMargins {
+    Float64 stall_margin_pct;
+    Float64 vmo_margin_pct;
+    Float64 mmo_margin_pct;
+    Float64 min_margin_pct;
+    Float64 load_factor;
+    Float64 corner_speed_kts;
+};
+
+// 3. Energy management
+struct EnergyData {
+    Float64 specific_energy_ft;
+    Float64 energy_rate_kts;
+    Int32 trend;  // 1=increasing, 0=stable, -1=decreasing
+};
+
+// 4. Glide reach
+struct GlideData {
+    Float64 still_air_range_nm;
+    Float64 wind_adjusted_range_nm;
+    Float64 glide_ratio;
+    Float64 best_glide_speed_kts;
+};
+
+// A JSF-compliant ring buffer for managing sensor history.
+// AV Rule 206: All memory is contained within the struct and is fixed at compile time.
+//
+// The mean and sum of squared deviations (M2) of the readings in the window
+// are kept up to date by Welford's update, so adding a reading and reading
+// the statistics are O(1). Once per pass around the ring they are recomputed
+// from the stored readings, which bounds the rounding drift of the
+// remove-oldest updates in a long-running process.
+template <Int32 history_length>
+struct SensorHistoryBuffer {
+    static_assert(history_length > 0, "history needs at least one reading");
+
+    //  The pre-allocated, fixed-size buffer.
+    std::array<Float64, history_length> data;
+
+    Int32 head_index = 0;
+    Int32 current_size = 0;
+    Float64 mean = 0.0;
+    Float64 m2 = 0.0;
+
+    void add_reading(Float64 new_ias) {
+        if (current_size < history_length) {
+            // The buffer size grows until it's full.
+            current_size++;
+            Float64 delta = new_ias - mean;
+            mean += delta / current_size;
+            m2 += delta * (new_ias - mean);
+        } else {
+            // Full: the new reading replaces the oldest one
+            Float64 old_ias = data[head_index];
+            Float64 old_mean = mean;
+            mean += (new_ias - old_ias) / current_size;
+            m2 += (new_ias - old_ias) * (new_ias - mean + old_ias - old_mean);
+        }
+        data[head_index] = new_ias;
+
+        // Move the head to the next position, wrapping around if necessary.
+        head_index = (head_index + 1) % history_length;
+
+        if (head_index == 0) {
+            resync_statistics();
+        }
+    }
+
+    const Float64* get_data_ptr() const {
+        return data.data();
+    }
+
+    Int32 get_size() const {
+        return current_size;
+    }
+
+    Float64 get_mean() const {
+        return mean;
+    }
+
+    // Population variance of the readings in the window
+    Float64 get_variance() const {
+        Float64 variance = 0.0;
+        if (current_size > 0 && m2 > 0.0) {
+            variance = m2 / current_size;
+        }
+        return variance;
+    }
+
+private:
+    // Two-pass mean and M2 over the stored readings
+    void resync_statistics() {
+        Float64 sum = 0.0;
+        for (Int32 i = 0; i < current_size; ++i) {
+            sum += data[i];
+        }
+        mean = sum / current_size;
+
+        Float64 sum_sq = 0.0;
+        for (Int32 i = 0; i < current_size; ++i) {
+            Float64 deviation = data[i] - mean;
+            sum_sq += deviation * deviation;
+        }
+        m2 = sum_sq;
+    }
+};
+
+// Gust history of the flight kernels
+using IasHistoryBuffer = SensorHistoryBuffer<ias_history_length>;
+
+// Number of numeric fields in one flight calculator request
+const Int32 flight_input_count = 14;
+
+// One flight calculator request, in argv / --serve field order
+struct FlightInputs {
+    Float64 tas_kts;
+    Float64 gs_kts;
+    Float64 heading;
+    Float64 track;
+    Float64 ias_kts;
+    Float64 mach;
+    Float64 altitude_ft;
+    Float64 agl_ft;
+    Float64 vs_fpm;
+    Float64 weight_kg;
+    Float64 bank_deg;
+    Float64 vso_kts;
+    Float64 vne_kts;
+    Float64 mmo;
+};
+
+// All four flight calculator results for one request
+struct FlightResults {
+    WindData wind;
+    EnvelopeMargins envelope;
+    EnergyData energy;
+    GlideData glide;
+};
+
+// Parse flight_input_count text fields into inputs
+bool parse_flight_inputs(const char* const* fields, FlightInputs& inputs);
+
+// Inputs from flight_input_count values in the same field order
+FlightInputs flight_inputs_from_values(const Float64* values);
+
+[[nodiscard]] unsigned long long binomial_coefficient(unsigned int n, unsigned int k);
+
+// AV Rule 58: Long parameter lists formatted one per line
+WindData calculate_wind_vector(
+    Float64 tas_kts,
+    Float64 gs_kts,
+    Float64 heading_deg,
+    Float64 track_deg,
+    const IasHistoryBuffer& ias_history  // Past airspeeds for gust calc
+);
+
+// AV Rule 58: Long parameter lists formatted one per line
+EnvelopeMargins calculate_envelope(
+    Float64 bank_deg,
+    Float64 ias_kts,
+    Float64 mach,
+    Float64 vso_kts,
+    Float64 vne_kts,
+    Float64 mmo
+);
+
+EnergyData calculate_energy(Float64 tas_kts, Float64 altitude_ft, Float64 vs_fpm);
+
+GlideData calculate_glide_reach(Float64 agl_ft, Float64 tas_kts, Float64 headwind_kts);
+
+// Glide reach from the profile's L/D table. The ratio and still-air range
+// are at the best L/D; the wind-adjusted range is the best over the
+// table's speeds of L/D times groundspeed over TAS (each point's TAS from
+// its IAS at the current tas/ias ratio), and best_glide_speed_kts is the
+// IAS that reaches it.
+GlideData calculate_glide_reach(const AircraftProfile& profile, Float64 agl_ft, Float64 ias_kts,
+                                Float64 tas_kts, Float64 headwind_kts);
+
+// Structure-of-arrays batch evaluation (offline flight-log replay).
+// Row i of each input column produces row i of each output column, using
+// the scalar kernels above so both paths give identical results. Columns
+// must not overlap. Integer results (trend) are stored as Float64 so every
+// column has the same type.
+struct EnvelopeBatchInputs {
+    const Float64* bank_deg;
+    const Float64* ias_kts;
+    const Float64* mach;
+    const Float64* vso_kts;
+    const Float64* vne_kts;
+    const Float64* mmo;
+};
+
+struct EnvelopeBatchOutputs {
+    Float64* stall_margin_pct;
+    Float64* vmo_margin_pct;
+    Float64* mmo_margin_pct;
+    Float64* min_margin_pct;
+    Float64* load_factor;
+    Float64* corner_speed_kts;
+};
+
+struct EnergyBatchInputs {
+    const Float64* tas_kts;
+    const Float64* altitude_ft;
+    const Float64* vs_fpm;
+};
+
+struct EnergyBatchOutputs {
+    Float64* specific_energy_ft;
+    Float64* energy_rate_kts;
+    Float64* trend;
+};
+
+struct GlideBatchInputs {
+    const Float64* agl_ft;
+    const Float64* tas_kts;
+    const Float64* headwind_kts;
+};
+
+struct GlideBatchOutputs {
+    Float64* still_air_range_nm;
+    Float64* wind_adjusted_range_nm;
+    Float64* glide_ratio;
+    Float64* best_glide_speed_kts;
+};
+
+void calculate_envelope_batch(const EnvelopeBatchInputs& in, const EnvelopeBatchOutputs& out, Int32 count);
+
+void calculate_energy_batch(const EnergyBatchInputs& in, const EnergyBatchOutputs& out, Int32 count);
+
+void calculate_glide_reach_batch(const GlideBatchInputs& in, const GlideBatchOutputs& out, Int32 count);
+
+// Run all four calculations for one request
+FlightResults calculate_flight(const FlightInputs& in, const IasHistoryBuffer& ias_history);
+
+// How far each input may move before results derived from it are
+// recomputed (absolute, in the field's units). A reused result is the one
+// for inputs up to these amounts away, which is not always below the
+// 2-decimal output: specific energy may be stale by 0.5 ft of altitude
+// plus about 1.1 ft from TAS at 250 kt, the energy rate by 0.01 kt, the
+// envelope margins by about 0.02 % at 250 kt and the glide ranges by
+// about 0.001 nm.
+const FlightInputs flight_input_epsilon = {
+    0.05,    // tas_kts
+    0.05,    // gs_kts
+    0.01,    // heading
+    0.01,    // track
+    0.05,    // ias_kts
+    0.0005,  // mach
+    0.5,     // altitude_ft
+    0.5,     // agl_ft
+    1.0,     // vs_fpm
+    0.5,     // weight_kg
+    0.05,    // bank_deg
+    0.01,    // vso_kts
+    0.01,    // vne_kts
+    0.0001   // mmo
+};
+const Float64 headwind_epsilon_kts = 0.05;
+
+// Hit / miss counts of one cached kernel
+struct CacheCounters {
+    Int64 hits = 0;
+    Int64 misses = 0;
+};
+
+// Results of the last samples of a resident calculator, reused while
+// their inputs stay within flight_input_epsilon.
+// Envelope, energy and glide each remember the inputs they were computed
+// from and are recomputed only once one of those drifts past its epsilon,
+// so slow drift is still picked up. Wind is recomputed every sample: its
+// gust factor follows the IAS history.
+class FlightResultCache {
+public:
+    FlightResults calculate(const FlightInputs& in, const IasHistoryBuffer& ias_history);
+
+    // Same, with glide from the profile (null: the fixed-ratio kernel).
+    // A profiled glide result also depends on ias_kts.
+    FlightResults calculate(const FlightInputs& in, const IasHistoryBuffer& ias_history,
+                            const AircraftProfile* profile);
+
+    const CacheCounters& envelope_counters() const {
+        return envelope_counters_;
+    }
+
+    const CacheCounters& energy_counters() const {
+        return energy_counters_;
+    }
+
+    const CacheCounters& glide_counters() const {
+        return glide_counters_;
+    }
+
+    // Envelope, energy and glide together
+    CacheCounters total_counters() const {
+        CacheCounters total;
+        total.hits = envelope_counters_.hits + energy_counters_.hits + glide_counters_.hits;
+        total.misses = envelope_counters_.misses + energy_counters_.misses + glide_counters_.misses;
+        return total;
+    }
+
+    // {"envelope": {"hits": n, "misses": n}, "energy": ..., "glide": ...}
+    void print_json_stats(std::ostream& out) const;
+
+private:
+    bool valid_ = false;
+    FlightResults results_ = {};
+    FlightInputs envelope_basis_ = {};
+    FlightInputs energy_basis_ = {};
+    FlightInputs glide_basis_ = {};
+    Float64 glide_headwind_basis_ = 0.0;
+    const AircraftProfile* glide_profile_basis_ = nullptr;
+    CacheCounters envelope_counters_;
+    CacheCounters energy_counters_;
+    CacheCounters glide_counters_;
+};
+
+// Per-process state of a resident flight calculator (--serve, mfd_calcd):
+// with the flight kernels' history and cache, the filtered wind and the
+// winds seen by altitude (wind_estimator.h)
+struct ResidentFlightState {
+    IasHistoryBuffer ias_history;
+    FlightResultCache results;
+    WindEstimator wind_estimator;
+    WindProfileStore wind_profile;
+};
+
+// Add the request's IAS to the history, then run all four calculations,
+// reusing cached results whose inputs haven't changed. Resident callers
+// keep one state across requests so the gust factor follows the live IAS
+// stream.
+FlightResults calculate_flight_sample(const FlightInputs& in, ResidentFlightState& state);
+
+// Number of fields of a flight request without the aircraft's limits: the
+// flight fields up to bank_deg
+const Int32 flight_dynamic_input_count = 11;
+
+// A sample of an aircraft whose limits and glide performance come from its
+// profile: in's vso_kts, vne_kts and mmo are replaced by the profile's
+FlightResults calculate_flight_sample(const FlightInputs& in, ResidentFlightState& state,
+                                      const AircraftProfile& profile);
+
+// Fill the gust history with the demonstration IAS readings used by the
+// one-shot calculator (a single process has no real samples to keep)
+void seed_ias_history(IasHistoryBuffer& ias_buffer);
+
+// Write the combined JSON object (no trailing newline).
+// single_line drops the newlines and indentation so a resident process can
+// answer each request with exactly one line.
+void print_json_results(std::ostream& out, const FlightResults& results, bool single_line);
+
+// Same object with a trailing "compute_us" member (resident replies)
+void print_json_results(std::ostream& out, const FlightResults& results, bool single_line,
+                        Float64 compute_us);
+
+// Records written by print_binary_results
+const Int32 flight_wire_record_count = 4;
+
+// Write the wind, envelope, energy and glide records back to back
+// (wire_format.h); the alternate airport demo values are JSON only.
+void print_binary_results(std::ostream& out, const FlightResults& results);
+
+} // namespace xplane_mfd::calc
+
+#endif // FLIGHT_KERNELS_H
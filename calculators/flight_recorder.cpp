@@ -0,0 +1,307 @@
+// Flight-Data Recorder for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Implementation of the recorder and reader declared in flight_recorder.h.
+//
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses return codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (fixed ring and batch; the
+//   log is mapped once to read)
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "flight_recorder.h"
+
+namespace xplane_mfd::calc {
+
+namespace {
+
+const Int64 image_alignment = 8;
+const Int64 header_bytes = static_cast<Int64>(sizeof(FlightLogHeader));
+const Int64 record_bytes = static_cast<Int64>(sizeof(FlightLogRecord));
+const Uint64 ring_mask = static_cast<Uint64>(flight_log_ring_records - 1);
+
+// pwrite the whole buffer, retrying short writes and interrupts
+bool write_all_at(Int32 fd, const void* data, Int64 size, Int64 offset) {
+    const char* bytes = static_cast<const char*>(data);
+    bool ok = true;
+    while (ok && size > 0) {
+        ssize_t n = pwrite(fd, bytes, static_cast<size_t>(size), static_cast<off_t>(offset));
+        if (n > 0) {
+            bytes += n;
+            size -= n;
+            offset += n;
+        } else {
+            ok = n < 0 && errno == EINTR;
+        }
+    }
+    return ok;
+}
+
+bool image_valid(const void* image, Int64 size) {
+    bool valid = image != nullptr && size >= header_bytes &&
+                 reinterpret_cast<std::uintptr_t>(image) % image_alignment == 0;
+    const FlightLogHeader* header = static_cast<const FlightLogHeader*>(image);
+    if (valid) {
+        valid = header->magic == flight_log_magic && header->version == flight_log_version &&
+                header->header_size == static_cast<Uint32>(header_bytes) &&
+                header->record_size == static_cast<Uint32>(record_bytes) &&
+                header->record_count >= 0 && header->dropped_count >= 0;
+    }
+    return valid;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// FlightLogRing
+// ---------------------------------------------------------------------------
+
+FlightLogRing::FlightLogRing() : enqueue_ticket_(0), dequeue_ticket_(0) {
+    reset();
+}
+
+void FlightLogRing::reset() {
+    for (Int32 i = 0; i < flight_log_ring_records; ++i) {
+        slots_[i].sequence.store(static_cast<Uint64>(i), std::memory_order_relaxed);
+    }
+    enqueue_ticket_.store(0, std::memory_order_relaxed);
+    dequeue_ticket_ = 0;
+}
+
+bool FlightLogRing::push(const FlightLogRecord& record, Int64 time_ns) {
+    bool queued = false;
+    bool full = false;
+    Uint64 ticket = enqueue_ticket_.load(std::memory_order_relaxed);
+    while (!queued && !full) {
+        Slot& slot = slots_[ticket & ring_mask];
+        Uint64 sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence == ticket) {
+            // Free for this ticket: claim it, or retry with the ticket
+            // another producer got first
+            if (enqueue_ticket_.compare_exchange_weak(ticket, ticket + 1, std::memory_order_relaxed)) {
+                slot.record = record;
+                slot.record.index = static_cast<Int64>(ticket);
+                slot.record.time_ns = time_ns;
+                slot.sequence.store(ticket + 1, std::memory_order_release);
+                queued = true;
+            }
+        } else if (sequence < ticket) {
+            // Still holding the record of ticket - ring size: the ring is full
+            full = true;
+        } else {
+            ticket = enqueue_ticket_.load(std::memory_order_relaxed);
+        }
+    }
+    return queued;
+}
+
+bool FlightLogRing::pop(FlightLogRecord& record) {
+    Slot& slot = slots_[dequeue_ticket_ & ring_mask];
+    bool ready = slot.sequence.load(std::memory_order_acquire) == dequeue_ticket_ + 1;
+    if (ready) {
+        record = slot.record;
+        slot.sequence.store(dequeue_ticket_ + flight_log_ring_records, std::memory_order_release);
+        ++dequeue_ticket_;
+    }
+    return ready;
+}
+
+// ---------------------------------------------------------------------------
+// FlightRecorder
+// ---------------------------------------------------------------------------
+
+FlightRecorder::FlightRecorder()
+    : written_(0), dropped_(0), allocated_records_(0), start_unix_ns_(0), fd_(-1), write_failed_(false),
+      stopping_(false) {
+}
+
+FlightRecorder::~FlightRecorder() {
+    close();
+}
+
+bool FlightRecorder::open(const char* path) {
+    bool ok = false;
+    Int32 fd = fd_ < 0 ? ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644) : -1;
+    if (fd >= 0) {
+        fd_ = fd;
+        ring_.reset();
+        written_.store(0, std::memory_order_relaxed);
+        dropped_.store(0, std::memory_order_relaxed);
+        write_failed_ = false;
+        start_time_ = std::chrono::steady_clock::now();
+        start_unix_ns_ = static_cast<Int64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        allocated_records_ = flight_log_segment_records;
+        ok = posix_fallocate(fd_, 0, static_cast<off_t>(header_bytes + allocated_records_ * record_bytes)) == 0 &&
+             write_header();
+        if (ok) {
+            stopping_ = false;
+            flusher_ = std::thread(&FlightRecorder::flusher_main, this);
+        } else {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+    return ok;
+}
+
+void FlightRecorder::close() {
+    if (fd_ >= 0) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        stop_cv_.notify_one();
+        flusher_.join();
+
+        // The flusher has drained the ring; give back the unused segment
+        if (ftruncate(fd_, static_cast<off_t>(header_bytes + written_count() * record_bytes)) != 0) {
+            write_failed_ = true;
+        }
+        write_header();
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool FlightRecorder::record(const FlightLogRecord& record) {
+    bool queued = fd_ >= 0 &&
+        ring_.push(record, static_cast<Int64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now() - start_time_).count()));
+    if (!queued) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return queued;
+}
+
+void FlightRecorder::flusher_main() {
+    bool running = true;
+    while (running) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            stop_cv_.wait_for(lock, std::chrono::milliseconds(flight_log_flush_interval_ms),
+                              [this] { return stopping_; });
+            running = !stopping_;
+        }
+        // After the stop, one last pass takes whatever is still queued
+        while (drain()) {
+        }
+    }
+}
+
+bool FlightRecorder::drain() {
+    Int32 count = 0;
+    while (count < flight_log_write_batch && ring_.pop(batch_[count])) {
+        ++count;
+    }
+    if (count > 0) {
+        if (write_failed_ || !write_batch(count)) {
+            write_failed_ = true;
+            dropped_.fetch_add(count, std::memory_order_relaxed);
+        }
+    }
+    return count == flight_log_write_batch;
+}
+
+bool FlightRecorder::write_batch(Int32 count) {
+    Int64 first = written_count();
+    bool ok = true;
+    while (ok && first + count > allocated_records_) {
+        ok = posix_fallocate(fd_, static_cast<off_t>(header_bytes + allocated_records_ * record_bytes),
+                             static_cast<off_t>(flight_log_segment_records * record_bytes)) == 0;
+        if (ok) {
+            allocated_records_ += flight_log_segment_records;
+        }
+    }
+    // Records before the count that covers them
+    ok = ok && write_all_at(fd_, batch_.data(), count * record_bytes, header_bytes + first * record_bytes);
+    if (ok) {
+        written_.store(first + count, std::memory_order_relaxed);
+        ok = write_header();
+    }
+    return ok;
+}
+
+bool FlightRecorder::write_header() {
+    FlightLogHeader header = {};
+    header.magic = flight_log_magic;
+    header.version = flight_log_version;
+    header.header_size = static_cast<Uint32>(header_bytes);
+    header.record_size = static_cast<Uint32>(record_bytes);
+    header.record_count = written_count();
+    header.dropped_count = dropped_count();
+    header.start_unix_ns = start_unix_ns_;
+    return write_all_at(fd_, &header, header_bytes, 0);
+}
+
+// ---------------------------------------------------------------------------
+// FlightLogReader
+// ---------------------------------------------------------------------------
+
+FlightLogReader::FlightLogReader()
+    : header_(nullptr), records_(nullptr), record_count_(0), mapping_(nullptr), mapping_size_(0) {
+}
+
+FlightLogReader::~FlightLogReader() {
+    unmap();
+}
+
+void FlightLogReader::unmap() {
+    if (mapping_ != nullptr) {
+        munmap(mapping_, static_cast<size_t>(mapping_size_));
+    }
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+}
+
+bool FlightLogReader::load(const char* path) {
+    bool ok = false;
+    Int32 fd = open(path, O_RDONLY);
+    if (fd >= 0) {
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+            Int64 size = static_cast<Int64>(file_stat.st_size);
+            // Shared, so a log still being written reads as the flusher left it
+            void* mapping = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_SHARED, fd, 0);
+            if (mapping != MAP_FAILED) {
+                if (image_valid(mapping, size)) {
+                    unmap();
+                    ok = attach(mapping, size);
+                    mapping_ = mapping;
+                    mapping_size_ = size;
+                } else {
+                    munmap(mapping, static_cast<size_t>(size));
+                }
+            }
+        }
+        close(fd);
+    }
+    return ok;
+}
+
+bool FlightLogReader::attach(const void* image, Int64 size) {
+    bool ok = image_valid(image, size);
+    if (ok) {
+        if (image != mapping_) {
+            unmap();
+        }
+        header_ = static_cast<const FlightLogHeader*>(image);
+        records_ = reinterpret_cast<const FlightLogRecord*>(header_ + 1);
+        record_count_ = std::min(header_->record_count, (size - header_bytes) / record_bytes);
+    }
+    return ok;
+}
+
+} // namespace xplane_mfd::calc
@@ -0,0 +1,260 @@
+// Flight-Data Recorder for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// An append-only log of every section a resident calculator computes
+// (mfd_calcd --record <path>): the section's input values and its result
+// struct, one fixed-size record per section, for offline replay through
+// calc_batch --log and for looking back at a flight.
+//
+// Recording must not slow the compute path, so FlightRecorder::record only
+// copies the record into a preallocated ring of flight_log_ring_records
+// slots (FlightLogRing, a bounded lock-free queue: one compare-exchange on
+// a shared ticket, one release store on the slot) and returns. A flusher thread wakes every
+// flight_log_flush_interval_ms, takes what the ring holds in order and
+// writes it to the file in batches of up to flight_log_write_batch
+// records. The file grows in preallocated segments of
+// flight_log_segment_records, so a batch write never extends it. When the
+// ring is full a record is dropped and counted instead of making the
+// compute path wait; the header carries the count.
+//
+// File layout (little-endian, this build's struct layout):
+//
+//   offset  size  field                Python struct "<4I3q24x"
+//   0       4     magic "XMFL"
+//   4       4     flight_log_version
+//   8       4     header size (64)
+//   12      4     record size (320)
+//   16      8     record count: records written so far
+//   24      8     dropped count: records lost to a full ring
+//   32      8     start_unix_ns: wall-clock time the log was opened
+//   40      24    reserved (0)
+//   64      320n  records
+//
+//   record, Python struct "<4q2i2I14d" + 160 bytes of result:
+//     index        position in the log, from 0
+//     time_ns      steady-clock time since the log was opened
+//     aircraft_id  the frame's aircraft if flags has flight_log_flag_aircraft
+//     reserved     0
+//     section      flight_log_section_* (the mfd_calcd section index)
+//     status       0, or the exit code the section's calculator would return
+//     value_count  input values used (the section's field count)
+//     flags        flight_log_flag_*
+//     values       the section's inputs in request field order, NaN past
+//                  value_count
+//     result       the section's result struct, zero if status is not 0:
+//                    flight, dynamic  FlightResults        "<5d6d2di4x4d"
+//                    turn             TurnData             "<8d"
+//                    vnav             VNAVData             "<7d?7x"
+//                    density          DensityAltitudeData  "<8d"
+//                    footprint        FlightLogFootprint   "<2dq"
+//                    wind_estimate    WindEstimate         "<6dq"
+//
+// The file is preallocated past its records while open; closing truncates
+// it to the records. A reader of a log still being written takes the
+// header's count, which the flusher updates after each batch's records are
+// written. A change to this layout must bump flight_log_version.
+//
+// FlightLogReader maps a log read only for random access to its records.
+//
+// Storage is fixed (AV Rule 206): the ring and the write batch are held in
+// the recorder, and its one thread is started by open.
+//
+// AV Rule 126: C++ style comments only (//)
+
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+// File identification and sizes (AV Rule 52: lowercase)
+const Uint32 flight_log_magic = 0x4C464D58u;  // bytes 'X' 'M' 'F' 'L' little-endian
+const Uint32 flight_log_version = 1;
+const Int32 flight_log_max_values = 14;       // flight_input_count
+const Int32 flight_log_result_bytes = 160;
+
+// Recorder sizing
+const Int32 flight_log_ring_records = 4096;    // a power of two
+const Int32 flight_log_write_batch = 256;
+const Int32 flight_log_segment_records = 4096;  // 1.25 MiB of file per segment
+const Int32 flight_log_flush_interval_ms = 5;
+
+// Sections, numbered as mfd_calcd's
+const Int32 flight_log_section_flight = 0;
+const Int32 flight_log_section_turn = 1;
+const Int32 flight_log_section_vnav = 2;
+const Int32 flight_log_section_density = 3;
+const Int32 flight_log_section_dynamic = 4;
+const Int32 flight_log_section_footprint = 5;
+const Int32 flight_log_section_wind_estimate = 6;
+
+// Record flags
+const Uint32 flight_log_flag_aircraft = 1u;  // aircraft_id is set (else the requests without one)
+const Uint32 flight_log_flag_fresh = 2u;     // footprint swept / wind sample fused this frame
+
+struct FlightLogHeader {
+    Uint32 magic;
+    Uint32 version;
+    Uint32 header_size;
+    Uint32 record_size;
+    Int64 record_count;
+    Int64 dropped_count;
+    Int64 start_unix_ns;
+    Uint8 reserved[24];
+};
+
+struct FlightLogRecord {
+    Int64 index;
+    Int64 time_ns;
+    Int64 aircraft_id;
+    Int64 reserved;
+    Int32 section;
+    Int32 status;
+    Uint32 value_count;
+    Uint32 flags;
+    Float64 values[flight_log_max_values];
+    alignas(8) Uint8 result[flight_log_result_bytes];
+};
+
+// A footprint section's result: its extent, not the 360 ranges
+struct FlightLogFootprint {
+    Float64 min_range_nm;
+    Float64 max_range_nm;
+    Int64 sweep_count;
+};
+
+static_assert(sizeof(FlightLogHeader) == 64, "flight log header layout");
+static_assert(sizeof(FlightLogRecord) == 320, "flight log record layout");
+static_assert((flight_log_ring_records & (flight_log_ring_records - 1)) == 0, "ring size is a power of two");
+
+// The recorder's queue: a bounded lock-free ring of records (Vyukov's
+// bounded queue) for any number of producers and one consumer. Each slot's
+// sequence says whose turn it is: slot i holds ticket t when sequence is
+// t + 1, and is free for ticket t when sequence is t.
+class FlightLogRing {
+public:
+    FlightLogRing();
+
+    FlightLogRing(const FlightLogRing&) = delete;
+    FlightLogRing& operator=(const FlightLogRing&) = delete;
+
+    // Empty the ring and start the tickets again from 0. Nothing may push
+    // or pop meanwhile.
+    void reset();
+
+    // Copy a record in with its ticket as index and the given time; false
+    // (nothing written) if the ring is full. Never waits.
+    bool push(const FlightLogRecord& record, Int64 time_ns);
+
+    // Take the oldest record, in ticket order; false if the ring is empty.
+    // One consumer only.
+    bool pop(FlightLogRecord& record);
+
+private:
+    struct Slot {
+        std::atomic<Uint64> sequence;
+        FlightLogRecord record;
+    };
+
+    std::array<Slot, flight_log_ring_records> slots_;
+    alignas(64) std::atomic<Uint64> enqueue_ticket_;
+    alignas(64) Uint64 dequeue_ticket_;
+};
+
+class FlightRecorder {
+public:
+    FlightRecorder();
+    ~FlightRecorder();
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    // Create (or truncate) the log, write its header and first segment, and
+    // start the flusher. False if the file cannot be created or the
+    // recorder is already open.
+    bool open(const char* path);
+
+    // Write everything recorded so far, stop the flusher, and truncate the
+    // file to its records. No record call may overlap it.
+    void close();
+
+    bool is_open() const { return fd_ >= 0; }
+
+    // Queue one record; its index and time_ns are filled in here. Any
+    // thread may call it at any time without waiting. False if the ring is
+    // full or the recorder is not open: the record is dropped and counted.
+    bool record(const FlightLogRecord& record);
+
+    // Records written to the file, and records lost (a full ring, or a
+    // write that failed; nothing more is written after a failure)
+    Int64 written_count() const { return written_.load(std::memory_order_relaxed); }
+    Int64 dropped_count() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    void flusher_main();
+
+    // Move up to a batch of the ring's records to the file; false once the
+    // ring ran empty
+    bool drain();
+    bool write_batch(Int32 count);
+    bool write_header();
+
+    FlightLogRing ring_;
+    std::array<FlightLogRecord, flight_log_write_batch> batch_;
+    std::atomic<Int64> written_;
+    std::atomic<Int64> dropped_;
+    Int64 allocated_records_;
+    Int64 start_unix_ns_;
+    std::chrono::steady_clock::time_point start_time_;
+    Int32 fd_;
+    bool write_failed_;
+    std::thread flusher_;
+    std::mutex mutex_;
+    std::condition_variable stop_cv_;
+    bool stopping_;
+};
+
+class FlightLogReader {
+public:
+    FlightLogReader();
+    ~FlightLogReader();
+
+    FlightLogReader(const FlightLogReader&) = delete;
+    FlightLogReader& operator=(const FlightLogReader&) = delete;
+
+    // Map a log file read only. False (keeping any log already loaded) if it
+    // cannot be read or fails the checks of attach.
+    bool load(const char* path);
+
+    // Use a log image already in memory (8-byte aligned, kept alive by the
+    // caller). False if the header is not this build's flight log; the
+    // records are the header's count, or as many as the size holds.
+    bool attach(const void* image, Int64 size);
+
+    bool loaded() const { return header_ != nullptr; }
+
+    Int64 record_count() const { return record_count_; }
+    Int64 dropped_count() const { return header_->dropped_count; }
+    Int64 start_unix_ns() const { return header_->start_unix_ns; }
+    const FlightLogRecord& record(Int64 index) const { return records_[index]; }
+
+private:
+    void unmap();
+
+    const FlightLogHeader* header_;
+    const FlightLogRecord* records_;
+    Int64 record_count_;
+    void* mapping_;
+    Int64 mapping_size_;
+};
+
+} // namespace xplane_mfd::calc
+
+#endif // FLIGHT_RECORDER_H
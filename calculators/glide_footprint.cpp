@@ -0,0 +1,205 @@
+// Terrain-Aware Glide Footprint for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Implementation of the footprint declared in glide_footprint.h.
+//
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try)
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (fixed radial array)
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#include <algorithm>
+#include <cmath>
+#include "glide_footprint.h"
+#include "flight_kernels.h"
+#include "aircraft_profile.h"
+#include "terrain_tiles.h"
+#include "units.h"
+#include "wire_format.h"
+#include "calc_io.h"
+
+namespace xplane_mfd::calc {
+
+namespace {
+
+// Flat-earth offsets, accurate to well under a step over a glide's reach
+const Float64 minutes_per_degree = 60.0;
+const Float64 min_cos_latitude = 0.01;
+const Float64 feet_per_nautical_mile = convert<NauticalMiles, Feet>(1.0);
+
+// Nautical miles per degree of longitude at a latitude
+Float64 east_nm_per_degree(Float64 lat_deg) {
+    return minutes_per_degree * std::max(min_cos_latitude, std::cos(convert<Degrees, Radians>(lat_deg)));
+}
+
+Float64 wind_east_kts(const FootprintInputs& in) {
+    return in.wind_speed_kts * std::sin(convert<Degrees, Radians>(in.wind_from_deg));
+}
+
+Float64 wind_north_kts(const FootprintInputs& in) {
+    return in.wind_speed_kts * std::cos(convert<Degrees, Radians>(in.wind_from_deg));
+}
+
+} // namespace
+
+GlideFootprint::GlideFootprint()
+    : basis_{}, terrain_(nullptr), profile_(nullptr), range_nm_{}, min_range_nm_(0.0), max_range_nm_(0.0),
+      sweep_count_(0), pending_(false) {
+}
+
+bool GlideFootprint::begin_update(const FootprintInputs& in, const TerrainTileCache* terrain,
+                                  const AircraftProfile* profile) {
+    Float64 north_nm = (in.lat_deg - basis_.lat_deg) * minutes_per_degree;
+    Float64 east_nm = (in.lon_deg - basis_.lon_deg) * east_nm_per_degree(in.lat_deg);
+    Float64 wind_change_kts = std::hypot(wind_east_kts(in) - wind_east_kts(basis_),
+                                         wind_north_kts(in) - wind_north_kts(basis_));
+    // NaN compares false, so a bad reading always sweeps again
+    bool unchanged = sweep_count_ > 0 && terrain == terrain_ && profile == profile_ &&
+        std::hypot(north_nm, east_nm) <= footprint_move_threshold_nm &&
+        std::fabs(in.altitude_ft - basis_.altitude_ft) <= footprint_altitude_threshold_ft &&
+        std::fabs(in.ias_kts - basis_.ias_kts) <= footprint_airspeed_threshold_kts &&
+        std::fabs(in.tas_kts - basis_.tas_kts) <= footprint_airspeed_threshold_kts &&
+        wind_change_kts <= footprint_wind_threshold_kts;
+
+    pending_ = !unchanged;
+    if (pending_) {
+        basis_ = in;
+        terrain_ = terrain;
+        profile_ = profile;
+    }
+    return pending_;
+}
+
+void GlideFootprint::sweep(Int32 first_radial, Int32 end_radial) {
+    if (pending_) {
+        for (Int32 r = std::max(first_radial, 0); r < std::min(end_radial, footprint_radial_count); ++r) {
+            range_nm_[r] = sweep_radial(r);
+        }
+    }
+}
+
+void GlideFootprint::finish_update() {
+    if (pending_) {
+        min_range_nm_ = range_nm_[0];
+        max_range_nm_ = range_nm_[0];
+        for (Int32 r = 1; r < footprint_radial_count; ++r) {
+            min_range_nm_ = std::min(min_range_nm_, range_nm_[r]);
+            max_range_nm_ = std::max(max_range_nm_, range_nm_[r]);
+        }
+        ++sweep_count_;
+        pending_ = false;
+    }
+}
+
+bool GlideFootprint::update(const FootprintInputs& in, const TerrainTileCache* terrain,
+                            const AircraftProfile* profile) {
+    bool swept = begin_update(in, terrain, profile);
+    sweep(0, footprint_radial_count);
+    finish_update();
+    return swept;
+}
+
+Float64 GlideFootprint::sweep_radial(Int32 radial) const {
+    const FootprintInputs& in = basis_;
+    Float64 bearing_deg = static_cast<Float64>(radial);
+    Float64 bearing_rad = convert<Degrees, Radians>(bearing_deg);
+    Float64 headwind_kts = in.wind_speed_kts * std::cos(convert<Degrees, Radians>(in.wind_from_deg - bearing_deg));
+
+    // Distance flown per distance of height: the glide reach from one
+    // nautical mile up
+    GlideData glide;
+    if (profile_ != nullptr) {
+        glide = calculate_glide_reach(*profile_, feet_per_nautical_mile, in.ias_kts, in.tas_kts, headwind_kts);
+    } else {
+        glide = calculate_glide_reach(feet_per_nautical_mile, in.tas_kts, headwind_kts);
+    }
+    Float64 distance_ratio = std::max(0.0, glide.wind_adjusted_range_nm);
+
+    Int32 tile_hint = no_terrain_tile;
+    Float64 ground_ft = terrain_ != nullptr ? terrain_->elevation_ft(in.lat_deg, in.lon_deg, tile_hint) : 0.0;
+    Float64 margin_ft = in.altitude_ft - ground_ft;
+    Float64 range_nm = 0.0;
+
+    if (margin_ft > 0.0 && distance_ratio > 0.0) {
+        // Reach down to sea level (or the ground here, if that is lower),
+        // walked in equal steps
+        Float64 reach_nm = (in.altitude_ft - std::min(0.0, ground_ft)) * distance_ratio / feet_per_nautical_mile;
+        Float64 step_nm = reach_nm / footprint_steps_per_radial;
+        Float64 sink_ft_per_step = step_nm * feet_per_nautical_mile / distance_ratio;
+        Float64 lat_per_step = step_nm * std::cos(bearing_rad) / minutes_per_degree;
+        Float64 lon_per_step = step_nm * std::sin(bearing_rad) / east_nm_per_degree(in.lat_deg);
+
+        range_nm = reach_nm;
+        bool landed = false;
+        for (Int32 k = 1; k <= footprint_steps_per_radial && !landed; ++k) {
+            Float64 ground_k_ft = 0.0;
+            if (terrain_ != nullptr) {
+                ground_k_ft = terrain_->elevation_ft(in.lat_deg + k * lat_per_step, in.lon_deg + k * lon_per_step,
+                                                     tile_hint);
+            }
+            Float64 next_margin_ft = in.altitude_ft - k * sink_ft_per_step - ground_k_ft;
+            if (next_margin_ft <= 0.0) {
+                range_nm = step_nm * ((k - 1) + margin_ft / (margin_ft - next_margin_ft));
+                landed = true;
+            }
+            margin_ft = next_margin_ft;
+        }
+    }
+
+    return range_nm;
+}
+
+static_assert(footprint_wire_record_count == 1 + footprint_radial_count / wire_footprint_ranges_per_record,
+              "footprint ranges fill whole records");
+
+void print_json(std::ostream& out, const GlideFootprint& footprint, Float64 lat_deg, Float64 lon_deg,
+                bool recomputed) {
+    const FootprintInputs& basis = footprint.basis();
+    TextWriter text(out);
+    text.put("{\"recomputed\": ");
+    text.put(recomputed ? "true" : "false");
+    text.put(", \"sweeps\": ");
+    text.put_int(footprint.sweep_count());
+    text.put(", \"center_north_nm\": ");
+    text.put_fixed((basis.lat_deg - lat_deg) * minutes_per_degree);
+    text.put(", \"center_east_nm\": ");
+    text.put_fixed((basis.lon_deg - lon_deg) * east_nm_per_degree(lat_deg));
+    text.put(", \"min_range_nm\": ");
+    text.put_fixed(footprint.min_range_nm());
+    text.put(", \"max_range_nm\": ");
+    text.put_fixed(footprint.max_range_nm());
+    text.put(", \"range_nm\": [");
+    for (Int32 r = 0; r < footprint_radial_count; ++r) {
+        if (r > 0) {
+            text.put(", ");
+        }
+        text.put_fixed(footprint.range_nm(r));
+    }
+    text.put("]}");
+}
+
+void print_binary(std::ostream& out, const GlideFootprint& footprint, Float64 lat_deg, Float64 lon_deg,
+                  bool recomputed) {
+    const FootprintInputs& basis = footprint.basis();
+    WireRecord summary(wire_record_footprint);
+    summary.put_float64((basis.lat_deg - lat_deg) * minutes_per_degree);
+    summary.put_float64((basis.lon_deg - lon_deg) * east_nm_per_degree(lat_deg));
+    summary.put_float64(footprint.min_range_nm());
+    summary.put_float64(footprint.max_range_nm());
+    summary.put_int64(footprint.sweep_count());
+    summary.put_bool(recomputed);
+    summary.write_to(out);
+
+    for (Int32 first = 0; first < footprint_radial_count; first += wire_footprint_ranges_per_record) {
+        WireRecord ranges(wire_record_footprint_ranges);
+        for (Int32 r = first; r < first + wire_footprint_ranges_per_record; ++r) {
+            ranges.put_float64(footprint.range_nm(r));
+        }
+        ranges.write_to(out);
+    }
+}
+
+} // namespace xplane_mfd::calc
@@ -0,0 +1,118 @@
+// Terrain-Aware Glide Footprint for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// How far the aircraft can glide on each of footprint_radial_count radials
+// (radial r is r degrees true), with the wind and the terrain along each
+// one. Per radial, calculate_glide_reach (flight_kernels.h) gives the
+// distance flown per unit of height with that radial's headwind component,
+// from the fixed ratio or the aircraft profile; the path then descends from
+// the aircraft's altitude and is walked outward in
+// footprint_steps_per_radial equal steps, sampling the terrain tiles
+// (terrain_tiles.h), until it meets the ground. The crossing is
+// interpolated between the last two samples, so a ridge narrower than a
+// step can be missed; the step is the sea-level reach over
+// footprint_steps_per_radial (about 1 nm from FL350).
+//
+// A sweep costs a few hundred microseconds, so the footprint is kept and
+// swept again only once the aircraft has moved footprint_move_threshold_nm,
+// or altitude, airspeed or wind has changed past its threshold, since the
+// last sweep. Ranges are from the position of that sweep (basis()).
+//
+// An update is begin_update, sweep over the radials and finish_update.
+// Radials are independent, so sweep calls on disjoint radial ranges may run
+// on different threads (mfd_calcd splits them over its work pool); update()
+// does all three on the calling thread.
+//
+// Storage is fixed (AV Rule 206): one range per radial, held in the object.
+//
+// AV Rule 126: C++ style comments only (//)
+
+#ifndef GLIDE_FOOTPRINT_H
+#define GLIDE_FOOTPRINT_H
+
+#include <array>
+#include <ostream>
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+class AircraftProfile;   // aircraft_profile.h
+class TerrainTileCache;  // terrain_tiles.h
+
+// Sweep resolution and refresh thresholds (AV Rule 52: lowercase)
+const Int32 footprint_radial_count = 360;
+const Int32 footprint_steps_per_radial = 64;
+const Float64 footprint_move_threshold_nm = 0.25;
+const Float64 footprint_altitude_threshold_ft = 100.0;
+const Float64 footprint_airspeed_threshold_kts = 5.0;
+const Float64 footprint_wind_threshold_kts = 2.0;  // change of the wind vector
+
+struct FootprintInputs {
+    Float64 lat_deg;
+    Float64 lon_deg;
+    Float64 altitude_ft;     // MSL
+    Float64 ias_kts;         // with tas_kts, the speed ratio for a profile's L/D table
+    Float64 tas_kts;
+    Float64 wind_from_deg;
+    Float64 wind_speed_kts;
+};
+
+class GlideFootprint {
+public:
+    GlideFootprint();
+
+    // Start an update. True if the radials must be swept again: there is no
+    // sweep yet, in has moved past a threshold from basis(), or terrain or
+    // profile (either may be null) is not the one of the last sweep.
+    bool begin_update(const FootprintInputs& in, const TerrainTileCache* terrain,
+                      const AircraftProfile* profile);
+
+    // Sweep radials [first_radial, end_radial) of a begun update
+    void sweep(Int32 first_radial, Int32 end_radial);
+
+    // Minimum and maximum range once every radial is swept
+    void finish_update();
+
+    // begin_update, sweep every radial if needed, finish_update
+    bool update(const FootprintInputs& in, const TerrainTileCache* terrain, const AircraftProfile* profile);
+
+    bool valid() const { return sweep_count_ > 0; }
+    Int64 sweep_count() const { return sweep_count_; }
+
+    // Inputs of the last sweep; ranges are from its position
+    const FootprintInputs& basis() const { return basis_; }
+
+    Float64 range_nm(Int32 radial) const { return range_nm_[radial]; }
+    Float64 min_range_nm() const { return min_range_nm_; }
+    Float64 max_range_nm() const { return max_range_nm_; }
+
+private:
+    Float64 sweep_radial(Int32 radial) const;
+
+    FootprintInputs basis_;
+    const TerrainTileCache* terrain_;
+    const AircraftProfile* profile_;
+    std::array<Float64, footprint_radial_count> range_nm_;
+    Float64 min_range_nm_;
+    Float64 max_range_nm_;
+    Int64 sweep_count_;
+    bool pending_;  // begun and not yet finished, with radials to sweep
+};
+
+// Records written by print_binary: the footprint record, then the ranges
+const Int32 footprint_wire_record_count = 1 + 45;
+
+// Write the JSON object (one line, no trailing newline) of a footprint for
+// an aircraft at (lat_deg, lon_deg): center_north_nm / center_east_nm is
+// where the ranges are measured from (the last sweep's position) relative
+// to the aircraft, recomputed whether this update swept
+void print_json(std::ostream& out, const GlideFootprint& footprint, Float64 lat_deg, Float64 lon_deg,
+                bool recomputed);
+
+// Write the wire_record_footprint record and the range records (wire_format.h)
+void print_binary(std::ostream& out, const GlideFootprint& footprint, Float64 lat_deg, Float64 lon_deg,
+                  bool recomputed);
+
+} // namespace xplane_mfd::calc
+
+#endif // GLIDE_FOOTPRINT_H
@@ -0,0 +1,143 @@
+// Latency Histogram for X-Plane MFD Calculators
+// JSF AV C++ Coding Standard Compliant Version
+//
+// A fixed-size histogram of durations in nanoseconds with log-linear
+// buckets: exact below 8 ns, then 8 buckets per power of two, so any
+// percentile read back is within 12.5% of the true value over the whole
+// range of an Int64. Adding a sample is a count-leading-zeros and an
+// increment; histograms of several threads are merged for reading.
+//
+// Storage is fixed (AV Rule 206): histogram_bucket_count counters held in
+// the object.
+//
+// AV Rule 126: C++ style comments only (//)
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+// Bucket layout (AV Rule 52: lowercase)
+const Int32 histogram_sub_bucket_bits = 3;
+const Int32 histogram_sub_buckets = 1 << histogram_sub_bucket_bits;
+const Int32 histogram_bucket_count = (64 - histogram_sub_bucket_bits + 1) * histogram_sub_buckets;
+
+class LatencyHistogram {
+public:
+    LatencyHistogram() {
+        clear();
+    }
+
+    void clear() {
+        counts_.fill(0);
+        count_ = 0;
+        sum_ns_ = 0;
+        max_ns_ = 0;
+    }
+
+    // Negative durations count as 0
+    void add(Int64 duration_ns) {
+        Uint64 value = duration_ns > 0 ? static_cast<Uint64>(duration_ns) : 0u;
+        ++counts_[bucket_of(value)];
+        ++count_;
+        sum_ns_ += static_cast<Int64>(value);
+        if (static_cast<Int64>(value) > max_ns_) {
+            max_ns_ = static_cast<Int64>(value);
+        }
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (Int32 b = 0; b < histogram_bucket_count; ++b) {
+            counts_[b] += other.counts_[b];
+        }
+        count_ += other.count_;
+        sum_ns_ += other.sum_ns_;
+        if (other.max_ns_ > max_ns_) {
+            max_ns_ = other.max_ns_;
+        }
+    }
+
+    Int64 count() const { return count_; }
+    Int64 max_ns() const { return max_ns_; }
+    Int64 sum_ns() const { return sum_ns_; }
+    Float64 mean_ns() const {
+        return count_ > 0 ? static_cast<Float64>(sum_ns_) / static_cast<Float64>(count_) : 0.0;
+    }
+
+    // The smallest bucket upper edge at or above fraction (0..1) of the
+    // samples, capped at the largest sample; 0 if empty
+    Int64 percentile_ns(Float64 fraction) const {
+        Int64 result = 0;
+        if (count_ > 0) {
+            Int64 rank = static_cast<Int64>(fraction * static_cast<Float64>(count_) + 0.5);
+            rank = rank < 1 ? 1 : (rank > count_ ? count_ : rank);
+            Int64 seen = 0;
+            Int32 bucket = 0;
+            while (seen + counts_[bucket] < rank) {
+                seen += counts_[bucket];
+                ++bucket;
+            }
+            result = upper_edge(bucket);
+            if (result > max_ns_) {
+                result = max_ns_;
+            }
+        }
+        return result;
+    }
+
+    Int64 bucket_count(Int32 bucket) const { return counts_[bucket]; }
+
+    // Fold in samples counted elsewhere in this bucket layout (by
+    // bucket_of): their bucket counts, sum and largest value
+    void add_counts(const std::array<Int64, histogram_bucket_count>& counts, Int64 sum_ns, Int64 max_ns) {
+        for (Int32 b = 0; b < histogram_bucket_count; ++b) {
+            counts_[b] += counts[b];
+            count_ += counts[b];
+        }
+        sum_ns_ += sum_ns;
+        if (max_ns > max_ns_) {
+            max_ns_ = max_ns;
+        }
+    }
+
+    // Largest value that falls in a bucket
+    static Int64 upper_edge(Int32 bucket) {
+        Int64 edge = bucket;
+        if (bucket >= histogram_sub_buckets) {
+            Int32 shift = bucket / histogram_sub_buckets - 1;
+            Int64 sub = bucket % histogram_sub_buckets;
+            Uint64 lower = static_cast<Uint64>(histogram_sub_buckets + sub) << shift;
+            Uint64 last = lower + ((static_cast<Uint64>(1) << shift) - 1u);
+            edge = last > static_cast<Uint64>(INT64_MAX) ? INT64_MAX : static_cast<Int64>(last);
+        }
+        return edge;
+    }
+
+    // Bucket of a value
+    static Int32 bucket_of(Uint64 value) {
+        Int32 bucket = static_cast<Int32>(value);
+        if (value >= static_cast<Uint64>(histogram_sub_buckets)) {
+            // Top histogram_sub_bucket_bits + 1 bits: the leading 1 picks
+            // the power of two, the rest the sub-bucket
+            Int32 shift = 63 - std::countl_zero(value) - histogram_sub_bucket_bits;
+            bucket = (shift + 1) * histogram_sub_buckets +
+                     static_cast<Int32>((value >> shift) & static_cast<Uint64>(histogram_sub_buckets - 1));
+        }
+        return bucket;
+    }
+
+private:
+    std::array<Int64, histogram_bucket_count> counts_;
+    Int64 count_;
+    Int64 sum_ns_;
+    Int64 max_ns_;
+};
+
+} // namespace xplane_mfd::calc
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,1738 @@
+// Unified Calculator Daemon for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Links the flight, turn, VNAV and density altitude kernels into one
+// long-lived process and serves them over a Unix domain socket, so the MFD
+// gets every panel's results for a frame in a single round trip.
+//
+// Protocol: one request per line, one reply per line, UTF-8 text.
+//
+//   <id> <section> <fields...> [<section> <fields...> ...]
+//
+//   flight  <14 fields, same order as flight_calculator>
+//   turn    <tas_kts> <bank_deg> <course_change_deg>
+//   vnav    <current_alt_ft> <target_alt_ft> <distance_nm> <groundspeed_kts> <current_vs_fpm>
+//   density <pressure_alt_ft> <oat_celsius> <ias_kts> <tas_kts> <force_error>
+//   dynamic <the first 11 flight fields, up to bank_deg>
+//   footprint <lat> <lon> <altitude_ft> <ias_kts> <tas_kts> <gs_kts> <heading> <track>
+//   wind_estimate <time_s> <altitude_ft> <tas_kts> <gs_kts> <heading> <track>
+//
+//   reply: {"id": <id>, "<section>": {...}, ..., "compute_us": <us>}
+//
+// <id> is an integer chosen by the client and echoed in the reply, so a
+// client may pipeline several requests on one connection and several clients
+// may be connected at once. Each section's object matches the JSON of its
+// standalone calculator; a section whose inputs are rejected is replaced by
+// {"error": <code>} using the exit code that calculator would return.
+// A malformed line gets {"id": <id>, "error": "<message>"}.
+//
+// The daemon keeps one IAS history for its lifetime: each flight section
+// of a request without an aircraft adds its ias_kts, and the gust factor
+// covers the last ias_history_length such flight sections from all clients. Flight envelope,
+// energy and glide results are reused while their inputs stay within
+// flight_input_epsilon of the inputs they were computed from;
+//
+//   <id> stats
+//
+// answers {"id": <id>, "cache": {"envelope": {"hits": n, "misses": n}, ...}}.
+//
+//   <id> metrics
+//
+// answers {"id": <id>, "metrics": {...}}: the daemon's always-on counters
+// (calc_metrics.h) summed over its threads. Every section computed is
+// counted and timed by kernel, with its parse failures, rejected inputs,
+// result cache hits and degenerate-input branches. With --metrics <path>
+// the same counters, and a compute-time histogram per kernel, are written
+// to a file in Prometheus text every metrics_export_interval_ms.
+//
+//   <id> binary <section> <fields...> ...
+//
+// asks for a binary reply instead (wire_format.h): the section records in
+// request order (records 1-4 for flight, an error record for a rejected
+// section), a timing record, then a reply record (id, status, record count)
+// that ends the reply. A malformed binary request gets only a reply record
+// with status 1.
+//
+// With --profile <path> the daemon maps an aircraft performance profile
+// (aircraft_profile.h) once at startup. A dynamic section then carries only
+// the aircraft's changing state: Vso, Vne and Mmo come from the profile, and
+// glide reach from its L/D table. Its object (or records) is that of a
+// flight section. All aircraft share the one read-only profile; without it
+// a dynamic section gets {"error": 1}.
+//
+// A footprint section gives the glide range on each of 360 radials over
+// the terrain tiles given with --terrain <path> (terrain_tiles.h, sea level
+// without any), with the wind from the section's speeds and directions and
+// the profile's L/D if one is loaded (glide_footprint.h). The footprint is
+// kept per aircraft (one more for requests without an aircraft) and swept
+// again only once the aircraft has moved or changed past its thresholds;
+// the object says whether this frame swept it. When a round's frames are
+// all of one aircraft, the sweep's radials are split over the work pool.
+//
+// A wind_estimate section feeds one sample to the filtered wind estimator
+// of the aircraft (or of the requests without one) and answers its smoothed
+// wind and confidence (wind_estimator.h); time_s is the sample's sim time.
+// Each estimate is also kept in the aircraft's wind profile by altitude.
+//
+// With --record <path> every section computed (socket and shared memory
+// alike) is appended to a flight-data log (flight_recorder.h): its inputs,
+// its result struct and the aircraft it belongs to. The compute path only
+// queues the record; a background thread writes the file, and the log is
+// closed and trimmed when the daemon stops. calc_batch --log replays it.
+//
+// compute_us is the time from having the request line to having the reply
+// formatted, so socket and scheduling cost is the client's round trip
+// minus compute_us.
+//
+// Several aircraft (multiplayer traffic, instructor stations) share one
+// daemon:
+//
+//   <id> [binary] aircraft <n> <section> <fields...> ...
+//
+// computes a frame of aircraft n (any integer id) with that aircraft's own
+// IAS history and result cache, and replies
+// {"id": <id>, "aircraft": <n>, "frame": <count>, "<section>": {...}, ...,
+// "compute_us": <us>}; a binary reply starts with an aircraft frame record.
+//
+//   <id> [binary] subscribe <n>      |   <id> unsubscribe <n>
+//
+// answers {"id": <id>, "aircraft": <n>, "subscribed": true|false}; from
+// then on every frame of aircraft n is pushed to the connection, without
+// an id: {"aircraft": <n>, "frame": <count>, ...} or, subscribed with
+// binary, the frame's records with the aircraft id in the reply record.
+// A frame is computed once and formatted once per format however many
+// displays watch it. The daemon tracks up to max_aircraft aircraft, and a
+// connection up to max_subscriptions of them. An aircraft without a frame
+// for --aircraft-idle seconds (default aircraft_idle_timeout_s) gives its
+// slot, and with it its IAS history and caches, to the next new aircraft;
+// its subscribers keep watching the id.
+//
+// Each poll round the daemon gathers every complete request line (up to
+// max_batch_jobs) and sorts them into tasks: one per aircraft with frames
+// in the round, plus one for the requests without an aircraft. The tasks
+// run on a work-stealing pool of --workers threads (work_pool.h), each
+// task's requests in order on one thread, so no aircraft's state is used
+// by two threads. Replies then go out in request order.
+//
+// With --shm <path> the daemon also serves one client through a mapped
+// file (shm_channel.h): the client writes numeric section inputs into the
+// input frame and the daemon writes the binary reply records straight into
+// the result frame. The channel has its own thread and its own IAS history
+// and result cache. With --spin the thread watches the input frame
+// continuously, with no system call on either side of the handoff;
+// otherwise it sleeps on the channel's doorbell until the client rings it
+// (a futex; on systems without one it looks every shm_poll_timeout_ms).
+//
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic allocation per request (fixed client, aircraft
+//   and batch buffers, fixed-layout shared-memory frames; pool threads
+//   started once)
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 113: Single exit point
+// - AV Rule 126: C++ style comments only (//)
+//
+// Compile: g++ -std=c++20 -O3 -pthread -o mfd_calcd mfd_calcd.cpp calc_io.cpp flight_kernels.cpp
+//          turn_kernels.cpp vnav_kernels.cpp density_altitude_kernels.cpp aircraft_profile.cpp
+//          terrain_tiles.cpp glide_footprint.cpp wind_estimator.cpp flight_recorder.cpp calc_metrics.cpp
+//
+// Usage: ./mfd_calcd [--socket <path>] [--shm <path> [--spin]] [--workers <n>] [--profile <path>]
+//                   [--terrain <path> ...] [--record <path>] [--metrics <path>] [--aircraft-idle <s>]
+
+#include <iostream>
+#include <ostream>
+#include <streambuf>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <cstdlib>
+#include <csignal>
+#include <cerrno>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "jsf_types.h"
+#include "calc_io.h"
+#include "flight_kernels.h"
+#include "turn_kernels.h"
+#include "vnav_kernels.h"
+#include "density_altitude_kernels.h"
+#include "wire_format.h"
+#include "shm_channel.h"
+#include "aircraft_profile.h"
+#include "terrain_tiles.h"
+#include "glide_footprint.h"
+#include "work_pool.h"
+#include "flight_recorder.h"
+#include "calc_metrics.h"
+
+namespace xplane_mfd::calc {
+
+// Error codes (AV Rule 52: lowercase)
+const Int32 error_success = 0;
+const Int32 error_invalid_args = 1;
+const Int32 error_parse_failed = 2;
+const Int32 error_invalid_value = 3;
+const Int32 error_socket_failed = 4;
+const Int32 error_reply_too_large = 5;
+
+// Fixed limits (AV Rule 206: no dynamic allocation per request)
+const Int32 max_clients = 16;
+const Int32 client_buffer_size = 4096;
+const Int32 reply_buffer_size = 8192;
+const Int32 max_request_fields = 64;
+const Int32 max_sections = 7;
+const Int32 listen_backlog = 8;
+const Int32 poll_timeout_ms = 500;
+const Int32 shm_poll_timeout_ms = 1;
+const Int32 no_client = -1;
+const Int32 max_aircraft = 64;
+const Float64 aircraft_idle_timeout_s = 60.0;  // default --aircraft-idle
+const Int32 max_subscriptions = 8;     // per client
+const Int32 max_batch_jobs = 128;      // request lines answered per poll round
+const Int32 no_aircraft = -1;
+const Int32 no_subscription = -1;
+const Int32 no_job = -1;
+const Int32 footprint_sweep_chunks = 12;  // pool tasks per footprint sweep
+const Int32 metrics_export_interval_ms = 1000;
+const Int32 metrics_text_max = 32768;     // Prometheus text of every counter and histogram
+const Int32 metrics_path_max = 4096;
+
+// Batch job kinds: a request on the shared state, an aircraft frame, or
+// one the main thread has already answered
+const Int32 job_shared = 0;
+const Int32 job_aircraft = 1;
+const Int32 job_answered = 2;
+
+const char* const default_socket_path = "/tmp/mfd_calcd.sock";
+
+// Section indices (as the flight log numbers them) and their field counts
+const Int32 section_flight = flight_log_section_flight;
+const Int32 section_turn = flight_log_section_turn;
+const Int32 section_vnav = flight_log_section_vnav;
+const Int32 section_density = flight_log_section_density;
+const Int32 section_dynamic = flight_log_section_dynamic;
+const Int32 section_footprint = flight_log_section_footprint;
+const Int32 section_wind_estimate = flight_log_section_wind_estimate;
+
+struct SectionSpec {
+    const char* name;
+    Int32 field_count;
+};
+
+static_assert(shm_flight_fields == flight_input_count, "shm flight fields match the flight section");
+static_assert(shm_section_count <= max_sections, "shm sections are the first socket sections");
+static_assert(section_flight == metric_kernel_flight && section_turn == metric_kernel_turn &&
+              section_vnav == metric_kernel_vnav && section_density == metric_kernel_density &&
+              section_dynamic == metric_kernel_dynamic && section_footprint == metric_kernel_footprint &&
+              section_wind_estimate == metric_kernel_wind_estimate && max_sections == metric_kernel_count,
+              "each section is timed as its metrics kernel");
+static_assert(flight_input_count <= flight_log_max_values, "every section's inputs fit a log record");
+static_assert(sizeof(FlightResults) <= flight_log_result_bytes && sizeof(TurnData) <= flight_log_result_bytes &&
+              sizeof(VNAVData) <= flight_log_result_bytes && sizeof(DensityAltitudeData) <= flight_log_result_bytes &&
+              sizeof(FlightLogFootprint) <= flight_log_result_bytes && sizeof(WindEstimate) <= flight_log_result_bytes,
+              "every section's result fits a log record");
+
+const SectionSpec section_specs[max_sections] = {
+    {"flight", flight_input_count},
+    {"turn", 3},
+    {"vnav", 5},
+    {"density", 5},
+    {"dynamic", flight_dynamic_input_count},
+    {"footprint", 8},
+    {"wind_estimate", 6}
+};
+
+// One section of a request: which kernel and where its fields start
+struct SectionRequest {
+    Int32 kind;
+    const char* const* fields;
+};
+
+// One section computed: its kernel's result, or the exit code that
+// kernel's calculator would return. Computed once, then written in any
+// number of replies and pushes. A footprint result points at the
+// footprint it updated, which is not touched again until the frame is
+// written.
+struct SectionResult {
+    Int32 kind;
+    Int32 status;
+    FlightResults flight;
+    TurnData turn;
+    VNAVData vnav;
+    DensityAltitudeData density;
+    const GlideFootprint* footprint;
+    bool footprint_swept;
+    Float64 footprint_lat_deg;
+    Float64 footprint_lon_deg;
+    WindEstimate wind_estimate;
+    bool wind_fused;
+};
+
+// The state a section is computed with: the flight state and footprint of
+// the aircraft (or of the requests without one), the daemon's profile and
+// terrain (either may be null), the pool a footprint sweep may use (null:
+// sweep on the calling thread), and the flight recorder (null: not
+// recording) with the aircraft its records belong to (null: no aircraft)
+struct SectionContext {
+    ResidentFlightState* flight_state;
+    GlideFootprint* footprint;
+    const AircraftProfile* profile;
+    const TerrainTileCache* terrain;
+    WorkPool* pool;
+    FlightRecorder* recorder;
+    const Int64* aircraft_id;
+};
+
+// streambuf over a caller-owned array: formatting the reply with the
+// existing JSON printers without touching the heap. Overflow fails the stream.
+class FixedBuffer : public std::streambuf {
+public:
+    FixedBuffer(char* data, Int32 size) : data_(data), size_(size) {
+        reset();
+    }
+
+    void reset() {
+        setp(data_, data_ + size_);
+    }
+
+    Int32 length() const {
+        return static_cast<Int32>(pptr() - pbase());
+    }
+
+private:
+    char* data_;
+    Int32 size_;
+};
+
+// An aircraft a client watches; every frame of it is pushed to the client
+struct Subscription {
+    bool active = false;
+    bool binary = false;
+    Int64 aircraft_id = 0;
+};
+
+struct ClientSlot {
+    Int32 fd = no_client;
+    Int32 length = 0;
+    Int32 consumed = 0;       // bytes of whole lines taken into the batch
+    bool discarding = false;  // dropping the rest of an over-long line
+    bool dropped = false;     // a send failed; closed after the batch
+    std::array<Subscription, max_subscriptions> subscriptions;
+    char buffer[client_buffer_size];
+};
+
+// Per-aircraft state: its own gust history and result cache, and the
+// formats its subscribers want pushed
+struct AircraftSlot {
+    bool in_use = false;
+    bool push_json = false;
+    bool push_binary = false;
+    Int64 aircraft_id = 0;
+    Int64 frame_count = 0;
+    Float64 last_request_us = 0.0;  // monotonic_us of its last frame request
+    ResidentFlightState flight_state;
+    GlideFootprint footprint;
+};
+
+// One request line of a batch and everything it sends
+struct BatchJob {
+    Int32 client;
+    Int32 kind;               // job_shared, job_aircraft or job_answered
+    Int32 aircraft;           // slot of a job_aircraft
+    Int32 next_in_task;       // next job of the same task, or no_job
+    Int32 field_count;
+    const char* fields[max_request_fields];
+    Int32 reply_length;
+    Int32 push_json_length;   // 0 if nothing to push in that format
+    Int32 push_binary_length;
+    char reply[reply_buffer_size];
+    char push_json[reply_buffer_size];
+    char push_binary[reply_buffer_size];
+};
+
+// Everything a batch touches. Tasks are the daemon's shared state (requests
+// without an aircraft) and each aircraft with requests in the batch; a
+// task runs its jobs in order on one worker, so no flight state is used by
+// two threads.
+struct Batch {
+    std::array<ClientSlot, max_clients> clients;
+    std::array<AircraftSlot, max_aircraft> aircraft;
+    std::array<BatchJob, max_batch_jobs> jobs;
+    std::array<Int32, max_aircraft + 1> task_first_job;
+    std::array<Int32, max_aircraft + 1> task_last_job;
+    std::array<Int32, max_aircraft + 1> task_of_group;
+    Int32 job_count = 0;
+    Int32 task_count = 0;
+    Float64 aircraft_idle_us = aircraft_idle_timeout_s * 1.0e6;
+    ResidentFlightState* shared_state = nullptr;
+    GlideFootprint* shared_footprint = nullptr;
+    const AircraftProfile* profile = nullptr;  // read by every task
+    const TerrainTileCache* terrain = nullptr;
+    FlightRecorder* recorder = nullptr;
+    WorkPool* sweep_pool = nullptr;  // set while the round's one task runs on the caller
+};
+
+volatile std::sig_atomic_t stop_requested = 0;
+
+void handle_stop_signal(int) {
+    stop_requested = 1;
+}
+
+Int32 find_section(const char* name) {
+    Int32 kind = -1;
+    for (Int32 i = 0; i < max_sections && kind < 0; ++i) {
+        if (std::strcmp(name, section_specs[i].name) == 0) {
+            kind = i;
+        }
+    }
+    return kind;
+}
+
+// Parse count numeric fields; false if any is not a number
+bool parse_values(const char* const* fields, Float64* values, Int32 count) {
+    bool ok = true;
+    for (Int32 i = 0; i < count && ok; ++i) {
+        ok = parse_float64(fields[i], values[i]);
+    }
+    return ok;
+}
+
+void write_section_error(std::ostream& out, Int32 code, bool binary) {
+    if (binary) {
+        print_binary_error(out, code);
+    } else {
+        TextWriter text(out);
+        text.put("{\"error\": ");
+        text.put_int(code);
+        text.put('}');
+    }
+}
+
+// WorkPool task: one chunk of a footprint's radials
+void sweep_footprint_chunk(void* context, Int32 chunk) {
+    GlideFootprint& footprint = *static_cast<GlideFootprint*>(context);
+    footprint.sweep(footprint_radial_count * chunk / footprint_sweep_chunks,
+                    footprint_radial_count * (chunk + 1) / footprint_sweep_chunks);
+}
+
+// Bring the context's footprint up to date; true if it was swept
+bool update_footprint(const SectionContext& context, const FootprintInputs& in) {
+    GlideFootprint& footprint = *context.footprint;
+    bool swept = footprint.begin_update(in, context.terrain, context.profile);
+    if (swept) {
+        if (context.pool != nullptr) {
+            context.pool->run(sweep_footprint_chunk, &footprint, footprint_sweep_chunks);
+        } else {
+            footprint.sweep(0, footprint_radial_count);
+        }
+    }
+    footprint.finish_update();
+    return swept;
+}
+
+// Queue a computed section's inputs and result to the flight log
+void record_section(const SectionContext& context, const Float64* values, const SectionResult& result) {
+    FlightLogRecord record;
+    record.aircraft_id = context.aircraft_id != nullptr ? *context.aircraft_id : 0;
+    record.reserved = 0;
+    record.section = result.kind;
+    record.status = result.status;
+    record.value_count = static_cast<Uint32>(section_specs[result.kind].field_count);
+    record.flags = context.aircraft_id != nullptr ? flight_log_flag_aircraft : 0u;
+    for (Int32 i = 0; i < flight_log_max_values; ++i) {
+        record.values[i] = i < section_specs[result.kind].field_count ? values[i]
+                                                                      : std::numeric_limits<Float64>::quiet_NaN();
+    }
+    std::memset(record.result, 0, sizeof(record.result));
+
+    if (result.status != error_success) {
+        // No result: the zeroed bytes
+    } else if (result.kind == section_flight || result.kind == section_dynamic) {
+        std::memcpy(record.result, &result.flight, sizeof(result.flight));
+    } else if (result.kind == section_turn) {
+        std::memcpy(record.result, &result.turn, sizeof(result.turn));
+    } else if (result.kind == section_vnav) {
+        std::memcpy(record.result, &result.vnav, sizeof(result.vnav));
+    } else if (result.kind == section_density) {
+        std::memcpy(record.result, &result.density, sizeof(result.density));
+    } else if (result.kind == section_footprint) {
+        FlightLogFootprint extent = {result.footprint->min_range_nm(), result.footprint->max_range_nm(),
+                                     result.footprint->sweep_count()};
+        std::memcpy(record.result, &extent, sizeof(extent));
+        record.flags |= result.footprint_swept ? flight_log_flag_fresh : 0u;
+    } else {
+        std::memcpy(record.result, &result.wind_estimate, sizeof(result.wind_estimate));
+        record.flags |= result.wind_fused ? flight_log_flag_fresh : 0u;
+    }
+
+    context.recorder->record(record);
+}
+
+// Compute one section from its numeric fields. A dynamic section needs the
+// daemon's aircraft profile (null if none was loaded); a footprint section
+// needs a footprint in the context.
+SectionResult compute_section_values(Int32 kind, const Float64* values, const SectionContext& context) {
+    Int64 start_ns = metrics_now_ns();
+    CacheCounters cache_before = context.flight_state->results.total_counters();
+    SectionResult result = {};
+    result.kind = kind;
+    result.status = error_success;
+
+    if (kind == section_flight) {
+        result.flight = calculate_flight_sample(flight_inputs_from_values(values), *context.flight_state);
+    } else if (kind == section_dynamic) {
+        if (context.profile == nullptr) {
+            result.status = error_invalid_args;
+        } else {
+            // The limit fields are taken from the profile
+            result.flight = calculate_flight_sample(flight_inputs_from_values(values), *context.flight_state,
+                                                    *context.profile);
+        }
+    } else if (kind == section_footprint) {
+        // lat lon altitude_ft ias_kts tas_kts gs_kts heading track
+        if (context.footprint == nullptr) {
+            result.status = error_invalid_args;
+        } else if (!(std::fabs(values[0]) <= 90.0 && std::fabs(values[1]) <= 180.0)) {
+            result.status = error_invalid_value;
+        } else {
+            WindData wind = calculate_wind_vector(values[4], values[5], values[6], values[7],
+                                                  context.flight_state->ias_history);
+            FootprintInputs in = {values[0], values[1], values[2], values[3], values[4],
+                                  wind.direction_from, wind.speed_kts};
+            result.footprint_swept = update_footprint(context, in);
+            if (result.footprint_swept) {
+                metrics_count(metric_footprint_sweeps, 1);
+            }
+            result.footprint = context.footprint;
+            result.footprint_lat_deg = values[0];
+            result.footprint_lon_deg = values[1];
+        }
+    } else if (kind == section_wind_estimate) {
+        // time_s altitude_ft tas_kts gs_kts heading track
+        if (values[2] < 0.0 || values[3] < 0.0) {
+            result.status = error_invalid_value;
+        } else {
+            WindSample sample = {values[0], values[1], values[2], values[3], values[4], values[5]};
+            ResidentFlightState& state = *context.flight_state;
+            result.wind_fused = state.wind_estimator.update(sample);
+            if (result.wind_fused) {
+                state.wind_profile.record(sample.altitude_ft, state.wind_estimator);
+            }
+            result.wind_estimate = state.wind_estimator.estimate();
+        }
+    } else if (kind == section_turn) {
+        if (!turn_inputs_valid(values[0], values[1])) {
+            result.status = error_invalid_value;
+        } else {
+            metrics_count_turn_inputs(values[1]);
+            result.turn = calculate_turn_performance(values[0], values[1], values[2]);
+        }
+    } else if (kind == section_vnav) {
+        metrics_count_vnav_inputs(values[2], values[3]);
+        result.vnav = calculate_vnav(values[0], values[1], values[2], values[3], values[4]);
+    } else {
+        // density: last field is the MFD's simulated-error flag
+        if (values[4] != 0.0) {
+            result.status = error_invalid_value;
+        } else if (!density_altitude_inputs_valid(values[0], values[1])) {
+            result.status = error_invalid_args;
+        } else {
+            result.density = calculate_density_altitude_data(values[0], values[1], values[2], values[3]);
+        }
+    }
+
+    if (kind == section_flight || kind == section_dynamic) {
+        metrics_count_cache(cache_before, context.flight_state->results.total_counters());
+    }
+    if (result.status != error_success) {
+        metrics_count(metric_section_errors, 1);
+    }
+    metrics_kernel_call(kind, metrics_now_ns() - start_ns);
+
+    if (context.recorder != nullptr) {
+        record_section(context, values, result);
+    }
+
+    return result;
+}
+
+// Parse one section's text fields, then compute it as compute_section_values
+SectionResult compute_section(const SectionRequest& section, const SectionContext& context) {
+    Float64 values[flight_input_count] = {};
+    SectionResult result = {};
+
+    if (!parse_values(section.fields, values, section_specs[section.kind].field_count)) {
+        result.kind = section.kind;
+        result.status = error_parse_failed;
+        metrics_count(metric_parse_failures, 1);
+    } else {
+        result = compute_section_values(section.kind, values, context);
+    }
+
+    return result;
+}
+
+// Write one section's JSON object or binary record(s). Returns the number
+// of binary records written.
+Int32 write_section_result(std::ostream& out, const SectionResult& result, bool binary) {
+    Int32 records = 1;
+
+    if (result.status != error_success) {
+        write_section_error(out, result.status, binary);
+    } else if (result.kind == section_flight || result.kind == section_dynamic) {
+        if (binary) {
+            print_binary_results(out, result.flight);
+            records = flight_wire_record_count;
+        } else {
+            print_json_results(out, result.flight, true);
+        }
+    } else if (result.kind == section_footprint) {
+        if (binary) {
+            print_binary(out, *result.footprint, result.footprint_lat_deg, result.footprint_lon_deg,
+                         result.footprint_swept);
+            records = footprint_wire_record_count;
+        } else {
+            print_json(out, *result.footprint, result.footprint_lat_deg, result.footprint_lon_deg,
+                       result.footprint_swept);
+        }
+    } else if (result.kind == section_wind_estimate) {
+        if (binary) {
+            print_binary(out, result.wind_estimate, result.wind_fused);
+        } else {
+            print_json(out, result.wind_estimate, result.wind_fused);
+        }
+    } else if (result.kind == section_turn) {
+        if (binary) {
+            print_binary(out, result.turn);
+        } else {
+            print_json(out, result.turn, true);
+        }
+    } else if (result.kind == section_vnav) {
+        if (binary) {
+            print_binary(out, result.vnav);
+        } else {
+            print_json(out, result.vnav, true);
+        }
+    } else {
+        if (binary) {
+            print_binary(out, result.density);
+        } else {
+            print_json(out, result.density, true);
+        }
+    }
+
+    return records;
+}
+
+// Check the section layout of fields[index, field_count) before anything
+// is computed; nullptr if it is well formed
+const char* parse_section_layout(const char* const* fields, Int32 index, Int32 field_count,
+                                 SectionRequest* sections, Int32& section_count) {
+    const char* error_message = nullptr;
+    section_count = 0;
+    while (error_message == nullptr && index < field_count) {
+        Int32 kind = find_section(fields[index]);
+        if (kind < 0) {
+            error_message = "unknown section";
+        } else if (index + 1 + section_specs[kind].field_count > field_count) {
+            error_message = "section has too few fields";
+        } else {
+            for (Int32 i = 0; i < section_count; ++i) {
+                if (sections[i].kind == kind) {
+                    error_message = "duplicate section";
+                }
+            }
+            if (error_message == nullptr) {
+                sections[section_count].kind = kind;
+                sections[section_count].fields = fields + index + 1;
+                ++section_count;
+                index += 1 + section_specs[kind].field_count;
+            }
+        }
+    }
+    return error_message;
+}
+
+// A rejected request: {"id": <id>, "error": "<message>"}, or a binary reply
+// record with status 1
+void write_request_error(std::ostream& out, bool id_ok, Int64 request_id, const char* error_message,
+                         bool binary) {
+    metrics_count(metric_request_errors, 1);
+    if (binary) {
+        WireRecord reply(wire_record_reply);
+        reply.put_int64(request_id);
+        reply.put_int32(error_invalid_args);
+        reply.put_int32(0);
+        reply.write_to(out);
+    } else {
+        TextWriter text(out);
+        text.put("{\"id\": ");
+        if (id_ok) {
+            text.put_int(request_id);
+        } else {
+            text.put("null");
+        }
+        text.put(", \"error\": \"");
+        text.put(error_message);
+        text.put("\"}");
+    }
+}
+
+// Handle one request line (split into fields) and write its reply: a single
+// JSON line without the newline, or binary records. Returns true if the
+// reply is binary.
+bool handle_request(const char* const* fields, Int32 field_count, std::ostream& out,
+                    const SectionContext& context) {
+    Float64 start_us = monotonic_us();
+    SectionRequest sections[max_sections];
+    Int32 section_count = 0;
+    Int64 request_id = 0;
+    const char* error_message = nullptr;
+
+    bool id_ok = field_count > 0 && parse_int64(fields[0], request_id);
+
+    if (field_count == 0) {
+        error_message = "empty request";
+    } else if (!id_ok) {
+        error_message = "request must start with an integer id";
+    } else if (field_count > max_request_fields) {
+        error_message = "too many fields";
+    }
+
+    // Optional binary marker right after the id
+    Int32 index = 1;
+    bool binary = (id_ok && field_count > 1 && field_count <= max_request_fields &&
+                   std::strcmp(fields[1], "binary") == 0);
+    if (binary) {
+        index = 2;
+    }
+
+    // "<id> stats": the flight result cache counters instead of sections;
+    // "<id> metrics": the daemon's metrics (calc_metrics.h)
+    bool stats = (id_ok && field_count == 2 && std::strcmp(fields[1], "stats") == 0);
+    bool metrics = (id_ok && field_count == 2 && std::strcmp(fields[1], "metrics") == 0);
+    if (stats || metrics) {
+        index = field_count;
+    }
+
+    // First pass: check the section layout before writing anything
+    if (error_message == nullptr) {
+        error_message = parse_section_layout(fields, index, field_count, sections, section_count);
+    }
+
+    if (binary) {
+        Int32 records = 0;
+        if (error_message == nullptr) {
+            for (Int32 i = 0; i < section_count; ++i) {
+                records += write_section_result(out, compute_section(sections[i], context), true);
+            }
+            print_binary_timing(out, monotonic_us() - start_us);
+            ++records;
+        }
+        WireRecord reply(wire_record_reply);
+        reply.put_int64(request_id);
+        reply.put_int32(error_message == nullptr ? error_success : error_invalid_args);
+        reply.put_int32(records);
+        reply.write_to(out);
+    } else if (error_message != nullptr) {
+        write_request_error(out, id_ok, request_id, error_message, false);
+    } else {
+        // Section objects are written to out by their printers, so the
+        // text around them is flushed first
+        TextWriter text(out);
+        text.put("{\"id\": ");
+        text.put_int(request_id);
+        if (stats) {
+            text.put(", \"cache\": ");
+            text.flush();
+            context.flight_state->results.print_json_stats(out);
+        } else if (metrics) {
+            // Summed from every thread's shard as it is read
+            MetricsSnapshot snapshot;
+            metrics_snapshot(snapshot);
+            text.put(", \"metrics\": ");
+            text.flush();
+            print_json(out, snapshot);
+        } else {
+            for (Int32 i = 0; i < section_count; ++i) {
+                text.put(", \"");
+                text.put(section_specs[sections[i].kind].name);
+                text.put("\": ");
+                text.flush();
+                write_section_result(out, compute_section(sections[i], context), false);
+            }
+            text.put(", \"compute_us\": ");
+            text.put_fixed(monotonic_us() - start_us);
+        }
+        text.put('}');
+        text.flush();
+    }
+
+    return binary;
+}
+
+// One frame of an aircraft: the reply to its request (request_id given) or
+// the push to its subscribers (request_id null; the binary reply record
+// then carries the aircraft id). JSON ends with the newline.
+void write_aircraft_frame(std::ostream& out, bool binary, const Int64* request_id, const AircraftSlot& slot,
+                          const SectionResult* results, Int32 section_count, Float64 compute_us) {
+    if (binary) {
+        print_binary_aircraft_frame(out, slot.aircraft_id, slot.frame_count);
+        Int32 records = 1;
+        for (Int32 i = 0; i < section_count; ++i) {
+            records += write_section_result(out, results[i], true);
+        }
+        print_binary_timing(out, compute_us);
+        ++records;
+        WireRecord reply(wire_record_reply);
+        reply.put_int64(request_id != nullptr ? *request_id : slot.aircraft_id);
+        reply.put_int32(error_success);
+        reply.put_int32(records);
+        reply.write_to(out);
+    } else {
+        TextWriter text(out);
+        text.put('{');
+        if (request_id != nullptr) {
+            text.put("\"id\": ");
+            text.put_int(*request_id);
+            text.put(", ");
+        }
+        text.put("\"aircraft\": ");
+        text.put_int(slot.aircraft_id);
+        text.put(", \"frame\": ");
+        text.put_int(slot.frame_count);
+        for (Int32 i = 0; i < section_count; ++i) {
+            text.put(", \"");
+            text.put(section_specs[results[i].kind].name);
+            text.put("\": ");
+            text.flush();
+            write_section_result(out, results[i], false);
+        }
+        text.put(", \"compute_us\": ");
+        text.put_fixed(compute_us);
+        text.put("}\n");
+    }
+}
+
+// Format a fixed buffer, falling back to a short error in the request's
+// format if it overflows: a JSON line, or an error record and a reply
+// record with status error_reply_too_large. Returns the length written.
+Int32 finish_buffer(FixedBuffer& buffer, std::ostream& out, bool binary, Int64 request_id) {
+    if (!out) {
+        buffer.reset();
+        out.clear();
+        metrics_count(metric_request_errors, 1);
+        if (binary) {
+            print_binary_error(out, error_reply_too_large);
+            WireRecord reply(wire_record_reply);
+            reply.put_int64(request_id);
+            reply.put_int32(error_reply_too_large);
+            reply.put_int32(1);
+            reply.write_to(out);
+        } else {
+            TextWriter text(out);
+            text.put("{\"id\": ");
+            text.put_int(request_id);
+            text.put(", \"error\": \"reply too large\"}\n");
+        }
+    }
+    return buffer.length();
+}
+
+// "<id> [binary] aircraft <n> <sections...>": compute the sections once
+// with the aircraft's state, then format the reply and one push per format
+// its subscribers want
+void run_aircraft_job(BatchJob& job, AircraftSlot& slot, Int32 index, bool binary, const Batch& batch) {
+    Float64 start_us = monotonic_us();
+    Int64 request_id = 0;
+    parse_int64(job.fields[0], request_id);
+    SectionRequest sections[max_sections];
+    Int32 section_count = 0;
+    const char* error_message = parse_section_layout(job.fields, index, job.field_count, sections, section_count);
+
+    FixedBuffer reply_buffer(job.reply, reply_buffer_size);
+    std::ostream reply_out(&reply_buffer);
+    job.push_json_length = 0;
+    job.push_binary_length = 0;
+
+    if (error_message != nullptr) {
+        write_request_error(reply_out, true, request_id, error_message, binary);
+        if (!binary) {
+            reply_out << "\n";
+        }
+    } else {
+        SectionContext context = {&slot.flight_state, &slot.footprint, batch.profile, batch.terrain,
+                                  batch.sweep_pool, batch.recorder, &slot.aircraft_id};
+        SectionResult results[max_sections];
+        for (Int32 i = 0; i < section_count; ++i) {
+            results[i] = compute_section(sections[i], context);
+        }
+        ++slot.frame_count;
+        Float64 compute_us = monotonic_us() - start_us;
+
+        write_aircraft_frame(reply_out, binary, &request_id, slot, results, section_count, compute_us);
+        if (slot.push_json) {
+            FixedBuffer push_buffer(job.push_json, reply_buffer_size);
+            std::ostream push_out(&push_buffer);
+            write_aircraft_frame(push_out, false, nullptr, slot, results, section_count, compute_us);
+            job.push_json_length = push_out ? push_buffer.length() : 0;
+        }
+        if (slot.push_binary) {
+            FixedBuffer push_buffer(job.push_binary, reply_buffer_size);
+            std::ostream push_out(&push_buffer);
+            write_aircraft_frame(push_out, true, nullptr, slot, results, section_count, compute_us);
+            job.push_binary_length = push_out ? push_buffer.length() : 0;
+        }
+    }
+    job.reply_length = finish_buffer(reply_buffer, reply_out, binary, request_id);
+}
+
+// A job that runs in a task: the shared state's requests as before, or an
+// aircraft frame
+void run_job(Batch& batch, BatchJob& job) {
+    Int32 index = 1;
+    if (job.field_count > 1 && std::strcmp(job.fields[1], "binary") == 0) {
+        index = 2;
+    }
+
+    if (job.kind == job_aircraft) {
+        run_aircraft_job(job, batch.aircraft[job.aircraft], index + 2, index == 2, batch);
+    } else {
+        SectionContext context = {batch.shared_state, batch.shared_footprint, batch.profile, batch.terrain,
+                                  batch.sweep_pool, batch.recorder, nullptr};
+        FixedBuffer reply_buffer(job.reply, reply_buffer_size);
+        std::ostream out(&reply_buffer);
+        bool binary = handle_request(job.fields, job.field_count, out, context);
+        if (!binary) {
+            out << "\n";
+        }
+        // A request without a valid id has a short error reply, never too large
+        Int64 request_id = 0;
+        if (job.field_count > 0) {
+            parse_int64(job.fields[0], request_id);
+        }
+        job.reply_length = finish_buffer(reply_buffer, out, binary, request_id);
+        job.push_json_length = 0;
+        job.push_binary_length = 0;
+    }
+}
+
+// WorkPool task: every job of one task, in request order
+void run_batch_task(void* context, Int32 task) {
+    Batch& batch = *static_cast<Batch*>(context);
+    for (Int32 j = batch.task_first_job[task]; j != no_job; j = batch.jobs[j].next_in_task) {
+        run_job(batch, batch.jobs[j]);
+    }
+}
+
+// Slot of an aircraft id, for a new aircraft a free one or else the one
+// idle longest past batch.aircraft_idle_us, started with fresh state;
+// no_aircraft if every slot is in recent use. A slot with a job in the
+// batch was requested just now, so it is never taken from under its task.
+Int32 find_aircraft(Batch& batch, Int64 aircraft_id) {
+    Float64 now_us = monotonic_us();
+    Int32 slot = no_aircraft;
+    Int32 free_slot = no_aircraft;
+    Int32 idle_slot = no_aircraft;
+    for (Int32 i = 0; i < max_aircraft && slot == no_aircraft; ++i) {
+        const AircraftSlot& candidate = batch.aircraft[i];
+        if (candidate.in_use && candidate.aircraft_id == aircraft_id) {
+            slot = i;
+        } else if (!candidate.in_use && free_slot == no_aircraft) {
+            free_slot = i;
+        } else if (candidate.in_use && now_us - candidate.last_request_us > batch.aircraft_idle_us &&
+                   (idle_slot == no_aircraft ||
+                    candidate.last_request_us < batch.aircraft[idle_slot].last_request_us)) {
+            idle_slot = i;
+        }
+    }
+    if (slot == no_aircraft) {
+        slot = free_slot != no_aircraft ? free_slot : idle_slot;
+        if (slot != no_aircraft) {
+            AircraftSlot& taken = batch.aircraft[slot];
+            taken.in_use = true;
+            taken.aircraft_id = aircraft_id;
+            taken.frame_count = 0;
+            taken.flight_state = ResidentFlightState();
+            taken.footprint = GlideFootprint();
+        }
+    }
+    if (slot != no_aircraft) {
+        batch.aircraft[slot].last_request_us = now_us;
+    }
+    return slot;
+}
+
+// "<id> [binary] subscribe|unsubscribe <n>", answered by the main thread:
+// {"id": <id>, "aircraft": <n>, "subscribed": true|false}, or a binary
+// reply record with no records
+void answer_subscription(BatchJob& job, ClientSlot& client, Int64 request_id, Int64 aircraft_id,
+                         bool subscribe, bool binary) {
+    Int32 found = no_subscription;
+    Int32 free_slot = no_subscription;
+    for (Int32 i = 0; i < max_subscriptions; ++i) {
+        const Subscription& s = client.subscriptions[i];
+        if (s.active && s.aircraft_id == aircraft_id) {
+            found = i;
+        } else if (!s.active && free_slot == no_subscription) {
+            free_slot = i;
+        }
+    }
+
+    FixedBuffer reply_buffer(job.reply, reply_buffer_size);
+    std::ostream out(&reply_buffer);
+    if (subscribe && found == no_subscription && free_slot == no_subscription) {
+        write_request_error(out, true, request_id, "too many subscriptions", binary);
+    } else {
+        if (subscribe) {
+            Subscription& s = client.subscriptions[found != no_subscription ? found : free_slot];
+            s.active = true;
+            s.binary = binary;
+            s.aircraft_id = aircraft_id;
+        } else if (found != no_subscription) {
+            client.subscriptions[found].active = false;
+        }
+        if (binary) {
+            WireRecord reply(wire_record_reply);
+            reply.put_int64(request_id);
+            reply.put_int32(error_success);
+            reply.put_int32(0);
+            reply.write_to(out);
+        } else {
+            TextWriter text(out);
+            text.put("{\"id\": ");
+            text.put_int(request_id);
+            text.put(", \"aircraft\": ");
+            text.put_int(aircraft_id);
+            text.put(subscribe ? ", \"subscribed\": true}" : ", \"subscribed\": false}");
+        }
+    }
+    if (!binary) {
+        out << "\n";
+    }
+    job.reply_length = finish_buffer(reply_buffer, out, binary, request_id);
+}
+
+// Sort one request line into the batch: aircraft frames to their aircraft's
+// task, subscriptions answered here, everything else to the shared task
+void add_job(Batch& batch, Int32 client_index, char* line, bool too_long) {
+    BatchJob& job = batch.jobs[batch.job_count];
+    ++batch.job_count;
+    job.client = client_index;
+    job.kind = job_shared;
+    job.aircraft = no_aircraft;
+    job.next_in_task = no_job;
+    job.push_json_length = 0;
+    job.push_binary_length = 0;
+    job.field_count = too_long ? 0 : split_fields(line, job.fields, max_request_fields);
+    metrics_count(metric_requests, 1);
+
+    Int64 request_id = 0;
+    Int64 aircraft_id = 0;
+    bool id_ok = job.field_count > 0 && job.field_count <= max_request_fields
+              && parse_int64(job.fields[0], request_id);
+    Int32 index = (id_ok && job.field_count > 1 && std::strcmp(job.fields[1], "binary") == 0) ? 2 : 1;
+    bool binary = index == 2;
+    const char* verb = (id_ok && index < job.field_count) ? job.fields[index] : "";
+    bool has_aircraft = index + 1 < job.field_count && parse_int64(job.fields[index + 1], aircraft_id);
+
+    if (too_long) {
+        FixedBuffer reply_buffer(job.reply, reply_buffer_size);
+        std::ostream out(&reply_buffer);
+        out << "{\"id\": null, \"error\": \"request line too long\"}\n";
+        metrics_count(metric_request_errors, 1);
+        job.kind = job_answered;
+        job.reply_length = reply_buffer.length();
+    } else if (std::strcmp(verb, "aircraft") == 0 || std::strcmp(verb, "subscribe") == 0 ||
+               std::strcmp(verb, "unsubscribe") == 0) {
+        bool frame = verb[0] == 'a';
+        const char* error_message = nullptr;
+        if (!has_aircraft) {
+            error_message = "aircraft id must be an integer";
+        } else if (!frame && index + 2 != job.field_count) {
+            error_message = "subscription takes one aircraft id";
+        } else if (frame) {
+            job.aircraft = find_aircraft(batch, aircraft_id);
+            if (job.aircraft == no_aircraft) {
+                error_message = "aircraft table full";
+            } else {
+                job.kind = job_aircraft;
+            }
+        } else {
+            answer_subscription(job, batch.clients[client_index], request_id, aircraft_id,
+                                verb[0] == 's', binary);
+            job.kind = job_answered;
+        }
+        if (error_message != nullptr) {
+            FixedBuffer reply_buffer(job.reply, reply_buffer_size);
+            std::ostream out(&reply_buffer);
+            write_request_error(out, true, request_id, error_message, binary);
+            if (!binary) {
+                out << "\n";
+            }
+            job.kind = job_answered;
+            job.reply_length = finish_buffer(reply_buffer, out, binary, request_id);
+        }
+    }
+
+    // Chain the job onto its task: group 0 is the shared state, group
+    // 1 + slot an aircraft
+    if (job.kind != job_answered) {
+        Int32 group = job.kind == job_aircraft ? 1 + job.aircraft : 0;
+        Int32 task = batch.task_of_group[group];
+        Int32 job_index = batch.job_count - 1;
+        if (task == no_job) {
+            task = batch.task_count;
+            ++batch.task_count;
+            batch.task_of_group[group] = task;
+            batch.task_first_job[task] = job_index;
+        } else {
+            batch.jobs[batch.task_last_job[task]].next_in_task = job_index;
+        }
+        batch.task_last_job[task] = job_index;
+    }
+}
+
+// Send all bytes; false if the client went away
+bool send_all(Int32 fd, const char* data, Int32 length) {
+    bool ok = true;
+    Int32 sent = 0;
+    while (ok && sent < length) {
+        ssize_t n = send(fd, data + sent, static_cast<size_t>(length - sent), MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += static_cast<Int32>(n);
+        } else if (n < 0 && errno == EINTR) {
+            // interrupted by a signal: retry
+        } else {
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+void send_to_client(ClientSlot& client, const char* data, Int32 length) {
+    if (!client.dropped && length > 0 && !send_all(client.fd, data, length)) {
+        client.dropped = true;
+    }
+}
+
+// A push is sent whole or not at all: a subscriber whose socket is full
+// misses this frame rather than stalling the daemon, and one that takes
+// only part of it is dropped (its stream would be torn)
+void push_to_client(ClientSlot& client, const char* data, Int32 length) {
+    if (!client.dropped && length > 0) {
+        ssize_t n = send(client.fd, data, static_cast<size_t>(length), MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            // socket full: skip the frame
+        } else if (n != static_cast<ssize_t>(length)) {
+            client.dropped = true;
+        }
+    }
+}
+
+void close_client(ClientSlot& client) {
+    if (client.fd != no_client) {
+        close(client.fd);
+    }
+    client.fd = no_client;
+    client.length = 0;
+    client.consumed = 0;
+    client.discarding = false;
+    client.dropped = false;
+    for (Int32 i = 0; i < max_subscriptions; ++i) {
+        client.subscriptions[i].active = false;
+    }
+}
+
+// The formats each aircraft's subscribers want pushed
+void mark_push_formats(Batch& batch) {
+    for (Int32 a = 0; a < max_aircraft; ++a) {
+        batch.aircraft[a].push_json = false;
+        batch.aircraft[a].push_binary = false;
+    }
+    for (Int32 j = 0; j < batch.job_count; ++j) {
+        if (batch.jobs[j].kind == job_aircraft) {
+            AircraftSlot& slot = batch.aircraft[batch.jobs[j].aircraft];
+            for (Int32 c = 0; c < max_clients; ++c) {
+                for (Int32 i = 0; i < max_subscriptions && batch.clients[c].fd != no_client; ++i) {
+                    const Subscription& s = batch.clients[c].subscriptions[i];
+                    if (s.active && s.aircraft_id == slot.aircraft_id) {
+                        slot.push_json = slot.push_json || !s.binary;
+                        slot.push_binary = slot.push_binary || s.binary;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Answer every complete line the clients have sent, up to max_batch_jobs:
+// sort them into tasks, run the tasks on the pool, then send the replies
+// in request order and each aircraft frame to its subscribers. Returns
+// true if lines are left for another batch.
+bool serve_batch(Batch& batch, WorkPool& pool) {
+    bool pending = false;
+    batch.job_count = 0;
+    batch.task_count = 0;
+    batch.task_of_group.fill(no_job);
+
+    for (Int32 c = 0; c < max_clients; ++c) {
+        ClientSlot& client = batch.clients[c];
+        Int32 start = 0;
+        for (Int32 i = 0; i < client.length && client.fd != no_client && !pending; ++i) {
+            if (client.buffer[i] == '\n') {
+                if (batch.job_count == max_batch_jobs) {
+                    pending = true;
+                } else {
+                    client.buffer[i] = '\0';
+                    add_job(batch, c, client.buffer + start, client.discarding);
+                    client.discarding = false;
+                    start = i + 1;
+                }
+            }
+        }
+        client.consumed = start;
+    }
+
+    mark_push_formats(batch);
+    if (batch.task_count == 1) {
+        // One task leaves the pool idle: run it here and let its footprint
+        // sweeps use the pool instead (a task cannot start a run of its own)
+        batch.sweep_pool = &pool;
+        run_batch_task(&batch, 0);
+        batch.sweep_pool = nullptr;
+    } else if (batch.task_count > 1) {
+        pool.run(run_batch_task, &batch, batch.task_count);
+    }
+
+    for (Int32 j = 0; j < batch.job_count; ++j) {
+        const BatchJob& job = batch.jobs[j];
+        send_to_client(batch.clients[job.client], job.reply, job.reply_length);
+        if (job.kind == job_aircraft && (job.push_json_length > 0 || job.push_binary_length > 0)) {
+            Int64 aircraft_id = batch.aircraft[job.aircraft].aircraft_id;
+            for (Int32 c = 0; c < max_clients; ++c) {
+                ClientSlot& subscriber = batch.clients[c];
+                for (Int32 i = 0; i < max_subscriptions && subscriber.fd != no_client; ++i) {
+                    const Subscription& s = subscriber.subscriptions[i];
+                    if (s.active && s.aircraft_id == aircraft_id) {
+                        if (s.binary) {
+                            push_to_client(subscriber, job.push_binary, job.push_binary_length);
+                        } else {
+                            push_to_client(subscriber, job.push_json, job.push_json_length);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    for (Int32 c = 0; c < max_clients; ++c) {
+        ClientSlot& client = batch.clients[c];
+        if (client.dropped) {
+            close_client(client);
+        } else if (client.fd != no_client) {
+            // Keep the unfinished tail for the next read
+            if (client.consumed > 0) {
+                std::memmove(client.buffer, client.buffer + client.consumed,
+                             static_cast<size_t>(client.length - client.consumed));
+                client.length -= client.consumed;
+                client.consumed = 0;
+            }
+            if (client.length == client_buffer_size &&
+                std::memchr(client.buffer, '\n', static_cast<size_t>(client.length)) == nullptr) {
+                // No newline in a full buffer: drop it and reply once the line ends
+                client.length = 0;
+                client.discarding = true;
+            }
+        }
+    }
+
+    return pending;
+}
+
+Int32 open_listen_socket(const char* socket_path) {
+    Int32 fd = no_client;
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (std::strlen(socket_path) >= sizeof(address.sun_path)) {
+        std::cerr << "Error: Socket path too long\n";
+    } else {
+        std::strncpy(address.sun_path, socket_path, sizeof(address.sun_path) - 1);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            std::cerr << "Error: socket() failed: " << std::strerror(errno) << "\n";
+            fd = no_client;
+        } else {
+            // Remove a stale socket left by a previous run
+            unlink(socket_path);
+            if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+                listen(fd, listen_backlog) != 0) {
+                std::cerr << "Error: Cannot listen on " << socket_path << ": "
+                          << std::strerror(errno) << "\n";
+                close(fd);
+                fd = no_client;
+            }
+        }
+    }
+    return fd;
+}
+
+// Create (or reset) and map the shared-memory channel file; nullptr on
+// failure. doorbell_wait tells the client whether to wake the daemon.
+ShmChannel* open_shm_channel(const char* shm_path, bool spin) {
+    ShmChannel* channel = nullptr;
+    Int32 fd = open(shm_path, O_RDWR | O_CREAT, 0600);
+    if (fd < 0) {
+        std::cerr << "Error: Cannot open " << shm_path << ": " << std::strerror(errno) << "\n";
+    } else {
+        if (ftruncate(fd, shm_channel_size) != 0) {
+            std::cerr << "Error: Cannot size " << shm_path << ": " << std::strerror(errno) << "\n";
+        } else {
+            void* mapping = mmap(nullptr, static_cast<size_t>(shm_channel_size), PROT_READ | PROT_WRITE,
+                                 MAP_SHARED, fd, 0);
+            if (mapping == MAP_FAILED) {
+                std::cerr << "Error: Cannot map " << shm_path << ": " << std::strerror(errno) << "\n";
+            } else {
+                channel = static_cast<ShmChannel*>(mapping);
+                std::memset(channel, 0, sizeof(ShmChannel));
+                channel->header.version = shm_version;
+                channel->header.size = static_cast<Uint32>(shm_channel_size);
+                channel->header.doorbell_wait = (!spin && shm_doorbell_sleeps()) ? 1u : 0u;
+                // Magic last: a client that sees it sees a complete header
+                std::atomic_ref<Uint32>(channel->header.magic).store(shm_magic, std::memory_order_release);
+            }
+        }
+        close(fd);
+    }
+    return channel;
+}
+
+void close_shm_channel(ShmChannel* channel, const char* shm_path) {
+    if (channel != nullptr) {
+        munmap(channel, static_cast<size_t>(shm_channel_size));
+        unlink(shm_path);
+    }
+}
+
+// Answer the channel's input frame if it is new: the same records as a
+// binary socket reply, written straight into the result frame.
+// last_frame_id is the frame answered last. Returns true if it answered one.
+bool serve_shm_frame(ShmChannel& channel, FixedBuffer& result_buffer, std::ostream& out,
+                     ResidentFlightState& flight_state, FlightRecorder* recorder, Uint64& last_frame_id) {
+    // The channel's sections need neither a profile nor a footprint
+    SectionContext context = {&flight_state, nullptr, nullptr, nullptr, nullptr, recorder, nullptr};
+    ShmInputFrame input;
+    bool fresh = seqlock_read(channel.input, input) && input.frame_id != last_frame_id;
+    if (fresh) {
+        Float64 start_us = monotonic_us();
+        metrics_count(metric_requests, 1);
+        const Float64* const section_values[shm_section_count] = {
+            input.flight, input.turn, input.vnav, input.density
+        };
+
+        seqlock_write_begin(channel.result.sequence);
+        result_buffer.reset();
+        out.clear();
+        Int32 records = 0;
+        for (Int32 kind = 0; kind < shm_section_count; ++kind) {
+            if ((input.section_mask & (1u << kind)) != 0u) {
+                SectionResult result = compute_section_values(kind, section_values[kind], context);
+                records += write_section_result(out, result, true);
+            }
+        }
+        print_binary_timing(out, monotonic_us() - start_us);
+        ++records;
+        WireRecord reply(wire_record_reply);
+        reply.put_int64(static_cast<Int64>(input.frame_id));
+        reply.put_int32(out ? error_success : error_invalid_args);
+        reply.put_int32(records);
+        reply.write_to(out);
+
+        channel.result.frame_id = input.frame_id;
+        channel.result.length = static_cast<Uint32>(result_buffer.length());
+        seqlock_write_end(channel.result.sequence);
+        last_frame_id = input.frame_id;
+    }
+    return fresh;
+}
+
+// The shared-memory channel's thread and what it needs
+struct ShmServer {
+    ShmChannel* channel = nullptr;
+    bool spin = false;
+    FlightRecorder* recorder = nullptr;
+    std::atomic<bool> stop{false};
+};
+
+// Answer every new input frame until server.stop: spinning on the input
+// sequence with --spin, otherwise sleeping on the doorbell between frames.
+// The doorbell is read before the frame is looked for, so a frame published
+// after the look has rung past it and the wait returns at once.
+void run_shm_server(ShmServer& server) {
+    ShmChannel& channel = *server.channel;
+    // Gust history and result cache of the channel's one client, used by
+    // this thread only (allocated once)
+    ResidentFlightState flight_state;
+    FixedBuffer result_buffer(reinterpret_cast<char*>(channel.result.records), shm_result_bytes);
+    std::ostream out(&result_buffer);
+    Uint64 last_frame_id = 0;
+    Int32 wait_ms = shm_doorbell_sleeps() ? poll_timeout_ms : shm_poll_timeout_ms;
+    std::atomic_ref<Uint32> doorbell(channel.header.doorbell);
+
+    while (!server.stop.load(std::memory_order_relaxed)) {
+        Uint32 seen = doorbell.load(std::memory_order_acquire);
+        bool served = serve_shm_frame(channel, result_buffer, out, flight_state, server.recorder, last_frame_id);
+        if (!served && !server.spin) {
+            shm_doorbell_wait(channel.header.doorbell, seen, wait_ms);
+        }
+    }
+}
+
+// Replace the file at path with the metrics in Prometheus text: written to
+// <path>.tmp, then renamed over it, so a scraper of the file (a node
+// exporter's textfile collector) never reads half of it. Main thread only.
+bool write_metrics_file(const char* path) {
+    // AV Rule 206: the snapshot and text are fixed
+    static MetricsSnapshot snapshot;
+    static char text[metrics_text_max];
+    static char temp_path[metrics_path_max];
+    metrics_snapshot(snapshot);
+    FixedBuffer buffer(text, metrics_text_max);
+    std::ostream out(&buffer);
+    print_prometheus(out, snapshot);
+
+    size_t path_length = std::strlen(path);
+    bool ok = static_cast<bool>(out) && path_length + 5 <= static_cast<size_t>(metrics_path_max);
+    if (ok) {
+        std::memcpy(temp_path, path, path_length);
+        std::memcpy(temp_path + path_length, ".tmp", 5);
+        Int32 fd = open(temp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        ok = fd >= 0;
+        if (ok) {
+            Int32 written = 0;
+            while (ok && written < buffer.length()) {
+                ssize_t n = write(fd, text + written, static_cast<size_t>(buffer.length() - written));
+                if (n > 0) {
+                    written += static_cast<Int32>(n);
+                } else {
+                    ok = n < 0 && errno == EINTR;
+                }
+            }
+            close(fd);
+            ok = ok && rename(temp_path, path) == 0;
+            if (!ok) {
+                unlink(temp_path);
+            }
+        }
+    }
+    return ok;
+}
+
+Int32 run_daemon(const char* socket_path, const char* shm_path, bool spin, Int32 worker_count,
+                 const AircraftProfile* profile, const TerrainTileCache* terrain, FlightRecorder* recorder,
+                 const char* metrics_path, Float64 aircraft_idle_s) {
+    Int32 return_code = error_success;
+
+    // The channel exists before the socket accepts anyone, so a client that
+    // connects finds it
+    ShmChannel* channel = nullptr;
+    Int32 listen_fd = no_client;
+    if (shm_path != nullptr) {
+        channel = open_shm_channel(shm_path, spin);
+    }
+    if (shm_path == nullptr || channel != nullptr) {
+        listen_fd = open_listen_socket(socket_path);
+    }
+
+    if (listen_fd == no_client) {
+        close_shm_channel(channel, shm_path);
+        return_code = error_socket_failed;
+    } else {
+        WorkPool pool(worker_count);
+        std::cerr << "mfd_calcd listening on " << socket_path << " (" << pool.worker_count()
+                  << (pool.worker_count() == 1 ? " worker)\n" : " workers)\n");
+        if (profile != nullptr) {
+            std::cerr << "mfd_calcd aircraft profile: " << profile->point_count() << " L/D points, best "
+                      << profile->best_lift_to_drag() << " at " << profile->best_glide_ias_kts() << " kts\n";
+        }
+        if (terrain != nullptr) {
+            std::cerr << "mfd_calcd terrain: " << terrain->tile_count()
+                      << (terrain->tile_count() == 1 ? " tile\n" : " tiles\n");
+        }
+        if (recorder != nullptr) {
+            std::cerr << "mfd_calcd recording sections to the flight log\n";
+        }
+        if (channel != nullptr) {
+            std::cerr << "mfd_calcd shared-memory channel " << shm_path << (spin ? " (spinning)" : "") << "\n";
+        }
+        if (metrics_path != nullptr) {
+            std::cerr << "mfd_calcd metrics to " << metrics_path << " every " << metrics_export_interval_ms
+                      << " ms\n";
+        }
+
+        // Gust history and result cache of the requests without an
+        // aircraft, fed by every such flight request for the life of the
+        // daemon (allocated once at startup)
+        ResidentFlightState flight_state;
+        GlideFootprint footprint;
+
+        // AV Rule 206: all per-connection, per-aircraft and per-reply
+        // storage is fixed
+        static Batch batch;
+        batch.shared_state = &flight_state;
+        batch.shared_footprint = &footprint;
+        batch.profile = profile;
+        batch.terrain = terrain;
+        batch.recorder = recorder;
+        batch.aircraft_idle_us = aircraft_idle_s * 1.0e6;
+        pollfd poll_fds[max_clients + 1];
+        Int32 poll_slot[max_clients + 1];
+
+        // The shared-memory channel is served on its own thread, so the
+        // socket loop sleeps in poll whether or not there is one
+        ShmServer shm_server;
+        std::thread shm_thread;
+        if (channel != nullptr) {
+            shm_server.channel = channel;
+            shm_server.spin = spin;
+            shm_server.recorder = recorder;
+            shm_thread = std::thread(run_shm_server, std::ref(shm_server));
+        }
+        bool pending = false;
+        Float64 next_metrics_us = monotonic_us();
+        bool metrics_failed = false;
+
+        while (stop_requested == 0) {
+            Int32 poll_count = 0;
+            poll_fds[poll_count].fd = listen_fd;
+            poll_fds[poll_count].events = POLLIN;
+            poll_slot[poll_count] = no_client;
+            ++poll_count;
+            for (Int32 i = 0; i < max_clients; ++i) {
+                ClientSlot& client = batch.clients[i];
+                if (client.fd != no_client && client.length < client_buffer_size) {
+                    poll_fds[poll_count].fd = client.fd;
+                    poll_fds[poll_count].events = POLLIN;
+                    poll_slot[poll_count] = i;
+                    ++poll_count;
+                }
+            }
+
+            // Lines left over from a full batch are answered without waiting
+            Int32 ready = poll(poll_fds, static_cast<nfds_t>(poll_count), pending ? 0 : poll_timeout_ms);
+            if (ready > 0) {
+                for (Int32 p = 1; p < poll_count; ++p) {
+                    if ((poll_fds[p].revents & (POLLIN | POLLHUP | POLLERR)) != 0) {
+                        ClientSlot& client = batch.clients[poll_slot[p]];
+                        ssize_t n = recv(client.fd, client.buffer + client.length,
+                                         static_cast<size_t>(client_buffer_size - client.length), 0);
+                        if (n <= 0) {
+                            close_client(client);
+                        } else {
+                            client.length += static_cast<Int32>(n);
+                        }
+                    }
+                }
+
+                if ((poll_fds[0].revents & POLLIN) != 0) {
+                    Int32 fd = accept(listen_fd, nullptr, nullptr);
+                    if (fd >= 0) {
+                        Int32 free_slot = no_client;
+                        for (Int32 i = 0; i < max_clients && free_slot == no_client; ++i) {
+                            if (batch.clients[i].fd == no_client) {
+                                free_slot = i;
+                            }
+                        }
+                        if (free_slot == no_client) {
+                            close(fd);  // all slots busy
+                        } else {
+                            close_client(batch.clients[free_slot]);
+                            batch.clients[free_slot].fd = fd;
+                        }
+                    }
+                }
+            } else if (ready < 0 && errno != EINTR) {
+                std::cerr << "Error: poll() failed: " << std::strerror(errno) << "\n";
+                stop_requested = 1;
+                return_code = error_socket_failed;
+            }
+
+            pending = serve_batch(batch, pool);
+
+            if (metrics_path != nullptr && monotonic_us() >= next_metrics_us) {
+                next_metrics_us = monotonic_us() + metrics_export_interval_ms * 1000.0;
+                if (!write_metrics_file(metrics_path) && !metrics_failed) {
+                    std::cerr << "Error: Cannot write metrics to " << metrics_path << "\n";
+                    metrics_failed = true;
+                }
+            }
+        }
+        if (channel != nullptr) {
+            shm_server.stop.store(true, std::memory_order_relaxed);
+            shm_doorbell_ring(channel->header.doorbell, true);
+            shm_thread.join();
+        }
+        if (metrics_path != nullptr) {
+            write_metrics_file(metrics_path);
+        }
+
+        for (Int32 i = 0; i < max_clients; ++i) {
+            close_client(batch.clients[i]);
+        }
+        close(listen_fd);
+        unlink(socket_path);
+        close_shm_channel(channel, shm_path);
+    }
+
+    return return_code;
+}
+
+} // namespace xplane_mfd::calc
+
+void print_usage(const char* program_name) {
+    std::cerr << "Usage: " << program_name << " [--socket <path>] [--shm <path> [--spin]] [--workers <n>]\n";
+    std::cerr << "       [--profile <path>] [--terrain <path> ...] [--record <path>] [--metrics <path>]\n";
+    std::cerr << "       [--aircraft-idle <s>]\n\n";
+    std::cerr << "Serves flight, turn, vnav and density calculations on a Unix socket\n";
+    std::cerr << "(default " << xplane_mfd::calc::default_socket_path << ").\n";
+    std::cerr << "--workers sets the compute threads (default: one per core).\n";
+    std::cerr << "--profile loads an aircraft performance profile (aircraft_profile.h) for\n";
+    std::cerr << "dynamic sections.\n";
+    std::cerr << "--terrain maps a terrain elevation tile (terrain_tiles.h) for footprint\n";
+    std::cerr << "sections; repeat it for up to 16 tiles.\n";
+    std::cerr << "--record appends every computed section to a flight-data log\n";
+    std::cerr << "(flight_recorder.h) for calc_batch --log.\n";
+    std::cerr << "--metrics writes the daemon's counters and compute-time histograms\n";
+    std::cerr << "(calc_metrics.h) to a file as Prometheus text every second.\n";
+    std::cerr << "--shm also serves one client through a shared-memory channel file\n";
+    std::cerr << "(shm_channel.h); --spin watches it without sleeping, using a whole core.\n";
+    std::cerr << "--aircraft-idle frees an aircraft's slot after that many seconds without a\n";
+    std::cerr << "frame (default " << xplane_mfd::calc::aircraft_idle_timeout_s << ").\n\n";
+    std::cerr << "Request line:  <id> <section> <fields...> [<section> <fields...> ...]\n";
+    std::cerr << "  flight  <tas_kts> <gs_kts> <heading> <track> <ias_kts> <mach> <altitude_ft>\n";
+    std::cerr << "          <agl_ft> <vs_fpm> <weight_kg> <bank_deg> <vso_kts> <vne_kts> <mmo>\n";
+    std::cerr << "  turn    <tas_kts> <bank_deg> <course_change_deg>\n";
+    std::cerr << "  vnav    <current_alt_ft> <target_alt_ft> <distance_nm> <groundspeed_kts> <current_vs_fpm>\n";
+    std::cerr << "  density <pressure_alt_ft> <oat_celsius> <ias_kts> <tas_kts> <force_error>\n";
+    std::cerr << "  dynamic <the first 11 flight fields>  (limits and glide from --profile)\n";
+    std::cerr << "  footprint <lat> <lon> <altitude_ft> <ias_kts> <tas_kts> <gs_kts> <heading> <track>\n";
+    std::cerr << "  wind_estimate <time_s> <altitude_ft> <tas_kts> <gs_kts> <heading> <track>\n\n";
+    std::cerr << "Start the request with '<id> binary' for a wire_format.h binary reply.\n";
+    std::cerr << "'<id> stats' reports the flight result cache's hit/miss counters,\n";
+    std::cerr << "'<id> metrics' every counter and kernel compute time as JSON.\n";
+    std::cerr << "'<id> aircraft <n> <sections...>' computes a frame of aircraft n with its own\n";
+    std::cerr << "state and pushes it to every '<id> subscribe <n>' client ('unsubscribe' stops).\n\n";
+    std::cerr << "Example:\n";
+    std::cerr << "  echo '1 turn 250 25 90 vnav 35000 10000 100 450 -1500' | nc -U /tmp/mfd_calcd.sock\n";
+}
+
+// AV Rule 113: Single exit point
+int main(int argc, char* argv[]) {
+    using namespace xplane_mfd::calc;
+
+    Int32 return_code = error_success;  // Single exit point variable
+    const char* socket_path = default_socket_path;
+    const char* shm_path = nullptr;
+    bool spin = false;
+    const char* profile_path = nullptr;
+    const char* terrain_paths[max_terrain_tiles] = {};
+    Int32 terrain_path_count = 0;
+    const char* record_path = nullptr;
+    const char* metrics_path = nullptr;
+    Int64 workers = static_cast<Int64>(std::thread::hardware_concurrency());
+    Float64 aircraft_idle_s = aircraft_idle_timeout_s;
+
+    for (Int32 i = 1; i < argc && return_code == error_success; ++i) {
+        if (std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            socket_path = argv[i + 1];
+            ++i;
+        } else if (std::strcmp(argv[i], "--shm") == 0 && i + 1 < argc) {
+            shm_path = argv[i + 1];
+            ++i;
+        } else if (std::strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            profile_path = argv[i + 1];
+            ++i;
+        } else if (std::strcmp(argv[i], "--terrain") == 0 && i + 1 < argc &&
+                   terrain_path_count < max_terrain_tiles) {
+            terrain_paths[terrain_path_count] = argv[i + 1];
+            ++terrain_path_count;
+            ++i;
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record_path = argv[i + 1];
+            ++i;
+        } else if (std::strcmp(argv[i], "--metrics") == 0 && i + 1 < argc &&
+                   std::strlen(argv[i + 1]) + 5 <= static_cast<size_t>(metrics_path_max)) {
+            metrics_path = argv[i + 1];
+            ++i;
+        } else if (std::strcmp(argv[i], "--aircraft-idle") == 0 && i + 1 < argc &&
+                   parse_float64(argv[i + 1], aircraft_idle_s) && aircraft_idle_s > 0.0) {
+            ++i;
+        } else if (std::strcmp(argv[i], "--spin") == 0) {
+            spin = true;
+        } else if (std::strcmp(argv[i], "--workers") == 0 && i + 1 < argc &&
+                   parse_int64(argv[i + 1], workers) && workers >= 1 && workers <= max_pool_workers) {
+            ++i;
+        } else {
+            return_code = error_invalid_args;
+        }
+    }
+    if (return_code == error_success && spin && shm_path == nullptr) {
+        return_code = error_invalid_args;
+    }
+    if (return_code != error_success) {
+        print_usage(argv[0]);
+    }
+
+    // Loaded once; every aircraft's dynamic sections read it
+    AircraftProfile profile;
+    if (return_code == error_success && profile_path != nullptr && !profile.load(profile_path)) {
+        std::cerr << "Error: " << profile_path << " is not a valid aircraft profile (aircraft_profile.h)\n";
+        return_code = error_invalid_args;
+    }
+
+    // Mapped once; every aircraft's footprint samples them
+    TerrainTileCache terrain;
+    for (Int32 i = 0; i < terrain_path_count && return_code == error_success; ++i) {
+        if (!terrain.load(terrain_paths[i])) {
+            std::cerr << "Error: " << terrain_paths[i] << " is not a valid terrain tile (terrain_tiles.h)\n";
+            return_code = error_invalid_args;
+        }
+    }
+
+    // The ring is large: static storage rather than the stack
+    static FlightRecorder recorder;
+    if (return_code == error_success && record_path != nullptr && !recorder.open(record_path)) {
+        std::cerr << "Error: Cannot create flight log " << record_path << "\n";
+        return_code = error_invalid_args;
+    }
+
+    if (return_code == error_success) {
+        std::signal(SIGINT, handle_stop_signal);
+        std::signal(SIGTERM, handle_stop_signal);
+        std::signal(SIGPIPE, SIG_IGN);
+        return_code = run_daemon(socket_path, shm_path, spin, static_cast<Int32>(workers),
+                                 profile.loaded() ? &profile : nullptr,
+                                 terrain.tile_count() > 0 ? &terrain : nullptr,
+                                 recorder.is_open() ? &recorder : nullptr, metrics_path, aircraft_idle_s);
+    }
+
+    if (recorder.is_open()) {
+        recorder.close();
+        std::cerr << "mfd_calcd flight log " << record_path << ": " << recorder.written_count() << " records, "
+                  << recorder.dropped_count() << " dropped\n";
+    }
+
+    return return_code;  // Single exit point
+}
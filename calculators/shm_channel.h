@@ -0,0 +1,180 @@
+// Shared-Memory Snapshot Channel for the X-Plane MFD Calculator Daemon
+// JSF AV C++ Coding Standard Compliant Version
+//
+// An optional alternative to the mfd_calcd socket (--shm <path>): a small
+// file mapped into both processes holding one input frame, written by the
+// MFD, and one result frame, written by the daemon. Each frame is guarded
+// by a seqlock, so neither side makes a system call to hand a frame over
+// to a spinning daemon. There is one writer per frame: the channel serves a
+// single client.
+//
+//   offset  size  block
+//   0       64    ShmChannelHeader  magic "XMFS", shm_version, total size,
+//                                   doorbell, doorbell_wait
+//   64      240   ShmInputFrame     section inputs as Float64 values
+//   320     536   ShmResultFrame    wire_format.h records
+//
+// Seqlock protocol (both frames): the writer increments sequence to an odd
+// value, writes the frame, then increments it back to even. A reader copies
+// the frame and keeps the copy only if sequence was even and unchanged
+// across the copy. frame_id tells the two sides' frames apart: the daemon
+// answers each new input frame_id once, and its result frame carries the
+// same frame_id.
+//
+// Doorbell: after publishing an input frame the client adds 1 to doorbell.
+// A daemon that spins (--spin) watches the input sequence and needs nothing
+// more. Otherwise the daemon sets doorbell_wait to 1 and sleeps until
+// doorbell changes (a Linux futex, shm_doorbell_wait), so the client also
+// wakes it (FUTEX_WAKE on doorbell, shm_doorbell_ring): one system call per
+// frame instead of the daemon waking on a timer. The stores are ordered
+// only as x86-64 keeps them: a client without fences (Python) must run
+// there.
+//
+// Header ("<IIIII"): magic, version, size, doorbell, doorbell_wait.
+//
+// Input frame (little-endian, Python struct "<QQII14d3d5d5d"):
+//   sequence, frame_id, section_mask (bit n = section n: flight, turn,
+//   vnav, density), reserved, then each section's fields in the order of
+//   the socket protocol.
+//
+// Result frame ("<QQII" then length bytes): sequence, frame_id, length,
+// reserved, then the bytes of a binary socket reply: the section records,
+// a timing record and the reply record (id = frame_id).
+//
+// A change to this layout must bump shm_version.
+//
+// AV Rule 126: C++ style comments only (//)
+
+#ifndef SHM_CHANNEL_H
+#define SHM_CHANNEL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <time.h>
+#include "jsf_types.h"
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace xplane_mfd::calc {
+
+// Channel identification and sizes (AV Rule 52: lowercase)
+const Uint32 shm_magic = 0x53464D58u;  // bytes 'X' 'M' 'F' 'S' little-endian
+const Uint32 shm_version = 2;
+const Int32 shm_section_count = 4;
+const Int32 shm_flight_fields = 14;
+const Int32 shm_result_bytes = 512;
+
+struct ShmChannelHeader {
+    Uint32 magic;
+    Uint32 version;
+    Uint32 size;
+    Uint32 doorbell;       // client: +1 per input frame published
+    Uint32 doorbell_wait;  // daemon: 1 if it sleeps on doorbell
+    Uint32 reserved[11];
+};
+
+struct ShmInputFrame {
+    Uint64 sequence;
+    Uint64 frame_id;
+    Uint32 section_mask;
+    Uint32 reserved;
+    Float64 flight[shm_flight_fields];
+    Float64 turn[3];
+    Float64 vnav[5];
+    Float64 density[5];
+};
+
+struct ShmResultFrame {
+    Uint64 sequence;
+    Uint64 frame_id;
+    Uint32 length;
+    Uint32 reserved;
+    Uint8 records[shm_result_bytes];
+};
+
+// AV Rule 209: every field is fixed width; the frames start on their own
+// cache lines so the two writers never share one
+struct ShmChannel {
+    ShmChannelHeader header;
+    alignas(64) ShmInputFrame input;
+    alignas(64) ShmResultFrame result;
+};
+
+static_assert(sizeof(ShmChannelHeader) == 64 && offsetof(ShmChannelHeader, doorbell) == 12,
+              "shm header layout");
+static_assert(offsetof(ShmChannel, input) == 64, "shm input frame offset");
+static_assert(sizeof(ShmInputFrame) == 240, "shm input frame layout");
+static_assert(offsetof(ShmChannel, result) == 320, "shm result frame offset");
+static_assert(offsetof(ShmResultFrame, records) == 24, "shm result frame layout");
+
+const Int32 shm_channel_size = static_cast<Int32>(sizeof(ShmChannel));
+
+// Mark a frame as being written (sequence becomes odd)
+inline void seqlock_write_begin(Uint64& sequence) {
+    std::atomic_ref<Uint64> seq(sequence);
+    seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+// Publish the written frame (sequence becomes even)
+inline void seqlock_write_end(Uint64& sequence) {
+    std::atomic_ref<Uint64> seq(sequence);
+    seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+// Copy a frame the other process writes; false if it was being written
+template <typename Frame>
+bool seqlock_read(Frame& shared, Frame& copy) {
+    std::atomic_ref<Uint64> seq(shared.sequence);
+    Uint64 before = seq.load(std::memory_order_acquire);
+    std::memcpy(&copy, &shared, sizeof(Frame));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    Uint64 after = seq.load(std::memory_order_relaxed);
+    return before == after && (before & 1u) == 0u;
+}
+
+// True where the daemon can sleep on the doorbell (Linux futexes)
+inline bool shm_doorbell_sleeps() {
+#if defined(__linux__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Sleep until doorbell is no longer seen or timeout_ms passes (wakes early
+// spuriously); elsewhere than Linux, sleep timeout_ms
+inline void shm_doorbell_wait(Uint32& doorbell, Uint32 seen, Int32 timeout_ms) {
+#if defined(__linux__)
+    // A shared (not FUTEX_PRIVATE) futex: the client is another process
+    timespec timeout = {timeout_ms / 1000, static_cast<long>(timeout_ms % 1000) * 1000000L};
+    syscall(SYS_futex, &doorbell, FUTEX_WAIT, seen, &timeout, nullptr, 0);
+#else
+    (void)doorbell;
+    (void)seen;
+    timespec timeout = {timeout_ms / 1000, static_cast<long>(timeout_ms % 1000) * 1000000L};
+    nanosleep(&timeout, nullptr);
+#endif
+}
+
+// Add 1 to doorbell and, with wake (the header's doorbell_wait), wake a
+// daemon sleeping on it
+inline void shm_doorbell_ring(Uint32& doorbell, bool wake) {
+    std::atomic_ref<Uint32>(doorbell).fetch_add(1u, std::memory_order_release);
+#if defined(__linux__)
+    if (wake) {
+        syscall(SYS_futex, &doorbell, FUTEX_WAKE, 1, nullptr, nullptr, 0);
+    }
+#else
+    (void)wake;
+#endif
+}
+
+} // namespace xplane_mfd::calc
+
+#endif // SHM_CHANNEL_H
@@ -0,0 +1,198 @@
+// SIMD Math for X-Plane MFD Calculators
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Four-lane Float64 vectors (GCC vector extensions) and branch-free
+// sin/cos/tan/atan approximations for the batch kernels. The same source
+// compiles to AVX2 (one 256-bit register per vector), SSE2 or NEON (two
+// 128-bit registers); functions marked SIMD_DISPATCH get one clone per ISA
+// and the best one for the running CPU is chosen when the program loads.
+//
+// Error against glibc libm (largest of 1M uniform samples per range,
+// |x| up to 1.6, 7, 100, 1e4 and 1e5 rad):
+//   simd_sincos  <= 2 ulp (Cody-Waite reduction by pi/2, fdlibm polynomials;
+//                the reduction stays exact for |x| < 1.6e6 rad)
+//   simd_tan     <= 3 ulp where |cos x| > 1e-3 (sin/cos quotient)
+//   simd_atan    <= 1 ulp (Cephes rational approximation)
+//
+// AV Rule 126: C++ style comments only (//)
+
+#ifndef SIMD_MATH_H
+#define SIMD_MATH_H
+
+#include <cstring>
+#include "jsf_types.h"
+
+// Force the helpers into each ISA clone of their caller, so the vector
+// code is generated for that clone's instruction set
+#define SIMD_INLINE inline __attribute__((always_inline))
+
+// One clone per ISA, picked at load time (ifunc). Other targets compile
+// the portable vector code for their baseline (NEON on AArch64).
+#if defined(__x86_64__) && defined(__linux__)
+#define SIMD_DISPATCH __attribute__((target_clones("avx2", "default")))
+#else
+#define SIMD_DISPATCH
+#endif
+
+// Vectors only cross always-inline helpers (arguments by reference), so the
+// vector-return ABI warning GCC emits for non-AVX clones does not apply.
+// Left off for the rest of the including file, whose vector code is built
+// the same way.
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+namespace xplane_mfd::calc {
+
+// AV Rule 209: fixed-width vector types
+typedef Float64 Float64x4 __attribute__((vector_size(32)));
+typedef Int64 Int64x4 __attribute__((vector_size(32)));
+
+const Int32 simd_lanes = 4;
+
+// Name of the instruction set the SIMD_DISPATCH kernels run with
+inline const char* simd_isa_name() {
+    const char* name = "generic";
+#if defined(__x86_64__) && defined(__linux__)
+    name = __builtin_cpu_supports("avx2") ? "avx2" : "sse2";
+#elif defined(__aarch64__)
+    name = "neon";
+#endif
+    return name;
+}
+
+SIMD_INLINE Float64x4 simd_load(const Float64* data) {
+    Float64x4 v;
+    std::memcpy(&v, data, sizeof(v));
+    return v;
+}
+
+SIMD_INLINE void simd_store(Float64* data, const Float64x4& v) {
+    std::memcpy(data, &v, sizeof(v));
+}
+
+// Load/store the first count rows (count <= simd_lanes); spare lanes of a
+// short load repeat the first row so they compute harmless values
+SIMD_INLINE Float64x4 simd_load_partial(const Float64* data, Int32 count) {
+    Float64 lanes[simd_lanes];
+    for (Int32 i = 0; i < simd_lanes; ++i) {
+        lanes[i] = data[i < count ? i : 0];
+    }
+    return simd_load(lanes);
+}
+
+SIMD_INLINE void simd_store_partial(Float64* data, const Float64x4& v, Int32 count) {
+    if (count >= simd_lanes) {
+        simd_store(data, v);
+    } else {
+        Float64 lanes[simd_lanes];
+        simd_store(lanes, v);
+        for (Int32 i = 0; i < count; ++i) {
+            data[i] = lanes[i];
+        }
+    }
+}
+
+SIMD_INLINE Float64x4 simd_splat(Float64 value) {
+    return Float64x4{value, value, value, value};
+}
+
+SIMD_INLINE Float64x4 simd_abs(const Float64x4& x) {
+    return x < 0.0 ? -x : x;
+}
+
+// Round to nearest integer (|x| < 2^51): adding 1.5 * 2^52 pushes the
+// fraction bits out of the mantissa
+const Float64 simd_round_magic = 6755399441055744.0;
+
+SIMD_INLINE Float64x4 simd_floor(const Float64x4& x) {
+    Float64x4 rounded = (x + simd_round_magic) - simd_round_magic;
+    return rounded > x ? rounded - 1.0 : rounded;
+}
+
+// Polynomial coefficients (fdlibm __kernel_sin / __kernel_cos on [-pi/4, pi/4])
+const Float64 sin_c1 = -1.66666666666666324348e-01;
+const Float64 sin_c2 = 8.33333333332248946124e-03;
+const Float64 sin_c3 = -1.98412698298579493134e-04;
+const Float64 sin_c4 = 2.75573137070700676789e-06;
+const Float64 sin_c5 = -2.50507602534068634195e-08;
+const Float64 sin_c6 = 1.58969099521155010221e-10;
+const Float64 cos_c1 = 4.16666666666666019037e-02;
+const Float64 cos_c2 = -1.38888888888741095749e-03;
+const Float64 cos_c3 = 2.48015872894767294178e-05;
+const Float64 cos_c4 = -2.75573143513906633035e-07;
+const Float64 cos_c5 = 2.08757232129817482790e-09;
+const Float64 cos_c6 = -1.13596475577881948265e-11;
+
+// pi/2 split so that n * pio2_hi is exact for n < 2^20
+const Float64 two_over_pi = 6.36619772367581382433e-01;
+const Float64 pio2_hi = 1.57079632673412561417e+00;
+const Float64 pio2_lo = 6.07710050650619224932e-11;
+
+// sin and cos of x together (one range reduction)
+SIMD_INLINE void simd_sincos(const Float64x4& x, Float64x4& sin_x, Float64x4& cos_x) {
+    Float64x4 shifted = x * two_over_pi + simd_round_magic;
+    Float64x4 n = shifted - simd_round_magic;
+    Int64x4 quadrant = reinterpret_cast<Int64x4>(shifted) & 3;
+    Float64x4 r = (x - n * pio2_hi) - n * pio2_lo;
+    Float64x4 r2 = r * r;
+
+    Float64x4 sin_poly = sin_c2 + r2 * (sin_c3 + r2 * (sin_c4 + r2 * (sin_c5 + r2 * sin_c6)));
+    Float64x4 sin_r = r + r * r2 * (sin_c1 + r2 * sin_poly);
+
+    // 1 - r2/2 with the rounding error of the subtraction added back
+    Float64x4 half_r2 = 0.5 * r2;
+    Float64x4 w = 1.0 - half_r2;
+    Float64x4 cos_poly = r2 * (cos_c1 + r2 * (cos_c2 + r2 * (cos_c3 + r2 * (cos_c4 + r2 * (cos_c5 + r2 * cos_c6)))));
+    Float64x4 cos_r = w + (((1.0 - w) - half_r2) + r2 * cos_poly);
+
+    // Odd quadrants swap sin and cos; quadrants 2-3 (sin) and 1-2 (cos) negate
+    Int64x4 odd = (quadrant & 1) != 0;
+    Float64x4 s = odd ? cos_r : sin_r;
+    Float64x4 c = odd ? sin_r : cos_r;
+    sin_x = (quadrant & 2) != 0 ? -s : s;
+    cos_x = ((quadrant + 1) & 2) != 0 ? -c : c;
+}
+
+SIMD_INLINE Float64x4 simd_tan(const Float64x4& x) {
+    Float64x4 s;
+    Float64x4 c;
+    simd_sincos(x, s, c);
+    return s / c;
+}
+
+// Rational approximation coefficients (Cephes atan.c)
+const Float64 atan_p0 = -8.750608600031904122785e-01;
+const Float64 atan_p1 = -1.615753718733365076637e+01;
+const Float64 atan_p2 = -7.500855792314704667340e+01;
+const Float64 atan_p3 = -1.228866684490136173410e+02;
+const Float64 atan_p4 = -6.485021904942025371773e+01;
+const Float64 atan_q0 = 2.485846490142306297962e+01;
+const Float64 atan_q1 = 1.650270098316988542046e+02;
+const Float64 atan_q2 = 4.328810604912902668951e+02;
+const Float64 atan_q3 = 4.853903996359136964868e+02;
+const Float64 atan_q4 = 1.945506571482613964425e+02;
+const Float64 tan_3pi_8 = 2.41421356237309504880;
+const Float64 atan_mid_threshold = 0.66;
+const Float64 pi_over_2 = 1.57079632679489661923;
+const Float64 pi_over_4 = 7.85398163397448309616e-01;
+const Float64 pio2_tail = 6.123233995736765886130e-17;  // pi/2 - pi_over_2
+
+SIMD_INLINE Float64x4 simd_atan(const Float64x4& x) {
+    Float64x4 ax = simd_abs(x);
+    Int64x4 big = ax > tan_3pi_8;
+    Int64x4 mid = ax > atan_mid_threshold;
+
+    // Reduce to |xr| <= 0.66 around 0, pi/4 or pi/2
+    Float64x4 xr = big ? -1.0 / ax : (mid ? (ax - 1.0) / (ax + 1.0) : ax);
+    Float64x4 base = big ? simd_splat(pi_over_2) : (mid ? simd_splat(pi_over_4) : simd_splat(0.0));
+    Float64x4 tail = big ? simd_splat(pio2_tail) : (mid ? simd_splat(0.5 * pio2_tail) : simd_splat(0.0));
+
+    Float64x4 z = xr * xr;
+    Float64x4 p = (((atan_p0 * z + atan_p1) * z + atan_p2) * z + atan_p3) * z + atan_p4;
+    Float64x4 q = ((((z + atan_q0) * z + atan_q1) * z + atan_q2) * z + atan_q3) * z + atan_q4;
+    Float64x4 result = base + ((xr * (z * p / q) + xr) + tail);
+    return x < 0.0 ? -result : result;
+}
+
+} // namespace xplane_mfd::calc
+
+#endif // SIMD_MATH_H
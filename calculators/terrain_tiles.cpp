@@ -0,0 +1,136 @@
+// Terrain Elevation Tiles for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Implementation of the tile cache declared in terrain_tiles.h.
+//
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses return codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (tiles are mapped once)
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "terrain_tiles.h"
+
+namespace xplane_mfd::calc {
+
+namespace {
+
+const Int64 sample_alignment = 2;
+const Float64 max_latitude_deg = 90.0;
+
+bool image_valid(const void* image, Int64 size) {
+    bool valid = image != nullptr && size >= static_cast<Int64>(sizeof(TerrainTileHeader)) &&
+                 reinterpret_cast<std::uintptr_t>(image) % sample_alignment == 0;
+    const TerrainTileHeader* header = static_cast<const TerrainTileHeader*>(image);
+    if (valid) {
+        valid = header->magic == terrain_tile_magic && header->version == terrain_tile_version &&
+                header->rows >= 2 && header->rows <= terrain_max_samples &&
+                header->columns >= 2 && header->columns <= terrain_max_samples &&
+                size == static_cast<Int64>(sizeof(TerrainTileHeader)) +
+                        static_cast<Int64>(header->rows) * header->columns * static_cast<Int64>(sizeof(Int16)) &&
+                std::isfinite(header->south_lat_deg) && std::isfinite(header->west_lon_deg) &&
+                std::isfinite(header->spacing_deg) && header->spacing_deg > 0.0 &&
+                header->south_lat_deg >= -max_latitude_deg &&
+                header->south_lat_deg + (header->rows - 1) * header->spacing_deg <= max_latitude_deg;
+    }
+    return valid;
+}
+
+} // namespace
+
+TerrainTileCache::TerrainTileCache() : tiles_{}, tile_count_(0) {
+}
+
+TerrainTileCache::~TerrainTileCache() {
+    for (Int32 i = 0; i < tile_count_; ++i) {
+        if (tiles_[i].mapping != nullptr) {
+            munmap(tiles_[i].mapping, static_cast<size_t>(tiles_[i].mapping_size));
+        }
+    }
+}
+
+bool TerrainTileCache::load(const char* path) {
+    bool ok = false;
+    Int32 fd = tile_count_ < max_terrain_tiles ? open(path, O_RDONLY) : -1;
+    if (fd >= 0) {
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+            Int64 size = static_cast<Int64>(file_stat.st_size);
+            void* mapping = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                ok = attach(mapping, size);
+                if (ok) {
+                    tiles_[tile_count_ - 1].mapping = mapping;
+                    tiles_[tile_count_ - 1].mapping_size = size;
+                } else {
+                    munmap(mapping, static_cast<size_t>(size));
+                }
+            }
+        }
+        close(fd);
+    }
+    return ok;
+}
+
+bool TerrainTileCache::attach(const void* image, Int64 size) {
+    bool ok = tile_count_ < max_terrain_tiles && image_valid(image, size);
+    if (ok) {
+        Tile& tile = tiles_[tile_count_];
+        tile.header = static_cast<const TerrainTileHeader*>(image);
+        tile.samples = reinterpret_cast<const Int16*>(tile.header + 1);
+        tile.mapping = nullptr;
+        tile.mapping_size = 0;
+        ++tile_count_;
+    }
+    return ok;
+}
+
+bool TerrainTileCache::sample(const Tile& tile, Float64 lat_deg, Float64 lon_deg, Float64& elevation_ft) const {
+    const TerrainTileHeader& header = *tile.header;
+    Float64 row = (lat_deg - header.south_lat_deg) / header.spacing_deg;
+    Float64 col = (lon_deg - header.west_lon_deg) / header.spacing_deg;
+    Float64 last_row = static_cast<Float64>(header.rows - 1);
+    Float64 last_col = static_cast<Float64>(header.columns - 1);
+    bool inside = row >= 0.0 && row <= last_row && col >= 0.0 && col <= last_col;
+    if (inside) {
+        // The cell's south-west corner, kept one short of the far edges so
+        // a point on them uses the last cell
+        Int32 r = static_cast<Int32>(std::min(row, last_row - 1.0));
+        Int32 c = static_cast<Int32>(std::min(col, last_col - 1.0));
+        Float64 fr = row - r;
+        Float64 fc = col - c;
+        const Int16* south = tile.samples + static_cast<Int64>(r) * header.columns + c;
+        const Int16* north = south + header.columns;
+        Float64 south_ft = south[0] + fc * (south[1] - south[0]);
+        Float64 north_ft = north[0] + fc * (north[1] - north[0]);
+        elevation_ft = south_ft + fr * (north_ft - south_ft);
+    }
+    return inside;
+}
+
+Float64 TerrainTileCache::elevation_ft(Float64 lat_deg, Float64 lon_deg, Int32& tile_hint) const {
+    Float64 elevation = 0.0;
+    bool found = tile_hint >= 0 && tile_hint < tile_count_ &&
+                 sample(tiles_[tile_hint], lat_deg, lon_deg, elevation);
+    if (!found) {
+        tile_hint = no_terrain_tile;
+        for (Int32 i = 0; i < tile_count_ && !found; ++i) {
+            found = sample(tiles_[i], lat_deg, lon_deg, elevation);
+            if (found) {
+                tile_hint = i;
+            }
+        }
+    }
+    return elevation;
+}
+
+} // namespace xplane_mfd::calc
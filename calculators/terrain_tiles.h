@@ -0,0 +1,98 @@
+// Terrain Elevation Tiles for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// A cache of terrain elevation grids, each a file memory mapped read only
+// and sampled where it lies (mfd_calcd --terrain <path>, once per tile).
+// A tile covers a latitude/longitude rectangle with a regular grid of
+// elevations in feet:
+//
+//   offset  size   field                Python struct "<IIii3d" + r*c * "h"
+//   0       4      magic "XPTE"
+//   4       4      terrain_tile_version
+//   8       4      rows r (latitude samples, 2..terrain_max_samples)
+//   12      4      columns c (longitude samples, 2..terrain_max_samples)
+//   16      24     south_lat_deg, west_lon_deg, spacing_deg
+//   40      2rc    Int16 elevation_ft, row-major: row 0 is the southern
+//                  edge, each row west to east
+//
+// Sample (row, col) is at (south + row * spacing, west + col * spacing).
+// The file size must be exactly 40 + 2rc. Elevations between samples are
+// bilinear. Tiles should not overlap (where they do, either may be
+// sampled); outside every tile the terrain is taken as sea level. A change
+// to this layout must bump terrain_tile_version.
+//
+// A loaded cache is never written, so any number of threads may sample it
+// at once.
+//
+// AV Rule 126: C++ style comments only (//)
+
+#ifndef TERRAIN_TILES_H
+#define TERRAIN_TILES_H
+
+#include <array>
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+// File identification and limits (AV Rule 52: lowercase)
+const Uint32 terrain_tile_magic = 0x45545058u;  // bytes 'X' 'P' 'T' 'E' little-endian
+const Uint32 terrain_tile_version = 1;
+const Int32 terrain_max_samples = 4096;
+const Int32 max_terrain_tiles = 16;
+const Int32 no_terrain_tile = -1;
+
+struct TerrainTileHeader {
+    Uint32 magic;
+    Uint32 version;
+    Int32 rows;
+    Int32 columns;
+    Float64 south_lat_deg;
+    Float64 west_lon_deg;
+    Float64 spacing_deg;
+};
+
+static_assert(sizeof(TerrainTileHeader) == 40, "terrain tile header layout");
+
+class TerrainTileCache {
+public:
+    TerrainTileCache();
+    ~TerrainTileCache();
+
+    TerrainTileCache(const TerrainTileCache&) = delete;
+    TerrainTileCache& operator=(const TerrainTileCache&) = delete;
+
+    // Map one more tile. False if the cache is full or the file is not a
+    // valid tile (see attach).
+    bool load(const char* path);
+
+    // Add a tile image already in memory (2-byte aligned, kept alive by the
+    // caller). False if the cache is full, or the header or size is
+    // invalid: spacing positive and finite, the rectangle within +-90
+    // latitude.
+    bool attach(const void* image, Int64 size);
+
+    Int32 tile_count() const { return tile_count_; }
+
+    // Terrain elevation in feet at a position (0 outside every tile).
+    // tile_hint is the caller's guess of the tile, updated to the tile
+    // sampled (or no_terrain_tile): a caller walking a path keeps one hint
+    // and usually finds its tile on the first try.
+    Float64 elevation_ft(Float64 lat_deg, Float64 lon_deg, Int32& tile_hint) const;
+
+private:
+    struct Tile {
+        const TerrainTileHeader* header;
+        const Int16* samples;
+        void* mapping;
+        Int64 mapping_size;
+    };
+
+    bool sample(const Tile& tile, Float64 lat_deg, Float64 lon_deg, Float64& elevation_ft) const;
+
+    std::array<Tile, max_terrain_tiles> tiles_;
+    Int32 tile_count_;
+};
+
+} // namespace xplane_mfd::calc
+
+#endif // TERRAIN_TILES_H
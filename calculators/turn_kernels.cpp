@@ -0,0 +1,216 @@
+// Turn Performance Kernels for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Implementation of the kernels declared in turn_kernels.h.
+//
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try)
+// - AV Rule 209: Fixed-width types (Int32, Float64)
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#include <cmath>
+#include "turn_kernels.h"
+#include "units.h"
+#include "wire_format.h"
+#include "calc_io.h"
+#include "simd_math.h"
+
+namespace xplane_mfd::calc {
+
+// Physical constants (AV Rule 52: lowercase); conversions are in units.h
+const Float64 gravity = standard_gravity.value();  // m/s²
+const Float64 standard_rate_rad_s = convert<DegreesPerSecond, RadiansPerSecond>(3.0);
+
+// Magic number constants (AV Rule 151: no magic numbers)
+const Float64 infinite_radius_nm = 999.9;
+const Float64 infinite_radius_ft = 999900.0;
+const Float64 zero_turn_rate = 0.0;
+const Float64 infinite_time = 999.9;
+const Float64 min_tan_threshold = 0.001;
+const Float64 min_turn_rate_threshold = 0.01;
+
+// Accepted bank angle range (degrees)
+const Float64 min_bank_deg = 0.0;
+const Float64 max_bank_deg = 90.0;
+
+bool turn_inputs_valid(Float64 tas_kts, Float64 bank_deg) {
+    return tas_kts > 0.0 && bank_deg >= min_bank_deg && bank_deg <= max_bank_deg;
+}
+
+bool turn_wings_level(Float64 bank_deg) {
+    return fabs(tan(convert<Degrees, Radians>(bank_deg))) < min_tan_threshold;
+}
+
+// Calculate comprehensive turn performance
+TurnData calculate_turn_performance(Float64 tas_kts, Float64 bank_deg, Float64 course_change_deg) {
+    TurnData result;
+    
+    // Convert inputs
+    Float64 v_ms = convert<Knots, MetersPerSecond>(tas_kts);  // TAS in m/s
+    Float64 phi_rad = convert<Degrees, Radians>(bank_deg);  // Bank angle in radians
+    Float64 delta_psi_rad = convert<Degrees, Radians>(course_change_deg);  // Course change in radians
+    
+    // Calculate load factor
+    result.load_factor = 1.0 / cos(phi_rad);
+    
+    // Turn radius: R = V² / (g * tan φ)
+    Float64 tan_phi = tan(phi_rad);
+    if (fabs(tan_phi) < min_tan_threshold) {
+        // Essentially wings level - infinite radius
+        result.radius_nm = infinite_radius_nm;
+        result.radius_ft = infinite_radius_ft;
+        result.turn_rate_dps = zero_turn_rate;
+        result.lead_distance_nm = zero_turn_rate;
+        result.lead_distance_ft = zero_turn_rate;
+        result.time_to_turn_sec = infinite_time;
+    } else {
+        Float64 radius_m = (v_ms * v_ms) / (gravity * tan_phi);
+        
+        // Convert radius to NM and feet
+        result.radius_nm = convert<Meters, NauticalMiles>(radius_m);
+        result.radius_ft = convert<Meters, Feet>(radius_m);
+        
+        // Turn rate: ω = (g * tan φ) / V (rad/s) -> convert to deg/s
+        Float64 omega_rad_s = (gravity * tan_phi) / v_ms;
+        result.turn_rate_dps = convert<RadiansPerSecond, DegreesPerSecond>(omega_rad_s);
+        
+        // Lead distance: L = R * tan(Δψ/2)
+        Float64 lead_m = radius_m * tan(delta_psi_rad / 2.0);
+        result.lead_distance_nm = convert<Meters, NauticalMiles>(lead_m);
+        result.lead_distance_ft = convert<Meters, Feet>(lead_m);
+        
+        // Time to turn
+        if (fabs(result.turn_rate_dps) > min_turn_rate_threshold) {
+            result.time_to_turn_sec = course_change_deg / result.turn_rate_dps;
+        } else {
+            result.time_to_turn_sec = infinite_time;
+        }
+    }
+    
+    // Standard rate bank angle: φ = atan(ω * V / g) where ω = 3°/s
+    Float64 std_bank_rad = atan((standard_rate_rad_s * v_ms) / gravity);
+    result.standard_rate_bank = convert<Radians, Degrees>(std_bank_rad);
+    
+    return result;
+}
+
+// Structure-of-arrays batch kernel: row i of out is the result of
+// calculate_turn_performance for row i of in. Inputs are not validated;
+// callers check turn_inputs_valid per row. The loop is in this translation
+// unit so the scalar kernel inlines into it; ivdep passes on the
+// no-overlap contract (no run-time alias checks).
+void calculate_turn_performance_batch(const TurnBatchInputs& in, const TurnBatchOutputs& out, Int32 count) {
+    const Float64* tas_kts = in.tas_kts;
+    const Float64* bank_deg = in.bank_deg;
+    const Float64* course_change_deg = in.course_change_deg;
+    Float64* radius_nm = out.radius_nm;
+    Float64* radius_ft = out.radius_ft;
+    Float64* turn_rate_dps = out.turn_rate_dps;
+    Float64* lead_distance_nm = out.lead_distance_nm;
+    Float64* lead_distance_ft = out.lead_distance_ft;
+    Float64* time_to_turn_sec = out.time_to_turn_sec;
+    Float64* load_factor = out.load_factor;
+    Float64* standard_rate_bank = out.standard_rate_bank;
+
+    #pragma GCC ivdep
+    for (Int32 i = 0; i < count; ++i) {
+        TurnData result = calculate_turn_performance(tas_kts[i], bank_deg[i], course_change_deg[i]);
+        radius_nm[i] = result.radius_nm;
+        radius_ft[i] = result.radius_ft;
+        turn_rate_dps[i] = result.turn_rate_dps;
+        lead_distance_nm[i] = result.lead_distance_nm;
+        lead_distance_ft[i] = result.lead_distance_ft;
+        time_to_turn_sec[i] = result.time_to_turn_sec;
+        load_factor[i] = result.load_factor;
+        standard_rate_bank[i] = result.standard_rate_bank;
+    }
+}
+
+namespace {
+
+// calculate_turn_performance for up to simd_lanes rows starting at row;
+// both sides of each branch are computed and selected per lane
+SIMD_INLINE void turn_performance_lanes(const TurnBatchInputs& in, const TurnBatchOutputs& out,
+                                        Int32 row, Int32 lanes) {
+    Float64x4 tas_kts = simd_load_partial(in.tas_kts + row, lanes);
+    Float64x4 bank_deg = simd_load_partial(in.bank_deg + row, lanes);
+    Float64x4 course_change_deg = simd_load_partial(in.course_change_deg + row, lanes);
+
+    Float64x4 v_ms = convert<Knots, MetersPerSecond>(tas_kts);
+    Float64x4 sin_phi;
+    Float64x4 cos_phi;
+    simd_sincos(convert<Degrees, Radians>(bank_deg), sin_phi, cos_phi);
+    Float64x4 tan_phi = sin_phi / cos_phi;
+    Float64x4 load_factor = 1.0 / cos_phi;
+
+    // Turning lanes
+    Float64x4 radius_m = (v_ms * v_ms) / (gravity * tan_phi);
+    Float64x4 turn_rate_dps = convert<RadiansPerSecond, DegreesPerSecond>((gravity * tan_phi) / v_ms);
+    Float64x4 lead_m = radius_m * simd_tan(convert<Degrees, Radians>(course_change_deg) / 2.0);
+    Float64x4 time_to_turn_sec = simd_abs(turn_rate_dps) > min_turn_rate_threshold
+        ? course_change_deg / turn_rate_dps : simd_splat(infinite_time);
+
+    // Wings-level lanes get the infinite-radius values
+    Int64x4 wings_level = simd_abs(tan_phi) < min_tan_threshold;
+    Float64x4 zero = simd_splat(zero_turn_rate);
+    simd_store_partial(out.radius_nm + row, wings_level ? simd_splat(infinite_radius_nm) : convert<Meters, NauticalMiles>(radius_m), lanes);
+    simd_store_partial(out.radius_ft + row, wings_level ? simd_splat(infinite_radius_ft) : convert<Meters, Feet>(radius_m), lanes);
+    simd_store_partial(out.turn_rate_dps + row, wings_level ? zero : turn_rate_dps, lanes);
+    simd_store_partial(out.lead_distance_nm + row, wings_level ? zero : convert<Meters, NauticalMiles>(lead_m), lanes);
+    simd_store_partial(out.lead_distance_ft + row, wings_level ? zero : convert<Meters, Feet>(lead_m), lanes);
+    simd_store_partial(out.time_to_turn_sec + row, wings_level ? simd_splat(infinite_time) : time_to_turn_sec, lanes);
+    simd_store_partial(out.load_factor + row, load_factor, lanes);
+
+    Float64x4 std_bank_rad = simd_atan((standard_rate_rad_s * v_ms) / gravity);
+    simd_store_partial(out.standard_rate_bank + row, convert<Radians, Degrees>(std_bank_rad), lanes);
+}
+
+} // namespace
+
+SIMD_DISPATCH
+void calculate_turn_performance_simd(const TurnBatchInputs& in, const TurnBatchOutputs& out, Int32 count) {
+    Int32 row = 0;
+    for (; row + simd_lanes <= count; row += simd_lanes) {
+        turn_performance_lanes(in, out, row, simd_lanes);
+    }
+    if (row < count) {
+        turn_performance_lanes(in, out, row, count - row);
+    }
+}
+
+// Output results as JSON
+void print_json(std::ostream& out, const TurnData& turn, bool single_line) {
+    const char* nl = single_line ? "" : "\n";
+    const char* in1 = single_line ? "" : "  ";
+    
+    TextWriter text(out);
+    text.put('{');
+    text.put(nl);
+    put_json_member(text, in1, "radius_nm", turn.radius_nm, false, nl);
+    put_json_member(text, in1, "radius_ft", turn.radius_ft, false, nl);
+    put_json_member(text, in1, "turn_rate_dps", turn.turn_rate_dps, false, nl);
+    put_json_member(text, in1, "lead_distance_nm", turn.lead_distance_nm, false, nl);
+    put_json_member(text, in1, "lead_distance_ft", turn.lead_distance_ft, false, nl);
+    put_json_member(text, in1, "time_to_turn_sec", turn.time_to_turn_sec, false, nl);
+    put_json_member(text, in1, "load_factor", turn.load_factor, false, nl);
+    put_json_member(text, in1, "standard_rate_bank", turn.standard_rate_bank, true, nl);
+    text.put('}');
+}
+
+void print_binary(std::ostream& out, const TurnData& turn) {
+    WireRecord record(wire_record_turn);
+    record.put_float64(turn.radius_nm);
+    record.put_float64(turn.radius_ft);
+    record.put_float64(turn.turn_rate_dps);
+    record.put_float64(turn.lead_distance_nm);
+    record.put_float64(turn.lead_distance_ft);
+    record.put_float64(turn.time_to_turn_sec);
+    record.put_float64(turn.load_factor);
+    record.put_float64(turn.standard_rate_bank);
+    record.write_to(out);
+}
+
+} // namespace xplane_mfd::calc
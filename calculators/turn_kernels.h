@@ -0,0 +1,74 @@
+// Turn Performance Kernels for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Result type and kernel shared by turn_calculator and mfd_calcd.
+//
+// AV Rule 126: C++ style comments only (//)
+
+#ifndef TURN_KERNELS_H
+#define TURN_KERNELS_H
+
+#include <ostream>
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+struct TurnData {
+    Float64 radius_nm;           // Turn radius in nautical miles
+    Float64 radius_ft;           // Turn radius in feet
+    Float64 turn_rate_dps;       // Turn rate in degrees per second
+    Float64 lead_distance_nm;    // Lead distance to roll out
+    Float64 lead_distance_ft;    // Lead distance in feet
+    Float64 time_to_turn_sec;    // Time to complete the turn
+    Float64 load_factor;         // G-loading in the turn
+    Float64 standard_rate_bank;  // Bank angle for standard rate turn
+};
+
+// True if the inputs are inside the range turn_calculator accepts
+// (positive TAS, bank between 0 and 90 degrees)
+bool turn_inputs_valid(Float64 tas_kts, Float64 bank_deg);
+
+// True if calculate_turn_performance takes its wings-level branch (infinite
+// radius, no turn rate) for this bank
+bool turn_wings_level(Float64 bank_deg);
+
+// Calculate comprehensive turn performance
+TurnData calculate_turn_performance(Float64 tas_kts, Float64 bank_deg, Float64 course_change_deg);
+
+// Structure-of-arrays batch evaluation: row i of the inputs gives row i of
+// the outputs (same results as the scalar kernel). Columns must not overlap.
+// Inputs are not validated; callers check turn_inputs_valid per row.
+struct TurnBatchInputs {
+    const Float64* tas_kts;
+    const Float64* bank_deg;
+    const Float64* course_change_deg;
+};
+
+struct TurnBatchOutputs {
+    Float64* radius_nm;
+    Float64* radius_ft;
+    Float64* turn_rate_dps;
+    Float64* lead_distance_nm;
+    Float64* lead_distance_ft;
+    Float64* time_to_turn_sec;
+    Float64* load_factor;
+    Float64* standard_rate_bank;
+};
+
+void calculate_turn_performance_batch(const TurnBatchInputs& in, const TurnBatchOutputs& out, Int32 count);
+
+// Same as calculate_turn_performance_batch, four rows per step with the
+// simd_math.h approximations (AVX2 / SSE2 / NEON, chosen at load time).
+// Outputs match the scalar kernel to within a few ulp (simd_math.h bounds).
+void calculate_turn_performance_simd(const TurnBatchInputs& in, const TurnBatchOutputs& out, Int32 count);
+
+// Write the JSON object (no trailing newline); single_line drops the
+// newlines and indentation for one-line replies
+void print_json(std::ostream& out, const TurnData& turn, bool single_line);
+
+// Write a wire_record_turn record (wire_format.h)
+void print_binary(std::ostream& out, const TurnData& turn);
+
+} // namespace xplane_mfd::calc
+
+#endif // TURN_KERNELS_H
@@ -0,0 +1,210 @@
+// Units of Measure for X-Plane MFD Calculators
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Compile-time unit conversions shared by every kernel. Each unit is a tag
+// type with a UnitTraits specialization giving its dimension and its size
+// in the SI unit of that dimension, from the exact definitions (1 ft =
+// 0.3048 m, 1 NM = 1852 m, 1 kt = 1 NM/h). A conversion between two units
+// is one constant, From::si_scale / To::si_scale, folded by the compiler,
+// so knots to ft/s costs one multiply however it is spelled. Converting
+// between units of different dimensions does not compile.
+//
+//   convert<Knots, MetersPerSecond>(tas_kts)     raw Float64 or Float64x4
+//   unit_cast<Feet>(Quantity<Meters>(radius))    strongly typed value
+//
+// Temperatures carry an offset as well (si_offset), applied with one add.
+//
+// AV Rule 126: C++ style comments only (//)
+
+#ifndef UNITS_H
+#define UNITS_H
+
+#include <numbers>
+#include <type_traits>
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+// Dimensions
+struct Length {};
+struct Speed {};
+struct Acceleration {};
+struct Angle {};
+struct AngularRate {};
+struct Temperature {};
+
+// Units (AV Rule 50: type names start with an uppercase letter)
+struct Meters {};
+struct Feet {};
+struct NauticalMiles {};
+struct MetersPerSecond {};
+struct FeetPerSecond {};
+struct FeetPerMinute {};
+struct Knots {};
+struct MetersPerSecondSquared {};
+struct FeetPerSecondSquared {};
+struct Radians {};
+struct Degrees {};
+struct RadiansPerSecond {};
+struct DegreesPerSecond {};
+struct Kelvin {};
+struct Celsius {};
+
+// Size of one Unit in the SI unit of its dimension; specialized below
+template <typename Unit>
+struct UnitTraits;
+
+constexpr Float64 meters_per_foot = 0.3048;
+constexpr Float64 meters_per_nautical_mile = 1852.0;
+constexpr Float64 seconds_per_minute = 60.0;
+constexpr Float64 seconds_per_hour = 3600.0;
+constexpr Float64 radians_per_degree = std::numbers::pi / 180.0;
+
+template <> struct UnitTraits<Meters> {
+    typedef Length dimension;
+    static constexpr Float64 si_scale = 1.0;
+    static constexpr Float64 si_offset = 0.0;
+};
+
+template <> struct UnitTraits<Feet> {
+    typedef Length dimension;
+    static constexpr Float64 si_scale = meters_per_foot;
+    static constexpr Float64 si_offset = 0.0;
+};
+
+template <> struct UnitTraits<NauticalMiles> {
+    typedef Length dimension;
+    static constexpr Float64 si_scale = meters_per_nautical_mile;
+    static constexpr Float64 si_offset = 0.0;
+};
+
+template <> struct UnitTraits<MetersPerSecond> {
+    typedef Speed dimension;
+    static constexpr Float64 si_scale = 1.0;
+    static constexpr Float64 si_offset = 0.0;
+};
+
+template <> struct UnitTraits<FeetPerSecond> {
+    typedef Speed dimension;
+    static constexpr Float64 si_scale = meters_per_foot;
+    static constexpr Float64 si_offset = 0.0;
+};
+
+template <> struct UnitTraits<FeetPerMinute> {
+    typedef Speed dimension;
+    static constexpr Float64 si_scale = meters_per_foot / seconds_per_minute;
+    static constexpr Float64 si_offset = 0.0;
+};
+
+template <> struct UnitTraits<Knots> {
+    typedef Speed dimension;
+    static constexpr Float64 si_scale = meters_per_nautical_mile / seconds_per_hour;
+    static constexpr Float64 si_offset = 0.0;
+};
+
+template <> struct UnitTraits<MetersPerSecondSquared> {
+    typedef Acceleration dimension;
+    static constexpr Float64 si_scale = 1.0;
+    static constexpr Float64 si_offset = 0.0;
+};
+
+template <> struct UnitTraits<FeetPerSecondSquared> {
+    typedef Acceleration dimension;
+    static constexpr Float64 si_scale = meters_per_foot;
+    static constexpr Float64 si_offset = 0.0;
+};
+
+template <> struct UnitTraits<Radians> {
+    typedef Angle dimension;
+    static constexpr Float64 si_scale = 1.0;
+    static constexpr Float64 si_offset = 0.0;
+};
+
+template <> struct UnitTraits<Degrees> {
+    typedef Angle dimension;
+    static constexpr Float64 si_scale = radians_per_degree;
+    static constexpr Float64 si_offset = 0.0;
+};
+
+template <> struct UnitTraits<RadiansPerSecond> {
+    typedef AngularRate dimension;
+    static constexpr Float64 si_scale = 1.0;
+    static constexpr Float64 si_offset = 0.0;
+};
+
+template <> struct UnitTraits<DegreesPerSecond> {
+    typedef AngularRate dimension;
+    static constexpr Float64 si_scale = radians_per_degree;
+    static constexpr Float64 si_offset = 0.0;
+};
+
+template <> struct UnitTraits<Kelvin> {
+    typedef Temperature dimension;
+    static constexpr Float64 si_scale = 1.0;
+    static constexpr Float64 si_offset = 0.0;
+};
+
+template <> struct UnitTraits<Celsius> {
+    typedef Temperature dimension;
+    static constexpr Float64 si_scale = 1.0;
+    static constexpr Float64 si_offset = 273.15;
+};
+
+// to = from * factor + offset
+template <typename From, typename To>
+struct UnitConversion {
+    static_assert(std::is_same_v<typename UnitTraits<From>::dimension, typename UnitTraits<To>::dimension>,
+                  "unit conversion between different dimensions");
+    static constexpr Float64 factor = UnitTraits<From>::si_scale / UnitTraits<To>::si_scale;
+    static constexpr Float64 offset =
+        (UnitTraits<From>::si_offset - UnitTraits<To>::si_offset) / UnitTraits<To>::si_scale;
+};
+
+// Convert a raw value (Float64 or a SIMD vector); one multiply, plus one
+// add for units with an offset. Vector instantiations inline into their
+// caller's ISA clone (simd_math.h), so the vector-return ABI warning for
+// non-AVX clones does not apply.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+template <typename From, typename To, typename Value>
+constexpr Value convert(const Value& value) {
+    Value result = value * UnitConversion<From, To>::factor;
+    if constexpr (UnitConversion<From, To>::offset != 0.0) {
+        result = result + UnitConversion<From, To>::offset;
+    }
+    return result;
+}
+#pragma GCC diagnostic pop
+
+// A Float64 tagged with its unit. Adding, subtracting or comparing two
+// quantities needs the same unit; anything else goes through unit_cast.
+template <typename Unit>
+class Quantity {
+public:
+    constexpr explicit Quantity(Float64 value) : value_(value) {}
+
+    constexpr Float64 value() const { return value_; }
+
+    constexpr Quantity operator+(Quantity other) const { return Quantity(value_ + other.value_); }
+    constexpr Quantity operator-(Quantity other) const { return Quantity(value_ - other.value_); }
+    constexpr Quantity operator-() const { return Quantity(-value_); }
+    constexpr Quantity operator*(Float64 scale) const { return Quantity(value_ * scale); }
+    constexpr Quantity operator/(Float64 scale) const { return Quantity(value_ / scale); }
+    constexpr bool operator<(Quantity other) const { return value_ < other.value_; }
+    constexpr bool operator>(Quantity other) const { return value_ > other.value_; }
+
+private:
+    Float64 value_;
+};
+
+template <typename To, typename From>
+constexpr Quantity<To> unit_cast(Quantity<From> quantity) {
+    return Quantity<To>(convert<From, To>(quantity.value()));
+}
+
+// Physical constants
+constexpr Quantity<MetersPerSecondSquared> standard_gravity(9.80665);
+
+} // namespace xplane_mfd::calc
+
+#endif // UNITS_H
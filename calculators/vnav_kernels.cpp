@@ -0,0 +1,221 @@
+// VNAV Kernels for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Implementation of the kernels declared in vnav_kernels.h.
+//
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try)
+// - AV Rule 209: Fixed-width types (Int32, Float64)
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#include <cmath>
+#include "vnav_kernels.h"
+#include "units.h"
+#include "wire_format.h"
+#include "calc_io.h"
+#include "simd_math.h"
+
+namespace xplane_mfd::calc {
+
+// Mathematical constants (AV Rule 52: lowercase); conversions are in units.h
+const Float64 three_deg_rad = convert<Degrees, Radians>(3.0);
+
+// Calculation constants (AV Rule 151: no magic numbers)
+const Float64 min_distance_nm = 0.01;
+const Float64 min_groundspeed_kts = 1.0;
+const Float64 min_vs_for_time_calc = 1.0;
+const Float64 infinite_time = 999.9;
+const Float64 zero_distance = 0.0;
+const Float64 thousand_feet = 1000.0;
+
+bool vnav_distance_floored(Float64 distance_nm) {
+    return distance_nm < min_distance_nm;
+}
+
+bool vnav_groundspeed_floored(Float64 groundspeed_kts) {
+    return groundspeed_kts < min_groundspeed_kts;
+}
+
+// Calculate VNAV parameters
+VNAVData calculate_vnav(Float64 current_alt_ft, Float64 target_alt_ft, 
+                        Float64 distance_nm, Float64 groundspeed_kts, Float64 current_vs_fpm) {
+    VNAVData result;
+    
+    // Calculate altitude change (positive = climb, negative = descend)
+    Float64 altitude_change_ft = target_alt_ft - current_alt_ft;
+    result.altitude_to_lose_ft = -altitude_change_ft;  // Legacy field name
+    result.is_descent = altitude_change_ft < zero_distance;
+    
+    // Avoid division by zero
+    if (vnav_distance_floored(distance_nm)) distance_nm = min_distance_nm;
+    if (vnav_groundspeed_floored(groundspeed_kts)) groundspeed_kts = min_groundspeed_kts;
+    
+    // Calculate flight path angle (positive = climb, negative = descent)
+    Float64 distance_ft = convert<NauticalMiles, Feet>(distance_nm);
+    Float64 gamma_rad = atan(altitude_change_ft / distance_ft);
+    result.flight_path_angle_deg = convert<Radians, Degrees>(gamma_rad);
+    
+    // Required vertical speed to meet constraint
+    // VS = GS * tan(γ), GS in fpm by convert<Knots, FeetPerMinute>
+    Float64 groundspeed_fpm = convert<Knots, FeetPerMinute>(groundspeed_kts);
+    result.required_vs_fpm = groundspeed_fpm * tan(gamma_rad);
+    
+    // Calculate TOD for standard 3° descent path
+    // D = h / tan(3°), h in NM by convert<Feet, NauticalMiles>
+    Float64 abs_alt_change = fabs(altitude_change_ft);
+    result.tod_distance_nm = convert<Feet, NauticalMiles>(abs_alt_change) / tan(three_deg_rad);
+    
+    // Vertical speed for 3° descent: VS ≈ 5 * GS (rule of thumb)
+    // More precisely: VS = GS in fpm * tan(3°)
+    result.vs_for_3deg = groundspeed_fpm * tan(three_deg_rad);
+    if (!result.is_descent) {
+        result.vs_for_3deg = -result.vs_for_3deg;  // Make positive for climb
+    }
+    
+    // Time to reach constraint at current vertical speed
+    if (fabs(current_vs_fpm) > min_vs_for_time_calc) {
+        result.time_to_constraint_min = altitude_change_ft / current_vs_fpm;
+    } else {
+        result.time_to_constraint_min = infinite_time;
+    }
+    
+    // Distance per 1000 ft of altitude change
+    if (abs_alt_change > min_vs_for_time_calc) {
+        result.distance_per_1000ft = (distance_nm * thousand_feet) / abs_alt_change;
+    } else {
+        result.distance_per_1000ft = zero_distance;
+    }
+    
+    return result;
+}
+
+// Structure-of-arrays batch kernel: row i of out is the result of
+// calculate_vnav for row i of in, with is_descent stored as 1.0 / 0.0. The
+// loop is in this translation unit so the scalar kernel inlines into it;
+// ivdep passes on the no-overlap contract (no run-time alias checks).
+void calculate_vnav_batch(const VNAVBatchInputs& in, const VNAVBatchOutputs& out, Int32 count) {
+    const Float64* current_alt_ft = in.current_alt_ft;
+    const Float64* target_alt_ft = in.target_alt_ft;
+    const Float64* distance_nm = in.distance_nm;
+    const Float64* groundspeed_kts = in.groundspeed_kts;
+    const Float64* current_vs_fpm = in.current_vs_fpm;
+    Float64* altitude_to_lose_ft = out.altitude_to_lose_ft;
+    Float64* flight_path_angle_deg = out.flight_path_angle_deg;
+    Float64* required_vs_fpm = out.required_vs_fpm;
+    Float64* tod_distance_nm = out.tod_distance_nm;
+    Float64* time_to_constraint_min = out.time_to_constraint_min;
+    Float64* distance_per_1000ft = out.distance_per_1000ft;
+    Float64* vs_for_3deg = out.vs_for_3deg;
+    Float64* is_descent = out.is_descent;
+
+    #pragma GCC ivdep
+    for (Int32 i = 0; i < count; ++i) {
+        VNAVData result = calculate_vnav(current_alt_ft[i], target_alt_ft[i], distance_nm[i],
+                                         groundspeed_kts[i], current_vs_fpm[i]);
+        altitude_to_lose_ft[i] = result.altitude_to_lose_ft;
+        flight_path_angle_deg[i] = result.flight_path_angle_deg;
+        required_vs_fpm[i] = result.required_vs_fpm;
+        tod_distance_nm[i] = result.tod_distance_nm;
+        time_to_constraint_min[i] = result.time_to_constraint_min;
+        distance_per_1000ft[i] = result.distance_per_1000ft;
+        vs_for_3deg[i] = result.vs_for_3deg;
+        is_descent[i] = result.is_descent ? 1.0 : 0.0;
+    }
+}
+
+namespace {
+
+// calculate_vnav for up to simd_lanes rows starting at row; both sides of
+// each branch are computed and selected per lane
+SIMD_INLINE void vnav_lanes(const VNAVBatchInputs& in, const VNAVBatchOutputs& out,
+                            Float64 tan_three_deg, Int32 row, Int32 lanes) {
+    Float64x4 current_alt_ft = simd_load_partial(in.current_alt_ft + row, lanes);
+    Float64x4 target_alt_ft = simd_load_partial(in.target_alt_ft + row, lanes);
+    Float64x4 distance_nm = simd_load_partial(in.distance_nm + row, lanes);
+    Float64x4 groundspeed_kts = simd_load_partial(in.groundspeed_kts + row, lanes);
+    Float64x4 current_vs_fpm = simd_load_partial(in.current_vs_fpm + row, lanes);
+
+    Float64x4 altitude_change_ft = target_alt_ft - current_alt_ft;
+    Int64x4 is_descent = altitude_change_ft < zero_distance;
+    simd_store_partial(out.altitude_to_lose_ft + row, -altitude_change_ft, lanes);
+    simd_store_partial(out.is_descent + row, is_descent ? simd_splat(1.0) : simd_splat(0.0), lanes);
+
+    // Avoid division by zero
+    distance_nm = distance_nm < min_distance_nm ? simd_splat(min_distance_nm) : distance_nm;
+    groundspeed_kts = groundspeed_kts < min_groundspeed_kts ? simd_splat(min_groundspeed_kts) : groundspeed_kts;
+
+    Float64x4 gamma_rad = simd_atan(altitude_change_ft / convert<NauticalMiles, Feet>(distance_nm));
+    Float64x4 groundspeed_fpm = convert<Knots, FeetPerMinute>(groundspeed_kts);
+    simd_store_partial(out.flight_path_angle_deg + row, convert<Radians, Degrees>(gamma_rad), lanes);
+    simd_store_partial(out.required_vs_fpm + row, groundspeed_fpm * simd_tan(gamma_rad), lanes);
+
+    Float64x4 abs_alt_change = simd_abs(altitude_change_ft);
+    simd_store_partial(out.tod_distance_nm + row, convert<Feet, NauticalMiles>(abs_alt_change) / tan_three_deg, lanes);
+
+    Float64x4 vs_for_3deg = groundspeed_fpm * tan_three_deg;
+    simd_store_partial(out.vs_for_3deg + row, is_descent ? vs_for_3deg : -vs_for_3deg, lanes);
+
+    Float64x4 time_to_constraint_min = simd_abs(current_vs_fpm) > min_vs_for_time_calc
+        ? altitude_change_ft / current_vs_fpm : simd_splat(infinite_time);
+    simd_store_partial(out.time_to_constraint_min + row, time_to_constraint_min, lanes);
+
+    Float64x4 distance_per_1000ft = abs_alt_change > min_vs_for_time_calc
+        ? (distance_nm * thousand_feet) / abs_alt_change : simd_splat(zero_distance);
+    simd_store_partial(out.distance_per_1000ft + row, distance_per_1000ft, lanes);
+}
+
+} // namespace
+
+SIMD_DISPATCH
+void calculate_vnav_simd(const VNAVBatchInputs& in, const VNAVBatchOutputs& out, Int32 count) {
+    // Same libm value the scalar kernel uses for the 3° path
+    const Float64 tan_three_deg = tan(three_deg_rad);
+
+    Int32 row = 0;
+    for (; row + simd_lanes <= count; row += simd_lanes) {
+        vnav_lanes(in, out, tan_three_deg, row, simd_lanes);
+    }
+    if (row < count) {
+        vnav_lanes(in, out, tan_three_deg, row, count - row);
+    }
+}
+
+// Output results as JSON
+void print_json(std::ostream& out, const VNAVData& vnav, bool single_line) {
+    const char* nl = single_line ? "" : "\n";
+    const char* in1 = single_line ? "" : "  ";
+    
+    TextWriter text(out);
+    text.put('{');
+    text.put(nl);
+    put_json_member(text, in1, "altitude_to_lose_ft", vnav.altitude_to_lose_ft, false, nl);
+    put_json_member(text, in1, "flight_path_angle_deg", vnav.flight_path_angle_deg, false, nl);
+    put_json_member(text, in1, "required_vs_fpm", vnav.required_vs_fpm, false, nl);
+    put_json_member(text, in1, "tod_distance_nm", vnav.tod_distance_nm, false, nl);
+    put_json_member(text, in1, "time_to_constraint_min", vnav.time_to_constraint_min, false, nl);
+    put_json_member(text, in1, "distance_per_1000ft", vnav.distance_per_1000ft, false, nl);
+    put_json_member(text, in1, "vs_for_3deg", vnav.vs_for_3deg, false, nl);
+    text.put(in1);
+    text.put("\"is_descent\": ");
+    text.put(vnav.is_descent ? "true" : "false");
+    text.put(nl);
+    text.put('}');
+}
+
+void print_binary(std::ostream& out, const VNAVData& vnav) {
+    WireRecord record(wire_record_vnav);
+    record.put_float64(vnav.altitude_to_lose_ft);
+    record.put_float64(vnav.flight_path_angle_deg);
+    record.put_float64(vnav.required_vs_fpm);
+    record.put_float64(vnav.tod_distance_nm);
+    record.put_float64(vnav.time_to_constraint_min);
+    record.put_float64(vnav.distance_per_1000ft);
+    record.put_float64(vnav.vs_for_3deg);
+    record.put_bool(vnav.is_descent);
+    record.write_to(out);
+}
+
+} // namespace xplane_mfd::calc
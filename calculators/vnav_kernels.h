@@ -0,0 +1,74 @@
+// VNAV Kernels for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Result type and kernel shared by vnav_calculator and mfd_calcd.
+//
+// AV Rule 126: C++ style comments only (//)
+
+#ifndef VNAV_KERNELS_H
+#define VNAV_KERNELS_H
+
+#include <ostream>
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+struct VNAVData {
+    Float64 altitude_to_lose_ft;      // Altitude change required
+    Float64 flight_path_angle_deg;    // Flight path angle (negative = descent)
+    Float64 required_vs_fpm;          // Required vertical speed
+    Float64 tod_distance_nm;          // Top of descent distance (for 3° path)
+    Float64 time_to_constraint_min;   // Time to reach altitude at current VS
+    Float64 distance_per_1000ft;      // Distance traveled per 1000 ft altitude change
+    Float64 vs_for_3deg;              // Vertical speed required for 3° path
+    bool is_descent;                  // True if descending, false if climbing
+};
+
+// True if calculate_vnav raises this distance (groundspeed) to its floor
+// to avoid dividing by zero
+bool vnav_distance_floored(Float64 distance_nm);
+bool vnav_groundspeed_floored(Float64 groundspeed_kts);
+
+// Calculate VNAV parameters
+VNAVData calculate_vnav(Float64 current_alt_ft, Float64 target_alt_ft, 
+                        Float64 distance_nm, Float64 groundspeed_kts, Float64 current_vs_fpm);
+
+// Structure-of-arrays batch evaluation: row i of the inputs gives row i of
+// the outputs (same results as the scalar kernel). Columns must not overlap.
+// is_descent is stored as 1.0 / 0.0 so every column has the same type.
+struct VNAVBatchInputs {
+    const Float64* current_alt_ft;
+    const Float64* target_alt_ft;
+    const Float64* distance_nm;
+    const Float64* groundspeed_kts;
+    const Float64* current_vs_fpm;
+};
+
+struct VNAVBatchOutputs {
+    Float64* altitude_to_lose_ft;
+    Float64* flight_path_angle_deg;
+    Float64* required_vs_fpm;
+    Float64* tod_distance_nm;
+    Float64* time_to_constraint_min;
+    Float64* distance_per_1000ft;
+    Float64* vs_for_3deg;
+    Float64* is_descent;
+};
+
+void calculate_vnav_batch(const VNAVBatchInputs& in, const VNAVBatchOutputs& out, Int32 count);
+
+// Same as calculate_vnav_batch, four rows per step with the simd_math.h
+// approximations (AVX2 / SSE2 / NEON, chosen at load time). Outputs match
+// the scalar kernel to within a few ulp (simd_math.h bounds).
+void calculate_vnav_simd(const VNAVBatchInputs& in, const VNAVBatchOutputs& out, Int32 count);
+
+// Write the JSON object (no trailing newline); single_line drops the
+// newlines and indentation for one-line replies
+void print_json(std::ostream& out, const VNAVData& vnav, bool single_line);
+
+// Write a wire_record_vnav record (wire_format.h)
+void print_binary(std::ostream& out, const VNAVData& vnav);
+
+} // namespace xplane_mfd::calc
+
+#endif // VNAV_KERNELS_H
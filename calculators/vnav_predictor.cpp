@@ -0,0 +1,387 @@
+// VNAV Trajectory Predictor for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Implementation of the predictor declared in vnav_predictor.h.
+//
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - setters return false
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (fixed step arena)
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#include <cmath>
+#include "vnav_predictor.h"
+#include "wind_estimator.h"
+#include "density_altitude_kernels.h"
+#include "units.h"
+
+namespace xplane_mfd::calc {
+
+namespace {
+
+// Calculation constants (AV Rule 151: no magic numbers)
+const Float64 min_profile_groundspeed_kts = 30.0;
+const Float64 max_final_approach_fpa_deg = 10.0;
+const Float64 constraint_tolerance_ft = 1.0;
+const Float64 feet_per_nm = convert<NauticalMiles, Feet>(1.0);
+const Float64 sea_level_speed_of_sound_kts = 661.4786;
+const Float64 sea_level_temp_k = convert<Celsius, Kelvin>(15.0);
+
+// First of steps [0, count) whose field is at least value, or count. The
+// profile's distance, altitude and time never decrease, so this is a
+// binary search.
+Int32 first_step_reaching(const std::array<VnavProfileStep, vnav_max_steps>& steps, Int32 count,
+                          Float64 VnavProfileStep::* field, Float64 value) {
+    Int32 lo = 0;
+    Int32 hi = count;
+    while (lo < hi) {
+        Int32 mid = lo + (hi - lo) / 2;
+        if (steps[mid].*field < value) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+bool settings_valid(const VnavDescentSettings& s) {
+    bool speeds_ok = s.descent_mach > 0.0 && s.descent_ias_kts > 0.0 && s.speed_limit_ias_kts > 0.0 && s.descent_vs_fpm > 0.0;
+    bool path_ok = s.final_approach_fpa_deg > 0.0 && s.final_approach_fpa_deg <= max_final_approach_fpa_deg
+                && s.final_approach_fix_nm >= 0.0 && std::isfinite(s.speed_limit_alt_ft);
+    bool altitudes_ok = s.cruise_alt_ft > s.runway_elevation_ft
+        && density_altitude_inputs_valid(s.runway_elevation_ft,
+                                         isa_temperature_c(s.runway_elevation_ft) + s.isa_deviation_c)
+        && density_altitude_inputs_valid(s.cruise_alt_ft,
+                                         isa_temperature_c(s.cruise_alt_ft) + s.isa_deviation_c);
+    return speeds_ok && path_ok && altitudes_ok;
+}
+
+// Everything but the cruise altitude is the same
+bool same_below_cruise(const VnavDescentSettings& a, const VnavDescentSettings& b) {
+    return a.runway_elevation_ft == b.runway_elevation_ft
+        && a.descent_mach == b.descent_mach
+        && a.descent_ias_kts == b.descent_ias_kts
+        && a.speed_limit_ias_kts == b.speed_limit_ias_kts
+        && a.speed_limit_alt_ft == b.speed_limit_alt_ft
+        && a.descent_vs_fpm == b.descent_vs_fpm
+        && a.final_approach_fpa_deg == b.final_approach_fpa_deg
+        && a.final_approach_fix_nm == b.final_approach_fix_nm
+        && a.isa_deviation_c == b.isa_deviation_c;
+}
+
+} // namespace
+
+VnavPredictor::VnavPredictor()
+    : settings_(), constraints_(), winds_(), steps_(),
+      constraint_count_(0), wind_count_(0), valid_steps_(0),
+      configured_(false), complete_(false), truncated_(false) {
+}
+
+bool VnavPredictor::set_settings(const VnavDescentSettings& settings) {
+    bool accepted = settings_valid(settings);
+    if (accepted) {
+        if (!configured_ || !same_below_cruise(settings_, settings)) {
+            invalidate_from(0);
+        } else if (settings.cruise_alt_ft != settings_.cruise_alt_ft) {
+            // The last step is the one capped at the old cruise altitude
+            invalidate_above(std::fmin(settings.cruise_alt_ft, settings_.cruise_alt_ft));
+        }
+        settings_ = settings;
+        configured_ = true;
+    }
+    return accepted;
+}
+
+bool VnavPredictor::set_constraints(const VnavConstraint* constraints, Int32 count) {
+    bool accepted = count >= 0 && count <= vnav_max_constraints && (count == 0 || constraints != nullptr);
+    for (Int32 i = 0; accepted && i < count; ++i) {
+        const VnavConstraint& c = constraints[i];
+        accepted = c.distance_nm > 0.0 && c.max_alt_ft >= c.min_alt_ft
+                && (i == 0 || c.distance_nm > constraints[i - 1].distance_nm);
+    }
+
+    if (accepted) {
+        // A constraint bounds the steps that reach its altitude and splits
+        // the step that crosses its distance; min_alt_ft is only checked
+        Float64 lowest_alt_ft = INFINITY;
+        Float64 nearest_nm = INFINITY;
+        Int32 span = count > constraint_count_ ? count : constraint_count_;
+        for (Int32 i = 0; i < span; ++i) {
+            bool in_old = i < constraint_count_;
+            bool in_new = i < count;
+            bool changed = !in_old || !in_new
+                || constraints_[i].distance_nm != constraints[i].distance_nm
+                || constraints_[i].max_alt_ft != constraints[i].max_alt_ft;
+            if (changed && in_old) {
+                lowest_alt_ft = std::fmin(lowest_alt_ft, constraints_[i].max_alt_ft);
+                nearest_nm = std::fmin(nearest_nm, constraints_[i].distance_nm);
+            }
+            if (changed && in_new) {
+                lowest_alt_ft = std::fmin(lowest_alt_ft, constraints[i].max_alt_ft);
+                nearest_nm = std::fmin(nearest_nm, constraints[i].distance_nm);
+            }
+        }
+        invalidate_above(lowest_alt_ft);
+        invalidate_beyond(nearest_nm);
+
+        for (Int32 i = 0; i < count; ++i) {
+            constraints_[i] = constraints[i];
+        }
+        constraint_count_ = count;
+    }
+    return accepted;
+}
+
+bool VnavPredictor::set_wind_layers(const VnavWindLayer* layers, Int32 count) {
+    bool accepted = count >= 0 && count <= vnav_max_wind_layers && (count == 0 || layers != nullptr);
+    for (Int32 i = 0; accepted && i < count; ++i) {
+        accepted = std::isfinite(layers[i].altitude_ft) && std::isfinite(layers[i].headwind_kts)
+                && (i == 0 || layers[i].altitude_ft > layers[i - 1].altitude_ft);
+    }
+
+    if (accepted) {
+        // Headwind at an altitude depends only on the layers around it, so
+        // nothing below the last unchanged layer moves
+        Int32 first_changed = 0;
+        while (first_changed < count && first_changed < wind_count_
+               && winds_[first_changed].altitude_ft == layers[first_changed].altitude_ft
+               && winds_[first_changed].headwind_kts == layers[first_changed].headwind_kts) {
+            ++first_changed;
+        }
+        if (first_changed == count && first_changed == wind_count_) {
+            // Unchanged, including still air set again
+        } else if (first_changed == 0) {
+            invalidate_from(0);
+        } else if (first_changed < count || first_changed < wind_count_) {
+            invalidate_above(winds_[first_changed - 1].altitude_ft);
+        }
+
+        for (Int32 i = 0; i < count; ++i) {
+            winds_[i] = layers[i];
+        }
+        wind_count_ = count;
+    }
+    return accepted;
+}
+
+bool VnavPredictor::set_wind_profile(const WindProfileStore& store, Float64 track_deg) {
+    std::array<VnavWindLayer, vnav_max_wind_layers> layers;
+    Int32 count = store.vnav_layers(track_deg, layers.data(), vnav_max_wind_layers);
+    return set_wind_layers(layers.data(), count);
+}
+
+Int32 VnavPredictor::advance(Int32 max_steps) {
+    Int32 done = 0;
+    if (configured_ && valid_steps_ == 0) {
+        steps_[0].distance_nm = 0.0;
+        steps_[0].altitude_ft = settings_.runway_elevation_ft;
+        steps_[0].time_s = 0.0;
+        steps_[0].gs_kts = groundspeed_at(settings_.runway_elevation_ft);
+        valid_steps_ = 1;
+    }
+    while (configured_ && !complete_ && done < max_steps) {
+        integrate_step(valid_steps_ - 1);
+        ++valid_steps_;
+        ++done;
+        if (steps_[valid_steps_ - 1].altitude_ft >= settings_.cruise_alt_ft) {
+            complete_ = true;
+        } else if (valid_steps_ == vnav_max_steps) {
+            complete_ = true;
+            truncated_ = true;
+        }
+    }
+    return done;
+}
+
+bool VnavPredictor::predict(Float64 distance_nm, Float64 altitude_ft, VnavPrediction& out) const {
+    bool covered = configured_ && valid_steps_ > 0;
+    Float64 distance = distance_nm > 0.0 ? distance_nm : 0.0;
+    const VnavProfileStep& last = steps_[valid_steps_ > 0 ? valid_steps_ - 1 : 0];
+    bool beyond_tod = covered && distance > last.distance_nm;
+    if (beyond_tod) {
+        covered = complete_ && !truncated_;
+    }
+
+    if (covered) {
+        VnavProfileStep here = point_at(distance);
+        out.path_altitude_ft = here.altitude_ft;
+        out.gs_kts = here.gs_kts;
+        out.time_to_runway_min = here.time_s / seconds_per_minute;
+        if (beyond_tod) {
+            out.required_vs_fpm = 0.0;
+            out.tod_distance_nm = distance - last.distance_nm;
+        } else {
+            Int32 upper = first_step_reaching(steps_, valid_steps_, &VnavProfileStep::distance_nm, distance);
+            Int32 lower = upper > 0 ? upper - 1 : 0;
+            Float64 step_time_s = steps_[upper].time_s - steps_[lower].time_s;
+            Float64 climb_ft = steps_[upper].altitude_ft - steps_[lower].altitude_ft;
+            out.required_vs_fpm = step_time_s > 0.0 ? 0.0 - climb_ft / step_time_s * seconds_per_minute : 0.0;
+            out.tod_distance_nm = last.distance_nm - distance;
+        }
+        out.vertical_deviation_ft = altitude_ft - out.path_altitude_ft;
+
+        // The next constraint is the farthest one not yet passed
+        out.next_constraint = -1;
+        out.next_constraint_alt_ft = 0.0;
+        out.time_to_next_constraint_min = 0.0;
+        out.next_constraint_met = true;
+        for (Int32 i = constraint_count_ - 1; out.next_constraint < 0 && i >= 0; --i) {
+            if (constraints_[i].distance_nm <= distance) {
+                const VnavConstraint& c = constraints_[i];
+                VnavProfileStep at = point_at(c.distance_nm);
+                out.next_constraint = i;
+                out.next_constraint_alt_ft = at.altitude_ft;
+                out.time_to_next_constraint_min = out.time_to_runway_min - at.time_s / seconds_per_minute;
+                out.next_constraint_met = at.altitude_ft <= c.max_alt_ft + constraint_tolerance_ft
+                                       && at.altitude_ft >= c.min_alt_ft - constraint_tolerance_ft;
+            }
+        }
+    }
+    return covered;
+}
+
+void VnavPredictor::invalidate_from(Int32 step) {
+    if (step < valid_steps_) {
+        valid_steps_ = step;
+        complete_ = false;
+        truncated_ = false;
+    }
+}
+
+// The first step at or above altitude_ft (or at or past distance_nm) was
+// integrated across it, and the midpoint estimate of the step before may
+// already have reached it: both are recomputed
+void VnavPredictor::invalidate_above(Float64 altitude_ft) {
+    Int32 reaching = first_step_reaching(steps_, valid_steps_, &VnavProfileStep::altitude_ft, altitude_ft);
+    invalidate_from(reaching > 0 ? reaching - 1 : 0);
+}
+
+void VnavPredictor::invalidate_beyond(Float64 distance_nm) {
+    Int32 reaching = first_step_reaching(steps_, valid_steps_, &VnavProfileStep::distance_nm, distance_nm);
+    invalidate_from(reaching > 0 ? reaching - 1 : 0);
+}
+
+// Midpoint integration: the groundspeed at the altitude halfway through a
+// first estimate of the step
+void VnavPredictor::integrate_step(Int32 index) {
+    const VnavProfileStep& from = steps_[index];
+    VnavProfileStep estimate = fly_step(from, groundspeed_at(from.altitude_ft));
+    Float64 midpoint_alt_ft = 0.5 * (from.altitude_ft + estimate.altitude_ft);
+    steps_[index + 1] = fly_step(from, groundspeed_at(midpoint_alt_ft));
+}
+
+// One vnav_step_seconds step away from the runway at gs_kts, shortened to
+// end on the next constraint or the FAF
+VnavProfileStep VnavPredictor::fly_step(const VnavProfileStep& from, Float64 gs_kts) const {
+    Float64 step_s = vnav_step_seconds;
+    Float64 distance_nm = from.distance_nm + gs_kts * step_s / seconds_per_hour;
+    Float64 boundary_nm = boundary_beyond(from.distance_nm);
+    if (distance_nm > boundary_nm) {
+        step_s *= (boundary_nm - from.distance_nm) / (distance_nm - from.distance_nm);
+        distance_nm = boundary_nm;
+    }
+
+    Float64 climb_ft = 0.0;
+    if (from.distance_nm < settings_.final_approach_fix_nm) {
+        Float64 gradient = std::tan(convert<Degrees, Radians>(settings_.final_approach_fpa_deg));
+        climb_ft = gradient * (distance_nm - from.distance_nm) * feet_per_nm;
+    } else {
+        climb_ft = settings_.descent_vs_fpm * step_s / seconds_per_minute;
+    }
+    Float64 altitude_ft = std::fmin(from.altitude_ft + climb_ft, ceiling_beyond(from.distance_nm));
+    altitude_ft = std::fmax(altitude_ft, from.altitude_ft);
+
+    VnavProfileStep to;
+    to.distance_nm = distance_nm;
+    to.altitude_ft = altitude_ft;
+    to.time_s = from.time_s + step_s;
+    to.gs_kts = gs_kts;
+    return to;
+}
+
+// Linear between layers, held at the nearest layer outside them
+Float64 VnavPredictor::headwind_at(Float64 altitude_ft) const {
+    Float64 headwind = 0.0;
+    if (wind_count_ > 0) {
+        Int32 upper = 0;
+        while (upper < wind_count_ && winds_[upper].altitude_ft < altitude_ft) {
+            ++upper;
+        }
+        if (upper == 0) {
+            headwind = winds_[0].headwind_kts;
+        } else if (upper == wind_count_) {
+            headwind = winds_[wind_count_ - 1].headwind_kts;
+        } else {
+            const VnavWindLayer& lo = winds_[upper - 1];
+            const VnavWindLayer& hi = winds_[upper];
+            Float64 t = (altitude_ft - lo.altitude_ft) / (hi.altitude_ft - lo.altitude_ft);
+            headwind = lo.headwind_kts + t * (hi.headwind_kts - lo.headwind_kts);
+        }
+    }
+    return headwind;
+}
+
+// TAS from the IAS schedule (IAS taken as EAS) and sigma at ISA plus the
+// deviation, held to the descent Mach above the crossover, less the headwind
+Float64 VnavPredictor::groundspeed_at(Float64 altitude_ft) const {
+    Float64 ias_kts = settings_.descent_ias_kts;
+    if (altitude_ft < settings_.speed_limit_alt_ft) {
+        ias_kts = std::fmin(ias_kts, settings_.speed_limit_ias_kts);
+    }
+    Float64 oat_celsius = isa_temperature_c(altitude_ft) + settings_.isa_deviation_c;
+    Float64 tas_kts = calculate_tas_from_eas(ias_kts, calculate_density_ratio(altitude_ft, oat_celsius));
+    Float64 speed_of_sound_kts = sea_level_speed_of_sound_kts
+                               * std::sqrt(convert<Celsius, Kelvin>(oat_celsius) / sea_level_temp_k);
+    tas_kts = std::fmin(tas_kts, settings_.descent_mach * speed_of_sound_kts);
+    return std::fmax(tas_kts - headwind_at(altitude_ft), min_profile_groundspeed_kts);
+}
+
+// Lowest "at or below" altitude of the constraints still to come, or cruise
+Float64 VnavPredictor::ceiling_beyond(Float64 distance_nm) const {
+    Float64 ceiling_ft = settings_.cruise_alt_ft;
+    for (Int32 i = 0; i < constraint_count_; ++i) {
+        if (constraints_[i].distance_nm > distance_nm) {
+            ceiling_ft = std::fmin(ceiling_ft, constraints_[i].max_alt_ft);
+        }
+    }
+    return ceiling_ft;
+}
+
+// Nearest constraint or FAF past distance_nm
+Float64 VnavPredictor::boundary_beyond(Float64 distance_nm) const {
+    Float64 boundary_nm = INFINITY;
+    if (settings_.final_approach_fix_nm > distance_nm) {
+        boundary_nm = settings_.final_approach_fix_nm;
+    }
+    for (Int32 i = 0; i < constraint_count_; ++i) {
+        if (constraints_[i].distance_nm > distance_nm) {
+            boundary_nm = std::fmin(boundary_nm, constraints_[i].distance_nm);
+        }
+    }
+    return boundary_nm;
+}
+
+// The profile interpolated at distance_nm: inside the up-to-date steps, or
+// level at cruise past the top of descent of a complete profile
+VnavProfileStep VnavPredictor::point_at(Float64 distance_nm) const {
+    Int32 upper = first_step_reaching(steps_, valid_steps_, &VnavProfileStep::distance_nm, distance_nm);
+    VnavProfileStep point = steps_[upper < valid_steps_ ? upper : valid_steps_ - 1];
+    if (upper == valid_steps_) {
+        point.gs_kts = groundspeed_at(point.altitude_ft);
+        point.time_s += (distance_nm - point.distance_nm) / point.gs_kts * seconds_per_hour;
+        point.distance_nm = distance_nm;
+    } else if (upper > 0) {
+        const VnavProfileStep& lo = steps_[upper - 1];
+        const VnavProfileStep& hi = steps_[upper];
+        Float64 t = (distance_nm - lo.distance_nm) / (hi.distance_nm - lo.distance_nm);
+        point.distance_nm = distance_nm;
+        point.altitude_ft = lo.altitude_ft + t * (hi.altitude_ft - lo.altitude_ft);
+        point.time_s = lo.time_s + t * (hi.time_s - lo.time_s);
+    }
+    return point;
+}
+
+} // namespace xplane_mfd::calc
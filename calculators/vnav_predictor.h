@@ -0,0 +1,156 @@
+// VNAV Trajectory Predictor for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Descent profile to the runway over several altitude constraints and wind
+// layers, integrated in fixed time steps. calculate_vnav (vnav_kernels.h)
+// answers one straight-line question; the predictor keeps a whole path.
+//
+// The profile is anchored at the runway threshold and built outward, the
+// way an FMS builds a descent: step 0 is the threshold, and each step
+// flies vnav_step_seconds backward along the path until it reaches the
+// cruise altitude (top of descent). Inside final_approach_fix_nm the path
+// is the geometric final approach angle; beyond it the aircraft descends
+// at descent_vs_fpm. Each step's TAS comes from the Mach/IAS schedule and
+// the air density and temperature at that altitude (density_altitude_kernels.h,
+// ISA plus isa_deviation_c), and its groundspeed from the headwind interpolated
+// between wind layers, taken at the step's midpoint altitude. An "at or
+// below" constraint holds the path level until it is passed; a step that
+// would cross a constraint ends on it, so the path meets it exactly.
+//
+// Because the path does not depend on where the aircraft is, it stays
+// valid from frame to frame and predict() only looks the aircraft up on it.
+// Changing an input invalidates just the steps it can affect: a wind
+// layer, the steps above the layer below it; a constraint, the steps from
+// its distance or altitude onward; the cruise altitude, the steps above the
+// lower of the old and new values. advance() then re-integrates at most
+// its step budget, so a full profile rebuild is spread over frames instead
+// of landing in one.
+//
+// Storage is fixed (AV Rule 206): vnav_max_steps steps, vnav_max_constraints
+// constraints and vnav_max_wind_layers layers, held in the object.
+//
+// AV Rule 126: C++ style comments only (//)
+
+#ifndef VNAV_PREDICTOR_H
+#define VNAV_PREDICTOR_H
+
+#include <array>
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+class WindProfileStore;  // wind_estimator.h
+
+// Arena sizes and integration step (AV Rule 52: lowercase constants)
+constexpr Int32 vnav_max_steps = 2048;
+constexpr Int32 vnav_max_constraints = 16;
+constexpr Int32 vnav_max_wind_layers = 8;
+constexpr Float64 vnav_step_seconds = 4.0;
+
+struct VnavDescentSettings {
+    Float64 cruise_alt_ft;              // Top of the profile
+    Float64 runway_elevation_ft;        // Threshold crossing altitude
+    Float64 descent_mach;               // Mach limit (above the IAS/Mach crossover)
+    Float64 descent_ias_kts;            // IAS above speed_limit_alt_ft
+    Float64 speed_limit_ias_kts;        // IAS limit below speed_limit_alt_ft
+    Float64 speed_limit_alt_ft;
+    Float64 descent_vs_fpm;             // Rate of descent beyond the FAF (positive)
+    Float64 final_approach_fpa_deg;     // Glide path angle inside the FAF (positive)
+    Float64 final_approach_fix_nm;      // FAF distance from the threshold
+    Float64 isa_deviation_c;            // Temperature = ISA + deviation at every altitude
+};
+
+// Distances are along the track before the threshold
+struct VnavConstraint {
+    Float64 distance_nm;
+    Float64 max_alt_ft;                 // At or below
+    Float64 min_alt_ft;                 // At or above (checked, not flown)
+};
+
+struct VnavWindLayer {
+    Float64 altitude_ft;
+    Float64 headwind_kts;               // Along the descent track (negative = tailwind)
+};
+
+struct VnavProfileStep {
+    Float64 distance_nm;                // From the threshold
+    Float64 altitude_ft;
+    Float64 time_s;                     // Flying time from here to the threshold
+    Float64 gs_kts;                     // Groundspeed over the step ending here
+};
+
+struct VnavPrediction {
+    Float64 path_altitude_ft;           // Profile altitude at the aircraft's distance
+    Float64 vertical_deviation_ft;      // Aircraft altitude minus path (positive = high)
+    Float64 tod_distance_nm;            // Distance to top of descent (0 once past it;
+                                        // to the last up-to-date step until complete())
+    Float64 required_vs_fpm;            // Path vertical speed here (negative = descending)
+    Float64 gs_kts;                     // Predicted groundspeed here
+    Float64 time_to_runway_min;
+    Float64 time_to_next_constraint_min;
+    Float64 next_constraint_alt_ft;     // Path altitude at the next constraint
+    Int32 next_constraint;              // Index of the next constraint ahead, -1 if none
+    bool next_constraint_met;           // Path is inside that constraint's window
+};
+
+class VnavPredictor {
+public:
+    VnavPredictor();
+
+    // Each setter invalidates only the steps the change can affect. Returns
+    // false (keeping the old inputs) if the values are out of range:
+    // constraints must be in increasing distance, layers in increasing
+    // altitude, counts within the arena sizes, speeds and rates positive.
+    bool set_settings(const VnavDescentSettings& settings);
+    bool set_constraints(const VnavConstraint* constraints, Int32 count);
+    bool set_wind_layers(const VnavWindLayer* layers, Int32 count);
+
+    // Wind layers from the winds measured on the way up or in cruise, as
+    // headwinds along a descent on track_deg (WindProfileStore::vnav_layers)
+    bool set_wind_profile(const WindProfileStore& store, Float64 track_deg);
+
+    // Integrate up to max_steps invalidated steps; returns the number done
+    Int32 advance(Int32 max_steps);
+
+    // True once the profile reaches the cruise altitude, or fills the arena
+    // first (truncated)
+    bool complete() const { return complete_; }
+    bool truncated() const { return truncated_; }
+
+    // Steps [0, step_count()) are up to date
+    Int32 step_count() const { return valid_steps_; }
+    const VnavProfileStep& step(Int32 index) const { return steps_[index]; }
+
+    // The aircraft on the profile. False while the up-to-date steps do not
+    // reach distance_nm yet (call advance), or past the end of a truncated
+    // profile.
+    bool predict(Float64 distance_nm, Float64 altitude_ft, VnavPrediction& out) const;
+
+private:
+    void invalidate_from(Int32 step);
+    void invalidate_above(Float64 altitude_ft);
+    void invalidate_beyond(Float64 distance_nm);
+    void integrate_step(Int32 index);
+    VnavProfileStep fly_step(const VnavProfileStep& from, Float64 gs_kts) const;
+
+    Float64 headwind_at(Float64 altitude_ft) const;
+    Float64 groundspeed_at(Float64 altitude_ft) const;
+    Float64 ceiling_beyond(Float64 distance_nm) const;
+    Float64 boundary_beyond(Float64 distance_nm) const;
+    VnavProfileStep point_at(Float64 distance_nm) const;
+
+    VnavDescentSettings settings_;
+    std::array<VnavConstraint, vnav_max_constraints> constraints_;
+    std::array<VnavWindLayer, vnav_max_wind_layers> winds_;
+    std::array<VnavProfileStep, vnav_max_steps> steps_;
+    Int32 constraint_count_;
+    Int32 wind_count_;
+    Int32 valid_steps_;
+    bool configured_;
+    bool complete_;
+    bool truncated_;
+};
+
+} // namespace xplane_mfd::calc
+
+#endif // VNAV_PREDICTOR_H
@@ -13,17 +13,17 @@
 // - AV Rule 113: Single exit point
 // - AV Rule 126: C++ style comments only (//)
 // 
-// Compile: g++ -std=c++20 -O3 -o wind_calculator wind_calculator.cpp
+// Kernels live in wind_kernels.cpp.
 // 
-// Usage: ./wind_calculator <track> <heading> <wind_dir> <wind_speed>
+// Compile: g++ -std=c++20 -O3 -o wind_calculator wind_calculator.cpp wind_kernels.cpp calc_io.cpp
+// 
+// Usage: ./wind_calculator [--binary] <track> <heading> <wind_dir> <wind_speed>
 
 #include <iostream>
-#include <cmath>
-#include <iomanip>
-#include <cstdlib>
-#include <numbers>
-#include <vector>
+#include <cstring>
 #include "jsf_types.h"
+#include "calc_io.h"
+#include "wind_kernels.h"
 
 namespace xplane_mfd::calc {
 
@@ -33,94 +33,20 @@ const Int32 error_invalid_args = 1;
 const Int32 error_parse_failed = 2;
 const Int32 error_invalid_value = 3;
 
-// Mathematical constants (AV Rule 52: lowercase)
-const Float64 deg_to_rad = std::numbers::pi / 180.0;
-const Float64 angle_wrap_limit = 360.0;
-const Float64 half_circle = 180.0;
+// Input validation (negative wind speed is rejected)
 const Float64 wind_calm_threshold = 0.0;
 
-// JSF-compliant parse function (no exceptions)
-bool parse_float64(const char* str, Float64& result) {
-    char* end = nullptr;
-    result = strtod(str, &end);
-    return (end != str && *end == '\0');
-}
-
-struct WindComponents {
-    Float64 headwind;      // Positive = headwind, negative = tailwind
-    Float64 crosswind;     // Positive = from right, negative = from left
-    Float64 total_wind;    // Total wind speed
-    Float64 wca;          // Wind correction angle
-    Float64 drift;        // Drift angle (track - heading)
-};
-
-// Normalize angle to 0-360 range
-// Uses fmod() for deterministic execution time (no variable-iteration loops)
-// This is important for real-time and safety-critical systems where
-// predictable worst-case execution time (WCET) is required
-Float64 normalize_angle(Float64 angle) {
-    Float64 result = fmod(angle, angle_wrap_limit);
-    if (result < wind_calm_threshold) {
-        result += angle_wrap_limit;
-    }
-    return result;
-}
-
-// Calculate wind components relative to aircraft track
-WindComponents calculate_wind(Float64 track, Float64 heading, 
-                               Float64 wind_dir, Float64 wind_speed) {
-    WindComponents result;
-    
-    // Normalize all angles
-    track = normalize_angle(track);
-    heading = normalize_angle(heading);
-    wind_dir = normalize_angle(wind_dir);
-    
-    // Calculate drift angle
-    result.drift = normalize_angle(track - heading);
-    if (result.drift > half_circle) result.drift -= angle_wrap_limit;
-    
-    // Wind direction is where wind comes FROM
-    // Calculate angle of wind-from relative to track
-    Float64 wind_from_relative = normalize_angle(wind_dir - track);
-    if (wind_from_relative > half_circle) wind_from_relative -= angle_wrap_limit;
-    
-    // Convert to radians for trig
-    Float64 wind_from_rad = wind_from_relative * deg_to_rad;
-    
-    // Calculate components using wind-from angle
-    result.headwind = -wind_speed * cos(wind_from_rad);
-    result.crosswind = wind_speed * sin(wind_from_rad);
-    result.total_wind = wind_speed;
-    
-    // Wind correction angle placeholder
-    result.wca = wind_calm_threshold;  // Cannot calculate without TAS
-    
-    return result;
-}
-
-// Output results as JSON
-void print_json(const WindComponents& wind) {
-    std::cout << std::fixed << std::setprecision(2);
-    std::cout << "{\n";
-    std::cout << "  \"headwind\": " << wind.headwind << ",\n";
-    std::cout << "  \"crosswind\": " << wind.crosswind << ",\n";
-    std::cout << "  \"total_wind\": " << wind.total_wind << ",\n";
-    std::cout << "  \"wca\": " << wind.wca << ",\n";
-    std::cout << "  \"drift\": " << wind.drift << "\n";
-    std::cout << "}\n";
-}
-
 } // namespace xplane_mfd::calc
 
 void print_usage(const char* program_name) {
     std::cerr << "Usage: " << program_name 
-              << " <track> <heading> <wind_dir> <wind_speed>\n\n";
+              << " [--binary] <track> <heading> <wind_dir> <wind_speed>\n\n";
     std::cerr << "Arguments:\n";
     std::cerr << "  track      : Ground track (degrees true)\n";
     std::cerr << "  heading    : Aircraft heading (degrees)\n";
     std::cerr << "  wind_dir   : Wind direction FROM (degrees)\n";
-    std::cerr << "  wind_speed : Wind speed (knots)\n\n";
+    std::cerr << "  wind_speed : Wind speed (knots)\n";
+    std::cerr << "  --binary   : Binary record (wire_format.h) instead of JSON\n\n";
     std::cerr << "Example:\n";
     std::cerr << "  " << program_name << " 90 85 270 15\n";
     std::cerr << "  (Track 90°, Heading 85°, Wind from 270° at 15 knots)\n";
@@ -132,8 +58,12 @@ int main(int argc, char* argv[]) {
     
     Int32 return_code = error_success;  // Single exit point variable
     
+    // Optional leading --binary: wire_format.h record instead of JSON
+    const bool binary_output = (argc > 1 && std::strcmp(argv[1], "--binary") == 0);
+    const Int32 arg_offset = binary_output ? 1 : 0;
+    
     // JSF-compliant: No exceptions, use error codes
-    if (argc != 5) {
+    if (argc - arg_offset != 5) {
         print_usage(argv[0]);
         return_code = error_invalid_args;
     } else {
@@ -143,16 +73,16 @@ int main(int argc, char* argv[]) {
         Float64 wind_dir;
         Float64 wind_speed;
         
-        if (!parse_float64(argv[1], track)) {
+        if (!parse_float64(argv[arg_offset + 1], track)) {
             std::cerr << "Error: Invalid track angle\n";
             return_code = error_parse_failed;
-        } else if (!parse_float64(argv[2], heading)) {
+        } else if (!parse_float64(argv[arg_offset + 2], heading)) {
             std::cerr << "Error: Invalid heading\n";
             return_code = error_parse_failed;
-        } else if (!parse_float64(argv[3], wind_dir)) {
+        } else if (!parse_float64(argv[arg_offset + 3], wind_dir)) {
             std::cerr << "Error: Invalid wind direction\n";
             return_code = error_parse_failed;
-        } else if (!parse_float64(argv[4], wind_speed)) {
+        } else if (!parse_float64(argv[arg_offset + 4], wind_speed)) {
             std::cerr << "Error: Invalid wind speed\n";
             return_code = error_parse_failed;
         } else if (wind_speed < wind_calm_threshold) {
@@ -163,7 +93,12 @@ int main(int argc, char* argv[]) {
             WindComponents wind = calculate_wind(track, heading, wind_dir, wind_speed);
             
             // Output JSON
-            print_json(wind);
+            if (binary_output) {
+                print_binary(std::cout, wind);
+            } else {
+                print_json(std::cout, wind, false);
+                std::cout << "\n";
+            }
             return_code = error_success;
         }
     }
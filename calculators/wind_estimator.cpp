@@ -0,0 +1,255 @@
+// Filtered Wind Estimator for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Implementation of the estimator and profile store declared in
+// wind_estimator.h.
+//
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try)
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation (fixed filter and band state)
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#include <algorithm>
+#include <cmath>
+#include "wind_estimator.h"
+#include "vnav_predictor.h"
+#include "units.h"
+#include "wire_format.h"
+#include "calc_io.h"
+
+namespace xplane_mfd::calc {
+
+namespace {
+
+const Float64 angle_wrap = 360.0;
+const Float64 half_circle = 180.0;
+const Float64 innovation_smoothing = 0.1;  // weight of each sample in the running innovation mean
+
+Float64 normalize_angle(Float64 angle) {
+    Float64 result = std::fmod(angle, angle_wrap);
+    if (result < 0.0) {
+        result += angle_wrap;
+    }
+    return result;
+}
+
+// Wind component opposing motion along a track, given its sine and cosine
+Float64 headwind_along(Float64 east_kts, Float64 north_kts, Float64 sin_track, Float64 cos_track) {
+    return -(east_kts * sin_track + north_kts * cos_track);
+}
+
+} // namespace
+
+WindEstimator::WindEstimator() {
+    reset();
+}
+
+void WindEstimator::reset() {
+    east_kts_ = 0.0;
+    north_kts_ = 0.0;
+    variance_kts2_ = 0.0;
+    innovation_mean_ = wind_expected_innovation;
+    last_time_s_ = 0.0;
+    last_heading_ = 0.0;
+    last_altitude_ft_ = 0.0;
+    last_track_ = 0.0;
+    sample_count_ = 0;
+    started_ = false;
+    timed_ = false;
+}
+
+bool WindEstimator::update(const WindSample& sample) {
+    bool fused = false;
+    bool finite = std::isfinite(sample.time_s) && std::isfinite(sample.altitude_ft) &&
+                  std::isfinite(sample.tas_kts) && std::isfinite(sample.gs_kts) &&
+                  std::isfinite(sample.heading) && std::isfinite(sample.track);
+
+    if (finite) {
+        Float64 dt = timed_ ? sample.time_s - last_time_s_ : 0.0;
+        if (dt < 0.0 || dt > wind_max_sample_gap_s) {
+            reset();
+            dt = 0.0;
+        }
+
+        // Predict: the wind wanders, faster while the innovations say the
+        // filter is behind it, and changes with height
+        if (started_) {
+            variance_kts2_ += wind_process_noise_kts2_per_s * dt *
+                              std::max(1.0, innovation_mean_ / wind_expected_innovation);
+            variance_kts2_ += wind_shear_noise_kts2_per_kft * std::fabs(sample.altitude_ft - last_altitude_ft_) /
+                              1000.0;
+        }
+
+        if (sample.tas_kts >= wind_min_tas_kts && sample.gs_kts >= 0.0) {
+            // Wind = ground vector - air vector, as calculate_wind_vector
+            Float64 heading_rad = convert<Degrees, Radians>(sample.heading);
+            Float64 track_rad = convert<Degrees, Radians>(sample.track);
+            Float64 measured_east = sample.gs_kts * std::sin(track_rad) - sample.tas_kts * std::sin(heading_rad);
+            Float64 measured_north = sample.gs_kts * std::cos(track_rad) - sample.tas_kts * std::cos(heading_rad);
+
+            Float64 noise_kts2 = wind_measurement_noise_kts2;
+            if (timed_ && dt > 0.0) {
+                Float64 turn = normalize_angle(sample.heading - last_heading_ + half_circle) - half_circle;
+                Float64 rate = std::fabs(turn) / dt / wind_turn_rate_scale_dps;
+                noise_kts2 *= 1.0 + rate * rate;
+            }
+
+            if (!started_) {
+                east_kts_ = measured_east;
+                north_kts_ = measured_north;
+                variance_kts2_ = noise_kts2;
+                started_ = true;
+            } else {
+                Float64 innovation_east = measured_east - east_kts_;
+                Float64 innovation_north = measured_north - north_kts_;
+                Float64 innovation = (innovation_east * innovation_east + innovation_north * innovation_north) /
+                                     (variance_kts2_ + noise_kts2);
+                if (innovation > wind_innovation_gate) {
+                    noise_kts2 *= innovation / wind_innovation_gate;
+                }
+                Float64 gain = variance_kts2_ / (variance_kts2_ + noise_kts2);
+                east_kts_ += gain * innovation_east;
+                north_kts_ += gain * innovation_north;
+                variance_kts2_ *= 1.0 - gain;
+                // One wild sample counts no more than one at the gate
+                innovation_mean_ += innovation_smoothing *
+                                    (std::min(innovation, wind_innovation_gate) - innovation_mean_);
+            }
+            last_track_ = sample.track;
+            ++sample_count_;
+            fused = true;
+        }
+
+        last_time_s_ = sample.time_s;
+        last_heading_ = sample.heading;
+        last_altitude_ft_ = sample.altitude_ft;
+        timed_ = true;
+    }
+
+    return fused;
+}
+
+WindEstimate WindEstimator::estimate() const {
+    WindEstimate result = {};
+    if (started_) {
+        Float64 track_rad = convert<Degrees, Radians>(last_track_);
+        result.speed_kts = std::hypot(east_kts_, north_kts_);
+        // The wind comes from opposite the way it blows
+        result.direction_from = normalize_angle(convert<Radians, Degrees>(std::atan2(-east_kts_, -north_kts_)));
+        Float64 sin_track = std::sin(track_rad);
+        Float64 cos_track = std::cos(track_rad);
+        result.headwind = headwind_along(east_kts_, north_kts_, sin_track, cos_track);
+        result.crosswind = -(east_kts_ * cos_track - north_kts_ * sin_track);
+        result.uncertainty_kts = std::sqrt(variance_kts2_);
+        result.confidence = wind_measurement_noise_kts2 / (wind_measurement_noise_kts2 + variance_kts2_) *
+                            std::min(1.0, wind_expected_innovation / innovation_mean_);
+        result.sample_count = sample_count_;
+    }
+    return result;
+}
+
+WindProfileStore::WindProfileStore() {
+    clear();
+}
+
+void WindProfileStore::clear() {
+    bands_.fill(Band{0.0, 0.0, 0.0});
+}
+
+void WindProfileStore::record(Float64 altitude_ft, const WindEstimator& estimator) {
+    Float64 confidence = estimator.estimate().confidence;
+    if (estimator.started() && std::isfinite(altitude_ft) && confidence > 0.0) {
+        Int32 index = static_cast<Int32>(std::clamp(std::floor(altitude_ft / wind_profile_band_ft), 0.0,
+                                                    static_cast<Float64>(wind_profile_band_count - 1)));
+        Band& band = bands_[index];
+        // A running mean over the band's samples, fading the oldest once
+        // the band holds wind_profile_max_weight
+        band.weight = std::min(wind_profile_max_weight, band.weight + confidence);
+        Float64 blend = confidence / band.weight;
+        band.east_kts += blend * (estimator.east_kts() - band.east_kts);
+        band.north_kts += blend * (estimator.north_kts() - band.north_kts);
+    }
+}
+
+Int32 WindProfileStore::band_count() const {
+    Int32 count = 0;
+    for (const Band& band : bands_) {
+        if (band.weight > 0.0) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+Int32 WindProfileStore::vnav_layers(Float64 track_deg, VnavWindLayer* layers, Int32 max_layers) const {
+    Int32 filled = band_count();
+    Int32 written = 0;
+    if (filled > 0 && max_layers > 0 && layers != nullptr) {
+        Int32 group_size = (filled + max_layers - 1) / max_layers;
+        Float64 sin_track = std::sin(convert<Degrees, Radians>(track_deg));
+        Float64 cos_track = std::cos(convert<Degrees, Radians>(track_deg));
+        Int32 in_group = 0;
+        Float64 altitude_sum = 0.0;
+        Float64 headwind_sum = 0.0;
+        Float64 weight_sum = 0.0;
+        for (Int32 b = 0; b < wind_profile_band_count; ++b) {
+            const Band& band = bands_[b];
+            if (band.weight > 0.0) {
+                altitude_sum += (b + 0.5) * wind_profile_band_ft;
+                headwind_sum += band.weight * headwind_along(band.east_kts, band.north_kts, sin_track, cos_track);
+                weight_sum += band.weight;
+                ++in_group;
+                --filled;
+                if (in_group == group_size || filled == 0) {
+                    layers[written].altitude_ft = altitude_sum / in_group;
+                    layers[written].headwind_kts = headwind_sum / weight_sum;
+                    ++written;
+                    in_group = 0;
+                    altitude_sum = 0.0;
+                    headwind_sum = 0.0;
+                    weight_sum = 0.0;
+                }
+            }
+        }
+    }
+    return written;
+}
+
+void print_json(std::ostream& out, const WindEstimate& estimate, bool fused) {
+    TextWriter text(out);
+    text.put("{\"speed_kts\": ");
+    text.put_fixed(estimate.speed_kts);
+    text.put(", \"direction_from\": ");
+    text.put_fixed(estimate.direction_from);
+    text.put(", \"headwind\": ");
+    text.put_fixed(estimate.headwind);
+    text.put(", \"crosswind\": ");
+    text.put_fixed(estimate.crosswind);
+    text.put(", \"uncertainty_kts\": ");
+    text.put_fixed(estimate.uncertainty_kts);
+    text.put(", \"confidence\": ");
+    text.put_fixed(estimate.confidence);
+    text.put(", \"samples\": ");
+    text.put_int(estimate.sample_count);
+    text.put(", \"fused\": ");
+    text.put(fused ? "true" : "false");
+    text.put('}');
+}
+
+void print_binary(std::ostream& out, const WindEstimate& estimate, bool fused) {
+    WireRecord record(wire_record_wind_estimate);
+    record.put_float64(estimate.speed_kts);
+    record.put_float64(estimate.direction_from);
+    record.put_float64(estimate.headwind);
+    record.put_float64(estimate.crosswind);
+    record.put_float64(estimate.uncertainty_kts);
+    record.put_float64(estimate.confidence);
+    record.put_int64(estimate.sample_count);
+    record.put_bool(fused);
+    record.write_to(out);
+}
+
+} // namespace xplane_mfd::calc
@@ -0,0 +1,151 @@
+// Filtered Wind Estimator for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// calculate_wind_vector (flight_kernels.h) solves the wind triangle from
+// one sample, so sensor noise and heading/track lag in a turn reach the
+// display directly. WindEstimator fuses the samples over time instead: a
+// Kalman filter on the wind's east and north components, modelled as a
+// random walk (wind_process_noise_kts2_per_s), with each sample's triangle
+// solution as the measurement. The wind also changes with height, so a
+// climb or descent adds wind_shear_noise_kts2_per_kft of variance per
+// thousand feet. Both components share one variance, so an update is a
+// handful of multiplies whatever the sample rate.
+//
+// A sample's measurement noise grows with the heading rate since the last
+// sample (track lags heading in a turn), and a sample far outside the
+// filter's expectation (normalized innovation past wind_innovation_gate)
+// is taken with proportionally less weight, so a gust or a bad frame
+// moves the estimate less than a real wind shift that persists. Below
+// wind_min_tas_kts (ground roll) samples only advance time.
+//
+// confidence (0 to 1) is how far the filter's variance is below one
+// sample's, scaled down while recent innovations are larger than the
+// filter expects: it starts at 0.5 with the first sample, rises as samples
+// agree, and falls through gaps, turns and wind shifts.
+//
+// WindProfileStore keeps the estimates by altitude band, weighted by their
+// confidence, for the VNAV predictor's wind layers (vnav_predictor.h).
+//
+// Storage is fixed (AV Rule 206): the filter state, and
+// wind_profile_band_count bands, held in the objects.
+//
+// AV Rule 126: C++ style comments only (//)
+
+#ifndef WIND_ESTIMATOR_H
+#define WIND_ESTIMATOR_H
+
+#include <array>
+#include <ostream>
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+struct VnavWindLayer;  // vnav_predictor.h
+
+// Filter tuning (AV Rule 52: lowercase)
+const Float64 wind_process_noise_kts2_per_s = 0.05;  // about 1.2 kt of drift in 30 s
+const Float64 wind_shear_noise_kts2_per_kft = 6.0;   // about 2.5 kt per 1000 ft
+const Float64 wind_measurement_noise_kts2 = 9.0;     // 3 kt per component in one triangle solve
+const Float64 wind_turn_rate_scale_dps = 3.0;        // standard rate doubles the noise
+const Float64 wind_innovation_gate = 9.21;           // chi-square, 2 degrees of freedom, 99%
+const Float64 wind_expected_innovation = 2.0;        // mean of that chi-square
+const Float64 wind_min_tas_kts = 40.0;
+const Float64 wind_max_sample_gap_s = 60.0;          // a longer gap, or time going back, restarts
+
+// Altitude bands of the profile store
+const Int32 wind_profile_band_count = 25;
+const Float64 wind_profile_band_ft = 2000.0;          // band b is [b, b + 1) * 2000 ft
+const Float64 wind_profile_max_weight = 50.0;         // confidence-weighted samples a band remembers
+
+struct WindSample {
+    Float64 time_s;        // Monotonic (sim or replay) time
+    Float64 altitude_ft;
+    Float64 tas_kts;
+    Float64 gs_kts;
+    Float64 heading;
+    Float64 track;
+};
+
+struct WindEstimate {
+    Float64 speed_kts;
+    Float64 direction_from;   // deg, where wind comes FROM
+    Float64 headwind;         // Along the last sample's track, positive = headwind
+    Float64 crosswind;        // Positive = from right
+    Float64 uncertainty_kts;  // Standard deviation of each component
+    Float64 confidence;       // 0 (nothing known) to 1
+    Int64 sample_count;       // Samples fused since the filter (re)started
+};
+
+class WindEstimator {
+public:
+    WindEstimator();
+
+    // Advance to the sample's time and fuse it; false if it only advanced
+    // time (TAS below wind_min_tas_kts, or a non-finite field)
+    bool update(const WindSample& sample);
+
+    // Forget everything: the next sample starts the filter again
+    void reset();
+
+    bool started() const { return started_; }
+
+    // Current estimate (all zero before the first fused sample)
+    WindEstimate estimate() const;
+
+    Float64 east_kts() const { return east_kts_; }    // Wind vector, blowing toward
+    Float64 north_kts() const { return north_kts_; }
+
+private:
+    Float64 east_kts_;
+    Float64 north_kts_;
+    Float64 variance_kts2_;
+    Float64 innovation_mean_;   // running mean of normalized innovations
+    Float64 last_time_s_;
+    Float64 last_heading_;
+    Float64 last_altitude_ft_;
+    Float64 last_track_;
+    Int64 sample_count_;
+    bool started_;
+    bool timed_;                // last_time_s_, last_heading_ and last_altitude_ft_ are set
+};
+
+class WindProfileStore {
+public:
+    WindProfileStore();
+
+    // Blend an estimator's current wind into the band of altitude_ft,
+    // weighted by its confidence; nothing before the estimator has started
+    void record(Float64 altitude_ft, const WindEstimator& estimator);
+
+    void clear();
+
+    // Bands holding any weight
+    Int32 band_count() const;
+
+    // VNAV wind layers for a descent along track_deg, in increasing
+    // altitude: one per band with weight, at its center altitude with its
+    // headwind, or per group of adjacent such bands (mean center, weighted
+    // headwind) when there are more than max_layers. Returns the number of
+    // layers written.
+    Int32 vnav_layers(Float64 track_deg, VnavWindLayer* layers, Int32 max_layers) const;
+
+private:
+    struct Band {
+        Float64 east_kts;
+        Float64 north_kts;
+        Float64 weight;
+    };
+
+    std::array<Band, wind_profile_band_count> bands_;
+};
+
+// Write the JSON object (one line, no trailing newline); fused is whether
+// this sample was taken into the filter
+void print_json(std::ostream& out, const WindEstimate& estimate, bool fused);
+
+// Write a wire_record_wind_estimate record (wire_format.h)
+void print_binary(std::ostream& out, const WindEstimate& estimate, bool fused);
+
+} // namespace xplane_mfd::calc
+
+#endif // WIND_ESTIMATOR_H
@@ -0,0 +1,159 @@
+// Wind Component Kernels for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Implementation of the kernels declared in wind_kernels.h.
+//
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#include <cmath>
+#include "wind_kernels.h"
+#include "units.h"
+#include "wire_format.h"
+#include "calc_io.h"
+#include "simd_math.h"
+
+namespace xplane_mfd::calc {
+
+// Mathematical constants (AV Rule 52: lowercase); conversions are in units.h
+const Float64 angle_wrap_limit = 360.0;
+const Float64 half_circle = 180.0;
+const Float64 wind_calm_threshold = 0.0;
+
+// Helpers local to this translation unit (other kernels have their own)
+namespace {
+
+// Normalize angle to 0-360 range
+// Uses fmod() for deterministic execution time (no variable-iteration loops)
+// This is important for real-time and safety-critical systems where
+// predictable worst-case execution time (WCET) is required
+Float64 normalize_angle(Float64 angle) {
+    Float64 result = fmod(angle, angle_wrap_limit);
+    if (result < wind_calm_threshold) {
+        result += angle_wrap_limit;
+    }
+    return result;
+}
+
+// normalize_angle for four lanes: angle - 360 * floor(angle / 360), with the
+// same +360 fix-up when rounding leaves a tiny negative result
+SIMD_INLINE Float64x4 normalize_angle_lanes(const Float64x4& angle) {
+    Float64x4 result = angle - angle_wrap_limit * simd_floor(angle / angle_wrap_limit);
+    return result < wind_calm_threshold ? result + angle_wrap_limit : result;
+}
+
+// calculate_wind for up to simd_lanes rows starting at row
+SIMD_INLINE void wind_lanes(const WindBatchInputs& in, const WindBatchOutputs& out,
+                            Int32 row, Int32 lanes) {
+    Float64x4 track = normalize_angle_lanes(simd_load_partial(in.track + row, lanes));
+    Float64x4 heading = normalize_angle_lanes(simd_load_partial(in.heading + row, lanes));
+    Float64x4 wind_dir = normalize_angle_lanes(simd_load_partial(in.wind_dir + row, lanes));
+    Float64x4 wind_speed = simd_load_partial(in.wind_speed + row, lanes);
+
+    Float64x4 drift = normalize_angle_lanes(track - heading);
+    simd_store_partial(out.drift + row, drift > half_circle ? drift - angle_wrap_limit : drift, lanes);
+
+    Float64x4 wind_from_relative = normalize_angle_lanes(wind_dir - track);
+    wind_from_relative = wind_from_relative > half_circle ? wind_from_relative - angle_wrap_limit : wind_from_relative;
+
+    Float64x4 sin_wind;
+    Float64x4 cos_wind;
+    simd_sincos(convert<Degrees, Radians>(wind_from_relative), sin_wind, cos_wind);
+    simd_store_partial(out.headwind + row, -wind_speed * cos_wind, lanes);
+    simd_store_partial(out.crosswind + row, wind_speed * sin_wind, lanes);
+    simd_store_partial(out.total_wind + row, wind_speed, lanes);
+    simd_store_partial(out.wca + row, simd_splat(wind_calm_threshold), lanes);
+}
+
+} // namespace
+
+// Calculate wind components relative to aircraft track
+WindComponents calculate_wind(Float64 track, Float64 heading, 
+                               Float64 wind_dir, Float64 wind_speed) {
+    WindComponents result;
+    
+    // Normalize all angles
+    track = normalize_angle(track);
+    heading = normalize_angle(heading);
+    wind_dir = normalize_angle(wind_dir);
+    
+    // Calculate drift angle
+    result.drift = normalize_angle(track - heading);
+    if (result.drift > half_circle) result.drift -= angle_wrap_limit;
+    
+    // Wind direction is where wind comes FROM
+    // Calculate angle of wind-from relative to track
+    Float64 wind_from_relative = normalize_angle(wind_dir - track);
+    if (wind_from_relative > half_circle) wind_from_relative -= angle_wrap_limit;
+    
+    // Convert to radians for trig
+    Float64 wind_from_rad = convert<Degrees, Radians>(wind_from_relative);
+    
+    // Calculate components using wind-from angle
+    result.headwind = -wind_speed * cos(wind_from_rad);
+    result.crosswind = wind_speed * sin(wind_from_rad);
+    result.total_wind = wind_speed;
+    
+    // Wind correction angle placeholder
+    result.wca = wind_calm_threshold;  // Cannot calculate without TAS
+    
+    return result;
+}
+
+// Batch loop in this translation unit so the scalar kernel can inline into
+// it; ivdep passes on the no-overlap contract (no run-time alias checks)
+void calculate_wind_batch(const WindBatchInputs& in, const WindBatchOutputs& out, Int32 count) {
+    #pragma GCC ivdep
+    for (Int32 i = 0; i < count; ++i) {
+        WindComponents result = calculate_wind(in.track[i], in.heading[i], in.wind_dir[i], in.wind_speed[i]);
+        out.headwind[i] = result.headwind;
+        out.crosswind[i] = result.crosswind;
+        out.total_wind[i] = result.total_wind;
+        out.wca[i] = result.wca;
+        out.drift[i] = result.drift;
+    }
+}
+
+SIMD_DISPATCH
+void calculate_wind_simd(const WindBatchInputs& in, const WindBatchOutputs& out, Int32 count) {
+    Int32 row = 0;
+    for (; row + simd_lanes <= count; row += simd_lanes) {
+        wind_lanes(in, out, row, simd_lanes);
+    }
+    if (row < count) {
+        wind_lanes(in, out, row, count - row);
+    }
+}
+
+// Output results as JSON
+void print_json(std::ostream& out, const WindComponents& wind, bool single_line) {
+    const char* nl = single_line ? "" : "\n";
+    const char* in1 = single_line ? "" : "  ";
+    
+    TextWriter text(out);
+    text.put('{');
+    text.put(nl);
+    put_json_member(text, in1, "headwind", wind.headwind, false, nl);
+    put_json_member(text, in1, "crosswind", wind.crosswind, false, nl);
+    put_json_member(text, in1, "total_wind", wind.total_wind, false, nl);
+    put_json_member(text, in1, "wca", wind.wca, false, nl);
+    put_json_member(text, in1, "drift", wind.drift, true, nl);
+    text.put('}');
+}
+
+void print_binary(std::ostream& out, const WindComponents& wind) {
+    WireRecord record(wire_record_wind_components);
+    record.put_float64(wind.headwind);
+    record.put_float64(wind.crosswind);
+    record.put_float64(wind.total_wind);
+    record.put_float64(wind.wca);
+    record.put_float64(wind.drift);
+    record.write_to(out);
+}
+
+} // namespace xplane_mfd::calc
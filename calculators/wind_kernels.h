@@ -0,0 +1,63 @@
+// Wind Component Kernels for X-Plane MFD
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Result type and kernel shared by wind_calculator and the other front ends.
+//
+// AV Rule 126: C++ style comments only (//)
+
+#ifndef WIND_KERNELS_H
+#define WIND_KERNELS_H
+
+#include <ostream>
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+struct WindComponents {
+    Float64 headwind;      // Positive = headwind, negative = tailwind
+    Float64 crosswind;     // Positive = from right, negative = from left
+    Float64 total_wind;    // Total wind speed
+    Float64 wca;          // Wind correction angle
+    Float64 drift;        // Drift angle (track - heading)
+};
+
+// Calculate wind components relative to aircraft track
+WindComponents calculate_wind(Float64 track, Float64 heading, 
+                               Float64 wind_dir, Float64 wind_speed);
+
+// Structure-of-arrays batch evaluation: row i of the inputs gives row i of
+// the outputs (same results as the scalar kernel). Columns must not overlap.
+// Inputs are not validated; callers reject negative wind speeds per row.
+struct WindBatchInputs {
+    const Float64* track;
+    const Float64* heading;
+    const Float64* wind_dir;
+    const Float64* wind_speed;
+};
+
+struct WindBatchOutputs {
+    Float64* headwind;
+    Float64* crosswind;
+    Float64* total_wind;
+    Float64* wca;
+    Float64* drift;
+};
+
+void calculate_wind_batch(const WindBatchInputs& in, const WindBatchOutputs& out, Int32 count);
+
+// Same as calculate_wind_batch, four rows per step with the simd_math.h
+// approximations (AVX2 / SSE2 / NEON, chosen at load time). Angles are
+// normalized with floor instead of fmod, which agrees exactly for
+// |angle| < 1e6 deg; outputs match the scalar kernel to within 2 ulp.
+void calculate_wind_simd(const WindBatchInputs& in, const WindBatchOutputs& out, Int32 count);
+
+// Write the JSON object (no trailing newline); single_line drops the
+// newlines and indentation for one-line replies
+void print_json(std::ostream& out, const WindComponents& wind, bool single_line);
+
+// Write a wire_record_wind_components record (wire_format.h)
+void print_binary(std::ostream& out, const WindComponents& wind);
+
+} // namespace xplane_mfd::calc
+
+#endif // WIND_KERNELS_H
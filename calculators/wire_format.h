@@ -0,0 +1,190 @@
+// Binary Wire Format for X-Plane MFD Calculators
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Fixed-layout little-endian records, an opt-in alternative to the JSON
+// printers (--binary). Each record is an 8-byte header followed by a
+// payload whose layout is fixed by (record_type, version), so a consumer
+// decodes a whole record with one Python struct.unpack call.
+//
+//   header: magic   Uint32  wire_magic ("XMFD" on the wire)
+//           version Uint8   wire_version
+//           type    Uint8   wire_record_*
+//           size    Uint16  payload bytes that follow
+//
+// Payloads (fields in struct declaration order, Python struct formats):
+//
+//   type  record            payload   format (header is "<IBBH")
+//   1     WindData          40 bytes  "<5d"
+//   2     EnvelopeMargins   48 bytes  "<6d"
+//   3     EnergyData        20 bytes  "<2di"   trend as Int32
+//   4     GlideData         32 bytes  "<4d"
+//   5     TurnData          64 bytes  "<8d"
+//   6     VNAVData          57 bytes  "<7d?"   is_descent as one byte
+//   7     DensityAltitudeData 64 bytes "<8d"
+//   8     WindComponents    40 bytes  "<5d"
+//   9     error             4 bytes   "<i"     calculator exit code
+//   10    reply             16 bytes  "<qii"   id, status, record count
+//   11    timing            8 bytes   "<d"     compute_us: time the server
+//                                              spent on the request, I/O excluded
+//   12    aircraft frame    16 bytes  "<qq"    aircraft id, frame number
+//   13    glide footprint   41 bytes  "<4dq?"  center north/east of the
+//                                              aircraft (nm), min and max
+//                                              range, sweep count, recomputed
+//   14    footprint ranges  64 bytes  "<8d"    8 radial ranges (nm)
+//   15    wind estimate     57 bytes  "<6dq?"  speed, direction from,
+//                                              headwind, crosswind,
+//                                              uncertainty, confidence,
+//                                              samples, fused
+//
+// flight_calculator writes its result as records 1-4 back to back
+// (172 bytes, "<IBBH5dIBBH6dIBBH2diIBBH4d"); in --serve mode a timing record
+// follows. A mfd_calcd binary reply is one record per requested section, a
+// timing record, then the reply record; its record count covers every
+// record before it. A reply to an aircraft frame request, and each frame
+// pushed to a subscriber, starts with an aircraft frame record. A glide
+// footprint is record 13 followed by 45 records 14 (360 radials, radial 0
+// north first). Readers skip record types they don't know, so new types
+// are added without a version bump.
+//
+// Column files (calc_batch --columns) carry many rows for offline replay,
+// column by column so they load straight into structure-of-arrays buffers:
+//
+//   file header "<IBBH": wire_column_magic ("XMFC"), wire_version, 0,
+//                        column count
+//   block       "<I" row count (1..wire_column_block_rows), then for each
+//               column in order that many Float64 values ("<Nd")
+//   end         a block with row count 0
+//
+// A change to any payload layout must bump wire_version.
+//
+// AV Rule 126: C++ style comments only (//)
+
+#ifndef WIRE_FORMAT_H
+#define WIRE_FORMAT_H
+
+#include <array>
+#include <bit>
+#include <cstring>
+#include <ostream>
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+// Format identification (AV Rule 52: lowercase)
+const Uint32 wire_magic = 0x44464D58u;  // bytes 'X' 'M' 'F' 'D' little-endian
+const Uint8 wire_version = 1;
+const Int32 wire_header_size = 8;
+const Int32 wire_max_payload = 64;
+
+// Column file identification and block size limit
+const Uint32 wire_column_magic = 0x43464D58u;  // bytes 'X' 'M' 'F' 'C' little-endian
+const Int32 wire_column_block_rows = 4096;
+
+// Record types
+const Uint8 wire_record_wind_data = 1;
+const Uint8 wire_record_envelope = 2;
+const Uint8 wire_record_energy = 3;
+const Uint8 wire_record_glide = 4;
+const Uint8 wire_record_turn = 5;
+const Uint8 wire_record_vnav = 6;
+const Uint8 wire_record_density_altitude = 7;
+const Uint8 wire_record_wind_components = 8;
+const Uint8 wire_record_error = 9;
+const Uint8 wire_record_reply = 10;
+const Uint8 wire_record_timing = 11;
+const Uint8 wire_record_aircraft_frame = 12;
+const Uint8 wire_record_footprint = 13;
+const Uint8 wire_record_footprint_ranges = 14;
+const Uint8 wire_record_wind_estimate = 15;
+
+// Radial ranges per footprint ranges record
+const Int32 wire_footprint_ranges_per_record = 8;
+
+// One record under construction.
+// AV Rule 206: fixed storage, no allocation. Fields are stored little-endian
+// whatever the host order, so the output is the same on any host.
+class WireRecord {
+public:
+    explicit WireRecord(Uint8 record_type) : length_(wire_header_size) {
+        bytes_.fill(0);
+        put_at(0, wire_magic, 4);
+        bytes_[4] = wire_version;
+        bytes_[5] = record_type;
+    }
+
+    void put_float64(Float64 value) {
+        Uint64 bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        append(bits, 8);
+    }
+
+    void put_int32(Int32 value) {
+        append(static_cast<Uint32>(value), 4);
+    }
+
+    void put_int64(Int64 value) {
+        append(static_cast<Uint64>(value), 8);
+    }
+
+    void put_bool(bool value) {
+        append(value ? 1u : 0u, 1);
+    }
+
+    // Fill in the payload size and write header + payload
+    void write_to(std::ostream& out) {
+        put_at(6, static_cast<Uint64>(length_ - wire_header_size), 2);
+        out.write(reinterpret_cast<const char*>(bytes_.data()), length_);
+    }
+
+private:
+    // A little-endian host copies the value as is: the byte loop only
+    // becomes one store where the optimizer merges it, which a profiled
+    // build may not do
+    void put_at(Int32 offset, Uint64 value, Int32 byte_count) {
+        if constexpr (std::endian::native == std::endian::little) {
+            std::memcpy(bytes_.data() + offset, &value, static_cast<size_t>(byte_count));
+        } else {
+            for (Int32 i = 0; i < byte_count; ++i) {
+                bytes_[offset + i] = static_cast<Uint8>(value >> (8 * i));
+            }
+        }
+    }
+
+    // Payloads are fixed by the layouts above; a write past the end is a
+    // programming error and is dropped rather than overrunning the array
+    void append(Uint64 value, Int32 byte_count) {
+        if (length_ + byte_count <= wire_header_size + wire_max_payload) {
+            put_at(length_, value, byte_count);
+            length_ += byte_count;
+        }
+    }
+
+    std::array<Uint8, wire_header_size + wire_max_payload> bytes_;
+    Int32 length_;
+};
+
+// Write an error record carrying a calculator exit code
+inline void print_binary_error(std::ostream& out, Int32 code) {
+    WireRecord record(wire_record_error);
+    record.put_int32(code);
+    record.write_to(out);
+}
+
+// Write a timing record: microseconds spent computing a reply
+inline void print_binary_timing(std::ostream& out, Float64 compute_us) {
+    WireRecord record(wire_record_timing);
+    record.put_float64(compute_us);
+    record.write_to(out);
+}
+
+// Write an aircraft frame record: which aircraft, and its frame count
+inline void print_binary_aircraft_frame(std::ostream& out, Int64 aircraft_id, Int64 frame) {
+    WireRecord record(wire_record_aircraft_frame);
+    record.put_int64(aircraft_id);
+    record.put_int64(frame);
+    record.write_to(out);
+}
+
+} // namespace xplane_mfd::calc
+
+#endif // WIRE_FORMAT_H
@@ -0,0 +1,161 @@
+// Work-Stealing Thread Pool for the X-Plane MFD Calculator Daemon
+// JSF AV C++ Coding Standard Compliant Version
+//
+// A fixed set of worker threads, started once, that run a batch of
+// independent tasks and return when every one has finished (fork-join).
+// mfd_calcd hands it one task per aircraft each time it has request lines
+// to answer.
+//
+// run() splits the task indices into one contiguous range per worker. Each
+// worker takes tasks from the front of its own range, and once that is
+// empty steals from the other workers' ranges, so a worker that drew cheap
+// tasks helps with the expensive ones instead of idling. A task is claimed
+// with one fetch_add on the range's cursor, by its owner or a thief alike.
+// The thread calling run() is worker 0 and works too; a pool of one worker
+// runs the tasks inline without any thread.
+//
+// Between batches the workers sleep on a condition variable. run() returns
+// only after every worker has finished with the batch, so the next run()
+// never overlaps the last one.
+//
+// AV Rule 206: the threads and ranges are allocated when the pool is
+// built; run() does not allocate.
+//
+// AV Rule 126: C++ style comments only (//)
+
+#ifndef WORK_POOL_H
+#define WORK_POOL_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "jsf_types.h"
+
+namespace xplane_mfd::calc {
+
+// Pool limits (AV Rule 52: lowercase)
+const Int32 max_pool_workers = 64;
+
+class WorkPool {
+public:
+    typedef void (*TaskFunction)(void* context, Int32 task);
+
+    // worker_count workers including the caller of run(), clamped to
+    // 1..max_pool_workers
+    explicit WorkPool(Int32 worker_count)
+        : workers_(worker_count < 1 ? 1 : (worker_count > max_pool_workers ? max_pool_workers : worker_count)),
+          function_(nullptr), context_(nullptr), generation_(0), active_(0), stopping_(false) {
+        for (Int32 w = 1; w < workers_; ++w) {
+            threads_[w] = std::thread(&WorkPool::worker_main, this, w);
+        }
+    }
+
+    ~WorkPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        start_cv_.notify_all();
+        for (Int32 w = 1; w < workers_; ++w) {
+            threads_[w].join();
+        }
+    }
+
+    WorkPool(const WorkPool&) = delete;
+    WorkPool& operator=(const WorkPool&) = delete;
+
+    Int32 worker_count() const {
+        return workers_;
+    }
+
+    // Run function(context, task) for every task in [0, task_count)
+    void run(TaskFunction function, void* context, Int32 task_count) {
+        for (Int32 w = 0; w < workers_; ++w) {
+            ranges_[w].next.store(task_count * w / workers_, std::memory_order_relaxed);
+            ranges_[w].end = task_count * (w + 1) / workers_;
+        }
+
+        if (workers_ > 1) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                function_ = function;
+                context_ = context;
+                active_ = workers_ - 1;
+                ++generation_;
+            }
+            start_cv_.notify_all();
+        } else {
+            function_ = function;
+            context_ = context;
+        }
+
+        drain(0);
+
+        if (workers_ > 1) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_cv_.wait(lock, [this] { return active_ == 0; });
+        }
+    }
+
+private:
+    // One worker's tasks; cache-line aligned so cursors never share a line
+    struct alignas(64) TaskRange {
+        std::atomic<Int32> next{0};
+        Int32 end = 0;
+    };
+
+    // Own range first, then each other worker's in turn
+    void drain(Int32 worker) {
+        for (Int32 v = 0; v < workers_; ++v) {
+            TaskRange& range = ranges_[(worker + v) % workers_];
+            Int32 task = range.next.fetch_add(1, std::memory_order_relaxed);
+            while (task < range.end) {
+                function_(context_, task);
+                task = range.next.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void worker_main(Int32 worker) {
+        Uint64 seen = 0;
+        bool running = true;
+        while (running) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_cv_.wait(lock, [this, seen] { return stopping_ || generation_ != seen; });
+                running = !stopping_;
+                seen = generation_;
+            }
+            if (running) {
+                drain(worker);
+                bool last = false;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    --active_;
+                    last = active_ == 0;
+                }
+                if (last) {
+                    done_cv_.notify_one();
+                }
+            }
+        }
+    }
+
+    Int32 workers_;
+    std::array<std::thread, max_pool_workers> threads_;
+    std::array<TaskRange, max_pool_workers> ranges_;
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    TaskFunction function_;
+    void* context_;
+    Uint64 generation_;
+    Int32 active_;
+    bool stopping_;
+};
+
+} // namespace xplane_mfd::calc
+
+#endif // WORK_POOL_H
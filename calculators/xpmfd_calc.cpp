@@ -0,0 +1,340 @@
+// X-Plane MFD Calculator Library - C API
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Implementation of the entry points declared in xpmfd_calc.h: each one
+// validates its inputs as the standalone calculator does, runs the kernel
+// and copies the kernel's struct into the caller's (same layout).
+//
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses error codes
+// - AV Rule 209: Fixed-width types (Int32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation, except the flight states and
+//   VNAV predictors the caller creates once (nothrow)
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <ostream>
+#include <streambuf>
+#include "xpmfd_calc.h"
+#include "jsf_types.h"
+#include "flight_kernels.h"
+#include "turn_kernels.h"
+#include "vnav_kernels.h"
+#include "vnav_predictor.h"
+#include "wind_kernels.h"
+#include "wind_estimator.h"
+#include "density_altitude_kernels.h"
+#include "calc_metrics.h"
+
+namespace calc = xplane_mfd::calc;
+
+struct XpmfdFlightState {
+    calc::ResidentFlightState resident;
+};
+
+struct XpmfdVnavPredictor {
+    calc::VnavPredictor predictor;
+};
+
+namespace {
+
+// Input validation (negative wind speed is rejected, as wind_calculator)
+const Float64 wind_calm_threshold = 0.0;
+
+// The C structs mirror the kernel structs byte for byte: same size, and the
+// fields that differ in type (or nest) at the same offsets
+static_assert(sizeof(XpmfdWindData) == sizeof(calc::WindData), "XpmfdWindData layout");
+static_assert(sizeof(XpmfdEnvelopeMargins) == sizeof(calc::EnvelopeMargins), "XpmfdEnvelopeMargins layout");
+static_assert(sizeof(XpmfdEnergyData) == sizeof(calc::EnergyData), "XpmfdEnergyData layout");
+static_assert(offsetof(XpmfdEnergyData, trend) == offsetof(calc::EnergyData, trend), "XpmfdEnergyData layout");
+static_assert(sizeof(XpmfdGlideData) == sizeof(calc::GlideData), "XpmfdGlideData layout");
+static_assert(sizeof(XpmfdFlightInputs) == sizeof(calc::FlightInputs), "XpmfdFlightInputs layout");
+static_assert(offsetof(XpmfdFlightInputs, mmo) == offsetof(calc::FlightInputs, mmo), "XpmfdFlightInputs layout");
+static_assert(sizeof(XpmfdFlightResults) == sizeof(calc::FlightResults), "XpmfdFlightResults layout");
+static_assert(offsetof(XpmfdFlightResults, envelope) == offsetof(calc::FlightResults, envelope), "XpmfdFlightResults layout");
+static_assert(offsetof(XpmfdFlightResults, energy) == offsetof(calc::FlightResults, energy), "XpmfdFlightResults layout");
+static_assert(offsetof(XpmfdFlightResults, glide) == offsetof(calc::FlightResults, glide), "XpmfdFlightResults layout");
+static_assert(sizeof(XpmfdTurnData) == sizeof(calc::TurnData), "XpmfdTurnData layout");
+static_assert(sizeof(XpmfdVnavData) == sizeof(calc::VNAVData), "XpmfdVnavData layout");
+static_assert(offsetof(XpmfdVnavData, is_descent) == offsetof(calc::VNAVData, is_descent), "XpmfdVnavData layout");
+static_assert(sizeof(XpmfdDensityAltitudeData) == sizeof(calc::DensityAltitudeData), "XpmfdDensityAltitudeData layout");
+static_assert(sizeof(XpmfdWindComponents) == sizeof(calc::WindComponents), "XpmfdWindComponents layout");
+static_assert(sizeof(XpmfdWindSample) == sizeof(calc::WindSample), "XpmfdWindSample layout");
+static_assert(sizeof(XpmfdWindEstimate) == sizeof(calc::WindEstimate), "XpmfdWindEstimate layout");
+static_assert(offsetof(XpmfdWindEstimate, sample_count) == offsetof(calc::WindEstimate, sample_count),
+              "XpmfdWindEstimate layout");
+static_assert(sizeof(XpmfdVnavSettings) == sizeof(calc::VnavDescentSettings), "XpmfdVnavSettings layout");
+static_assert(sizeof(XpmfdVnavConstraint) == sizeof(calc::VnavConstraint), "XpmfdVnavConstraint layout");
+static_assert(sizeof(XpmfdVnavWindLayer) == sizeof(calc::VnavWindLayer), "XpmfdVnavWindLayer layout");
+static_assert(sizeof(XpmfdVnavProfileStep) == sizeof(calc::VnavProfileStep), "XpmfdVnavProfileStep layout");
+static_assert(sizeof(XpmfdVnavPrediction) == sizeof(calc::VnavPrediction), "XpmfdVnavPrediction layout");
+static_assert(offsetof(XpmfdVnavPrediction, next_constraint_met) == offsetof(calc::VnavPrediction, next_constraint_met),
+              "XpmfdVnavPrediction layout");
+
+template <typename Out, typename In>
+void copy_out(const In& result, Out* out) {
+    static_assert(sizeof(Out) == sizeof(In), "C API struct layout");
+    std::memcpy(out, &result, sizeof(Out));
+}
+
+// C API calls are counted, not timed
+const Int64 untimed = -1;
+
+// streambuf over the caller's buffer; overflow fails the stream
+class CallerBuffer : public std::streambuf {
+public:
+    CallerBuffer(char* data, Int32 size) {
+        setp(data, data + size);
+    }
+
+    Int32 length() const {
+        return static_cast<Int32>(pptr() - pbase());
+    }
+};
+
+} // namespace
+
+extern "C" {
+
+int32_t xpmfd_calc_version(void) {
+    return xpmfd_calc_api_version;
+}
+
+XpmfdFlightState* xpmfd_flight_state_create(void) {
+    return new (std::nothrow) XpmfdFlightState();
+}
+
+void xpmfd_flight_state_destroy(XpmfdFlightState* state) {
+    delete state;
+}
+
+int32_t xpmfd_calculate_flight(XpmfdFlightState* state, const XpmfdFlightInputs* inputs,
+                               XpmfdFlightResults* out) {
+    int32_t status = xpmfd_ok;
+    if (state == nullptr || inputs == nullptr || out == nullptr) {
+        status = xpmfd_error_invalid_args;
+    } else {
+        calc::FlightInputs in;
+        std::memcpy(&in, inputs, sizeof(in));
+        calc::CacheCounters cache_before = state->resident.results.total_counters();
+        copy_out(calc::calculate_flight_sample(in, state->resident), out);
+        calc::metrics_kernel_call(calc::metric_kernel_flight, untimed);
+        calc::metrics_count_cache(cache_before, state->resident.results.total_counters());
+    }
+    return status;
+}
+
+int32_t xpmfd_estimate_wind(XpmfdFlightState* state, const XpmfdWindSample* sample, XpmfdWindEstimate* out) {
+    int32_t status = xpmfd_ok;
+    if (state == nullptr || sample == nullptr || out == nullptr) {
+        status = xpmfd_error_invalid_args;
+    } else if (sample->tas_kts < 0.0 || sample->gs_kts < 0.0) {
+        status = xpmfd_error_invalid_value;
+        calc::metrics_count(calc::metric_section_errors, 1);
+    } else {
+        calc::metrics_kernel_call(calc::metric_kernel_wind_estimate, untimed);
+        calc::WindSample in;
+        std::memcpy(&in, sample, sizeof(in));
+        calc::ResidentFlightState& resident = state->resident;
+        if (resident.wind_estimator.update(in)) {
+            resident.wind_profile.record(in.altitude_ft, resident.wind_estimator);
+        }
+        copy_out(resident.wind_estimator.estimate(), out);
+    }
+    return status;
+}
+
+int32_t xpmfd_wind_profile_layers(const XpmfdFlightState* state, double track_deg,
+                                  XpmfdVnavWindLayer* layers, int32_t max_layers, int32_t* count) {
+    int32_t status = xpmfd_ok;
+    if (state == nullptr || layers == nullptr || count == nullptr || max_layers < 0) {
+        status = xpmfd_error_invalid_args;
+    } else {
+        *count = state->resident.wind_profile.vnav_layers(track_deg, reinterpret_cast<calc::VnavWindLayer*>(layers),
+                                                          max_layers);
+    }
+    return status;
+}
+
+int32_t xpmfd_calculate_turn(double tas_kts, double bank_deg, double course_change_deg,
+                             XpmfdTurnData* out) {
+    int32_t status = xpmfd_ok;
+    if (out == nullptr) {
+        status = xpmfd_error_invalid_args;
+    } else if (!calc::turn_inputs_valid(tas_kts, bank_deg)) {
+        status = xpmfd_error_invalid_value;
+        calc::metrics_count(calc::metric_section_errors, 1);
+    } else {
+        calc::metrics_kernel_call(calc::metric_kernel_turn, untimed);
+        calc::metrics_count_turn_inputs(bank_deg);
+        copy_out(calc::calculate_turn_performance(tas_kts, bank_deg, course_change_deg), out);
+    }
+    return status;
+}
+
+int32_t xpmfd_calculate_vnav(double current_alt_ft, double target_alt_ft, double distance_nm,
+                             double groundspeed_kts, double current_vs_fpm, XpmfdVnavData* out) {
+    int32_t status = xpmfd_ok;
+    if (out == nullptr) {
+        status = xpmfd_error_invalid_args;
+    } else {
+        calc::metrics_kernel_call(calc::metric_kernel_vnav, untimed);
+        calc::metrics_count_vnav_inputs(distance_nm, groundspeed_kts);
+        copy_out(calc::calculate_vnav(current_alt_ft, target_alt_ft, distance_nm,
+                                      groundspeed_kts, current_vs_fpm), out);
+    }
+    return status;
+}
+
+int32_t xpmfd_calculate_density_altitude(double pressure_altitude_ft, double oat_celsius,
+                                         double ias_kts, double tas_kts,
+                                         XpmfdDensityAltitudeData* out) {
+    int32_t status = xpmfd_ok;
+    if (out == nullptr || !calc::density_altitude_inputs_valid(pressure_altitude_ft, oat_celsius)) {
+        status = xpmfd_error_invalid_args;
+        if (out != nullptr) {
+            calc::metrics_count(calc::metric_section_errors, 1);
+        }
+    } else {
+        calc::metrics_kernel_call(calc::metric_kernel_density, untimed);
+        copy_out(calc::calculate_density_altitude_data(pressure_altitude_ft, oat_celsius,
+                                                       ias_kts, tas_kts), out);
+    }
+    return status;
+}
+
+int32_t xpmfd_calculate_wind(double track, double heading, double wind_dir, double wind_speed,
+                             XpmfdWindComponents* out) {
+    int32_t status = xpmfd_ok;
+    if (out == nullptr) {
+        status = xpmfd_error_invalid_args;
+    } else if (wind_speed < wind_calm_threshold) {
+        status = xpmfd_error_invalid_value;
+    } else {
+        copy_out(calc::calculate_wind(track, heading, wind_dir, wind_speed), out);
+    }
+    return status;
+}
+
+XpmfdVnavPredictor* xpmfd_vnav_predictor_create(void) {
+    return new (std::nothrow) XpmfdVnavPredictor();
+}
+
+void xpmfd_vnav_predictor_destroy(XpmfdVnavPredictor* predictor) {
+    delete predictor;
+}
+
+int32_t xpmfd_vnav_set_settings(XpmfdVnavPredictor* predictor, const XpmfdVnavSettings* settings) {
+    int32_t status = xpmfd_ok;
+    if (predictor == nullptr || settings == nullptr) {
+        status = xpmfd_error_invalid_args;
+    } else {
+        calc::VnavDescentSettings in;
+        std::memcpy(&in, settings, sizeof(in));
+        if (!predictor->predictor.set_settings(in)) {
+            status = xpmfd_error_invalid_args;
+        }
+    }
+    return status;
+}
+
+// The C structs have the kernel layouts (static_asserts above), so the
+// caller's arrays are read in place
+int32_t xpmfd_vnav_set_constraints(XpmfdVnavPredictor* predictor,
+                                   const XpmfdVnavConstraint* constraints, int32_t count) {
+    int32_t status = xpmfd_ok;
+    if (predictor == nullptr
+        || !predictor->predictor.set_constraints(reinterpret_cast<const calc::VnavConstraint*>(constraints),
+                                                 count)) {
+        status = xpmfd_error_invalid_args;
+    }
+    return status;
+}
+
+int32_t xpmfd_vnav_set_wind_layers(XpmfdVnavPredictor* predictor,
+                                   const XpmfdVnavWindLayer* layers, int32_t count) {
+    int32_t status = xpmfd_ok;
+    if (predictor == nullptr
+        || !predictor->predictor.set_wind_layers(reinterpret_cast<const calc::VnavWindLayer*>(layers),
+                                                 count)) {
+        status = xpmfd_error_invalid_args;
+    }
+    return status;
+}
+
+int32_t xpmfd_vnav_set_wind_profile(XpmfdVnavPredictor* predictor, const XpmfdFlightState* state,
+                                    double track_deg) {
+    int32_t status = xpmfd_ok;
+    if (predictor == nullptr || state == nullptr
+        || !predictor->predictor.set_wind_profile(state->resident.wind_profile, track_deg)) {
+        status = xpmfd_error_invalid_args;
+    }
+    return status;
+}
+
+int32_t xpmfd_vnav_advance(XpmfdVnavPredictor* predictor, int32_t max_steps, XpmfdVnavProgress* out) {
+    int32_t status = xpmfd_ok;
+    if (predictor == nullptr || out == nullptr || max_steps < 0) {
+        status = xpmfd_error_invalid_args;
+    } else {
+        out->steps_done = predictor->predictor.advance(max_steps);
+        out->step_count = predictor->predictor.step_count();
+        out->complete = predictor->predictor.complete();
+        out->truncated = predictor->predictor.truncated();
+    }
+    return status;
+}
+
+int32_t xpmfd_vnav_profile_step(const XpmfdVnavPredictor* predictor, int32_t index,
+                                XpmfdVnavProfileStep* out) {
+    int32_t status = xpmfd_ok;
+    if (predictor == nullptr || out == nullptr || index < 0 || index >= predictor->predictor.step_count()) {
+        status = xpmfd_error_invalid_args;
+    } else {
+        copy_out(predictor->predictor.step(index), out);
+    }
+    return status;
+}
+
+int32_t xpmfd_vnav_predict(const XpmfdVnavPredictor* predictor, double distance_nm,
+                           double altitude_ft, XpmfdVnavPrediction* out) {
+    int32_t status = xpmfd_ok;
+    calc::VnavPrediction prediction;
+    if (predictor == nullptr || out == nullptr) {
+        status = xpmfd_error_invalid_args;
+    } else if (!predictor->predictor.predict(distance_nm, altitude_ft, prediction)) {
+        status = xpmfd_pending;
+    } else {
+        copy_out(prediction, out);
+    }
+    return status;
+}
+
+int32_t xpmfd_metrics_text(int32_t format, char* buffer, int32_t capacity, int32_t* length) {
+    int32_t status = xpmfd_ok;
+    if (buffer == nullptr || length == nullptr || capacity < 0 ||
+        (format != xpmfd_metrics_json && format != xpmfd_metrics_prometheus)) {
+        status = xpmfd_error_invalid_args;
+    } else {
+        calc::MetricsSnapshot snapshot;
+        calc::metrics_snapshot(snapshot);
+        CallerBuffer text(buffer, capacity);
+        std::ostream out(&text);
+        if (format == xpmfd_metrics_json) {
+            calc::print_json(out, snapshot);
+        } else {
+            calc::print_prometheus(out, snapshot);
+        }
+        *length = text.length();
+        if (!out) {
+            status = xpmfd_error_invalid_args;
+        }
+    }
+    return status;
+}
+
+} // extern "C"
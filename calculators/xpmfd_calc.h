@@ -0,0 +1,308 @@
+// X-Plane MFD Calculator Library - C API
+// JSF AV C++ Coding Standard Compliant Version
+//
+// Stable extern "C" entry points into the calculator kernels, built as
+// libxpmfd_calc.a and libxpmfd_calc.so, for callers that want the maths
+// in their own process: the MFD through ctypes, an X-Plane plugin, or any
+// C or C++ program. The standalone calculators and mfd_calcd link the same
+// library.
+//
+// The structs below are C declarations of the kernels' result and input
+// structs (flight_kernels.h, turn_kernels.h, vnav_kernels.h,
+// vnav_predictor.h, wind_kernels.h, wind_estimator.h,
+// density_altitude_kernels.h) with the same field order and layout;
+// xpmfd_calc.cpp checks each one with static_asserts. Fields are
+// documented in those headers.
+//
+// Every calculate function returns a status code and writes its result
+// only when it returns xpmfd_ok. The codes are the exit codes of the
+// matching standalone calculator. The flight state keeps an IAS history,
+// a result cache and the filtered wind between samples, and the VNAV
+// predictor its descent profile, so both take a handle; other functions
+// hold no state and may be called from any thread. One handle must not be
+// used from two threads at once.
+//
+// Adding a function or a struct field bumps xpmfd_calc_api_version; an
+// existing signature or layout never changes.
+//
+// AV Rule 126: C++ style comments only (//)
+
+#ifndef XPMFD_CALC_H
+#define XPMFD_CALC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Status codes
+enum XpmfdStatus {
+    xpmfd_ok = 0,
+    xpmfd_error_invalid_args = 1,   // null pointer, or inputs outside the validated range
+    xpmfd_error_invalid_value = 3,  // rejected input (negative wind speed, bank outside 0-90)
+    xpmfd_pending = 4               // VNAV profile does not reach the aircraft yet; advance it
+};
+
+enum { xpmfd_calc_api_version = 4 };
+
+// Text formats of xpmfd_metrics_text
+enum XpmfdMetricsFormat {
+    xpmfd_metrics_json = 0,       // one line, as mfd_calcd's "metrics" reply
+    xpmfd_metrics_prometheus = 1  // Prometheus text exposition format
+};
+
+typedef struct XpmfdWindData {
+    double speed_kts;
+    double direction_from;
+    double headwind;
+    double crosswind;
+    double gust_factor;
+} XpmfdWindData;
+
+typedef struct XpmfdEnvelopeMargins {
+    double stall_margin_pct;
+    double vmo_margin_pct;
+    double mmo_margin_pct;
+    double min_margin_pct;
+    double load_factor;
+    double corner_speed_kts;
+} XpmfdEnvelopeMargins;
+
+typedef struct XpmfdEnergyData {
+    double specific_energy_ft;
+    double energy_rate_kts;
+    int32_t trend;
+} XpmfdEnergyData;
+
+typedef struct XpmfdGlideData {
+    double still_air_range_nm;
+    double wind_adjusted_range_nm;
+    double glide_ratio;
+    double best_glide_speed_kts;
+} XpmfdGlideData;
+
+typedef struct XpmfdFlightInputs {
+    double tas_kts;
+    double gs_kts;
+    double heading;
+    double track;
+    double ias_kts;
+    double mach;
+    double altitude_ft;
+    double agl_ft;
+    double vs_fpm;
+    double weight_kg;
+    double bank_deg;
+    double vso_kts;
+    double vne_kts;
+    double mmo;
+} XpmfdFlightInputs;
+
+typedef struct XpmfdFlightResults {
+    XpmfdWindData wind;
+    XpmfdEnvelopeMargins envelope;
+    XpmfdEnergyData energy;
+    XpmfdGlideData glide;
+} XpmfdFlightResults;
+
+typedef struct XpmfdTurnData {
+    double radius_nm;
+    double radius_ft;
+    double turn_rate_dps;
+    double lead_distance_nm;
+    double lead_distance_ft;
+    double time_to_turn_sec;
+    double load_factor;
+    double standard_rate_bank;
+} XpmfdTurnData;
+
+typedef struct XpmfdVnavData {
+    double altitude_to_lose_ft;
+    double flight_path_angle_deg;
+    double required_vs_fpm;
+    double tod_distance_nm;
+    double time_to_constraint_min;
+    double distance_per_1000ft;
+    double vs_for_3deg;
+    bool is_descent;
+} XpmfdVnavData;
+
+typedef struct XpmfdDensityAltitudeData {
+    double density_altitude_ft;
+    double pressure_altitude_ft;
+    double air_density_ratio;
+    double temperature_deviation_c;
+    double performance_loss_pct;
+    double eas_kts;
+    double tas_to_ias_ratio;
+    double pressure_ratio;
+} XpmfdDensityAltitudeData;
+
+typedef struct XpmfdWindComponents {
+    double headwind;
+    double crosswind;
+    double total_wind;
+    double wca;
+    double drift;
+} XpmfdWindComponents;
+
+typedef struct XpmfdWindSample {
+    double time_s;
+    double altitude_ft;
+    double tas_kts;
+    double gs_kts;
+    double heading;
+    double track;
+} XpmfdWindSample;
+
+typedef struct XpmfdWindEstimate {
+    double speed_kts;
+    double direction_from;
+    double headwind;
+    double crosswind;
+    double uncertainty_kts;
+    double confidence;
+    int64_t sample_count;
+} XpmfdWindEstimate;
+
+typedef struct XpmfdVnavSettings {
+    double cruise_alt_ft;
+    double runway_elevation_ft;
+    double descent_mach;
+    double descent_ias_kts;
+    double speed_limit_ias_kts;
+    double speed_limit_alt_ft;
+    double descent_vs_fpm;
+    double final_approach_fpa_deg;
+    double final_approach_fix_nm;
+    double isa_deviation_c;
+} XpmfdVnavSettings;
+
+typedef struct XpmfdVnavConstraint {
+    double distance_nm;
+    double max_alt_ft;
+    double min_alt_ft;
+} XpmfdVnavConstraint;
+
+typedef struct XpmfdVnavWindLayer {
+    double altitude_ft;
+    double headwind_kts;
+} XpmfdVnavWindLayer;
+
+typedef struct XpmfdVnavProfileStep {
+    double distance_nm;
+    double altitude_ft;
+    double time_s;
+    double gs_kts;
+} XpmfdVnavProfileStep;
+
+typedef struct XpmfdVnavPrediction {
+    double path_altitude_ft;
+    double vertical_deviation_ft;
+    double tod_distance_nm;
+    double required_vs_fpm;
+    double gs_kts;
+    double time_to_runway_min;
+    double time_to_next_constraint_min;
+    double next_constraint_alt_ft;
+    int32_t next_constraint;
+    bool next_constraint_met;
+} XpmfdVnavPrediction;
+
+// Where xpmfd_vnav_advance left the profile
+typedef struct XpmfdVnavProgress {
+    int32_t steps_done;     // Steps integrated by this call
+    int32_t step_count;     // Up-to-date steps
+    bool complete;
+    bool truncated;
+} XpmfdVnavProgress;
+
+// Resident flight state: IAS history, result cache, wind estimator and
+// wind profile (opaque)
+typedef struct XpmfdFlightState XpmfdFlightState;
+
+// VNAV trajectory predictor: inputs and descent profile (opaque)
+typedef struct XpmfdVnavPredictor XpmfdVnavPredictor;
+
+// xpmfd_calc_api_version of the loaded library
+int32_t xpmfd_calc_version(void);
+
+// Allocate a flight state; null if out of memory. Release it with
+// xpmfd_flight_state_destroy.
+XpmfdFlightState* xpmfd_flight_state_create(void);
+void xpmfd_flight_state_destroy(XpmfdFlightState* state);
+
+// One flight sample, as flight_calculator --serve / the mfd_calcd flight section
+int32_t xpmfd_calculate_flight(XpmfdFlightState* state, const XpmfdFlightInputs* inputs,
+                               XpmfdFlightResults* out);
+
+// One sample into the state's wind estimator and wind profile, as the
+// mfd_calcd wind_estimate section; out is the smoothed wind after it
+// (sample_count grows only if the sample was fused).
+// xpmfd_error_invalid_value for a negative TAS or groundspeed.
+int32_t xpmfd_estimate_wind(XpmfdFlightState* state, const XpmfdWindSample* sample, XpmfdWindEstimate* out);
+
+// The state's wind profile as up to max_layers VNAV wind layers for a
+// descent on track_deg (count written to *count), for
+// xpmfd_vnav_set_wind_layers
+int32_t xpmfd_wind_profile_layers(const XpmfdFlightState* state, double track_deg,
+                                  XpmfdVnavWindLayer* layers, int32_t max_layers, int32_t* count);
+
+int32_t xpmfd_calculate_turn(double tas_kts, double bank_deg, double course_change_deg,
+                             XpmfdTurnData* out);
+
+int32_t xpmfd_calculate_vnav(double current_alt_ft, double target_alt_ft, double distance_nm,
+                             double groundspeed_kts, double current_vs_fpm, XpmfdVnavData* out);
+
+int32_t xpmfd_calculate_density_altitude(double pressure_altitude_ft, double oat_celsius,
+                                         double ias_kts, double tas_kts,
+                                         XpmfdDensityAltitudeData* out);
+
+int32_t xpmfd_calculate_wind(double track, double heading, double wind_dir, double wind_speed,
+                             XpmfdWindComponents* out);
+
+// Allocate a VNAV predictor (no inputs, empty profile); null if out of
+// memory. Release it with xpmfd_vnav_predictor_destroy.
+XpmfdVnavPredictor* xpmfd_vnav_predictor_create(void);
+void xpmfd_vnav_predictor_destroy(XpmfdVnavPredictor* predictor);
+
+// Inputs, as VnavPredictor (vnav_predictor.h); each invalidates only the
+// steps it changes. xpmfd_error_invalid_args leaves the old inputs.
+int32_t xpmfd_vnav_set_settings(XpmfdVnavPredictor* predictor, const XpmfdVnavSettings* settings);
+int32_t xpmfd_vnav_set_constraints(XpmfdVnavPredictor* predictor,
+                                   const XpmfdVnavConstraint* constraints, int32_t count);
+int32_t xpmfd_vnav_set_wind_layers(XpmfdVnavPredictor* predictor,
+                                   const XpmfdVnavWindLayer* layers, int32_t count);
+
+// Wind layers straight from a flight state's wind profile
+// (xpmfd_wind_profile_layers with the predictor's maximum of 8)
+int32_t xpmfd_vnav_set_wind_profile(XpmfdVnavPredictor* predictor, const XpmfdFlightState* state,
+                                    double track_deg);
+
+// Integrate up to max_steps invalidated steps (call once per display frame)
+int32_t xpmfd_vnav_advance(XpmfdVnavPredictor* predictor, int32_t max_steps, XpmfdVnavProgress* out);
+
+// Profile step index (0 = threshold) of the up-to-date steps
+int32_t xpmfd_vnav_profile_step(const XpmfdVnavPredictor* predictor, int32_t index,
+                                XpmfdVnavProfileStep* out);
+
+// The aircraft on the profile; xpmfd_pending until the up-to-date steps
+// reach distance_nm
+int32_t xpmfd_vnav_predict(const XpmfdVnavPredictor* predictor, double distance_nm,
+                           double altitude_ft, XpmfdVnavPrediction* out);
+
+// The process's calculator metrics (calc_metrics.h), summed over its
+// threads: the flight, turn, VNAV, density and wind estimate calls above
+// are counted (not timed: the caller times its own frame) with their
+// rejected inputs, result cache hits and degenerate-input branches. Writes
+// the text to buffer without a terminator and its size to *length;
+// xpmfd_error_invalid_args if it needs more than capacity bytes.
+int32_t xpmfd_metrics_text(int32_t format, char* buffer, int32_t capacity, int32_t* length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // XPMFD_CALC_H
@@ -0,0 +1,382 @@
+// X-Plane MFD Calculator Plugin
+// JSF AV C++ Coding Standard Compliant Version
+//
+// The calculator kernels as an XPLM plugin: a flight-loop callback reads
+// the aircraft datarefs straight from the sim after each flight model
+// step, runs the flight, turn, VNAV and density altitude calculations
+// through libxpmfd_calc (xpmfd_calc.h), and publishes the results as
+// read-only custom datarefs. The derived values are fresh every sim frame
+// with no HTTP, process or socket hop; anything that reads datarefs (the
+// web API, DataRefEditor, another plugin) sees them.
+//
+// Published datarefs (double, also readable as float; int where noted):
+//
+//   xpmfd/wind/*       speed_kts direction_from headwind crosswind gust_factor
+//   xpmfd/envelope/*   stall_margin_pct vmo_margin_pct mmo_margin_pct
+//                      min_margin_pct load_factor corner_speed_kts
+//   xpmfd/energy/*     specific_energy_ft energy_rate_kts trend (int)
+//   xpmfd/glide/*      still_air_range_nm wind_adjusted_range_nm glide_ratio
+//                      best_glide_speed_kts
+//   xpmfd/turn/*       radius_nm turn_rate_dps lead_distance_nm
+//                      time_to_turn_sec load_factor standard_rate_bank
+//   xpmfd/vnav/*       required_vs_fpm flight_path_angle_deg tod_distance_nm
+//                      time_to_constraint_min vs_for_3deg
+//   xpmfd/density/*    density_altitude_ft air_density_ratio
+//                      temperature_deviation_c performance_loss_pct eas_kts
+//   xpmfd/status/*     flight turn vnav density (int): the section's
+//                      xpmfd_calc status; its datarefs keep their last good
+//                      values while it is non-zero
+//   xpmfd/compute_us   time spent in the kernels on the last frame
+//
+// The turn and VNAV references are the MFD's: a 90 degree turn at the
+// current bank, and a descent to 10000 ft over 100 NM.
+//
+// Build: make plugin XPLM_SDK=/path/to/SDK (installs as xpmfd/64/lin.xpl,
+// or mac.xpl on macOS; copy the xpmfd folder into Resources/plugins)
+//
+// JSF Compliance:
+// - AV Rule 208: No exceptions (throw/catch/try) - uses status codes
+// - AV Rule 209: Fixed-width types (Int32, Float32, Float64) via jsf_types.h
+// - AV Rule 206: No dynamic memory allocation after XPluginEnable (the
+//   flight state is created once there)
+// - AV Rule 119: No recursion
+// - AV Rule 52: Constants in lowercase
+// - AV Rule 126: C++ style comments only (//)
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include "XPLMDataAccess.h"
+#include "XPLMPlugin.h"
+#include "XPLMProcessing.h"
+#include "jsf_types.h"
+#include "units.h"
+#include "xpmfd_calc.h"
+
+namespace calc = xplane_mfd::calc;
+
+namespace {
+
+const char* const plugin_name = "X-Plane MFD Calculators";
+const char* const plugin_signature = "harryz8.xplane_mfd.calculators";
+const char* const plugin_description = "Wind, envelope, energy, glide, turn, VNAV and density altitude every sim frame";
+
+// Reference values the MFD uses for its turn and VNAV panels
+const Float64 turn_reference_course_change_deg = 90.0;
+const Float64 vnav_target_alt_ft = 10000.0;
+const Float64 vnav_reference_distance_nm = 100.0;
+
+// DataRefEditor picks up custom datarefs announced with this message
+const char* const dataref_editor_signature = "xplanesdk.examples.DataRefEditor";
+const Int32 dataref_editor_register_message = 0x01000000;
+
+// Run the callback every flight loop (a negative interval counts loops)
+const Float32 every_flight_loop = -1.0F;
+
+// Sim datarefs, found once at enable
+struct SimDatarefs {
+    XPLMDataRef true_airspeed;      // m/s
+    XPLMDataRef groundspeed;        // m/s
+    XPLMDataRef heading;            // psi, deg true
+    XPLMDataRef track;              // hpath, deg true
+    XPLMDataRef ias_pilot;          // kts
+    XPLMDataRef ias_raw;            // kts (fallback when the gauge is absent)
+    XPLMDataRef mach;
+    XPLMDataRef elevation;          // m MSL
+    XPLMDataRef agl;                // m
+    XPLMDataRef pressure_altitude;  // ft
+    XPLMDataRef vs_fpm;
+    XPLMDataRef weight_kg;
+    XPLMDataRef bank;               // phi, deg
+    XPLMDataRef vso_kts;
+    XPLMDataRef vne_kts;
+    XPLMDataRef mmo;
+    XPLMDataRef oat_c;
+};
+
+// Latest results, read by the dataref accessors
+struct PublishedResults {
+    XpmfdFlightResults flight;
+    XpmfdTurnData turn;
+    XpmfdVnavData vnav;
+    XpmfdDensityAltitudeData density;
+    Int32 flight_status;
+    Int32 turn_status;
+    Int32 vnav_status;
+    Int32 density_status;
+    Float64 compute_us;
+};
+
+struct DoubleDataref {
+    const char* name;
+    const Float64* value;
+};
+
+struct IntDataref {
+    const char* name;
+    const Int32* value;
+};
+
+SimDatarefs sim = {};
+PublishedResults results = {};
+XpmfdFlightState* flight_state = nullptr;
+XPLMFlightLoopID flight_loop = nullptr;
+
+const DoubleDataref double_datarefs[] = {
+    {"xpmfd/wind/speed_kts", &results.flight.wind.speed_kts},
+    {"xpmfd/wind/direction_from", &results.flight.wind.direction_from},
+    {"xpmfd/wind/headwind", &results.flight.wind.headwind},
+    {"xpmfd/wind/crosswind", &results.flight.wind.crosswind},
+    {"xpmfd/wind/gust_factor", &results.flight.wind.gust_factor},
+    {"xpmfd/envelope/stall_margin_pct", &results.flight.envelope.stall_margin_pct},
+    {"xpmfd/envelope/vmo_margin_pct", &results.flight.envelope.vmo_margin_pct},
+    {"xpmfd/envelope/mmo_margin_pct", &results.flight.envelope.mmo_margin_pct},
+    {"xpmfd/envelope/min_margin_pct", &results.flight.envelope.min_margin_pct},
+    {"xpmfd/envelope/load_factor", &results.flight.envelope.load_factor},
+    {"xpmfd/envelope/corner_speed_kts", &results.flight.envelope.corner_speed_kts},
+    {"xpmfd/energy/specific_energy_ft", &results.flight.energy.specific_energy_ft},
+    {"xpmfd/energy/energy_rate_kts", &results.flight.energy.energy_rate_kts},
+    {"xpmfd/glide/still_air_range_nm", &results.flight.glide.still_air_range_nm},
+    {"xpmfd/glide/wind_adjusted_range_nm", &results.flight.glide.wind_adjusted_range_nm},
+    {"xpmfd/glide/glide_ratio", &results.flight.glide.glide_ratio},
+    {"xpmfd/glide/best_glide_speed_kts", &results.flight.glide.best_glide_speed_kts},
+    {"xpmfd/turn/radius_nm", &results.turn.radius_nm},
+    {"xpmfd/turn/turn_rate_dps", &results.turn.turn_rate_dps},
+    {"xpmfd/turn/lead_distance_nm", &results.turn.lead_distance_nm},
+    {"xpmfd/turn/time_to_turn_sec", &results.turn.time_to_turn_sec},
+    {"xpmfd/turn/load_factor", &results.turn.load_factor},
+    {"xpmfd/turn/standard_rate_bank", &results.turn.standard_rate_bank},
+    {"xpmfd/vnav/required_vs_fpm", &results.vnav.required_vs_fpm},
+    {"xpmfd/vnav/flight_path_angle_deg", &results.vnav.flight_path_angle_deg},
+    {"xpmfd/vnav/tod_distance_nm", &results.vnav.tod_distance_nm},
+    {"xpmfd/vnav/time_to_constraint_min", &results.vnav.time_to_constraint_min},
+    {"xpmfd/vnav/vs_for_3deg", &results.vnav.vs_for_3deg},
+    {"xpmfd/density/density_altitude_ft", &results.density.density_altitude_ft},
+    {"xpmfd/density/air_density_ratio", &results.density.air_density_ratio},
+    {"xpmfd/density/temperature_deviation_c", &results.density.temperature_deviation_c},
+    {"xpmfd/density/performance_loss_pct", &results.density.performance_loss_pct},
+    {"xpmfd/density/eas_kts", &results.density.eas_kts},
+    {"xpmfd/compute_us", &results.compute_us},
+};
+
+const IntDataref int_datarefs[] = {
+    {"xpmfd/energy/trend", &results.flight.energy.trend},
+    {"xpmfd/status/flight", &results.flight_status},
+    {"xpmfd/status/turn", &results.turn_status},
+    {"xpmfd/status/vnav", &results.vnav_status},
+    {"xpmfd/status/density", &results.density_status},
+};
+
+const std::size_t double_dataref_count = sizeof(double_datarefs) / sizeof(double_datarefs[0]);
+const std::size_t int_dataref_count = sizeof(int_datarefs) / sizeof(int_datarefs[0]);
+
+XPLMDataRef registered_doubles[double_dataref_count] = {};
+XPLMDataRef registered_ints[int_dataref_count] = {};
+
+// Accessors: the refcon is the published field
+Float64 read_double(void* refcon) {
+    return *static_cast<const Float64*>(refcon);
+}
+
+Float32 read_float(void* refcon) {
+    return static_cast<Float32>(*static_cast<const Float64*>(refcon));
+}
+
+Int32 read_int(void* refcon) {
+    return *static_cast<const Int32*>(refcon);
+}
+
+XPLMDataRef register_double(const DoubleDataref& dataref) {
+    void* refcon = const_cast<Float64*>(dataref.value);
+    return XPLMRegisterDataAccessor(dataref.name, xplmType_Float | xplmType_Double, 0,
+                                    nullptr, nullptr, read_float, nullptr, read_double, nullptr,
+                                    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+                                    refcon, nullptr);
+}
+
+XPLMDataRef register_int(const IntDataref& dataref) {
+    void* refcon = const_cast<Int32*>(dataref.value);
+    return XPLMRegisterDataAccessor(dataref.name, xplmType_Int, 0,
+                                    read_int, nullptr, nullptr, nullptr, nullptr, nullptr,
+                                    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+                                    refcon, nullptr);
+}
+
+void find_sim_datarefs() {
+    sim.true_airspeed = XPLMFindDataRef("sim/flightmodel/position/true_airspeed");
+    sim.groundspeed = XPLMFindDataRef("sim/flightmodel/position/groundspeed");
+    sim.heading = XPLMFindDataRef("sim/flightmodel/position/psi");
+    sim.track = XPLMFindDataRef("sim/flightmodel/position/hpath");
+    sim.ias_pilot = XPLMFindDataRef("sim/cockpit2/gauges/indicators/airspeed_kts_pilot");
+    sim.ias_raw = XPLMFindDataRef("sim/flightmodel/position/indicated_airspeed");
+    sim.mach = XPLMFindDataRef("sim/flightmodel/misc/machno");
+    sim.elevation = XPLMFindDataRef("sim/flightmodel/position/elevation");
+    sim.agl = XPLMFindDataRef("sim/flightmodel/position/y_agl");
+    sim.pressure_altitude = XPLMFindDataRef("sim/flightmodel2/position/pressure_altitude");
+    sim.vs_fpm = XPLMFindDataRef("sim/cockpit2/gauges/indicators/vvi_fpm_pilot");
+    sim.weight_kg = XPLMFindDataRef("sim/flightmodel/weight/m_total");
+    sim.bank = XPLMFindDataRef("sim/flightmodel/position/phi");
+    sim.vso_kts = XPLMFindDataRef("sim/aircraft/view/acf_Vso");
+    sim.vne_kts = XPLMFindDataRef("sim/aircraft/view/acf_Vne");
+    sim.mmo = XPLMFindDataRef("sim/aircraft/view/acf_Mmo");
+    sim.oat_c = XPLMFindDataRef("sim/cockpit2/temperature/outside_air_temp_degc");
+}
+
+// A float dataref as Float64 (0 if the sim doesn't have it)
+Float64 read_sim(XPLMDataRef dataref) {
+    Float64 value = 0.0;
+    if (dataref != nullptr) {
+        value = static_cast<Float64>(XPLMGetDataf(dataref));
+    }
+    return value;
+}
+
+// Read one frame of inputs and recompute every section
+void compute_frame() {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    XpmfdFlightInputs inputs;
+    inputs.tas_kts = calc::convert<calc::MetersPerSecond, calc::Knots>(read_sim(sim.true_airspeed));
+    inputs.gs_kts = calc::convert<calc::MetersPerSecond, calc::Knots>(read_sim(sim.groundspeed));
+    inputs.heading = read_sim(sim.heading);
+    inputs.track = read_sim(sim.track);
+    inputs.ias_kts = read_sim(sim.ias_pilot != nullptr ? sim.ias_pilot : sim.ias_raw);
+    inputs.mach = read_sim(sim.mach);
+    inputs.altitude_ft = 0.0;
+    if (sim.elevation != nullptr) {
+        inputs.altitude_ft = calc::convert<calc::Meters, calc::Feet>(XPLMGetDatad(sim.elevation));
+    }
+    inputs.agl_ft = calc::convert<calc::Meters, calc::Feet>(read_sim(sim.agl));
+    inputs.vs_fpm = read_sim(sim.vs_fpm);
+    inputs.weight_kg = read_sim(sim.weight_kg);
+    inputs.bank_deg = read_sim(sim.bank);
+    inputs.vso_kts = read_sim(sim.vso_kts);
+    inputs.vne_kts = read_sim(sim.vne_kts);
+    inputs.mmo = read_sim(sim.mmo);
+
+    // Density altitude needs pressure altitude; without the dataref
+    // (X-Plane 10) the MSL altitude stands in, as in the MFD
+    Float64 pressure_altitude_ft = inputs.altitude_ft;
+    if (sim.pressure_altitude != nullptr) {
+        pressure_altitude_ft = read_sim(sim.pressure_altitude);
+    }
+    Float64 bank_deg = inputs.bank_deg < 0.0 ? -inputs.bank_deg : inputs.bank_deg;
+
+    // Results are computed into locals and published only on success, so
+    // a rejected frame leaves the last good values in place
+    XpmfdFlightResults flight;
+    results.flight_status = xpmfd_calculate_flight(flight_state, &inputs, &flight);
+    if (results.flight_status == xpmfd_ok) {
+        results.flight = flight;
+    }
+
+    XpmfdTurnData turn;
+    results.turn_status = xpmfd_calculate_turn(inputs.tas_kts, bank_deg,
+                                               turn_reference_course_change_deg, &turn);
+    if (results.turn_status == xpmfd_ok) {
+        results.turn = turn;
+    }
+
+    XpmfdVnavData vnav;
+    results.vnav_status = xpmfd_calculate_vnav(inputs.altitude_ft, vnav_target_alt_ft,
+                                               vnav_reference_distance_nm, inputs.gs_kts,
+                                               inputs.vs_fpm, &vnav);
+    if (results.vnav_status == xpmfd_ok) {
+        results.vnav = vnav;
+    }
+
+    XpmfdDensityAltitudeData density;
+    results.density_status = xpmfd_calculate_density_altitude(pressure_altitude_ft, read_sim(sim.oat_c),
+                                                              inputs.ias_kts, inputs.tas_kts, &density);
+    if (results.density_status == xpmfd_ok) {
+        results.density = density;
+    }
+
+    std::chrono::duration<Float64, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    results.compute_us = elapsed.count();
+}
+
+Float32 flight_loop_callback(Float32 elapsed_since_last_call, Float32 elapsed_since_last_loop,
+                             Int32 counter, void* refcon) {
+    (void)elapsed_since_last_call;
+    (void)elapsed_since_last_loop;
+    (void)counter;
+    (void)refcon;
+    compute_frame();
+    return every_flight_loop;
+}
+
+} // namespace
+
+PLUGIN_API int XPluginStart(char* out_name, char* out_signature, char* out_description) {
+    // The SDK gives each buffer 256 bytes; the strings above are shorter
+    std::strcpy(out_name, plugin_name);
+    std::strcpy(out_signature, plugin_signature);
+    std::strcpy(out_description, plugin_description);
+    return 1;
+}
+
+PLUGIN_API void XPluginStop(void) {
+}
+
+PLUGIN_API int XPluginEnable(void) {
+    int enabled = 0;
+    if (xpmfd_calc_version() == xpmfd_calc_api_version) {
+        flight_state = xpmfd_flight_state_create();
+    }
+    if (flight_state != nullptr) {
+        find_sim_datarefs();
+        for (std::size_t i = 0; i < double_dataref_count; ++i) {
+            registered_doubles[i] = register_double(double_datarefs[i]);
+        }
+        for (std::size_t i = 0; i < int_dataref_count; ++i) {
+            registered_ints[i] = register_int(int_datarefs[i]);
+        }
+
+        XPLMCreateFlightLoop_t loop = {};
+        loop.structSize = sizeof(loop);
+        loop.phase = xplm_FlightLoop_Phase_AfterFlightModel;
+        loop.callbackFunc = flight_loop_callback;
+        loop.refcon = nullptr;
+        flight_loop = XPLMCreateFlightLoop(&loop);
+        XPLMScheduleFlightLoop(flight_loop, every_flight_loop, 1);
+        enabled = 1;
+    }
+    return enabled;
+}
+
+PLUGIN_API void XPluginDisable(void) {
+    if (flight_loop != nullptr) {
+        XPLMDestroyFlightLoop(flight_loop);
+        flight_loop = nullptr;
+    }
+    for (std::size_t i = 0; i < double_dataref_count; ++i) {
+        XPLMUnregisterDataAccessor(registered_doubles[i]);
+        registered_doubles[i] = nullptr;
+    }
+    for (std::size_t i = 0; i < int_dataref_count; ++i) {
+        XPLMUnregisterDataAccessor(registered_ints[i]);
+        registered_ints[i] = nullptr;
+    }
+    xpmfd_flight_state_destroy(flight_state);
+    flight_state = nullptr;
+}
+
+PLUGIN_API void XPluginReceiveMessage(XPLMPluginID from, int message, void* param) {
+    (void)from;
+    // Once the user's aircraft (plane 0) is loaded every plugin is up:
+    // announce the datarefs to DataRefEditor
+    if (message == XPLM_MSG_PLANE_LOADED && param == nullptr) {
+        XPLMPluginID editor = XPLMFindPluginBySignature(dataref_editor_signature);
+        if (editor != XPLM_NO_PLUGIN_ID) {
+            for (std::size_t i = 0; i < double_dataref_count; ++i) {
+                XPLMSendMessageToPlugin(editor, dataref_editor_register_message,
+                                        const_cast<char*>(double_datarefs[i].name));
+            }
+            for (std::size_t i = 0; i < int_dataref_count; ++i) {
+                XPLMSendMessageToPlugin(editor, dataref_editor_register_message,
+                                        const_cast<char*>(int_datarefs[i].name));
+            }
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#!/bin/bash
+# Train the release build's profiles (make release)
+#
+# Runs the instrumented programs in <dir> on the replay harness, each run
+# adding its counts to the .gcda profiles there:
+#   1. calc_loadgen flies a synthetic flight through mfd_calcd, from
+#      several clients on its socket and one on its shared-memory channel,
+#      then once more as dynamic sections, which take their limits and
+#      glide L/D from the daemon's aircraft profile. Both are flown again
+#      with binary replies, each sample held for several frames as a
+#      display refreshing faster than its data, so the resident caches
+#      hit as they do in flight. mfd_calcd records every section it
+#      computes to train.log.
+#   2. That recording and any other flight logs given are replayed in
+#      process through the C API, and kernel by kernel through calc_batch;
+#      the synthetic flight is also held in process.
+# calc_bench is left out, so the benchmarks measure the build rather than
+# what it was trained on.
+#
+# Usage: ./pgo_train.sh <dir> [<flight log> ...]
+#        TRAIN_FRAMES=<n> sets the frames per client (default 5000)
+#        TRAIN_PROFILE=<path> sets the aircraft profile (aircraft_profile.h;
+#        default: a generated 16-point airliner curve)
+
+set -e
+
+cd "$1"
+shift
+frames=${TRAIN_FRAMES:-5000}
+profile=${TRAIN_PROFILE:-train.xpap}
+
+rm -f train.sock train.shm train.log
+if [ -z "$TRAIN_PROFILE" ]; then
+    # L/D peaking at 17 near 240 kts, with the synthetic flight's limits
+    python3 -c '
+import struct
+points = [(120.0 + 15.0 * i, 17.0 - 0.04 * (i - 8) ** 2) for i in range(16)]
+header = struct.pack("<IIii3d", 0x50415058, 1, len(points), 0, 120.0, 340.0, 0.82)
+with open("train.xpap", "wb") as f:
+    f.write(header + b"".join(struct.pack("<2d", *point) for point in points))
+'
+fi
+./mfd_calcd --socket train.sock --shm train.shm --profile "$profile" --record train.log &
+daemon=$!
+trap 'kill $daemon 2>/dev/null || true' EXIT
+for _ in $(seq 50); do
+    [ -S train.sock ] && [ -e train.shm ] && break
+    sleep 0.1
+done
+./calc_loadgen --socket train.sock --clients 4 --frames "$frames" > /dev/null
+./calc_loadgen --shm train.shm --frames "$frames" > /dev/null
+./calc_loadgen --socket train.sock --dynamic --clients 4 --frames "$frames" > /dev/null
+./calc_loadgen --socket train.sock --binary --hold 4 --clients 4 --frames "$frames" > /dev/null
+./calc_loadgen --socket train.sock --dynamic --binary --hold 4 --clients 4 --frames "$frames" > /dev/null
+# A clean shutdown writes the daemon's profile (and closes the log)
+kill -TERM $daemon
+wait $daemon
+trap - EXIT
+
+./calc_loadgen --in-process --hold 4 --clients 4 --frames "$frames" > /dev/null
+for log in train.log "$@"; do
+    ./calc_loadgen --in-process --log "$log" --frames "$frames" > /dev/null
+    for kernel in envelope energy glide turn vnav wind; do
+        ./calc_batch --log "$log" "$kernel" > /dev/null
+    done
+done
+echo "✓ Profiles trained: $((frames * 17)) frames served, $(($# + 1)) flight log(s) replayed"
@@ -0,0 +1,548 @@
+from pathlib import Path
+import base64
+import hashlib
+import json
+import socket
+import struct
+import sys
+import tempfile
+import threading
+import time
+import types
+
+# aircraft_mfd uses requests only for X-Plane's REST API, which these tests
+# replace; where it isn't installed a stand-in lets the module import
+try:
+    import requests
+except ImportError:
+    requests = types.ModuleType("requests")
+    requests.Session = type("Session", (), {"mount": lambda self, prefix, adapter: None})
+    requests.adapters = types.SimpleNamespace(HTTPAdapter=lambda **kwargs: None)
+    sys.modules["requests"] = requests
+
+import aircraft_mfd
+from test_calculators import (DENSITY_ARGUMENTS, FLIGHT_ARGUMENTS, TURN_ARGUMENTS, VNAV_ARGUMENTS,
+                              connect_unix_socket, read_json_lines)
+
+
+def test_fetch_frame_values():
+    """XPlaneAPI.fetch_frame_values: one request per dataref in flight"""
+    print("Testing XPlaneAPI.fetch_frame_values")
+
+    # Dataref 1 stalls until released; dataref 2 answers at once
+    release = threading.Event()
+    calls = {1: 0, 2: 0}
+
+    def fetch_value_by_id(dataref_id, index=None):
+        calls[dataref_id] += 1
+        if dataref_id == 1:
+            release.wait(2.0)
+            return 1.0 + calls[1]
+        return 2.0
+
+    api = aircraft_mfd.XPlaneAPI()
+    api.FRAME_FETCH_DEADLINE_S = 0.05
+    api.fetch_value_by_id = fetch_value_by_id
+    api.resolve_dataref_ids = lambda names: None
+    slow, fast = ("sim/slow", None), ("sim/fast", None)
+    api.dataref_cache.update({"sim/slow": 1, "sim/fast": 2})
+    api.register_datarefs([slow, fast])
+
+    errors = []
+    try:
+        # The stalled request misses the deadline and stays in flight
+        first = api.fetch_frame_values()
+        if first != {slow: None, fast: 2.0} or api.missed_deadline != 1 or slow not in api.in_flight:
+            errors.append(f"Frame past the deadline: got {first}, missed {api.missed_deadline}")
+        # While it runs the key is skipped, not requested again
+        second = api.fetch_frame_values()
+        if second != {slow: None, fast: 2.0} or calls[1] != 1 or api.skipped_pending != 1:
+            errors.append(f"Frame while in flight: got {second}, {calls[1]} requests")
+        # Once it finishes its value is the next frame's, still one request
+        release.set()
+        api.in_flight[slow].result(timeout=2.0)
+        third = api.fetch_frame_values()
+        if third != {slow: 2.0, fast: 2.0} or calls[1] != 1 or api.in_flight:
+            errors.append(f"Frame after it finished: got {third}, {calls[1]} requests")
+        # Then the key is requested afresh
+        fourth = api.fetch_frame_values([slow])
+        if fourth != {slow: 3.0} or calls[1] != 2:
+            errors.append(f"Next frame: got {fourth}, {calls[1]} requests")
+    finally:
+        release.set()
+        api.executor.shutdown(wait=True)
+
+    if errors:
+        print("❌ Fetch mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print("✅ Output matches expected data")
+    return True
+
+
+# A WebSocket server end (RFC 6455) for the client under test: one
+# connection, handshake answered, frames built and read by hand
+def websocket_frame(opcode, payload, fin=True, mask=None):
+    """One frame; mask (4 bytes) sets the mask bit and masks the payload"""
+    header = bytes([(0x80 if fin else 0x00) | opcode])
+    mask_bit = 0x80 if mask is not None else 0x00
+    if len(payload) < 126:
+        header += bytes([mask_bit | len(payload)])
+    else:
+        header += bytes([mask_bit | 126]) + struct.pack(">H", len(payload))
+    if mask is not None:
+        header += mask
+        payload = bytes(b ^ mask[i % 4] for i, b in enumerate(payload))
+    return header + payload
+
+def read_client_frame(connection):
+    """(masked, opcode, unmasked payload) of one frame the client sent"""
+    head = connection.recv(2, socket.MSG_WAITALL)
+    length = head[1] & 0x7F
+    if length == 126:
+        length = struct.unpack(">H", connection.recv(2, socket.MSG_WAITALL))[0]
+    masked = bool(head[1] & 0x80)
+    mask = connection.recv(4, socket.MSG_WAITALL) if masked else b"\0\0\0\0"
+    payload = connection.recv(length, socket.MSG_WAITALL) if length else b""
+    return masked, head[0] & 0x0F, bytes(b ^ mask[i % 4] for i, b in enumerate(payload))
+
+class WebSocketServer:
+    """Accepts one connection on localhost, answers the upgrade, then runs
+    script(connection) on its own thread"""
+
+    def __init__(self, script):
+        self.listener = socket.create_server(("127.0.0.1", 0))
+        self.url = f"ws://127.0.0.1:{self.listener.getsockname()[1]}/api/v2"
+        self.script = script
+        self.error = None
+        self.thread = threading.Thread(target=self.serve, daemon=True)
+        self.thread.start()
+
+    def serve(self):
+        try:
+            connection, _ = self.listener.accept()
+            with connection:
+                connection.settimeout(5.0)
+                request = b""
+                while b"\r\n\r\n" not in request:
+                    request += connection.recv(4096)
+                key = [line.split(b":", 1)[1].strip() for line in request.split(b"\r\n")
+                       if line.lower().startswith(b"sec-websocket-key:")][0]
+                accept = base64.b64encode(hashlib.sha1(key + aircraft_mfd.WebSocketConnection.GUID).digest())
+                connection.sendall(b"HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\n"
+                                   b"Connection: Upgrade\r\nSec-WebSocket-Accept: " + accept + b"\r\n\r\n")
+                self.script(connection)
+        except Exception as e:
+            self.error = e
+        finally:
+            self.listener.close()
+
+    def join(self):
+        self.thread.join(timeout=5.0)
+
+def test_websocket_frames():
+    """WebSocketConnection: masked, fragmented and 16-bit length frames"""
+    print("Testing WebSocketConnection frames")
+
+    long_text = "x" * 300
+    received = []
+
+    def script(connection):
+        # A message split over a text and a continuation frame with a ping
+        # between them, sent a few bytes at a time; a masked frame; a
+        # 16-bit length frame; then the client's pong and text
+        stream = (websocket_frame(0x1, b"hel", fin=False) + websocket_frame(0x9, b"hi") +
+                  websocket_frame(0x0, b"lo") + websocket_frame(0x1, b"masked", mask=b"\x01\x02\x03\x04") +
+                  websocket_frame(0x1, long_text.encode()))
+        for start in range(0, len(stream), 5):
+            connection.sendall(stream[start:start + 5])
+            time.sleep(0.001)
+        received.append(read_client_frame(connection))
+        received.append(read_client_frame(connection))
+        connection.sendall(websocket_frame(0x8, b""))
+
+    server = WebSocketServer(script)
+    errors = []
+    connection = aircraft_mfd.WebSocketConnection(server.url)
+    try:
+        messages = [connection.recv_text(timeout=2.0) for _ in range(3)]
+        connection.send_text("subscribe")
+        try:
+            connection.recv_text(timeout=2.0)
+            errors.append("Close frame did not end the connection")
+        except ConnectionError:
+            pass
+    finally:
+        connection.sock.close()
+        server.join()
+
+    if server.error is not None:
+        errors.append(f"Server: {server.error!r}")
+    if messages != ["hello", "masked", long_text]:
+        errors.append(f"Messages: got {[m if m is None or len(m) < 20 else m[:20] + '...' for m in messages]}")
+    if received != [(True, 0xA, b"hi"), (True, 0x1, b"subscribe")]:
+        errors.append(f"Client frames (masked, opcode, payload): got {received}")
+
+    if errors:
+        print("❌ WebSocket mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print("✅ Output matches expected data")
+    return True
+
+def test_websocket_subscription():
+    """XPlaneAPI.subscribe_updates: subscribe by ID, apply pushed values"""
+    print("Testing XPlaneAPI dataref subscription")
+
+    api = aircraft_mfd.XPlaneAPI()
+    api.resolve_dataref_ids = lambda names: None
+    altitude, fuel = ("sim/altitude", None), ("sim/fuel", 2)
+    api.dataref_cache.update({"sim/altitude": 11, "sim/fuel": 12})
+    api.register_datarefs([altitude, fuel])
+    requests_sent = []
+
+    def session_script(pushes):
+        def script(connection):
+            requests_sent.append(json.loads(read_client_frame(connection)[2]))
+            for data in pushes:
+                connection.sendall(websocket_frame(0x1, json.dumps(
+                    {"type": "dataref_update_values", "data": data}).encode()))
+            deadline = time.monotonic() + 2.0
+            while api.pushed_values.get(altitude) != pushes[-1]["11"] and time.monotonic() < deadline:
+                time.sleep(0.01)
+            connection.sendall(websocket_frame(0x8, b""))
+        return script
+
+    def run_session(pushes):
+        server = WebSocketServer(session_script(pushes))
+        connection = aircraft_mfd.WebSocketConnection(server.url)
+        closed = False
+        try:
+            api.subscribe_updates(connection)
+        except ConnectionError:
+            closed = True
+        finally:
+            connection.sock.close()
+            server.join()
+        return server.error, closed, api.fetch_frame_values()
+
+    # Only changed values, keyed by ID; an indexed value as [value]. After
+    # a reconnect, fuel isn't pushed again and must not keep the old value.
+    sessions = [run_session([{"11": 5000.0, "12": [42.5]}, {"11": 5100.0}]),
+                run_session([{"11": 6000.0}])]
+    api.executor.shutdown(wait=True)
+
+    errors = []
+    expected_frames = [{altitude: 5100.0, fuel: 42.5}, {altitude: 6000.0, fuel: None}]
+    for number, ((error, closed, frame), expected) in enumerate(zip(sessions, expected_frames), 1):
+        if error is not None:
+            errors.append(f"Session {number} server: {error!r}")
+        if not closed:
+            errors.append(f"Session {number}: close frame did not end the subscription")
+        if frame != expected:
+            errors.append(f"Session {number} frame from the pushed cache: got {frame}")
+    expected_request = {"req_id": 1, "type": "dataref_subscribe_values",
+                        "params": {"datarefs": [{"id": 11}, {"id": 12, "index": 2}]}}
+    if requests_sent != [expected_request] * 2:
+        errors.append(f"Subscribe requests: got {requests_sent}")
+    # Still marked connected: the subscription thread clears that on exit
+    if not api.is_subscribed():
+        errors.append("Subscription not marked connected")
+
+    if errors:
+        print("❌ Subscription mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print("✅ Output matches expected data")
+    return True
+
+def test_latest_slot():
+    """LatestSlot: a stale item is overwritten, a waiting taker is woken"""
+    print("Testing LatestSlot")
+
+    errors = []
+    slot = aircraft_mfd.LatestSlot()
+    slot.put("frame 1")
+    slot.put("frame 2")
+    taken = slot.take(timeout=0.0)
+    if taken != "frame 2" or slot.dropped != 1:
+        errors.append(f"Two puts, one take: got {taken!r}, {slot.dropped} dropped")
+    empty = slot.take(timeout=0.01)
+    if empty is not None:
+        errors.append(f"Take from an empty slot: got {empty!r}")
+
+    # A consumer waiting on the slot gets the item put while it waits
+    result = []
+    consumer = threading.Thread(target=lambda: result.append(slot.take(timeout=2.0)))
+    consumer.start()
+    time.sleep(0.05)
+    slot.put("frame 3")
+    consumer.join(timeout=2.0)
+    if result != ["frame 3"] or slot.dropped != 1:
+        errors.append(f"Waiting take: got {result}, {slot.dropped} dropped")
+
+    if errors:
+        print("❌ LatestSlot mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print("✅ Output matches expected data")
+    return True
+
+def test_panel_scheduler():
+    """PanelScheduler with the MFD's panels: each item at its rate, hidden ones paused"""
+    print("Testing PanelScheduler")
+
+    mfd = aircraft_mfd.AircraftMFD
+    scheduler = aircraft_mfd.PanelScheduler(mfd.PANEL_ITEMS, mfd.SECTION_DATAREFS, mfd.DATAREF_RATE_LIMITS)
+    turn_inputs = set(mfd.SECTION_DATAREFS["turn"])
+    density_inputs = set(mfd.SECTION_DATAREFS["density"])
+    flight_items = set(mfd.SECTION_DATAREFS["flight"]) | {key for key in mfd.PANEL_ITEMS[5] if key != "flight"}
+    rate_limited = set(mfd.DATAREF_RATE_LIMITS)
+
+    # Turn (fast) and density altitude (slow, 1 s): an input both read
+    # goes at the faster rate; then the air data panel alone, whose flight
+    # section is fast but whose weight and aircraft limits are rate limited
+    expected = []
+    scheduler.set_visible([7, 9])
+    expected.append((0.0, turn_inputs | density_inputs, {"turn", "density"}))
+    expected.append((0.5, turn_inputs, {"turn"}))
+    expected.append((1.0, turn_inputs | density_inputs, {"turn", "density"}))
+    errors = []
+    for now, datarefs, sections in expected:
+        due = scheduler.take_due(now)
+        if (set(due[0]), due[1]) != (datarefs, sections):
+            errors.append(f"Turn and density at {now} s: got {len(due[0])} datarefs, {due[1]}")
+    # A panel shown again is due at once; its limited inputs were never read
+    scheduler.set_visible([5])
+    for now, datarefs in ((1.2, flight_items), (1.3, flight_items - rate_limited),
+                          (2.5, flight_items)):
+        due = scheduler.take_due(now)
+        if (set(due[0]), due[1]) != (datarefs, {"flight"}):
+            errors.append(f"Air data at {now} s: got {len(due[0])} datarefs, {due[1]}, "
+                          f"expected {len(datarefs)}")
+    if scheduler.section_runs != 8:
+        errors.append(f"Section runs: got {scheduler.section_runs}")
+
+    if errors:
+        print("❌ Schedule mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print("✅ Output matches expected data")
+    return True
+
+class RecordingVariable:
+    """StringVar stand-in (no Tk display here) that counts its sets"""
+
+    def __init__(self, text):
+        self.text = text
+        self.sets = 0
+
+    def get(self):
+        return self.text
+
+    def set(self, text):
+        self.text = text
+        self.sets += 1
+
+
+def test_field_renderer():
+    """FieldRenderer: only changed fields are set, omitted fields keep their text"""
+    print("Testing FieldRenderer")
+
+    variables = {name: RecordingVariable("---") for name in ("alt", "spd", "hdg")}
+    renderer = aircraft_mfd.FieldRenderer(variables)
+    errors = []
+    # First frame changes two, the second repeats one and changes one, the
+    # third leaves everything out but the repeated heading
+    frames = [({"alt": "10000", "spd": "250"}, 2), ({"alt": "10000", "spd": "260", "hdg": "---"}, 1),
+              ({"hdg": "---"}, 0)]
+    for fields, changed in frames:
+        got = renderer.apply(fields)
+        if got != changed:
+            errors.append(f"{fields}: {got} set, expected {changed}")
+    texts = {name: variable.text for name, variable in variables.items()}
+    if texts != {"alt": "10000", "spd": "260", "hdg": "---"}:
+        errors.append(f"Texts: got {texts}")
+    sets = {name: variable.sets for name, variable in variables.items()}
+    if sets != {"alt": 1, "spd": 2, "hdg": 0}:
+        errors.append(f"Sets per variable: got {sets}")
+    if (renderer.set_count, renderer.unchanged_count) != (3, 3):
+        errors.append(f"Counts: got {renderer.set_count} set, {renderer.unchanged_count} unchanged")
+
+    if errors:
+        print("❌ Renderer mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print("✅ Output matches expected data")
+    return True
+
+
+def test_font_cache():
+    """FontCache: one font per (size, weight), created on first use"""
+    print("Testing FontCache")
+
+    created = []
+
+    def counting_font(**options):
+        created.append(options)
+        return types.SimpleNamespace(**options)
+
+    real_font = aircraft_mfd.tkfont.Font
+    aircraft_mfd.tkfont.Font = counting_font
+    try:
+        cache = aircraft_mfd.FontCache("Courier")
+        first = cache.get(12)
+        again = cache.get(12, "normal")
+        bold = cache.get(12, "bold")
+        larger = cache.get(16)
+    finally:
+        aircraft_mfd.tkfont.Font = real_font
+
+    errors = []
+    if first is not again:
+        errors.append("Same size and weight gave a second font")
+    if bold is first or larger is first:
+        errors.append("New weight or size reused a font")
+    expected = [{"family": "Courier", "size": 12, "weight": "normal"},
+                {"family": "Courier", "size": 12, "weight": "bold"},
+                {"family": "Courier", "size": 16, "weight": "normal"}]
+    if created != expected:
+        errors.append(f"Fonts created: got {created}")
+
+    if errors:
+        print("❌ Font cache mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print("✅ Output matches expected data")
+    return True
+
+def compare_decoded(label, decoded, expected):
+    """Errors where decoded differs from the daemon's JSON reply, by WIRE_RECORDS"""
+    errors = []
+    for section, key, _, names in aircraft_mfd.WIRE_RECORDS.values():
+        got = decoded.get(section, {})
+        want = expected.get(section, {})
+        if key is not None:
+            got, want = got.get(key, {}), want.get(key, {})
+        where = f"{label} {section}" + (f".{key}" if key else "")
+        if set(got) != set(want) or set(names) != set(want):
+            errors.append(f"{where}: fields {sorted(got)}, expected {sorted(want)}")
+            continue
+        for name in names:
+            if abs(got[name] - want[name]) > 0.006:
+                errors.append(f"{where}.{name}: got {got[name]}, expected {want[name]}")
+    return errors
+
+
+def test_daemon_decoding():
+    """CalculatorDaemonClient decodes mfd_calcd's shm and socket replies as its JSON"""
+    print("Testing CalculatorDaemonClient decoding")
+
+    sections = {"flight": [float(v) for v in FLIGHT_ARGUMENTS], "turn": [float(v) for v in TURN_ARGUMENTS],
+                "vnav": [float(v) for v in VNAV_ARGUMENTS],
+                "density": [float(v) for v in DENSITY_ARGUMENTS] + [0.0]}
+    request = " ".join(["1", "aircraft", "1"] + [
+        field for name, values in sections.items() for field in [name] + [str(v) for v in values]])
+    errors = []
+
+    with tempfile.TemporaryDirectory() as tmp:
+        client = aircraft_mfd.CalculatorDaemonClient(Path(__file__).parent / "mfd_calcd",
+                                                     socket_path=f"{tmp}/mfd_calcd.sock", timeout=1.0,
+                                                     shm_path=f"{tmp}/mfd_calcd.shm")
+        try:
+            # The first connect starts the daemon; the channel maps once it exists
+            deadline = time.monotonic() + 2.0
+            while time.monotonic() < deadline:
+                if client.connect():
+                    client.attach_shm()
+                    if client.shm is not None or not aircraft_mfd.SHM_ORDERED_STORES:
+                        break
+                time.sleep(0.05)
+            if client.sock is None:
+                print("❌ Could not start mfd_calcd")
+                return False
+
+            # Each path answers from fresh state: the channel's own, the
+            # socket's shared state, then aircraft 1's for the JSON reply
+            decoded = []
+            if aircraft_mfd.SHM_ORDERED_STORES:
+                if client.shm is None:
+                    errors.append("Shared-memory channel not attached")
+                else:
+                    decoded.append(("shm", client.query(sections)))
+                    client.shm.close()
+                    client.shm = None
+            decoded.append(("socket", client.query(sections)))
+
+            connection = connect_unix_socket(client.socket_path)
+            if connection is None:
+                print("❌ Could not connect to mfd_calcd")
+                return False
+            with connection:
+                connection.sendall(f"{request}\n".encode())
+                replies = read_json_lines(connection, 1)
+        finally:
+            client.stop()
+
+    if replies is None:
+        print("❌ No JSON reply from mfd_calcd")
+        return False
+    for label, reply in decoded:
+        if reply is None or "error" in reply:
+            errors.append(f"{label}: got {reply}")
+        else:
+            errors += compare_decoded(label, reply, replies[0])
+
+    if errors:
+        print("❌ Decoded replies differ from JSON:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print(f"✅ {', '.join(label for label, _ in decoded)} replies match the JSON reply")
+    return True
+
+
+def run_test(test_fn):
+    """Run a test function and return True if it passed, False otherwise."""
+    result = test_fn()
+    if not result:
+        print(f"❌ {test_fn.__name__} FAILED\n")
+    return result
+
+def main():
+    """Run the aircraft_mfd.py unit tests"""
+    tests = [
+        test_fetch_frame_values,
+        test_websocket_frames,
+        test_websocket_subscription,
+        test_latest_slot,
+        test_panel_scheduler,
+        test_field_renderer,
+        test_font_cache,
+        test_daemon_decoding
+    ]
+
+    any_failures = False
+    for test_fn in tests:
+        if not run_test(test_fn):
+            any_failures = True
+
+    exit(1 if any_failures else 0)
+
+if __name__ == "__main__":
+    main()
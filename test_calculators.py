@@ -2,115 +2,308 @@ from pathlib import Path
 import subprocess
 import sys
 import json
+import ctypes
+import math
+import platform
+import mmap
+import random
+import socket
+import statistics
+import struct
+import tempfile
+import time
 
 
-def test_density_altitude_calculator():
-    arguments = ["5000", "25", "150", "170"]
+DENSITY_ARGUMENTS = ["5000", "25", "150", "170"]
 
-    expected_output = {
-        "density_altitude_ft": 7388.72,
-        "pressure_altitude_ft": 5000.00,
-        "air_density_ratio": 0.80,
-        "temperature_deviation_c": 19.91,
-        "performance_loss_pct": 19.59,
-        "eas_kts": 152.45,
-        "tas_to_ias_ratio": 1.13,
-        "pressure_ratio": 0.83
-    }
+DENSITY_EXPECTED = {
+    "density_altitude_ft": 7388.72,
+    "pressure_altitude_ft": 5000.00,
+    "air_density_ratio": 0.80,
+    "temperature_deviation_c": 19.91,
+    "performance_loss_pct": 19.59,
+    "eas_kts": 152.45,
+    "tas_to_ias_ratio": 1.13,
+    "pressure_ratio": 0.83
+}
 
+def test_density_altitude_calculator():
     exit_code = 0
-    if not test_calculator("density_altitude_calculator", arguments, expected_output):
+    if not test_calculator("density_altitude_calculator", DENSITY_ARGUMENTS, DENSITY_EXPECTED):
         exit_code = 1
-    if not test_calculator("density_altitude_calculator", arguments + ["1"], expected_return_code=3):
+    if not test_calculator("density_altitude_calculator", DENSITY_ARGUMENTS + ["1"], expected_return_code=3):
         exit_code = 1
 
     return exit_code == 0
 
-def test_flight_calculator():
-    arguments = [
-        "250",
-        "245",
-        "90",
-        "95",
-        "220",
-        "0.65",
-        "35000",
-        "35000",
-        "-500",
-        "75000",
-        "5",
-        "120",
-        "250",
-        "0.82"
-    ]
+# Table range and documented error bound of calculators/isa_table.h
+ISA_TABLE_ALTITUDES_FT = [-2000.0, -1875.0, 0.0, 137.5, 5000.0, 36089.0, 45123.4, 59875.0, 60000.0]
+ISA_TABLE_MAX_ERROR = 1e-11
 
-    expected_output = {
-        "wind": {
-            "speed_kts": 22.16,
-            "direction_from": 195.53,
-            "headwind": 4.05,
-            "crosswind": 21.79,
-            "gust_factor": 0.01
-        },
-        "envelope": {
-            "stall_margin_pct": 82.98,
-            "vmo_margin_pct": 12.00,
-            "mmo_margin_pct": 20.73,
-            "min_margin_pct": 12.00,
-            "load_factor": 1.00,
-            "corner_speed_kts": 170.00
-        },
-        "energy": {
-            "specific_energy_ft": 37766.88,
-            "energy_rate_kts": -4.94,
-            "trend": -1
-        },
-        "glide": {
-            "still_air_range_nm": 69.12,
-            "wind_adjusted_range_nm": 68.00,
-            "glide_ratio": 12.00,
-            "best_glide_speed_kts": 78.00
-        },
-        "alternate_airports": {
-            "combinations_5_choose_2": 10,
-            "combinations_10_choose_3": 120,
-            "note": "Iterative binomial calculation (JSF-compliant, no recursion)"
-        }
-    }
+def test_isa_table():
+    """Tabulated pressure and density ratios match the pow() formula"""
+    print("Testing ISA table lookups")
+    calculator = str(Path(__file__).parent / "density_altitude_calculator")
+    errors = []
 
-    return test_calculator("flight_calculator", arguments, expected_output)
+    for altitude_ft in ISA_TABLE_ALTITUDES_FT:
+        oat_c = max(15.0 - 0.0019812 * altitude_ft + 10.0, -55.0)  # inside the validated OAT range
+        result = subprocess.run([calculator, "--binary", str(altitude_ft), str(oat_c), "150", "170"],
+                                capture_output=True, timeout=2.0)
+        values = unpack_wire("<IBBH8d", result.stdout)
+        if result.returncode != 0 or values is None:
+            errors.append(f"{altitude_ft} ft: no record (return code {result.returncode})")
+            continue
 
-def test_turn_calculator():
-    arguments = ["250", "25", "90"]
+        sigma, pressure_ratio = values[6], values[11]
+        expected_pressure = math.pow(1.0 - 6.8756e-6 * altitude_ft, 5.2559)
+        expected_sigma = expected_pressure * 288.15 / (oat_c + 273.15)
+        if abs(pressure_ratio - expected_pressure) > ISA_TABLE_MAX_ERROR:
+            errors.append(f"{altitude_ft} ft: pressure_ratio {pressure_ratio!r}, expected {expected_pressure!r}")
+        if abs(sigma - expected_sigma) > ISA_TABLE_MAX_ERROR:
+            errors.append(f"{altitude_ft} ft: air_density_ratio {sigma!r}, expected {expected_sigma!r}")
 
-    expected_output = {
-        "radius_nm": 1.95,
-        "radius_ft": 11867.19,
-        "turn_rate_dps": 2.04,
-        "lead_distance_nm": 1.95,
-        "lead_distance_ft": 11867.19,
-        "time_to_turn_sec": 44.18,
-        "load_factor": 1.10,
-        "standard_rate_bank": 34.48
+    if errors:
+        print("❌ ISA table mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print(f"✅ Within {ISA_TABLE_MAX_ERROR} of pow() at {len(ISA_TABLE_ALTITUDES_FT)} altitudes")
+    return True
+
+FLIGHT_ARGUMENTS = [
+    "250",
+    "245",
+    "90",
+    "95",
+    "220",
+    "0.65",
+    "35000",
+    "35000",
+    "-500",
+    "75000",
+    "5",
+    "120",
+    "250",
+    "0.82"
+]
+
+FLIGHT_EXPECTED = {
+    "wind": {
+        "speed_kts": 22.16,
+        "direction_from": 195.53,
+        "headwind": 4.05,
+        "crosswind": 21.79,
+        "gust_factor": 0.01
+    },
+    "envelope": {
+        "stall_margin_pct": 82.98,
+        "vmo_margin_pct": 12.00,
+        "mmo_margin_pct": 20.73,
+        "min_margin_pct": 12.00,
+        "load_factor": 1.00,
+        "corner_speed_kts": 170.00
+    },
+    "energy": {
+        "specific_energy_ft": 37766.89,
+        "energy_rate_kts": -4.94,
+        "trend": -1
+    },
+    "glide": {
+        "still_air_range_nm": 69.12,
+        "wind_adjusted_range_nm": 68.00,
+        "glide_ratio": 12.00,
+        "best_glide_speed_kts": 78.00
+    },
+    "alternate_airports": {
+        "combinations_5_choose_2": 10,
+        "combinations_10_choose_3": 120,
+        "note": "Iterative binomial calculation (JSF-compliant, no recursion)"
     }
+}
+
+# Resident processes build the gust history from the requests they see;
+# repeats of one request have a steady IAS
+FLIGHT_RESIDENT_EXPECTED = dict(FLIGHT_EXPECTED, wind=dict(FLIGHT_EXPECTED["wind"], gust_factor=0.0))
+
+# IAS window of calculators/flight_kernels.h (ias_history_length)
+IAS_HISTORY_LENGTH = 20
+
+def test_flight_calculator():
+    return test_calculator("flight_calculator", FLIGHT_ARGUMENTS, FLIGHT_EXPECTED)
+
+def flight_request_with_ias(ias_kts):
+    """FLIGHT_ARGUMENTS as one request line with a different IAS"""
+    fields = list(FLIGHT_ARGUMENTS)
+    fields[4] = str(ias_kts)
+    return " ".join(fields)
+
+def test_flight_calculator_serve():
+    """Resident --serve mode: one JSON line per request, errors don't stop it"""
+    print("Testing flight_calculator --serve")
+    calculator_path = Path(__file__).parent / "flight_calculator"
+
+    if not calculator_path.exists():
+        print("flight_calculator not found")
+        return False
+
+    # Two gusts, then enough steady requests to push them out of the window
+    request = " ".join(FLIGHT_ARGUMENTS)
+    gusts = [flight_request_with_ias(100), flight_request_with_ias(300)]
+    steady = [request] * IAS_HISTORY_LENGTH
+    result = subprocess.run(
+        [str(calculator_path), "--serve"],
+        input="\n".join([request, "1 2 3", request] + gusts + steady) + "\n",
+        capture_output=True,
+        text=True,
+        timeout=2.0
+    )
+
+    if result.returncode != 0:
+        print(f"❌ Return code mismatch: expected 0, got {result.returncode}")
+        return False
+
+    lines = result.stdout.splitlines()
+    if len(lines) != 5 + IAS_HISTORY_LENGTH:
+        print(f"❌ Expected {5 + IAS_HISTORY_LENGTH} response lines, got {len(lines)}")
+        print(result.stdout)
+        return False
+
+    try:
+        responses = [json.loads(line) for line in lines]
+    except json.JSONDecodeError:
+        print("❌ Output was not valid JSON")
+        print(result.stdout)
+        return False
+
+    # Every result reports the server's own compute time
+    errors = []
+    for index, response in enumerate(responses):
+        if "error" in response:
+            continue
+        compute_us = response.pop("compute_us", None)
+        if not isinstance(compute_us, (int, float)) or compute_us < 0:
+            errors.append(f"Response {index}: bad compute_us {compute_us}")
+
+    errors += compare_json(FLIGHT_RESIDENT_EXPECTED, responses[0])
+    errors += compare_json(FLIGHT_RESIDENT_EXPECTED, responses[2])
+    if "error" not in responses[1]:
+        errors.append("Malformed request did not produce an error reply")
+
+    # IAS window 220, 220, 100, 300: std dev 71.41 over mean 210
+    gust_factor = responses[4]["wind"]["gust_factor"]
+    if abs(gust_factor - 0.34) > 0.01:
+        errors.append(f"Gust factor after IAS 100/300: expected 0.34, got {gust_factor}")
+    errors += compare_json(FLIGHT_RESIDENT_EXPECTED, responses[-1])
+
+    if errors:
+        print("❌ JSON mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print("✅ Output matches expected data")
+    return True
+
+def flight_request_with_altitude(altitude_ft):
+    """FLIGHT_ARGUMENTS as one request line with a different altitude"""
+    fields = list(FLIGHT_ARGUMENTS)
+    fields[6] = str(altitude_ft)
+    return " ".join(fields)
+
+def test_flight_result_cache():
+    """Resident results are reused until an input moves past its epsilon"""
+    print("Testing flight_calculator --serve result cache")
+    calculator_path = Path(__file__).parent / "flight_calculator"
+
+    if not calculator_path.exists():
+        print("flight_calculator not found")
+        return False
+
+    # Repeats, an altitude change within the 0.5 ft epsilon, then one past it
+    altitude_ft = float(FLIGHT_ARGUMENTS[6])
+    request = " ".join(FLIGHT_ARGUMENTS)
+    requests = [request, request, request,
+                flight_request_with_altitude(altitude_ft + 0.25),
+                flight_request_with_altitude(altitude_ft + 100.0)]
+    result = subprocess.run(
+        [str(calculator_path), "--serve"],
+        input="\n".join(requests + ["stats"]) + "\n",
+        capture_output=True,
+        text=True,
+        timeout=2.0
+    )
+
+    try:
+        responses = [json.loads(line) for line in result.stdout.splitlines()]
+    except json.JSONDecodeError:
+        print("❌ Output was not valid JSON")
+        print(result.stdout)
+        return False
+    if len(responses) != len(requests) + 1:
+        print(f"❌ Expected {len(requests) + 1} response lines, got {len(responses)}")
+        return False
+
+    errors = []
+    for response in responses[:-1]:
+        response.pop("compute_us", None)
+    if responses[3] != responses[0]:
+        errors.append("Altitude change within epsilon changed the results")
+    moved = responses[4]["energy"]["specific_energy_ft"] - responses[0]["energy"]["specific_energy_ft"]
+    if abs(moved - 100.0) > 1.0:
+        errors.append(f"Specific energy after +100 ft: moved {moved}")
+
+    expected_stats = {"cache": {
+        "envelope": {"hits": 4, "misses": 1},
+        "energy": {"hits": 3, "misses": 2},
+        "glide": {"hits": 4, "misses": 1}
+    }}
+    if responses[-1] != expected_stats:
+        errors.append(f"Cache counters: expected {expected_stats}, got {responses[-1]}")
+
+    if errors:
+        print("❌ Cache mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print("✅ Output matches expected data")
+    return True
+
+TURN_ARGUMENTS = ["250", "25", "90"]
+
+TURN_EXPECTED = {
+    "radius_nm": 1.95,
+    "radius_ft": 11867.21,
+    "turn_rate_dps": 2.04,
+    "lead_distance_nm": 1.95,
+    "lead_distance_ft": 11867.21,
+    "time_to_turn_sec": 44.18,
+    "load_factor": 1.10,
+    "standard_rate_bank": 34.48
+}
+
+def test_turn_calculator():
     
-    return test_calculator("turn_calculator", arguments, expected_output)
+    return test_calculator("turn_calculator", TURN_ARGUMENTS, TURN_EXPECTED)
 
-def test_vnav_calculator():
-    arguments = ["35000", "10000", "100", "450", "-1500"]
+VNAV_ARGUMENTS = ["35000", "10000", "100", "450", "-1500"]
 
-    expected_output = {
-        "altitude_to_lose_ft": 25000.00,
-        "flight_path_angle_deg": -2.36,
-        "required_vs_fpm": -1875.02,
-        "tod_distance_nm": 78.51,
-        "time_to_constraint_min": 16.67,
-        "distance_per_1000ft": 4.00,
-        "vs_for_3deg": 2388.30,
-        "is_descent": True
-    }
+VNAV_EXPECTED = {
+    "altitude_to_lose_ft": 25000.00,
+    "flight_path_angle_deg": -2.36,
+    "required_vs_fpm": -1875.00,
+    "tod_distance_nm": 78.51,
+    "time_to_constraint_min": 16.67,
+    "distance_per_1000ft": 4.00,
+    "vs_for_3deg": 2388.27,
+    "is_descent": True
+}
+
+def test_vnav_calculator():
     
-    return test_calculator("vnav_calculator", arguments, expected_output)
+    return test_calculator("vnav_calculator", VNAV_ARGUMENTS, VNAV_EXPECTED)
 
 def test_wind_calculator():
     arguments = ["090", "085", "240", "60"]
@@ -125,6 +318,1645 @@ def test_wind_calculator():
     
     return test_calculator("wind_calculator", arguments, expected_output)
 
+def test_number_parsing():
+    """calc_io parsing: strtod's accepted forms, whole-field and range checks"""
+    passed = True
+    if not test_calculator("turn_calculator", ["+250", "2.5e1", "90.0"], TURN_EXPECTED):
+        passed = False
+    for bad_tas in ["250abc", "", "0x10", "1e999", "+-250", "250 "]:
+        if not test_calculator("turn_calculator", [bad_tas, "25", "90"], expected_return_code=2):
+            passed = False
+    # Previously std::stod: a bad field aborted instead of failing cleanly
+    if not test_calculator("density_altitude_calculator", ["5000", "warm", "150", "170"],
+                           expected_return_code=2):
+        passed = False
+    return passed
+
+def test_mfd_calcd():
+    """Calculator daemon: one multiplexed request returns every section"""
+    print("Testing mfd_calcd")
+    daemon_path = Path(__file__).parent / "mfd_calcd"
+
+    if not daemon_path.exists():
+        print("mfd_calcd not found")
+        return False
+
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        socket_path = str(Path(tmp_dir) / "mfd_calcd.sock")
+        daemon = subprocess.Popen(
+            [str(daemon_path), "--socket", socket_path],
+            stderr=subprocess.DEVNULL
+        )
+        try:
+            client = connect_unix_socket(socket_path)
+            if client is None:
+                print("❌ Could not connect to mfd_calcd")
+                return False
+
+            with client:
+                request = " ".join(
+                    ["7", "flight"] + FLIGHT_ARGUMENTS +
+                    ["turn"] + TURN_ARGUMENTS +
+                    ["vnav"] + VNAV_ARGUMENTS +
+                    ["density"] + DENSITY_ARGUMENTS + ["0"]
+                )
+                # Second request pipelined on the same connection: rejected inputs
+                client.sendall(f"{request}\n8 density {' '.join(DENSITY_ARGUMENTS)} 1\n10 stats\n".encode())
+                replies = read_json_lines(client, 3)
+
+                # Binary reply: turn record, timing record, then the reply
+                # record ending it
+                layout = "<" + WIRE_HEADER[1:] + "8d" + WIRE_HEADER[1:] + "d" + WIRE_HEADER[1:] + "qii"
+                client.sendall(f"9 binary turn {' '.join(TURN_ARGUMENTS)}\n".encode())
+                binary_reply = unpack_wire(layout, read_bytes(client, struct.calcsize(layout)))
+        finally:
+            daemon.terminate()
+            daemon.wait(timeout=2.0)
+
+    if replies is None:
+        print("❌ Daemon replies were not valid JSON lines")
+        return False
+
+    errors = []
+    if replies[0].get("id") != 7:
+        errors.append(f"Reply id: expected 7, got {replies[0].get('id')}")
+    if not isinstance(replies[0].get("compute_us"), (int, float)) or replies[0]["compute_us"] < 0:
+        errors.append(f"Reply compute_us: got {replies[0].get('compute_us')}")
+    for section, expected in [("flight", FLIGHT_RESIDENT_EXPECTED), ("turn", TURN_EXPECTED),
+                              ("vnav", VNAV_EXPECTED), ("density", DENSITY_EXPECTED)]:
+        if section not in replies[0]:
+            errors.append(f"Missing section: {section}")
+        else:
+            errors += [f"{section}.{err}" for err in compare_json(expected, replies[0][section])]
+    replies[1].pop("compute_us", None)
+    if replies[1] != {"id": 8, "density": {"error": 3}}:
+        errors.append(f"Forced density error: got {replies[1]}")
+    if replies[2].get("cache", {}).get("envelope") != {"hits": 0, "misses": 1}:
+        errors.append(f"Cache counters after one flight section: got {replies[2]}")
+    if binary_reply is None:
+        errors.append("Binary reply had the wrong size")
+    else:
+        errors += [f"binary turn.{err}" for err in
+                   compare_json(TURN_EXPECTED, dict(zip(TURN_EXPECTED, binary_reply[4:12])))]
+        if binary_reply[14] != 11 or binary_reply[16] < 0:
+            errors.append(f"Binary timing record: got {binary_reply[12:17]}")
+        if binary_reply[21:] != (9, 0, 2):
+            errors.append(f"Binary reply record: got {binary_reply[21:]}")
+
+    if errors:
+        print("❌ JSON mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print("✅ Output matches expected data")
+    return True
+
+def test_mfd_calcd_aircraft():
+    """Calculator daemon: per-aircraft frames pushed to every subscriber"""
+    print("Testing mfd_calcd aircraft frames")
+    daemon_path = Path(__file__).parent / "mfd_calcd"
+
+    if not daemon_path.exists():
+        print("mfd_calcd not found")
+        return False
+
+    # Binary push of a turn frame: aircraft frame record, turn record,
+    # timing record, reply record
+    layout = ("<" + WIRE_HEADER[1:] + "qq" + WIRE_HEADER[1:] + "8d" +
+              WIRE_HEADER[1:] + "d" + WIRE_HEADER[1:] + "qii")
+    turn = " ".join(TURN_ARGUMENTS)
+    flight = " ".join(FLIGHT_ARGUMENTS)
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        socket_path = str(Path(tmp_dir) / "mfd_calcd.sock")
+        daemon = subprocess.Popen(
+            [str(daemon_path), "--socket", socket_path, "--workers", "3"],
+            stderr=subprocess.DEVNULL
+        )
+        try:
+            displays = [connect_unix_socket(socket_path) for _ in range(3)]
+            client = connect_unix_socket(socket_path)
+            if client is None or None in displays:
+                print("❌ Could not connect to mfd_calcd")
+                return False
+
+            displays[0].sendall(b"1 subscribe 2\n")
+            displays[1].sendall(b"1 subscribe 2\n")
+            subscribed = read_json_lines(displays[0], 1), read_json_lines(displays[1], 1)
+            displays[2].sendall(b"1 binary subscribe 1\n")
+            binary_subscribed = unpack_wire("<" + WIRE_HEADER[1:] + "qii",
+                                            read_bytes(displays[2], struct.calcsize("<IBBHqii")))
+
+            # Aircraft 2's flight frame uses its own IAS history, then the
+            # shared history is still empty for the request without one
+            client.sendall((f"5 aircraft 1 turn {turn}\n6 aircraft 2 flight {flight}\n"
+                            f"7 aircraft 2 turn {turn}\n8 aircraft x turn {turn}\n"
+                            f"9 flight {flight}\n10 unsubscribe 2\n").encode())
+            replies = read_json_lines(client, 6)
+            pushes = [read_json_lines(display, 2) for display in displays[:2]]
+            binary_push = unpack_wire(layout, read_bytes(displays[2], struct.calcsize(layout)))
+            for connection in displays + [client]:
+                connection.close()
+        finally:
+            daemon.terminate()
+            daemon.wait(timeout=2.0)
+
+    if None in subscribed or replies is None or None in pushes:
+        print("❌ Daemon replies were not valid JSON lines")
+        return False
+
+    errors = []
+    for reply in subscribed:
+        if reply != [{"id": 1, "aircraft": 2, "subscribed": True}]:
+            errors.append(f"Subscribe reply: got {reply}")
+    if binary_subscribed is None or binary_subscribed[4:] != (1, 0, 0):
+        errors.append(f"Binary subscribe reply: got {binary_subscribed}")
+    for reply, (request_id, aircraft, frame) in zip(replies, [(5, 1, 1), (6, 2, 1), (7, 2, 2)]):
+        if (reply.get("id"), reply.get("aircraft"), reply.get("frame")) != (request_id, aircraft, frame):
+            errors.append(f"Frame reply {request_id}: got id, aircraft, frame "
+                          f"{reply.get('id'), reply.get('aircraft'), reply.get('frame')}")
+    errors += [f"aircraft 2 flight.{err}" for err in
+               compare_json(FLIGHT_RESIDENT_EXPECTED, replies[1].get("flight", {}))]
+    errors += [f"aircraft 2 turn.{err}" for err in compare_json(TURN_EXPECTED, replies[2].get("turn", {}))]
+    if replies[3] != {"id": 8, "error": "aircraft id must be an integer"}:
+        errors.append(f"Bad aircraft id: got {replies[3]}")
+    if replies[4].get("id") != 9 or "aircraft" in replies[4]:
+        errors.append(f"Request without an aircraft: got {replies[4]}")
+    errors += [f"shared flight.{err}" for err in
+               compare_json(FLIGHT_RESIDENT_EXPECTED, replies[4].get("flight", {}))]
+    if replies[5] != {"id": 10, "aircraft": 2, "subscribed": False}:
+        errors.append(f"Unsubscribe reply: got {replies[5]}")
+
+    if pushes[0] != pushes[1]:
+        errors.append("Subscribers of one aircraft got different pushes")
+    for push, reply in zip(pushes[0], replies[1:3]):
+        expected = {key: value for key, value in reply.items() if key != "id"}
+        if "id" in push or push != expected:
+            errors.append(f"Push of frame {reply.get('frame')}: got {push}")
+    if binary_push is None:
+        errors.append("Binary push had the wrong size")
+    else:
+        if binary_push[2] != 12 or binary_push[4:6] != (1, 1):
+            errors.append(f"Binary aircraft frame record: got {binary_push[:6]}")
+        errors += [f"binary push turn.{err}" for err in
+                   compare_json(TURN_EXPECTED, dict(zip(TURN_EXPECTED, binary_push[10:18])))]
+        if binary_push[27:] != (1, 0, 3):
+            errors.append(f"Binary push reply record: got {binary_push[23:]}")
+
+    if errors:
+        print("❌ JSON mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print("✅ Output matches expected data")
+    return True
+
+def test_mfd_calcd_aircraft_slots():
+    """Calculator daemon: idle aircraft give their slots to new ones"""
+    print("Testing mfd_calcd aircraft slot reuse")
+    daemon_path = Path(__file__).parent / "mfd_calcd"
+
+    if not daemon_path.exists():
+        print("mfd_calcd not found")
+        return False
+
+    # 64 slots: a 65th aircraft is refused while the first 64 are recent,
+    # then once they have idled 64 more each start at frame 1, and the
+    # table is full of recent aircraft again
+    turn = " ".join(TURN_ARGUMENTS)
+    first = [f"{n} aircraft {n} turn {turn}\n" for n in range(1, 66)]
+    second = [f"{n} aircraft {n} turn {turn}\n" for n in range(65, 130)]
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        socket_path = str(Path(tmp_dir) / "mfd_calcd.sock")
+        daemon = subprocess.Popen(
+            [str(daemon_path), "--socket", socket_path, "--aircraft-idle", "0.5"],
+            stderr=subprocess.DEVNULL
+        )
+        try:
+            client = connect_unix_socket(socket_path)
+            if client is None:
+                print("❌ Could not connect to mfd_calcd")
+                return False
+
+            with client:
+                client.sendall("".join(first).encode())
+                replies = read_json_lines(client, len(first))
+                time.sleep(0.8)
+                client.sendall("".join(second).encode())
+                later = read_json_lines(client, len(second))
+        finally:
+            daemon.terminate()
+            daemon.wait(timeout=2.0)
+
+    if replies is None or later is None:
+        print("❌ Daemon replies were not valid JSON lines")
+        return False
+
+    errors = []
+    full = {"error": "aircraft table full"}
+    for reply in replies[:64] + later[:64]:
+        if (reply.get("aircraft"), reply.get("frame")) != (reply.get("id"), 1):
+            errors.append(f"Frame reply {reply.get('id')}: got aircraft, frame "
+                          f"{reply.get('aircraft'), reply.get('frame')}")
+    if replies[64] != {"id": 65, **full}:
+        errors.append(f"65th recent aircraft: got {replies[64]}")
+    if later[64] != {"id": 129, **full}:
+        errors.append(f"Aircraft after 64 reused slots: got {later[64]}")
+
+    if errors:
+        print("❌ JSON mismatch:")
+        for err in errors[:5]:
+            print(f" - {err}")
+        return False
+
+    print("✅ Output matches expected data")
+    return True
+
+# Aircraft performance profile of calculators/aircraft_profile.h: Vso, Vne
+# and Mmo of FLIGHT_ARGUMENTS, and an L/D curve peaking at 180 kts
+PROFILE_POINTS = [(100.0, 10.0), (140.0, 15.0), (180.0, 16.0), (220.0, 14.0), (260.0, 11.0)]
+
+def aircraft_profile_image(vso_kts, vne_kts, mmo, points, version=1):
+    """Profile file bytes: header "<IIii3d" then (ias_kts, lift_to_drag) pairs"""
+    header = struct.pack("<IIii3d", 0x50415058, version, len(points), 0, vso_kts, vne_kts, mmo)
+    return header + b"".join(struct.pack("<2d", *point) for point in points)
+
+def profile_glide_expected(agl_ft, ias_kts, tas_kts, headwind_kts):
+    """Glide reach over the profile's points (best L/D, best wind-adjusted range)"""
+    feet_per_nm = 1852.0 / 0.3048
+    best_ld = max(ld for _, ld in PROFILE_POINTS)
+    ratios = [(max(0.0, ld * (1.0 - headwind_kts / (ias * tas_kts / ias_kts))), ias) for ias, ld in PROFILE_POINTS]
+    # First of equal ratios, so a headwind no speed beats keeps the slowest point
+    best_ratio, best_ias = max(ratios, key=lambda ratio: ratio[0])
+    return {
+        "still_air_range_nm": agl_ft * best_ld / feet_per_nm,
+        "wind_adjusted_range_nm": agl_ft * best_ratio / feet_per_nm,
+        "glide_ratio": best_ld,
+        "best_glide_speed_kts": best_ias
+    }
+
+def test_aircraft_profile():
+    """Calculator daemon: dynamic sections take limits and glide from a mapped profile"""
+    print("Testing mfd_calcd --profile")
+    daemon_path = Path(__file__).parent / "mfd_calcd"
+
+    if not daemon_path.exists():
+        print("mfd_calcd not found")
+        return False
+
+    errors = []
+    dynamic = " ".join(FLIGHT_ARGUMENTS[:11])
+    # Hovering over the ground (gs 0) the headwind equals TAS, and at an IAS
+    # above every profile point no speed makes headway: the range clamps to 0
+    hovering = " ".join(["250", "0", "90", "90", "300"] + FLIGHT_ARGUMENTS[5:11])
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        profile_path = Path(tmp_dir) / "aircraft.xpap"
+        bad_profile_path = Path(tmp_dir) / "bad.xpap"
+        profile_path.write_bytes(aircraft_profile_image(120.0, 250.0, 0.82, PROFILE_POINTS))
+        # Speeds out of order
+        bad_profile_path.write_bytes(aircraft_profile_image(120.0, 250.0, 0.82, PROFILE_POINTS[::-1]))
+
+        rejected = subprocess.run([str(daemon_path), "--socket", str(Path(tmp_dir) / "bad.sock"),
+                                   "--profile", str(bad_profile_path)],
+                                  capture_output=True, timeout=5.0)
+        if rejected.returncode != 1:
+            errors.append(f"Invalid profile: expected exit code 1, got {rejected.returncode}")
+
+        replies = {}
+        for name, profile_args in [("profiled", ["--profile", str(profile_path)]), ("plain", [])]:
+            socket_path = str(Path(tmp_dir) / f"{name}.sock")
+            daemon = subprocess.Popen([str(daemon_path), "--socket", socket_path] + profile_args,
+                                      stderr=subprocess.DEVNULL)
+            try:
+                client = connect_unix_socket(socket_path)
+                if client is None:
+                    print("❌ Could not connect to mfd_calcd")
+                    return False
+                with client:
+                    client.sendall(f"1 dynamic {dynamic}\n2 aircraft 7 dynamic {dynamic}\n"
+                                   f"3 dynamic {hovering}\n".encode())
+                    replies[name] = read_json_lines(client, 3)
+            finally:
+                daemon.terminate()
+                daemon.wait(timeout=2.0)
+
+    if replies["profiled"] is None or replies["plain"] is None:
+        print("❌ Daemon replies were not valid JSON lines")
+        return False
+
+    expected = dict(FLIGHT_RESIDENT_EXPECTED,
+                    glide=profile_glide_expected(35000.0, 220.0, 250.0, FLIGHT_EXPECTED["wind"]["headwind"]))
+    for reply in replies["profiled"][:2]:
+        if "dynamic" not in reply:
+            errors.append(f"Missing dynamic section: {reply}")
+        else:
+            for section in ("wind", "envelope", "energy", "glide"):
+                errors += [f"{reply.get('id')}: {section}.{err}"
+                           for err in compare_json(expected[section], reply["dynamic"].get(section, {}))]
+    clamped = profile_glide_expected(35000.0, 300.0, 250.0, 250.0)
+    if clamped["wind_adjusted_range_nm"] != 0.0 or clamped["best_glide_speed_kts"] != PROFILE_POINTS[0][0]:
+        errors.append(f"Expected clamped glide: got {clamped}")
+    errors += [f"3: glide.{err}" for err in
+               compare_json(clamped, replies["profiled"][2].get("dynamic", {}).get("glide", {}))]
+    if replies["profiled"][1].get("aircraft") != 7:
+        errors.append(f"Aircraft frame: got {replies['profiled'][1]}")
+    if replies["plain"][0].get("dynamic") != {"error": 1}:
+        errors.append(f"Dynamic section without a profile: got {replies['plain'][0]}")
+
+    if errors:
+        print("❌ JSON mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print("✅ Output matches expected data")
+    return True
+
+def terrain_tile_image(rows, columns, south_lat_deg, west_lon_deg, spacing_deg, elevation_ft, version=1):
+    """Terrain tile bytes: header "<IIii3d" then Int16 feet, row-major from the south"""
+    header = struct.pack("<IIii3d", 0x45545058, version, rows, columns, south_lat_deg, west_lon_deg, spacing_deg)
+    samples = [elevation_ft(r, c) for r in range(rows) for c in range(columns)]
+    return header + struct.pack(f"<{len(samples)}h", *samples)
+
+def test_glide_footprint():
+    """Calculator daemon: glide footprint over terrain tiles, swept again only past its thresholds"""
+    print("Testing mfd_calcd footprint")
+    daemon_path = Path(__file__).parent / "mfd_calcd"
+
+    if not daemon_path.exists():
+        print("mfd_calcd not found")
+        return False
+
+    # Sea level, with a 9000 ft ridge from 11.2 E (about 8.2 nm east of the
+    # aircraft at 47 N 11 E); still air, fixed 12:1 glide from 10000 ft
+    tile = terrain_tile_image(101, 101, 46.0, 10.0, 0.02, lambda r, c: 9000 if c >= 60 else 0)
+    footprint = "47 11 10000 200 240 240 90 90"
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        tile_path = Path(tmp_dir) / "ridge.xpte"
+        bad_tile_path = Path(tmp_dir) / "bad.xpte"
+        tile_path.write_bytes(tile)
+        bad_tile_path.write_bytes(tile[:-2])  # one sample short
+
+        rejected = subprocess.run([str(daemon_path), "--socket", str(Path(tmp_dir) / "bad.sock"),
+                                   "--terrain", str(tile_path), "--terrain", str(bad_tile_path)],
+                                  capture_output=True, timeout=5.0)
+
+        socket_path = str(Path(tmp_dir) / "mfd_calcd.sock")
+        daemon = subprocess.Popen([str(daemon_path), "--socket", socket_path, "--terrain", str(tile_path)],
+                                  stderr=subprocess.DEVNULL)
+        try:
+            client = connect_unix_socket(socket_path)
+            if client is None:
+                print("❌ Could not connect to mfd_calcd")
+                return False
+            with client:
+                # Swept; moved 0.06 nm (kept); climbed 500 ft (swept again);
+                # another aircraft; a position off the globe
+                client.sendall(f"1 footprint {footprint}\n"
+                               f"2 footprint 47.001 11 10000 200 240 240 90 90\n"
+                               f"3 footprint 47 11 10500 200 240 240 90 90\n"
+                               f"4 aircraft 5 footprint {footprint}\n"
+                               f"5 footprint 95 11 10000 200 240 240 90 90\n".encode())
+                replies = read_json_lines(client, 5)
+
+                # Footprint record, 45 range records, timing and reply records
+                layout = "<" + WIRE_HEADER[1:] + "4dq?" + (WIRE_HEADER[1:] + "8d") * 45 + \
+                         WIRE_HEADER[1:] + "d" + WIRE_HEADER[1:] + "qii"
+                client.sendall(b"6 binary footprint 47 11 10500 200 240 240 90 90\n")
+                binary_reply = unpack_wire(layout, read_bytes(client, struct.calcsize(layout)))
+        finally:
+            daemon.terminate()
+            daemon.wait(timeout=2.0)
+
+    errors = []
+    if rejected.returncode != 1:
+        errors.append(f"Invalid terrain tile: expected exit code 1, got {rejected.returncode}")
+    if replies is None:
+        print("❌ Daemon replies were not valid JSON lines")
+        return False
+
+    reach_nm = 10000.0 * 12.0 * 0.3048 / 1852.0
+    first = replies[0].get("footprint", {})
+    ranges = first.get("range_nm", [])
+    if len(ranges) != 360:
+        errors.append(f"Expected 360 radials, got {len(ranges)}")
+    else:
+        # West of the aircraft the glide reaches sea level
+        for radial in [0] + list(range(180, 360)):
+            if abs(ranges[radial] - reach_nm) > 0.01:
+                errors.append(f"Radial {radial}: expected {reach_nm:.2f} nm, got {ranges[radial]}")
+        # East, the path meets the ridge's face between its foot and top
+        if not 7.3 < ranges[90] < 8.25:
+            errors.append(f"Radial 90 over the ridge: got {ranges[90]}")
+        errors += [f"footprint.{err}" for err in compare_json(
+            {"recomputed": True, "sweeps": 1, "center_north_nm": 0.0, "center_east_nm": 0.0,
+             "min_range_nm": min(ranges), "max_range_nm": round(reach_nm, 2)},
+            {k: v for k, v in first.items() if k != "range_nm"})]
+
+    expected_updates = [(1, False, 1, -0.06), (2, True, 2, 0.0), (3, True, 1, 0.0)]
+    for index, recomputed, sweeps, center_north_nm in expected_updates:
+        update = replies[index].get("footprint", {})
+        if (update.get("recomputed"), update.get("sweeps")) != (recomputed, sweeps) or \
+                abs(update.get("center_north_nm", 1.0) - center_north_nm) > 0.005:
+            errors.append(f"Reply {index + 1}: got {dict(update, range_nm='...')}")
+    if replies[3].get("aircraft") != 5:
+        errors.append(f"Aircraft frame: got {replies[3]}")
+    if replies[4].get("footprint") != {"error": 3}:
+        errors.append(f"Position off the globe: got {replies[4]}")
+
+    if binary_reply is None:
+        errors.append("Binary reply had the wrong size")
+    else:
+        binary_ranges = [binary_reply[14 + 12 * k + i] for k in range(45) for i in range(8)]
+        climbed = replies[2].get("footprint", {}).get("range_nm", [])
+        if binary_reply[2] != 13 or any(binary_reply[10 + 12 * k + 2] != 14 for k in range(45)):
+            errors.append("Binary record types: expected 13 then 14s")
+        if binary_reply[8:10] != (2, False) or len(climbed) != 360 or \
+                any(abs(a - b) > 0.005 for a, b in zip(binary_ranges, climbed)):
+            errors.append(f"Binary footprint: got {binary_reply[4:10]}")
+        if binary_reply[-3:] != (6, 0, 47):
+            errors.append(f"Binary reply record: got {binary_reply[-3:]}")
+
+    if errors:
+        print("❌ JSON mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print("✅ Output matches expected data")
+    return True
+
+def ring_shm_doorbell(channel):
+    """Add 1 to a channel's doorbell and wake the daemon (FUTEX_WAKE)"""
+    doorbell = ctypes.c_uint32.from_buffer(channel, SHM_DOORBELL_OFFSET)
+    doorbell.value += 1
+    libc = ctypes.CDLL(None, use_errno=True)
+    libc.syscall(SYS_FUTEX[platform.machine()], ctypes.c_void_p(ctypes.addressof(doorbell)), 1, 1,
+                 None, None, 0)
+    del doorbell
+
+def test_mfd_calcd_shm():
+    """Calculator daemon --shm: an input frame in shared memory gets its records back"""
+    print("Testing mfd_calcd --shm")
+    daemon_path = Path(__file__).parent / "mfd_calcd"
+
+    if not daemon_path.exists():
+        print("mfd_calcd not found")
+        return False
+
+    # Sleeping on the doorbell the daemon is woken by the client's ring;
+    # spinning it sees the frame with nothing rung. Either way the frame is
+    # answered well before the sleeping daemon's 500 ms safety timeout.
+    errors = []
+    results = {}
+    for mode in ([], ["--spin"]):
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            socket_path = str(Path(tmp_dir) / "mfd_calcd.sock")
+            shm_path = Path(tmp_dir) / "mfd_calcd.shm"
+            daemon = subprocess.Popen(
+                [str(daemon_path), "--socket", socket_path, "--shm", str(shm_path)] + mode,
+                stderr=subprocess.DEVNULL
+            )
+            try:
+                # The channel file exists once the socket accepts connections
+                client = connect_unix_socket(socket_path)
+                if client is None:
+                    print("❌ Could not connect to mfd_calcd")
+                    return False
+                client.close()
+
+                with open(shm_path, "r+b") as f:
+                    channel = mmap.mmap(f.fileno(), 0)
+                header = struct.unpack_from("<IIIII", channel, 0)
+                # Let the daemon fall asleep on the doorbell first
+                time.sleep(0.1)
+
+                # Input frame: turn (bit 1) and density (bit 3), seqlock-written
+                values = [0.0] * 14 + [float(v) for v in TURN_ARGUMENTS] + [0.0] * 5 + \
+                         [float(v) for v in DENSITY_ARGUMENTS] + [0.0]
+                struct.pack_into("<Q", channel, SHM_INPUT_OFFSET, 1)
+                struct.pack_into("<QII14d3d5d5d", channel, SHM_INPUT_OFFSET + 8, 5, 0b1010, 0, *values)
+                struct.pack_into("<Q", channel, SHM_INPUT_OFFSET, 2)
+                published = time.monotonic()
+                if header[4] == 1:
+                    ring_shm_doorbell(channel)
+
+                result = None
+                while result is None and time.monotonic() < published + 2.0:
+                    sequence, frame_id, length, _ = struct.unpack_from("<QQII", channel, SHM_RESULT_OFFSET)
+                    if frame_id == 5 and sequence % 2 == 0:
+                        start = SHM_RESULT_OFFSET + 24
+                        result = bytes(channel[start:start + length])
+                    else:
+                        time.sleep(0.001)
+                answered_s = time.monotonic() - published
+                channel.close()
+            finally:
+                daemon.terminate()
+                daemon.wait(timeout=2.0)
+            channel_removed = not shm_path.exists()
+
+        name = " ".join(["--shm"] + mode)
+        if header != (SHM_MAGIC, 2, 896, 0, 0 if mode else 1):
+            errors.append(f"{name} channel header: got {header}")
+        if not channel_removed:
+            errors.append(f"{name}: channel file left behind after exit")
+        if result is None:
+            print(f"❌ No result frame for the input frame ({name})")
+            return False
+        if answered_s > 0.25:
+            errors.append(f"{name}: frame answered after {answered_s:.3f} s")
+        results[name] = result
+
+    # Turn record, density record, timing record, then the reply record
+    layout = "<" + WIRE_HEADER[1:] + "8d" + WIRE_HEADER[1:] + "8d" + WIRE_HEADER[1:] + "d" + \
+             WIRE_HEADER[1:] + "qii"
+    for name, result in results.items():
+        records = unpack_wire(layout, result)
+        if records is None:
+            errors.append(f"{name}: result frame had the wrong size: {len(result)} bytes")
+        else:
+            errors += [f"{name} turn.{err}" for err in
+                       compare_json(TURN_EXPECTED, dict(zip(TURN_EXPECTED, records[4:12])))]
+            errors += [f"{name} density.{err}" for err in
+                       compare_json(DENSITY_EXPECTED, dict(zip(DENSITY_EXPECTED, records[16:24])))]
+            if records[26] != 11 or records[28] < 0:
+                errors.append(f"{name} timing record: got {records[24:29]}")
+            if records[33:] != (5, 0, 3):
+                errors.append(f"{name} reply record: got {records[33:]}")
+
+    if errors:
+        print("❌ Shared-memory mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print("✅ Output matches expected data")
+    return True
+
+# Binary wire format (calculators/wire_format.h), spelled out independently
+# of the decoder in aircraft_mfd.py so a layout change fails here
+WIRE_HEADER = "<IBBH"
+WIRE_MAGIC = 0x44464D58
+
+# Shared-memory channel (calculators/shm_channel.h)
+SHM_MAGIC = 0x53464D58
+SHM_DOORBELL_OFFSET = 12
+SHM_INPUT_OFFSET = 64
+SHM_RESULT_OFFSET = 320
+SYS_FUTEX = {"x86_64": 202, "aarch64": 98}
+
+def unpack_wire(layout, data):
+    """Unpack one fixed-layout binary output; None if the size is wrong"""
+    if len(data) != struct.calcsize(layout):
+        return None
+    return struct.unpack(layout, data)
+
+def test_binary_output():
+    """--binary writes fixed-layout records holding the same values as the JSON"""
+    print("Testing --binary output")
+    script_dir = Path(__file__).parent
+    errors = []
+
+    cases = [
+        ("turn_calculator", TURN_ARGUMENTS, [(5, TURN_EXPECTED, "8d")]),
+        ("vnav_calculator", VNAV_ARGUMENTS, [(6, VNAV_EXPECTED, "7d?")]),
+        ("density_altitude_calculator", DENSITY_ARGUMENTS, [(7, DENSITY_EXPECTED, "8d")]),
+        ("flight_calculator", FLIGHT_ARGUMENTS, [
+            (1, FLIGHT_EXPECTED["wind"], "5d"),
+            (2, FLIGHT_EXPECTED["envelope"], "6d"),
+            (3, FLIGHT_EXPECTED["energy"], "2di"),
+            (4, FLIGHT_EXPECTED["glide"], "4d")
+        ])
+    ]
+
+    for filename, arguments, records in cases:
+        result = subprocess.run(
+            [str(script_dir / filename), "--binary"] + arguments,
+            capture_output=True,
+            timeout=2.0
+        )
+        # One struct.unpack call for the whole output
+        layout = "<" + "".join(WIRE_HEADER[1:] + fmt for _, _, fmt in records)
+        values = unpack_wire(layout, result.stdout)
+        if result.returncode != 0 or values is None:
+            errors.append(f"{filename}: expected {struct.calcsize(layout)} bytes, "
+                          f"got {len(result.stdout)} (return code {result.returncode})")
+            continue
+
+        values = list(values)
+        for record_type, expected, fmt in records:
+            magic, version, actual_type, size = values[:4]
+            fields = values[4:4 + len(expected)]
+            values = values[4 + len(expected):]
+            if (magic, version, actual_type, size) != (WIRE_MAGIC, 1, record_type, struct.calcsize("<" + fmt)):
+                errors.append(f"{filename}: bad header for record type {record_type}")
+            errors += [f"{filename}.{err}" for err in
+                       compare_json(expected, dict(zip(expected, fields)))]
+
+    # Rejected inputs still exit with the calculator's error code
+    result = subprocess.run(
+        [str(script_dir / "turn_calculator"), "--binary", "250", "95", "90"],
+        capture_output=True,
+        timeout=2.0
+    )
+    if result.returncode != 3 or result.stdout:
+        errors.append(f"turn_calculator: invalid bank returned {result.returncode}")
+
+    if errors:
+        print("❌ Binary output mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print("✅ Output matches expected data")
+    return True
+
+def test_calc_batch():
+    """Batch replay: CSV and column file rows match the one-shot calculators"""
+    print("Testing calc_batch")
+    batch_path = Path(__file__).parent / "calc_batch"
+
+    if not batch_path.exists():
+        print("calc_batch not found")
+        return False
+
+    errors = []
+
+    # CSV: header line skipped, rejected turn inputs come back as nan
+    csv_input = "tas_kts,bank_deg,course_change_deg\n" + ",".join(TURN_ARGUMENTS) + "\n250,95,90\n"
+    result = subprocess.run([str(batch_path), "turn"], input=csv_input,
+                            capture_output=True, text=True, timeout=2.0)
+    lines = result.stdout.splitlines()
+    if result.returncode != 0 or len(lines) != 3:
+        errors.append(f"turn CSV: return code {result.returncode}, {len(lines)} lines")
+    else:
+        header = lines[0].split(",")
+        row = dict(zip(header, (float(v) for v in lines[1].split(","))))
+        errors += [f"turn CSV.{err}" for err in compare_json(TURN_EXPECTED, row)]
+        if lines[2] != ",".join(["nan"] * len(header)):
+            errors.append(f"turn CSV: invalid row gave {lines[2]}")
+
+    # Column file: energy inputs of the flight test, two one-row blocks
+    tas, altitude, vs = float(FLIGHT_ARGUMENTS[0]), float(FLIGHT_ARGUMENTS[6]), float(FLIGHT_ARGUMENTS[8])
+    block = struct.pack("<I3d", 1, tas, altitude, vs)
+    column_input = struct.pack(WIRE_HEADER, 0x43464D58, 1, 0, 3) + block * 2 + struct.pack("<I", 0)
+    result = subprocess.run([str(batch_path), "--columns", "energy"], input=column_input,
+                            capture_output=True, timeout=2.0)
+    layout = WIRE_HEADER + "I3dI3dI"
+    values = unpack_wire(layout, result.stdout)
+    if result.returncode != 0 or values is None:
+        errors.append(f"energy columns: return code {result.returncode}, {len(result.stdout)} bytes")
+    else:
+        if values[:4] != (0x43464D58, 1, 0, 3) or values[4] != 1 or values[8] != 1 or values[12] != 0:
+            errors.append(f"energy columns: bad framing {values}")
+        for fields in (values[5:8], values[9:12]):
+            errors += [f"energy columns.{err}" for err in
+                       compare_json(FLIGHT_EXPECTED["energy"], dict(zip(FLIGHT_EXPECTED["energy"], fields)))]
+
+    # Wrong field count is an error, not a skipped row
+    result = subprocess.run([str(batch_path), "turn"], input="250,25,90\n250,25\n",
+                            capture_output=True, text=True, timeout=2.0)
+    if result.returncode != 2:
+        errors.append(f"short CSV row: expected return code 2, got {result.returncode}")
+
+    if errors:
+        print("❌ Batch output mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print("✅ Output matches expected data")
+    return True
+
+def simd_sweep_rows(kernel):
+    """Deterministic input sweep for one kernel (row count not a multiple of 4)"""
+    rows = []
+    for i in range(4099):
+        if kernel == "turn":
+            # +/-180 deg puts tan(course/2) on its pole, outside the SIMD error bound
+            rows.append((80 + i % 400, -60 + (i * 7) % 121, (i * 13) % 359 - 179))
+        elif kernel == "vnav":
+            rows.append((1000 + (i * 37) % 40000, 500 + (i * 53) % 30000, 1 + (i * 3) % 150,
+                         60 + i % 450, -3000 + (i * 11) % 6000))
+        else:
+            rows.append(((i * 7) % 720 - 360, (i * 11) % 360, (i * 17) % 1080 - 360, (i % 80) - 5))
+    return rows
+
+def test_calc_batch_simd():
+    """SIMD batch kernels agree with the scalar reference kernels"""
+    print("Testing calc_batch SIMD kernels")
+    batch_path = Path(__file__).parent / "calc_batch"
+
+    if not batch_path.exists():
+        print("calc_batch not found")
+        return False
+
+    errors = []
+    for kernel in ("turn", "vnav", "wind"):
+        csv_input = "".join(",".join(str(v) for v in row) + "\n" for row in simd_sweep_rows(kernel))
+        outputs = []
+        for flags in ([], ["--scalar"]):
+            result = subprocess.run([str(batch_path)] + flags + [kernel], input=csv_input,
+                                    capture_output=True, text=True, timeout=5.0)
+            if result.returncode != 0:
+                errors.append(f"{kernel} {flags}: return code {result.returncode}")
+            outputs.append(result.stdout.splitlines())
+
+        simd_lines, scalar_lines = outputs
+        if len(simd_lines) != len(scalar_lines):
+            errors.append(f"{kernel}: {len(simd_lines)} SIMD rows, {len(scalar_lines)} scalar rows")
+            continue
+        header = simd_lines[0].split(",") if simd_lines else []
+        for simd_line, scalar_line in zip(simd_lines[1:], scalar_lines[1:]):
+            for name, simd_text, scalar_text in zip(header, simd_line.split(","), scalar_line.split(",")):
+                simd_value, scalar_value = float(simd_text), float(scalar_text)
+                if math.isnan(scalar_value) and math.isnan(simd_value):
+                    continue
+                if not math.isclose(simd_value, scalar_value, rel_tol=1e-12, abs_tol=1e-9):
+                    errors.append(f"{kernel}.{name}: SIMD {simd_value} scalar {scalar_value}")
+        if len(errors) > 10:
+            break
+
+    if errors:
+        print("❌ SIMD output differs from scalar:")
+        for err in errors[:10]:
+            print(f" - {err}")
+        return False
+
+    print("✅ SIMD output matches scalar kernels")
+    return True
+
+BENCH_KERNELS = [
+    "calculate_wind", "calculate_envelope", "calculate_energy", "calculate_glide_reach",
+    "calculate_turn_performance", "calculate_vnav", "calculate_density_altitude_data",
+    "isa_pressure_ratio", "isa_density_ratio",
+    "vnav_predictor/full_profile", "vnav_predictor/upper_wind_frame", "vnav_predictor/predict",
+    "calculate_glide_reach/profile", "calculate_flight_sample/profile",
+    "glide_footprint/sweep", "glide_footprint/hold",
+    "wind_estimator/update", "wind_profile/vnav_layers", "flight_log_ring/push+pop",
+    "metrics/kernel_call"
+]
+
+def test_calc_bench():
+    """Benchmark suite covers every kernel and the kernels never allocate"""
+    print("Testing calc_bench")
+    bench_path = Path(__file__).parent / "calc_bench"
+
+    if not bench_path.exists():
+        print("calc_bench not found")
+        return False
+
+    result = subprocess.run([str(bench_path)], capture_output=True, text=True, timeout=30.0)
+    if result.returncode != 0:
+        print(f"❌ Return code mismatch: expected 0, got {result.returncode}")
+        return False
+
+    # name, ns/op, p99 ns, allocs/op, iterations
+    rows = {}
+    for line in result.stdout.splitlines()[1:]:
+        fields = line.split()
+        rows[fields[0]] = [float(v) for v in fields[1:]]
+
+    errors = []
+    for name in BENCH_KERNELS + ["print_json_results", "parse_flight_inputs"]:
+        if name not in rows:
+            errors.append(f"Missing benchmark: {name}")
+        elif rows[name][0] <= 0.0 or rows[name][3] <= 0:
+            errors.append(f"{name}: no timing ({rows[name]})")
+    for name in BENCH_KERNELS:
+        if name in rows and rows[name][2] != 0.0:
+            errors.append(f"{name}: {rows[name][2]} allocations per call")
+
+    # The release build's gate: any single allocation fails it
+    checked = subprocess.run([str(bench_path), "--check-allocs", "calculate_vnav"], capture_output=True,
+                             text=True, timeout=30.0)
+    if checked.returncode != 0 or "calculate_vnav" not in checked.stdout:
+        errors.append(f"--check-allocs: return code {checked.returncode}, {checked.stderr.strip()}")
+
+    if errors:
+        print("❌ Benchmark output mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print("✅ Every kernel benchmarked, no allocations")
+    return True
+
+def connect_unix_socket(socket_path, timeout=2.0):
+    """Connect to a Unix socket, waiting for the server to create it"""
+    deadline = time.monotonic() + timeout
+    while time.monotonic() < deadline:
+        client = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        client.settimeout(timeout)
+        try:
+            client.connect(socket_path)
+            return client
+        except OSError:
+            client.close()
+            time.sleep(0.05)
+    return None
+
+def read_json_lines(client, count):
+    """Read count newline-terminated JSON replies from a socket"""
+    data = b""
+    try:
+        while data.count(b"\n") < count:
+            chunk = client.recv(65536)
+            if not chunk:
+                break
+            data += chunk
+        lines = data.decode().splitlines()
+        if len(lines) < count:
+            return None
+        return [json.loads(line) for line in lines[:count]]
+    except (OSError, ValueError):
+        return None
+
+def read_bytes(client, count):
+    """Read exactly count bytes from a socket (fewer on timeout or close)"""
+    data = b""
+    try:
+        while len(data) < count:
+            chunk = client.recv(count - len(data))
+            if not chunk:
+                break
+            data += chunk
+    except OSError:
+        pass
+    return data
+
+# C structs of calculators/xpmfd_calc.h, declared here independently of
+# aircraft_mfd.py so a layout change fails here
+XPMFD_CALC_API_VERSION = 4
+
+def double_struct(*names, extra=()):
+    fields = [(name, ctypes.c_double) for name in names] + list(extra)
+    return type("XpmfdStruct", (ctypes.Structure,), {"_fields_": fields})
+
+XpmfdWindData = double_struct(*FLIGHT_EXPECTED["wind"])
+XpmfdEnvelopeMargins = double_struct(*FLIGHT_EXPECTED["envelope"])
+XpmfdEnergyData = double_struct("specific_energy_ft", "energy_rate_kts", extra=[("trend", ctypes.c_int32)])
+XpmfdGlideData = double_struct(*FLIGHT_EXPECTED["glide"])
+XpmfdFlightInputs = double_struct("tas_kts", "gs_kts", "heading", "track", "ias_kts", "mach",
+                                  "altitude_ft", "agl_ft", "vs_fpm", "weight_kg", "bank_deg",
+                                  "vso_kts", "vne_kts", "mmo")
+XpmfdTurnData = double_struct(*TURN_EXPECTED)
+XpmfdVnavData = double_struct(*list(VNAV_EXPECTED)[:-1], extra=[("is_descent", ctypes.c_bool)])
+XpmfdDensityAltitudeData = double_struct(*DENSITY_EXPECTED)
+XpmfdWindComponents = double_struct("headwind", "crosswind", "total_wind", "wca", "drift")
+
+XpmfdVnavSettings = double_struct("cruise_alt_ft", "runway_elevation_ft", "descent_mach",
+                                  "descent_ias_kts", "speed_limit_ias_kts", "speed_limit_alt_ft",
+                                  "descent_vs_fpm", "final_approach_fpa_deg", "final_approach_fix_nm",
+                                  "isa_deviation_c")
+XpmfdVnavConstraint = double_struct("distance_nm", "max_alt_ft", "min_alt_ft")
+XpmfdVnavWindLayer = double_struct("altitude_ft", "headwind_kts")
+XpmfdVnavProfileStep = double_struct("distance_nm", "altitude_ft", "time_s", "gs_kts")
+XpmfdVnavPrediction = double_struct("path_altitude_ft", "vertical_deviation_ft", "tod_distance_nm",
+                                    "required_vs_fpm", "gs_kts", "time_to_runway_min",
+                                    "time_to_next_constraint_min", "next_constraint_alt_ft",
+                                    extra=[("next_constraint", ctypes.c_int32),
+                                           ("next_constraint_met", ctypes.c_bool)])
+
+class XpmfdVnavProgress(ctypes.Structure):
+    _fields_ = [("steps_done", ctypes.c_int32), ("step_count", ctypes.c_int32),
+                ("complete", ctypes.c_bool), ("truncated", ctypes.c_bool)]
+
+class XpmfdFlightResults(ctypes.Structure):
+    _fields_ = [("wind", XpmfdWindData), ("envelope", XpmfdEnvelopeMargins),
+                ("energy", XpmfdEnergyData), ("glide", XpmfdGlideData)]
+
+def struct_values(data):
+    return {name: getattr(data, name) for name, _ in data._fields_}
+
+def test_calculator_library():
+    """libxpmfd_calc: the C API returns what the calculator programs print"""
+    print("Testing libxpmfd_calc")
+    library_path = Path(__file__).parent / "libxpmfd_calc.so"
+
+    if not library_path.exists():
+        print("libxpmfd_calc.so not found")
+        return False
+
+    lib = ctypes.CDLL(str(library_path))
+    lib.xpmfd_flight_state_create.restype = ctypes.c_void_p
+    lib.xpmfd_flight_state_destroy.argtypes = [ctypes.c_void_p]
+    lib.xpmfd_calculate_flight.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p]
+    double = ctypes.c_double
+    lib.xpmfd_calculate_turn.argtypes = [double] * 3 + [ctypes.c_void_p]
+    lib.xpmfd_calculate_vnav.argtypes = [double] * 5 + [ctypes.c_void_p]
+    lib.xpmfd_calculate_density_altitude.argtypes = [double] * 4 + [ctypes.c_void_p]
+    lib.xpmfd_calculate_wind.argtypes = [double] * 4 + [ctypes.c_void_p]
+
+    errors = []
+    version = lib.xpmfd_calc_version()
+    if version != XPMFD_CALC_API_VERSION:
+        errors.append(f"API version {version}, expected {XPMFD_CALC_API_VERSION}")
+
+    def check(label, function, arguments, out, expected):
+        status = function(*[float(a) for a in arguments], ctypes.byref(out))
+        if status != 0:
+            errors.append(f"{label}: status {status}")
+        else:
+            errors.extend(f"{label}: {e}" for e in compare_json(expected, struct_values(out)))
+
+    check("turn", lib.xpmfd_calculate_turn, TURN_ARGUMENTS, XpmfdTurnData(), TURN_EXPECTED)
+    check("vnav", lib.xpmfd_calculate_vnav, VNAV_ARGUMENTS, XpmfdVnavData(), VNAV_EXPECTED)
+    check("density", lib.xpmfd_calculate_density_altitude, DENSITY_ARGUMENTS,
+          XpmfdDensityAltitudeData(), DENSITY_EXPECTED)
+    check("wind", lib.xpmfd_calculate_wind, ["090", "085", "240", "60"], XpmfdWindComponents(),
+          {"headwind": 51.96, "crosswind": 30.00, "total_wind": 60.00, "wca": 0.00, "drift": 5.00})
+
+    # The flight state holds the IAS history across calls, as --serve does
+    state = lib.xpmfd_flight_state_create()
+    if not state:
+        errors.append("xpmfd_flight_state_create returned null")
+    else:
+        inputs = XpmfdFlightInputs(*[float(a) for a in FLIGHT_ARGUMENTS])
+        for _ in range(2):
+            out = XpmfdFlightResults()
+            status = lib.xpmfd_calculate_flight(state, ctypes.byref(inputs), ctypes.byref(out))
+            if status != 0:
+                errors.append(f"flight: status {status}")
+                break
+            for section, _ in out._fields_:
+                actual = struct_values(getattr(out, section))
+                errors.extend(f"flight {section}: {e}"
+                              for e in compare_json(FLIGHT_RESIDENT_EXPECTED[section], actual))
+        if lib.xpmfd_calculate_flight(state, ctypes.byref(inputs), None) != 1:
+            errors.append("flight: null result not rejected")
+        lib.xpmfd_flight_state_destroy(state)
+
+    # Rejected inputs return the standalone calculator's exit code
+    rejected = [
+        ("turn bank 95", lib.xpmfd_calculate_turn(250.0, 95.0, 90.0, ctypes.byref(XpmfdTurnData())), 3),
+        ("wind speed -1", lib.xpmfd_calculate_wind(90.0, 85.0, 240.0, -1.0,
+                                                   ctypes.byref(XpmfdWindComponents())), 3),
+        ("density out of range", lib.xpmfd_calculate_density_altitude(
+            70000.0, 25.0, 150.0, 170.0, ctypes.byref(XpmfdDensityAltitudeData())), 1),
+        ("turn null result", lib.xpmfd_calculate_turn(250.0, 25.0, 90.0, None), 1),
+    ]
+    for label, status, expected_status in rejected:
+        if status != expected_status:
+            errors.append(f"{label}: status {status}, expected {expected_status}")
+
+    if errors:
+        print("❌ libxpmfd_calc mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+    print("✅ libxpmfd_calc matches the calculators")
+    return True
+
+# Descent from FL350: 0.78 / 280 kt, 250 kt below 10000 ft, 2200 fpm, 3° final
+# from 6 nm, three constraints, four wind layers (calc_bench uses the same)
+VNAV_PREDICTOR_SETTINGS = (35000.0, 500.0, 0.78, 280.0, 250.0, 10000.0, 2200.0, 3.0, 6.0, 0.0)
+VNAV_PREDICTOR_CONSTRAINTS = [(12.0, 4000.0, 3000.0), (30.0, 11000.0, 9000.0), (60.0, 24000.0, 0.0)]
+VNAV_PREDICTOR_WINDS = [(0.0, 5.0), (10000.0, 20.0), (20000.0, 40.0), (35000.0, 60.0)]
+
+def test_vnav_predictor():
+    """VNAV predictor: profile meets its constraints, incremental updates match a rebuild"""
+    print("Testing VNAV trajectory predictor")
+    library_path = Path(__file__).parent / "libxpmfd_calc.so"
+
+    if not library_path.exists():
+        print("libxpmfd_calc.so not found")
+        return False
+
+    lib = ctypes.CDLL(str(library_path))
+    handle = ctypes.c_void_p
+    lib.xpmfd_vnav_predictor_create.restype = handle
+    lib.xpmfd_vnav_predictor_destroy.argtypes = [handle]
+    lib.xpmfd_vnav_set_settings.argtypes = [handle, handle]
+    lib.xpmfd_vnav_set_constraints.argtypes = [handle, handle, ctypes.c_int32]
+    lib.xpmfd_vnav_set_wind_layers.argtypes = [handle, handle, ctypes.c_int32]
+    lib.xpmfd_vnav_advance.argtypes = [handle, ctypes.c_int32, handle]
+    lib.xpmfd_vnav_profile_step.argtypes = [handle, ctypes.c_int32, handle]
+    lib.xpmfd_vnav_predict.argtypes = [handle, ctypes.c_double, ctypes.c_double, handle]
+
+    def configure(predictor, settings, constraints, winds):
+        constraint_array = (XpmfdVnavConstraint * len(constraints))(*constraints)
+        wind_array = (XpmfdVnavWindLayer * len(winds))(*winds)
+        return (lib.xpmfd_vnav_set_settings(predictor, ctypes.byref(XpmfdVnavSettings(*settings))),
+                lib.xpmfd_vnav_set_constraints(predictor, constraint_array, len(constraints)),
+                lib.xpmfd_vnav_set_wind_layers(predictor, wind_array, len(winds)))
+
+    def advance(predictor, max_steps):
+        progress = XpmfdVnavProgress()
+        lib.xpmfd_vnav_advance(predictor, max_steps, ctypes.byref(progress))
+        return progress
+
+    def profile(predictor, count):
+        steps = []
+        for index in range(count):
+            step = XpmfdVnavProfileStep()
+            lib.xpmfd_vnav_profile_step(predictor, index, ctypes.byref(step))
+            steps.append(tuple(struct_values(step).values()))
+        return steps
+
+    def predict(predictor, distance_nm, altitude_ft):
+        out = XpmfdVnavPrediction()
+        status = lib.xpmfd_vnav_predict(predictor, distance_nm, altitude_ft, ctypes.byref(out))
+        return status, out
+
+    errors = []
+    predictor = lib.xpmfd_vnav_predictor_create()
+    rebuilt = lib.xpmfd_vnav_predictor_create()
+    if not predictor or not rebuilt:
+        print("❌ xpmfd_vnav_predictor_create returned null")
+        return False
+
+    if configure(predictor, VNAV_PREDICTOR_SETTINGS, VNAV_PREDICTOR_CONSTRAINTS,
+                 VNAV_PREDICTOR_WINDS) != (0, 0, 0):
+        errors.append("inputs rejected")
+
+    # A step budget bounds the work per call; beyond the steps done so far
+    # predict is pending
+    progress = advance(predictor, 16)
+    if progress.steps_done != 16 or progress.complete:
+        errors.append(f"advance(16): {progress.steps_done} steps, complete {progress.complete}")
+    if predict(predictor, 50.0, 20000.0)[0] != 4:
+        errors.append("prediction beyond the integrated steps not pending")
+
+    progress = advance(predictor, 4096)
+    if not progress.complete or progress.truncated:
+        errors.append(f"profile incomplete after {progress.step_count} steps")
+    steps = profile(predictor, progress.step_count)
+
+    for earlier, later in zip(steps, steps[1:]):
+        if not (later[0] > earlier[0] and later[1] >= earlier[1] and later[2] > earlier[2]):
+            errors.append(f"profile not monotonic at {earlier} -> {later}")
+            break
+    if steps and steps[-1][1] != VNAV_PREDICTOR_SETTINGS[0]:
+        errors.append(f"profile ends at {steps[-1][1]} ft, not cruise")
+
+    # "At or below" constraints are met exactly at their distance
+    distances = {step[0]: step[1] for step in steps}
+    for distance_nm, max_alt_ft, _ in VNAV_PREDICTOR_CONSTRAINTS:
+        if distance_nm not in distances:
+            errors.append(f"no step ends on the constraint at {distance_nm} nm")
+        elif distances[distance_nm] > max_alt_ft:
+            errors.append(f"{distances[distance_nm]:.0f} ft at {distance_nm} nm (max {max_alt_ft:.0f})")
+
+    # Inside the FAF the path is the geometric 3° glide path
+    status, out = predict(predictor, 3.0, 1500.0)
+    glide_path_ft = 500.0 + math.tan(math.radians(3.0)) * 3.0 * 1852.0 / 0.3048
+    if status != 0 or abs(out.path_altitude_ft - glide_path_ft) > 0.5:
+        errors.append(f"3 nm: path {out.path_altitude_ft:.1f} ft, expected {glide_path_ft:.1f}")
+    elif abs(out.vertical_deviation_ft - (1500.0 - out.path_altitude_ft)) > 1e-9:
+        errors.append(f"3 nm: deviation {out.vertical_deviation_ft}")
+
+    status, out = predict(predictor, 20.0, 9000.0)
+    if status != 0 or out.next_constraint != 0 or not out.next_constraint_met:
+        errors.append(f"20 nm: next constraint {out.next_constraint}, met {out.next_constraint_met}")
+    elif not (out.required_vs_fpm < 0.0 and out.tod_distance_nm > 0.0 and out.time_to_runway_min > 0.0):
+        errors.append(f"20 nm: {struct_values(out)}")
+
+    status, out = predict(predictor, steps[-1][0] + 20.0, 35000.0)
+    if status != 0 or out.required_vs_fpm != 0.0 or abs(out.tod_distance_nm - 20.0) > 1e-9:
+        errors.append(f"before TOD: {struct_values(out)}")
+
+    # A top wind layer change keeps the steps below the layer beneath it
+    winds = VNAV_PREDICTOR_WINDS[:-1] + [(35000.0, 80.0)]
+    lib.xpmfd_vnav_set_wind_layers(predictor, (XpmfdVnavWindLayer * len(winds))(*winds), len(winds))
+    kept = advance(predictor, 0).step_count
+    if not 0 < kept < len(steps):
+        errors.append(f"upper wind change kept {kept} of {len(steps)} steps")
+
+    # Changed inputs, integrated a few steps per frame, give the profile a
+    # fresh predictor builds in one go
+    settings = list(VNAV_PREDICTOR_SETTINGS)
+    settings[0] = 37000.0
+    constraints = [VNAV_PREDICTOR_CONSTRAINTS[0], (30.0, 10000.0, 9000.0), VNAV_PREDICTOR_CONSTRAINTS[2]]
+    configure(predictor, settings, constraints, winds)
+    frames = 0
+    while not advance(predictor, 32).complete and frames < 200:
+        frames += 1
+    configure(rebuilt, settings, constraints, winds)
+    full = advance(rebuilt, 4096)
+    if profile(predictor, advance(predictor, 0).step_count) != profile(rebuilt, full.step_count):
+        errors.append("incremental profile differs from a rebuild")
+
+    # Rejected inputs leave the profile alone
+    unsorted = (XpmfdVnavConstraint * 2)((30.0, 11000.0, 0.0), (12.0, 4000.0, 0.0))
+    bad_settings = list(VNAV_PREDICTOR_SETTINGS)
+    bad_settings[0] = 0.0
+    rejected = [
+        ("unsorted constraints", lib.xpmfd_vnav_set_constraints(predictor, unsorted, 2)),
+        ("cruise below runway", lib.xpmfd_vnav_set_settings(predictor,
+                                                            ctypes.byref(XpmfdVnavSettings(*bad_settings)))),
+        ("too many layers", lib.xpmfd_vnav_set_wind_layers(predictor, None, 9)),
+        ("step out of range", lib.xpmfd_vnav_profile_step(predictor, 5000, ctypes.byref(XpmfdVnavProfileStep()))),
+    ]
+    for label, status in rejected:
+        if status != 1:
+            errors.append(f"{label}: status {status}, expected 1")
+    if not advance(predictor, 0).complete:
+        errors.append("rejected input invalidated the profile")
+
+    # The same layers again (a display sets them every frame) keep every
+    # step, in still air too
+    for layers in (winds, []):
+        lib.xpmfd_vnav_set_wind_layers(rebuilt, (XpmfdVnavWindLayer * len(layers))(*layers), len(layers))
+        before = advance(rebuilt, 4096).step_count
+        lib.xpmfd_vnav_set_wind_layers(rebuilt, (XpmfdVnavWindLayer * len(layers))(*layers), len(layers))
+        kept = advance(rebuilt, 0).step_count
+        if kept != before:
+            errors.append(f"unchanged {len(layers)} wind layers kept {kept} of {before} steps")
+
+    lib.xpmfd_vnav_predictor_destroy(predictor)
+    lib.xpmfd_vnav_predictor_destroy(rebuilt)
+
+    if errors:
+        print("❌ VNAV predictor mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+    print(f"✅ {len(steps)}-step profile meets its constraints; {frames + 1} frames of 32 steps match a rebuild")
+    return True
+
+XpmfdWindSample = double_struct("time_s", "altitude_ft", "tas_kts", "gs_kts", "heading", "track")
+XpmfdWindEstimate = double_struct("speed_kts", "direction_from", "headwind", "crosswind", "uncertainty_kts",
+                                  "confidence", extra=[("sample_count", ctypes.c_int64)])
+
+def wind_samples(count, start_s, altitude_ft, wind_from_deg, wind_kts, noise, seed):
+    """(time_s, altitude_ft, tas, gs, heading, track) samples at 1 s through a
+    constant wind, heading weaving slowly; noise is the gs (kt) and track (deg)
+    standard deviation"""
+    rng = random.Random(seed)
+    wind_east = -wind_kts * math.sin(math.radians(wind_from_deg))
+    wind_north = -wind_kts * math.cos(math.radians(wind_from_deg))
+    samples = []
+    for i in range(count):
+        heading = 10.0 + 5.0 * math.sin(i / 15.0)
+        east = 250.0 * math.sin(math.radians(heading)) + wind_east
+        north = 250.0 * math.cos(math.radians(heading)) + wind_north
+        gs = math.hypot(east, north) + rng.gauss(0.0, noise)
+        track = math.degrees(math.atan2(east, north)) % 360.0 + rng.gauss(0.0, noise / 3.0)
+        samples.append((start_s + i, altitude_ft, 250.0, gs, heading, track))
+    return samples
+
+def triangle_wind_speed(sample):
+    """One-sample wind speed, as calculate_wind_vector"""
+    _, _, tas, gs, heading, track = sample
+    return math.hypot(gs * math.sin(math.radians(track)) - tas * math.sin(math.radians(heading)),
+                      gs * math.cos(math.radians(track)) - tas * math.cos(math.radians(heading)))
+
+def test_wind_estimator():
+    """Wind estimator: filtered wind and confidence, and a wind profile the VNAV predictor reads"""
+    print("Testing mfd_calcd wind_estimate")
+    daemon_path = Path(__file__).parent / "mfd_calcd"
+    library_path = Path(__file__).parent / "libxpmfd_calc.so"
+
+    if not daemon_path.exists() or not library_path.exists():
+        print("mfd_calcd or libxpmfd_calc.so not found")
+        return False
+
+    # Wind from 270 at 30 kt, 2 kt groundspeed and 0.7 deg track noise
+    samples = wind_samples(120, 0.0, 30000.0, 270.0, 30.0, 2.0, 24)
+    lines = "".join(f"{i + 1} wind_estimate {' '.join(f'{v:.4f}' for v in sample)}\n"
+                    for i, sample in enumerate(samples))
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        socket_path = str(Path(tmp_dir) / "mfd_calcd.sock")
+        daemon = subprocess.Popen([str(daemon_path), "--socket", socket_path], stderr=subprocess.DEVNULL)
+        try:
+            client = connect_unix_socket(socket_path)
+            if client is None:
+                print("❌ Could not connect to mfd_calcd")
+                return False
+            with client:
+                # Then: ground roll (not fused), a negative TAS, another aircraft
+                client.sendall((lines + "121 wind_estimate 121 0 20 20 0 0\n"
+                                        "122 wind_estimate 122 0 -1 20 0 0\n"
+                                        "123 aircraft 9 wind_estimate 0 30000 250 260 10 10\n").encode())
+                replies = read_json_lines(client, 123)
+
+                # Wind estimate record, timing and reply records
+                layout = "<" + WIRE_HEADER[1:] + "6dq?" + WIRE_HEADER[1:] + "d" + WIRE_HEADER[1:] + "qii"
+                client.sendall(f"124 binary wind_estimate 124 {' '.join(str(v) for v in samples[-1][1:])}\n".encode())
+                binary_reply = unpack_wire(layout, read_bytes(client, struct.calcsize(layout)))
+        finally:
+            daemon.terminate()
+            daemon.wait(timeout=2.0)
+
+    if replies is None:
+        print("❌ Daemon replies were not valid JSON lines")
+        return False
+
+    errors = []
+    estimates = [reply.get("wind_estimate", {}) for reply in replies]
+    first, last = estimates[0], estimates[119]
+    if (first.get("confidence"), first.get("samples"), first.get("fused")) != (0.5, 1, True):
+        errors.append(f"First sample: got {first}")
+    if abs(last.get("speed_kts", 0.0) - 30.0) > 1.5 or abs(last.get("direction_from", 0.0) - 270.0) > 3.0:
+        errors.append(f"Estimate after 120 s: got {last}")
+    if not last.get("confidence", 0.0) > 0.85 or not last.get("confidence", 0.0) > estimates[5].get("confidence"):
+        errors.append(f"Confidence: {estimates[5].get('confidence')} after 6 s, {last.get('confidence')} after 120 s")
+
+    # The displayed wind moves far less than the one-sample solution
+    filtered = statistics.pstdev(e.get("speed_kts", 0.0) for e in estimates[60:120])
+    raw = statistics.pstdev(triangle_wind_speed(sample) for sample in samples[60:])
+    if not filtered < 0.3 * raw:
+        errors.append(f"Speed jitter {filtered:.2f} kt filtered, {raw:.2f} kt raw")
+
+    if (estimates[120].get("fused"), estimates[120].get("samples")) != (False, 120):
+        errors.append(f"Ground roll sample: got {estimates[120]}")
+    if estimates[121] != {"error": 3}:
+        errors.append(f"Negative TAS: got {estimates[121]}")
+    if replies[122].get("aircraft") != 9 or estimates[122].get("samples") != 1:
+        errors.append(f"Aircraft's own estimator: got {replies[122]}")
+    if binary_reply is None:
+        errors.append("Binary reply had the wrong size")
+    elif binary_reply[2] != 15 or binary_reply[10:12] != (121, True) or binary_reply[-3:] != (124, 0, 2):
+        errors.append(f"Binary wind estimate: got {binary_reply}")
+
+    # A climb through two wind bands, then a descent on 270 from the profile
+    lib = ctypes.CDLL(str(library_path))
+    handle = ctypes.c_void_p
+    lib.xpmfd_flight_state_create.restype = handle
+    lib.xpmfd_flight_state_destroy.argtypes = [handle]
+    lib.xpmfd_estimate_wind.argtypes = [handle, handle, handle]
+    lib.xpmfd_wind_profile_layers.argtypes = [handle, ctypes.c_double, handle, ctypes.c_int32, handle]
+    lib.xpmfd_vnav_predictor_create.restype = handle
+    lib.xpmfd_vnav_predictor_destroy.argtypes = [handle]
+    lib.xpmfd_vnav_set_settings.argtypes = [handle, handle]
+    lib.xpmfd_vnav_set_wind_layers.argtypes = [handle, handle, ctypes.c_int32]
+    lib.xpmfd_vnav_set_wind_profile.argtypes = [handle, handle, ctypes.c_double]
+    lib.xpmfd_vnav_advance.argtypes = [handle, ctypes.c_int32, handle]
+    lib.xpmfd_vnav_profile_step.argtypes = [handle, ctypes.c_int32, handle]
+
+    state = lib.xpmfd_flight_state_create()
+    estimate = XpmfdWindEstimate()
+    for sample in (wind_samples(60, 0.0, 5000.0, 270.0, 20.0, 0.0, 1) +
+                   wind_samples(60, 60.0, 20000.0, 270.0, 60.0, 0.0, 1)):
+        lib.xpmfd_estimate_wind(state, ctypes.byref(XpmfdWindSample(*sample)), ctypes.byref(estimate))
+    layers = (XpmfdVnavWindLayer * 8)()
+    count = ctypes.c_int32()
+    status = lib.xpmfd_wind_profile_layers(state, 270.0, layers, 8, ctypes.byref(count))
+    got = [(layer.altitude_ft, layer.headwind_kts) for layer in layers[:count.value]]
+    if status != 0 or [a for a, _ in got] != [5000.0, 21000.0] or abs(got[0][1] - 20.0) > 0.01 or \
+            not 58.0 < got[1][1] < 60.01:
+        errors.append(f"Wind profile layers: status {status}, got {got}")
+
+    # The predictor reading the state directly builds the same path as one
+    # given those layers
+    steps = []
+    for use_profile in (True, False):
+        predictor = lib.xpmfd_vnav_predictor_create()
+        lib.xpmfd_vnav_set_settings(predictor, ctypes.byref(XpmfdVnavSettings(*VNAV_PREDICTOR_SETTINGS)))
+        if use_profile:
+            status = lib.xpmfd_vnav_set_wind_profile(predictor, state, 270.0)
+        else:
+            status = lib.xpmfd_vnav_set_wind_layers(predictor, layers, count.value)
+        progress = XpmfdVnavProgress()
+        lib.xpmfd_vnav_advance(predictor, 4096, ctypes.byref(progress))
+        step = XpmfdVnavProfileStep()
+        lib.xpmfd_vnav_profile_step(predictor, progress.step_count - 1, ctypes.byref(step))
+        steps.append((status, progress.step_count, tuple(struct_values(step).values())))
+        lib.xpmfd_vnav_predictor_destroy(predictor)
+    lib.xpmfd_flight_state_destroy(state)
+    if steps[0] != steps[1] or steps[0][0] != 0:
+        errors.append(f"VNAV from the wind profile: got {steps[0]}, from its layers {steps[1]}")
+
+    if errors:
+        print("❌ Wind estimate mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print("✅ Filtered wind, confidence and wind profile as expected")
+    return True
+
+FLIGHT_LOG_HEADER = "<4I3q24x"
+FLIGHT_LOG_RECORD = "<4q2i2I14d160s"
+
+def read_flight_log(path):
+    """Header fields and records (index, time_ns, aircraft_id, section, status, value_count, flags, values, result)"""
+    data = Path(path).read_bytes()
+    header = struct.unpack_from(FLIGHT_LOG_HEADER, data, 0)
+    records = []
+    for offset in range(struct.calcsize(FLIGHT_LOG_HEADER), len(data), struct.calcsize(FLIGHT_LOG_RECORD)):
+        fields = struct.unpack_from(FLIGHT_LOG_RECORD, data, offset)
+        records.append(fields[:3] + fields[4:8] + (fields[8:22], fields[22]))
+    return header, records, len(data)
+
+def test_flight_recorder():
+    """Flight recorder: every computed section logged with its inputs and result, replayed by calc_batch --log"""
+    print("Testing mfd_calcd --record")
+    daemon_path = Path(__file__).parent / "mfd_calcd"
+    batch_path = Path(__file__).parent / "calc_batch"
+
+    if not daemon_path.exists() or not batch_path.exists():
+        print("mfd_calcd or calc_batch not found")
+        return False
+
+    flight = "250 245 90 95 220 0.65 35000 35000 -500 75000 5 120 250 0.82"
+    requests = [f"{i + 1} turn {200 + 10 * i} {20 + i} 90 vnav 35000 10000 {100 + i} 450 -1500 flight {flight}"
+                for i in range(3)]
+    requests += ["4 turn 250 95 90",
+                 "5 aircraft 7 turn 300 30 45 wind_estimate 10 30000 250 260 10 10",
+                 "6 footprint 47 11 12000 200 240 250 270 270"]
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        socket_path = str(Path(tmp_dir) / "mfd_calcd.sock")
+        log_path = Path(tmp_dir) / "flight.log"
+        daemon = subprocess.Popen([str(daemon_path), "--socket", socket_path, "--workers", "2",
+                                   "--record", str(log_path)], stderr=subprocess.DEVNULL)
+        replies = []
+        try:
+            client = connect_unix_socket(socket_path)
+            if client is None:
+                print("❌ Could not connect to mfd_calcd")
+                return False
+            with client:
+                # One at a time, so the records are in request order
+                for line in requests:
+                    client.sendall((line + "\n").encode())
+                    replies += read_json_lines(client, 1) or [None]
+        finally:
+            daemon.terminate()
+            daemon.wait(timeout=5.0)
+
+        header, records, size = read_flight_log(log_path)
+        turn_csv = subprocess.run([str(batch_path), "--log", str(log_path), "turn"],
+                                  capture_output=True, text=True, timeout=10)
+        wind_csv = subprocess.run([str(batch_path), "--log", str(log_path), "wind"],
+                                  capture_output=True, text=True, timeout=10)
+        turn_inputs = "".join(f"{200 + 10 * i},{20 + i},90\n" for i in range(3)) + "250,95,90\n300,30,45\n"
+        turn_direct = subprocess.run([str(batch_path), "turn"], input=turn_inputs,
+                                     capture_output=True, text=True, timeout=10)
+        not_a_log = subprocess.run([str(batch_path), "--log", str(Path(tmp_dir) / "mfd_calcd.sock"), "turn"],
+                                   capture_output=True, text=True, timeout=10)
+
+    errors = []
+    if None in replies:
+        print("❌ Daemon replies were not valid JSON lines")
+        return False
+
+    # 3 frames of turn, vnav and flight; a rejected turn; an aircraft's
+    # turn and wind sample; a footprint
+    sections = [1, 2, 0] * 3 + [1, 1, 6, 5]
+    if header[:4] != (0x4C464D58, 1, 64, 320) or header[4] != len(sections) or header[5] != 0 or \
+            size != 64 + 320 * len(sections):
+        errors.append(f"Header {header}, file size {size}")
+    elif [r[3] for r in records] != sections or [r[0] for r in records] != list(range(len(sections))):
+        errors.append(f"Record sections {[r[3] for r in records]}, indices {[r[0] for r in records]}")
+    else:
+        if not all(r[1] >= 0 for r in records) or not header[6] > 0:
+            errors.append(f"Times: start {header[6]}, records {[r[1] for r in records]}")
+        turn = records[0]
+        radius_nm = struct.unpack_from("<8d", turn[8])[0]
+        if turn[5:7] != (3, 0) or turn[7][:3] != (200.0, 20.0, 90.0) or not all(math.isnan(v) for v in turn[7][3:]) \
+                or abs(radius_nm - replies[0]["turn"]["radius_nm"]) > 0.005:
+            errors.append(f"Turn record: {turn[3:8]}, radius {radius_nm}")
+        vnav = struct.unpack_from("<7d?", records[4][8])
+        if abs(vnav[2] - replies[1]["vnav"]["required_vs_fpm"]) > 0.005 or vnav[7] is not True:
+            errors.append(f"VNAV record result: {vnav}")
+        flight_result = struct.unpack_from("<5d6d2di4x4d", records[2][8])
+        if records[2][5] != 14 or abs(flight_result[2] - replies[0]["flight"]["wind"]["headwind"]) > 0.005 or \
+                abs(flight_result[-2] - replies[0]["flight"]["glide"]["glide_ratio"]) > 0.005:
+            errors.append(f"Flight record result: {flight_result}")
+        rejected = records[9]
+        if rejected[4] != 3 or rejected[8] != bytes(160):
+            errors.append(f"Rejected turn: status {rejected[4]}, result {rejected[8][:16]}")
+        aircraft_turn, aircraft_wind, footprint = records[10], records[11], records[12]
+        if (aircraft_turn[2], aircraft_turn[6]) != (7, 1) or (aircraft_wind[2], aircraft_wind[6]) != (7, 3):
+            errors.append(f"Aircraft records: {aircraft_turn[2:7]}, {aircraft_wind[2:7]}")
+        extent = struct.unpack_from("<2dq", footprint[8])
+        if footprint[6] != 2 or abs(extent[1] - replies[5]["footprint"]["max_range_nm"]) > 0.005 or extent[2] != 1:
+            errors.append(f"Footprint record: flags {footprint[6]}, extent {extent}")
+
+    # Replay: the log's turn sections give the same rows as their CSV
+    if turn_csv.returncode != 0 or turn_csv.stdout != turn_direct.stdout or turn_csv.stdout.count("\n") != 6:
+        errors.append(f"calc_batch --log turn: exit {turn_csv.returncode}, {turn_csv.stdout!r}")
+    wind_rows = wind_csv.stdout.splitlines()[1:]
+    if wind_csv.returncode != 0 or len(wind_rows) != 3 or \
+            abs(float(wind_rows[0].split(",")[0]) - replies[0]["flight"]["wind"]["headwind"]) > 0.005:
+        errors.append(f"calc_batch --log wind: exit {wind_csv.returncode}, {wind_rows}")
+    if not_a_log.returncode != 3:
+        errors.append(f"calc_batch --log on a non-log: exit {not_a_log.returncode}")
+
+    if errors:
+        print("❌ Flight recorder mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print("✅ Every section recorded and replayed from the flight log")
+    return True
+
+def test_calc_loadgen():
+    """Load generator: deterministic frames over the socket, shm and the C API, and replay of a flight log"""
+    print("Testing calc_loadgen")
+    daemon_path = Path(__file__).parent / "mfd_calcd"
+    loadgen_path = Path(__file__).parent / "calc_loadgen"
+
+    if not daemon_path.exists() or not loadgen_path.exists():
+        print("mfd_calcd or calc_loadgen not found")
+        return False
+
+    def loadgen(*arguments):
+        return subprocess.run([str(loadgen_path)] + [str(a) for a in arguments],
+                              capture_output=True, text=True, timeout=30)
+
+    def report(result):
+        try:
+            return json.loads(result.stdout) if result.returncode == 0 else None
+        except json.JSONDecodeError:
+            return None
+
+    errors = []
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        socket_path = str(Path(tmp_dir) / "mfd_calcd.sock")
+        shm_path = Path(tmp_dir) / "mfd_calcd.shm"
+        log_path = Path(tmp_dir) / "flight.log"
+        daemon = subprocess.Popen([str(daemon_path), "--socket", socket_path, "--shm", str(shm_path),
+                                   "--workers", "2", "--record", str(log_path)], stderr=subprocess.DEVNULL)
+        try:
+            client = connect_unix_socket(socket_path)
+            if client is None:
+                print("❌ Could not connect to mfd_calcd")
+                return False
+            client.close()
+            socket_run = loadgen("--socket", socket_path, "--clients", 3, "--frames", 200, "--json")
+            shm_run = loadgen("--shm", shm_path, "--frames", 50, "--json")
+            paced_run = loadgen("--socket", socket_path, "--rate", 50, "--frames", 20, "--json")
+        finally:
+            daemon.terminate()
+            daemon.wait(timeout=5.0)
+
+        replay_run = loadgen("--in-process", "--log", log_path, "--frames", 500, "--json")
+        in_process_run = loadgen("--in-process", "--clients", 2, "--frames", 1000, "--json")
+        unreachable = loadgen("--socket", socket_path, "--frames", 5)
+        shm_clients = loadgen("--shm", shm_path, "--clients", 2)
+        dry_runs = [loadgen("--dry-run", "--clients", 2, "--frames", 5, "--seed", seed).stdout
+                    for seed in (7, 7, 8)]
+
+    # Every synthetic frame is flight, turn, vnav and density
+    expected = [(socket_run, "socket", 600, 2400), (shm_run, "shm", 50, 200), (paced_run, "socket", 20, 80),
+                (replay_run, "in-process", 500, 500), (in_process_run, "in-process", 2000, 8000)]
+    for run, interface, frames, sections in expected:
+        result = report(run)
+        if result is None or result["interface"] != interface or result["answered"] != frames or \
+                result["sections"] != sections or result["failed"] != 0 or result["dropped"] != 0:
+            errors.append(f"{interface} run: exit {run.returncode}, {run.stdout.strip()}")
+        elif not 0 < result["latency_us"]["p50"] <= result["latency_us"]["p99"] <= result["latency_us"]["max"]:
+            errors.append(f"{interface} latency: {result['latency_us']}")
+
+    # 20 frames at 50 Hz: the last is due 0.38 s after the first
+    paced = report(paced_run)
+    if paced is not None and not 0.3 < paced["elapsed_s"] < 1.5:
+        errors.append(f"Paced run took {paced['elapsed_s']} s")
+    replay = report(replay_run)
+    if replay is not None and replay["source"] != "log":
+        errors.append(f"Replay source: {replay['source']}")
+
+    lines = dry_runs[0].splitlines()
+    if dry_runs[0] != dry_runs[1] or dry_runs[0] == dry_runs[2] or len(lines) != 10 or \
+            not lines[0].startswith("1 aircraft 1 flight ") or not lines[5].startswith("1 aircraft 2 flight ") or \
+            [len(line.split()) for line in lines[:1]] != [3 + 15 + 4 + 6 + 6]:
+        errors.append(f"Dry runs: {dry_runs[0][:200]!r}")
+    if unreachable.returncode != 4 or shm_clients.returncode != 1:
+        errors.append(f"Exit codes: unreachable {unreachable.returncode}, two shm clients {shm_clients.returncode}")
+
+    if errors:
+        print("❌ Load generator mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print("✅ Load generator frames answered on every interface and replayed deterministically")
+    return True
+
+def parse_prometheus(text):
+    """Sample lines of Prometheus text as {name{labels}: value}"""
+    samples = {}
+    for line in text.splitlines():
+        if line and not line.startswith("#"):
+            name, value = line.rsplit(" ", 1)
+            samples[name] = float(value)
+    return samples
+
+def test_calculator_metrics():
+    """Metrics: counters and compute times from mfd_calcd, flight_calculator --serve and the C API"""
+    print("Testing calculator metrics")
+    daemon_path = Path(__file__).parent / "mfd_calcd"
+    calculator_path = Path(__file__).parent / "flight_calculator"
+    library_path = Path(__file__).parent / "libxpmfd_calc.so"
+
+    if not daemon_path.exists() or not calculator_path.exists() or not library_path.exists():
+        print("mfd_calcd, flight_calculator or libxpmfd_calc.so not found")
+        return False
+
+    flight = " ".join(FLIGHT_ARGUMENTS)
+    # A wings-level turn and a VNAV below both floors; a repeated flight
+    # sample (cache hits); a field that is not a number; a malformed line;
+    # a rejected bank angle
+    requests = ["1 turn 250 0 90 vnav 35000 10000 0 0.5 -1500", f"2 flight {flight}", f"3 flight {flight}",
+                "4 turn abc 25 90", "x turn", "5 turn 250 95 90 density 5000 25 150 170 0"]
+    errors = []
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        socket_path = str(Path(tmp_dir) / "mfd_calcd.sock")
+        metrics_path = Path(tmp_dir) / "mfd_calcd.prom"
+        daemon = subprocess.Popen([str(daemon_path), "--socket", socket_path, "--metrics", str(metrics_path)],
+                                  stderr=subprocess.DEVNULL)
+        replies = []
+        exported = {}
+        try:
+            client = connect_unix_socket(socket_path)
+            if client is None:
+                print("❌ Could not connect to mfd_calcd")
+                return False
+            with client:
+                for line in requests + ["6 metrics"]:
+                    client.sendall((line + "\n").encode())
+                    replies += read_json_lines(client, 1) or [None]
+            # Written every second: wait for a file with the requests in it
+            deadline = time.monotonic() + 5.0
+            while exported.get("xpmfd_requests_total", 0) < len(requests) + 1 and time.monotonic() < deadline:
+                time.sleep(0.1)
+                if metrics_path.exists():
+                    exported = parse_prometheus(metrics_path.read_text())
+        finally:
+            daemon.terminate()
+            daemon.wait(timeout=5.0)
+
+    expected_counters = {"requests": 7, "request_errors": 1, "parse_failures": 1, "section_errors": 1,
+                         "turn_wings_level": 1, "vnav_distance_floor": 1, "vnav_groundspeed_floor": 1,
+                         "footprint_sweeps": 0, "cache_misses": 3, "cache_hits": 3}
+    if None in replies or replies[-1].get("id") != 6 or "metrics" not in replies[-1]:
+        errors.append(f"Metrics reply: {replies[-1:]}")
+    else:
+        metrics = replies[-1]["metrics"]
+        if metrics["counters"] != expected_counters:
+            errors.append(f"Daemon counters: {metrics['counters']}")
+        # The rejected bank is a call too; the unparsed turn never reached a kernel
+        calls = {name: kernel["calls"] for name, kernel in metrics["kernels"].items()}
+        if calls != {"flight": 2, "turn": 2, "vnav": 1, "density": 1, "dynamic": 0, "footprint": 0,
+                     "wind_estimate": 0}:
+            errors.append(f"Daemon kernel calls: {calls}")
+        flight_time = metrics["kernels"]["flight"]
+        if flight_time["timed"] != 2 or not 0 < flight_time["p50_us"] <= flight_time["max_us"]:
+            errors.append(f"Flight compute time: {flight_time}")
+
+    for name, value in expected_counters.items():
+        if exported.get(f"xpmfd_{name}_total") != value:
+            errors.append(f"Prometheus xpmfd_{name}_total: {exported.get(f'xpmfd_{name}_total')}")
+    label = 'kernel="flight"'
+    buckets = [v for k, v in exported.items() if k.startswith("xpmfd_kernel_seconds_bucket{" + label)]
+    if exported.get("xpmfd_kernel_calls_total{" + label + "}") != 2 or len(buckets) != 16 or \
+            buckets != sorted(buckets) or buckets[-1] != 2 or \
+            exported.get("xpmfd_kernel_seconds_count{" + label + "}") != 2 or \
+            not exported.get("xpmfd_kernel_seconds_sum{" + label + "}", 0) > 0:
+        errors.append(f"Prometheus flight histogram: {buckets}")
+
+    # flight_calculator --serve: its own requests and the flight kernel
+    served = subprocess.run([str(calculator_path), "--serve"], input=f"{flight}\n{flight}\n1 2 3\nmetrics\n",
+                            capture_output=True, text=True, timeout=5)
+    try:
+        serve_metrics = json.loads(served.stdout.splitlines()[-1])["metrics"]
+        if serve_metrics["counters"]["requests"] != 3 or serve_metrics["counters"]["request_errors"] != 1 or \
+                serve_metrics["counters"]["cache_hits"] != 3 or serve_metrics["kernels"]["flight"]["timed"] != 2:
+            errors.append(f"--serve metrics: {serve_metrics['counters']}, {serve_metrics['kernels']['flight']}")
+    except (json.JSONDecodeError, IndexError, KeyError):
+        errors.append(f"--serve metrics line: {served.stdout[-200:]!r}")
+
+    # The C API counts its calls, untimed
+    lib = ctypes.CDLL(str(library_path))
+    double = ctypes.c_double
+    lib.xpmfd_calculate_turn.argtypes = [double] * 3 + [ctypes.c_void_p]
+    lib.xpmfd_calculate_vnav.argtypes = [double] * 5 + [ctypes.c_void_p]
+    lib.xpmfd_metrics_text.argtypes = [ctypes.c_int32, ctypes.c_char_p, ctypes.c_int32,
+                                       ctypes.POINTER(ctypes.c_int32)]
+    lib.xpmfd_calculate_turn(250.0, 0.0, 90.0, ctypes.byref(XpmfdTurnData()))
+    lib.xpmfd_calculate_turn(250.0, 95.0, 90.0, ctypes.byref(XpmfdTurnData()))
+    lib.xpmfd_calculate_vnav(35000.0, 10000.0, 100.0, 0.0, -1500.0, ctypes.byref(XpmfdVnavData()))
+    buffer = ctypes.create_string_buffer(65536)
+    length = ctypes.c_int32(0)
+    json_status = lib.xpmfd_metrics_text(0, buffer, len(buffer), ctypes.byref(length))
+    library_metrics = json.loads(buffer.raw[:length.value]) if json_status == 0 else None
+    prometheus_status = lib.xpmfd_metrics_text(1, buffer, len(buffer), ctypes.byref(length))
+    library_samples = parse_prometheus(buffer.raw[:length.value].decode()) if prometheus_status == 0 else {}
+    short_status = lib.xpmfd_metrics_text(0, buffer, 16, ctypes.byref(length))
+    if library_metrics is None or library_metrics["kernels"]["turn"] != \
+            {"calls": 1, "timed": 0, "mean_us": 0.0, "p50_us": 0.0, "p90_us": 0.0, "p99_us": 0.0, "max_us": 0.0} or \
+            library_metrics["counters"]["turn_wings_level"] != 1 or \
+            library_metrics["counters"]["section_errors"] != 1 or \
+            library_metrics["counters"]["vnav_groundspeed_floor"] != 1:
+        errors.append(f"C API metrics: {library_metrics}")
+    if library_samples.get('xpmfd_kernel_calls_total{kernel="vnav"}') != 1 or short_status != 1:
+        errors.append(f"C API Prometheus text: status {prometheus_status}, short buffer {short_status}")
+
+    if errors:
+        print("❌ Metrics mismatch:")
+        for err in errors:
+            print(f" - {err}")
+        return False
+
+    print("✅ Counters and compute times match the requests on every front end")
+    return True
+
 def test_calculator(filename, arguments, expected_output=None, expected_return_code=0):
     print(f"Testing {filename}")
     script_dir = Path(__file__).parent
@@ -220,8 +2052,28 @@ def main():
         test_turn_calculator,
         test_vnav_calculator,
         test_density_altitude_calculator,
+        test_isa_table,
         test_wind_calculator,
-        test_flight_calculator
+        test_number_parsing,
+        test_flight_calculator,
+        test_flight_calculator_serve,
+        test_flight_result_cache,
+        test_mfd_calcd,
+        test_mfd_calcd_shm,
+        test_mfd_calcd_aircraft,
+        test_mfd_calcd_aircraft_slots,
+        test_aircraft_profile,
+        test_glide_footprint,
+        test_wind_estimator,
+        test_flight_recorder,
+        test_calc_loadgen,
+        test_calculator_metrics,
+        test_binary_output,
+        test_calc_batch,
+        test_calc_batch_simd,
+        test_calc_bench,
+        test_calculator_library,
+        test_vnav_predictor
     ]
 
     any_failures = False